@@ -0,0 +1,49 @@
+-- ASYNC.LUA =============================================================== --
+-- Loads many small files at once off the main thread and logs how long      --
+-- it took. Compare the 'jobs' section of the report to see how many         --
+-- threads were used.                                                        --
+-- ========================================================================= --
+-- Lua aliases (optimisation) ---------------------------------------------- --
+local error<const>, format<const> = error, string.format;
+-- M-Engine aliases (optimisation) ----------------------------------------- --
+local AssetCreate<const>, AssetFileAsync<const>, CoreLog<const>,
+  CoreOnTick<const>, FileMkDir<const>, InfoOSNanoTime<const> =
+    Asset.Create, Asset.FileAsync, Core.Log, Core.OnTick, File.MkDir,
+    Info.OSNanoTime;
+-- Settings ---------------------------------------------------------------- --
+local iFiles<const> = 500;             -- Number of files to load
+local iSize<const> = 4096;             -- Size of each file in bytes
+local strDir<const> = "async";         -- Directory to write the files to
+local iFlags<const>=Asset.Flags.NONE;   -- Load flags
+-- Variables --------------------------------------------------------------- --
+local iStart, iLoaded = 0, 0;          -- Time loading started and count
+-- Get filename of a file -------------------------------------------------- --
+local function GetFile(iIndex) return format("%s/%u.bin", strDir, iIndex) end;
+-- Create the files to load ------------------------------------------------ --
+FileMkDir(strDir);
+local aData<const> = AssetCreate("bench", iSize);
+for iIndex = 1, iFiles do aData:ToFile(GetFile(iIndex)) end;
+aData:Destroy();
+-- Load callbacks ---------------------------------------------------------- --
+local function OnError(strReason) error(strReason) end;
+local function OnProgress() end;
+local function OnLoaded(aAsset)
+  -- Free it and wait for the rest
+  aAsset:Destroy();
+  iLoaded = iLoaded + 1;
+  if iLoaded < iFiles then return end;
+  -- Log the time taken
+  CoreLog(format("Loaded %u files of %u bytes in %.3f ms.", iFiles, iSize,
+    (InfoOSNanoTime() - iStart) / 1000000));
+end
+-- Nothing to do while waiting for the files ------------------------------- --
+local function Idle() end;
+-- Queue every file on the first tick -------------------------------------- --
+CoreOnTick(function()
+  iStart = InfoOSNanoTime();
+  for iIndex = 1, iFiles do
+    AssetFileAsync(GetFile(iIndex), iFlags, OnError, OnProgress, OnLoaded);
+  end
+  CoreOnTick(Idle);
+end);
+-- End-of-File ============================================================= --
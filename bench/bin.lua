@@ -0,0 +1,47 @@
+-- BIN.LUA ================================================================= --
+-- Packs many randomly sized rects into a small bin every tick, doubling the --
+-- bin whenever a rect does not fit like the font atlas does. The same rect  --
+-- sizes are used every tick so the tick times are the time taken to pack    --
+-- them all and the final size and occupancy never change.                   --
+-- ========================================================================= --
+-- Lua aliases (optimisation) ---------------------------------------------- --
+local error<const>, format<const>, select<const> =
+  error, string.format, select;
+-- M-Engine aliases (optimisation) ----------------------------------------- --
+local BinCreate<const>, CoreLog<const>, CoreOnTick<const> =
+  Bin.Create, Core.Log, Core.OnTick;
+-- Settings ---------------------------------------------------------------- --
+local iRects<const> = 2000;            -- Rects to pack every tick
+local iMinSize<const> = 6;             -- Smallest width or height of a rect
+local iMaxSize<const> = 40;            -- Largest width or height of a rect
+local iStart<const> = 128;             -- Starting width and height of bin
+-- Make the rect sizes with a fixed seed so every run is the same ---------- --
+local aSizes<const>, iSeed = { }, 12345;
+local function Random()
+  iSeed = (iSeed * 1103515245 + 12345) % 2147483648;
+  return iMinSize + iSeed % (iMaxSize - iMinSize + 1);
+end
+for iIndex = 1, iRects * 2, 2 do
+  aSizes[iIndex], aSizes[iIndex + 1] = Random(), Random();
+end;
+-- Pack the rects every tick ----------------------------------------------- --
+local iFirst;                          -- Final bin size on the first tick
+CoreOnTick(function()
+  local binPack = BinCreate(iStart, iStart);
+  for iIndex = 1, iRects * 2, 2 do
+    local iWidth<const>, iHeight<const> = aSizes[iIndex], aSizes[iIndex + 1];
+    -- Double the bin until the rect fits
+    while select(3, binPack:Insert(iWidth, iHeight)) == 0 do
+      binPack:Enlarge(binPack:Width() * 2, binPack:Height() * 2);
+    end;
+  end;
+  -- Log the result once and make sure it never changes
+  local iSize<const> = binPack:Width();
+  if not iFirst then
+    iFirst = iSize;
+    CoreLog(format("Packed %u rects into %ux%u at %.2f%% occupancy.",
+      iRects, iSize, binPack:Height(), binPack:Occupancy() * 100));
+  elseif iSize ~= iFirst then error("Bin size changed!") end;
+  binPack:Destroy();
+end);
+-- End-of-File ============================================================= --
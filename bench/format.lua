@@ -0,0 +1,24 @@
+-- FORMAT.LUA ============================================================== --
+-- Calls an engine function with an out of range argument many times every   --
+-- tick. Each call builds an engine error message with several formatted     --
+-- integer parameters so the tick times in the report are mostly the time    --
+-- taken to format them.                                                     --
+-- ========================================================================= --
+-- Lua aliases (optimisation) ---------------------------------------------- --
+local error<const>, find<const>, pcall<const> = error, string.find, pcall;
+-- M-Engine aliases (optimisation) ----------------------------------------- --
+local CoreLogEx<const>, CoreOnTick<const> = Core.LogEx, Core.OnTick;
+-- Settings ---------------------------------------------------------------- --
+local iCalls<const> = 10000;           -- Errors to build every tick
+local iLevel<const> = 99;              -- Out of range log level
+local strLine<const> = "Not logged";   -- Line that is never logged
+-- Build the errors every tick --------------------------------------------- --
+CoreOnTick(function()
+  for iIndex = 1, iCalls do
+    local bResult<const>, strError<const> =
+      pcall(CoreLogEx, strLine, iLevel);
+    if bResult or not find(strError, "out of range", 1, true) then
+      error("Expected an out of range error!") end;
+  end;
+end);
+-- End-of-File ============================================================= --
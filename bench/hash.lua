@@ -0,0 +1,33 @@
+-- HASH.LUA ================================================================ --
+-- Writes a large file once then hashes it in chunks on the job pool every   --
+-- tick. The tick times in the report are the time taken to hash it so the   --
+-- throughput is the file size divided by them.                              --
+-- ========================================================================= --
+-- Lua aliases (optimisation) ---------------------------------------------- --
+local error<const>, format<const> = error, string.format;
+-- M-Engine aliases (optimisation) ----------------------------------------- --
+local AssetCreate<const>, CoreLog<const>, CoreOnTick<const>,
+  CryptHashManifest<const> =
+    Asset.Create, Core.Log, Core.OnTick, Crypt.HashManifest;
+-- Settings ---------------------------------------------------------------- --
+local iSize<const> = 268435456;       -- Size of the file in bytes
+local iChunk<const> = 65536;          -- Size of each chunk in bytes
+local strFile<const> = "hash.bin";    -- File to hash
+local iType<const> = Crypt.Hashes.SHA256; -- Hash type
+-- Create the file to hash ------------------------------------------------- --
+local aData<const> = AssetCreate("bench", iSize);
+aData:ToFile(strFile);
+aData:Destroy();
+-- Hash the file every tick ------------------------------------------------ --
+local strFirst;                        -- Root of the first hash
+CoreOnTick(function()
+  local strRoot<const>, aChunks<const> =
+    CryptHashManifest(iType, strFile, iChunk);
+  -- Log the result once and make sure it never changes
+  if not strFirst then
+    strFirst = strRoot;
+    CoreLog(format("Hashed %u bytes in %u chunks to %s.", iSize, #aChunks,
+      strRoot));
+  elseif strRoot ~= strFirst then error("Hash changed!") end;
+end);
+-- End-of-File ============================================================= --
@@ -0,0 +1,71 @@
+-- IMAGE.LUA =============================================================== --
+-- Writes an odd sized luminance and luminance alpha test image once then    --
+-- loads them every tick with each conversion to RGB, RGBA and BGR order.    --
+-- The time taken by each conversion over plainly loading the image is       --
+-- logged every few ticks. The odd size leaves a tail after the vector       --
+-- kernels so both them and the per-pixel filters are timed.                 --
+-- ========================================================================= --
+-- Lua aliases (optimisation) ---------------------------------------------- --
+local format<const>, ipairs<const> = string.format, ipairs;
+-- M-Engine aliases (optimisation) ----------------------------------------- --
+local AssetCreate<const>, CoreLog<const>, CoreOnTick<const>,
+  ImageFile<const>, ImageRaw<const>, InfoOSNanoTime<const> =
+    Asset.Create, Core.Log, Core.OnTick, Image.File, Image.Raw,
+    Info.OSNanoTime;
+-- Settings ---------------------------------------------------------------- --
+local iWidth<const>, iHeight<const> = 1021, 1021; -- Size of test images
+local iReport<const> = 10;             -- Log the times every this many ticks
+local aFlags<const> = Image.Flags;     -- Image load flags
+local aTests<const> = {                -- Conversions to time
+  { "RGB",  aFlags.TO24BPP },          -- Luminance to RGB
+  { "RGBA", aFlags.TO32BPP },          -- Luminance to RGBA
+  { "BGR",  aFlags.TO24BPP | aFlags.TOBGR }, -- Then swap red and blue
+  { "BGRA", aFlags.TO32BPP | aFlags.TOBGR }, -- Then swap red and blue
+};
+local aImages<const> = {               -- Test images to write and load
+  { "image8.png",  1, 8 },             -- Luminance
+  { "image16.png", 2, 16 },            -- Luminance alpha
+};
+-- Write the test images with gradients and some noise --------------------- --
+local iSeed = 1;
+for _, aImage in ipairs(aImages) do
+  local iBytes<const> = aImage[2];
+  local aPixels<const> = AssetCreate(aImage[1], iWidth * iHeight * iBytes);
+  for iIndex = 0, iWidth * iHeight - 1 do
+    iSeed = (iSeed * 1103515245 + 12345) % 2147483648;
+    local iLum<const> = (iIndex % iWidth + (iSeed >> 16)) & 255;
+    if iBytes == 1 then aPixels:WU8(iIndex, iLum);
+    else aPixels:WU16LE(iIndex * 2, iLum | ((iSeed >> 8) & 0xFF00)) end;
+  end;
+  local imSource<const> =
+    ImageRaw(aImage[1], aPixels, iWidth, iHeight, aImage[3]);
+  imSource:Save(aImage[1]);
+  imSource:Destroy();
+  aImage[4] = { };                     -- Nanoseconds spent on each test
+  for iTest = 1, #aTests do aImage[4][iTest] = 0 end;
+end;
+-- Load the images with each conversion every tick ------------------------- --
+local iTicks = 0;                      -- Ticks done
+CoreOnTick(function()
+  for _, aImage in ipairs(aImages) do
+    local strFile<const>, aTotals<const> = aImage[1], aImage[4];
+    local iStart<const> = InfoOSNanoTime();
+    ImageFile(strFile, aFlags.NONE):Destroy();
+    local iPlain<const> = InfoOSNanoTime() - iStart;
+    for iTest, aTest in ipairs(aTests) do
+      local iBegin<const> = InfoOSNanoTime();
+      ImageFile(strFile, aTest[2]):Destroy();
+      aTotals[iTest] = aTotals[iTest] + (InfoOSNanoTime() - iBegin) - iPlain;
+    end;
+  end;
+  -- Log the average conversion times every few ticks
+  iTicks = iTicks + 1;
+  if iTicks % iReport ~= 0 then return end;
+  for _, aImage in ipairs(aImages) do
+    for iTest, aTest in ipairs(aTests) do
+      CoreLog(format("Converted %ux%u %s to %s in %.3f ms.", iWidth,
+        iHeight, aImage[1], aTest[1], aImage[4][iTest] / iTicks / 1000000));
+    end;
+  end;
+end);
+-- End-of-File ============================================================= --
@@ -0,0 +1,62 @@
+-- JSON.LUA ================================================================ --
+-- Builds a large nested table once then encodes and decodes it every tick   --
+-- directly with Json.Encode and Json.Decode and through a Json object. The  --
+-- time taken by both ways is logged every few ticks so they can be          --
+-- compared.                                                                 --
+-- ========================================================================= --
+-- Lua aliases (optimisation) ---------------------------------------------- --
+local error<const>, format<const> = error, string.format;
+-- M-Engine aliases (optimisation) ----------------------------------------- --
+local CoreLog<const>, CoreOnTick<const>, InfoOSNanoTime<const>,
+  JsonDecode<const>, JsonEncode<const>, JsonString<const>,
+  JsonTable<const> =
+    Core.Log, Core.OnTick, Info.OSNanoTime, Json.Decode, Json.Encode,
+    Json.String, Json.Table;
+-- Settings ---------------------------------------------------------------- --
+local iEntities<const> = 5000;         -- Number of entities in the table
+local iItems<const> = 16;              -- Inventory items of each entity
+local iReport<const> = 10;             -- Log the times every this many ticks
+-- Build the table --------------------------------------------------------- --
+local aEntities<const> = { };
+for iEntity = 1, iEntities do
+  local aItems<const> = { };
+  for iItem = 1, iItems do
+    aItems[iItem] = { name = format("Item %u", iItem), count = iItem * 3,
+      weight = iItem * 0.25, stacked = iItem % 2 == 0 };
+  end;
+  aEntities[iEntity] = { id = iEntity, name = format("Entity %u", iEntity),
+    position = { x = iEntity * 1.5, y = iEntity * -2.5 },
+    stats = { health = 100, armour = iEntity % 50, level = iEntity % 99 },
+    inventory = aItems };
+end;
+local aData<const> = { version = 1, entities = aEntities };
+-- Check a decoded table --------------------------------------------------- --
+local function Check(aDecoded)
+  if #aDecoded.entities ~= iEntities or
+     #aDecoded.entities[iEntities].inventory ~= iItems then
+    error("Decoded table does not match!") end;
+end;
+-- Encode and decode the table every tick ---------------------------------- --
+local iTicks, iDirect, iObject = 0, 0, 0; -- Ticks and nanoseconds taken
+CoreOnTick(function()
+  -- Encode and decode directly
+  local iStart<const> = InfoOSNanoTime();
+  local strCode<const> = JsonEncode(aData, false);
+  Check(JsonDecode(strCode));
+  local iMiddle<const> = InfoOSNanoTime();
+  -- Encode and decode through a Json object
+  local jEncoder<const> = JsonTable(aData);
+  local strObject<const> = jEncoder:ToString();
+  jEncoder:Destroy();
+  local jDecoder<const> = JsonString("json", strObject);
+  Check(jDecoder:ToTable());
+  jDecoder:Destroy();
+  local iEnd<const> = InfoOSNanoTime();
+  -- Add the times and log them every few ticks
+  iTicks, iDirect, iObject =
+    iTicks + 1, iDirect + iMiddle - iStart, iObject + iEnd - iMiddle;
+  if iTicks % iReport ~= 0 then return end;
+  CoreLog(format("%u bytes of JSON: direct %.2f ms, Json object %.2f ms.",
+    #strCode, iDirect / iTicks / 1000000, iObject / iTicks / 1000000));
+end);
+-- End-of-File ============================================================= --
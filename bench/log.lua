@@ -0,0 +1,17 @@
+-- LOG.LUA ================================================================= --
+-- Writes many lines to the log file every tick. The tick times in the       --
+-- report are the time the calling thread spent logging so the lines per     --
+-- second are the number of lines divided by them. Run again with the        --
+-- 'log_async' cvar set to 0 to compare with writing lines synchronously.    --
+-- ========================================================================= --
+-- M-Engine aliases (optimisation) ----------------------------------------- --
+local CoreLog<const>, CoreOnTick<const> = Core.Log, Core.OnTick;
+-- Settings ---------------------------------------------------------------- --
+local iLines<const> = 10000;           -- Lines to log every tick
+local strLine<const> =                 -- Line to log
+  "The quick brown fox jumps over the lazy dog.";
+-- Log the lines every tick ------------------------------------------------ --
+CoreOnTick(function()
+  for iIndex = 1, iLines do CoreLog(strLine) end;
+end);
+-- End-of-File ============================================================= --
@@ -0,0 +1,36 @@
+-- MASK.LUA ================================================================ --
+-- Tests a 128x128 sprite mask against a mostly empty 2048x2048 world mask   --
+-- at many unaligned positions every tick. Most tests miss so every row of   --
+-- the overlap is compared. The tick times in the report are the time taken  --
+-- to do all the tests.                                                      --
+-- ========================================================================= --
+-- Lua aliases (optimisation) ---------------------------------------------- --
+local error<const>, format<const> = error, string.format;
+-- M-Engine aliases (optimisation) ----------------------------------------- --
+local CoreLog<const>, CoreOnTick<const>, MaskCreateOne<const>,
+  MaskCreateZero<const> =
+    Core.Log, Core.OnTick, Mask.CreateOne, Mask.CreateZero;
+-- Settings ---------------------------------------------------------------- --
+local iWorld<const> = 2048;            -- Width and height of world mask
+local iSprite<const> = 128;            -- Width and height of sprite mask
+local iTests<const> = 10000;           -- Tests to do every tick
+-- Create the masks -------------------------------------------------------- --
+local mWorld<const> = MaskCreateZero("world", iWorld, iWorld);
+local mSprite<const> = MaskCreateOne("sprite", iSprite, iSprite);
+mWorld:Fill(1000, 1000, 16, 16);
+-- Test the masks every tick ----------------------------------------------- --
+local iFirst;                          -- Hits on the first tick
+CoreOnTick(function()
+  local iHits = 0;
+  for iIndex = 1, iTests do
+    local iX<const> = (iIndex * 37) % (iWorld - iSprite) + 1;
+    local iY<const> = (iIndex * 53) % (iWorld - iSprite) + 1;
+    if mWorld:IsCollide(mSprite, 0, iX, iY) then iHits = iHits + 1 end;
+  end;
+  -- Log the result once and make sure it never changes
+  if not iFirst then
+    iFirst = iHits;
+    CoreLog(format("%u of %u mask tests hit.", iHits, iTests));
+  elseif iHits ~= iFirst then error("Mask hits changed!") end;
+end);
+-- End-of-File ============================================================= --
@@ -10,7 +10,8 @@
 /* ------------------------------------------------------------------------- */
 namespace IArchive {                   // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
-using namespace IASync::P;             using namespace ICodec::P;
+using namespace IAsset::P;             using namespace IASync::P;
+using namespace IClock::P;             using namespace ICodec::P;
 using namespace ICollector::P;         using namespace ICrypt::P;
 using namespace ICVarDef::P;           using namespace IDir::P;
 using namespace IError::P;             using namespace IEvtMain::P;
@@ -34,6 +35,23 @@ CTOR_BEGIN_ASYNC(Archives, Archive, CLHelperSafe,
   /* -- Free function for lzma --------------------------------------------- */
   static void Free(ISzAllocPtr, void*const vpAddress)
     { UtilMemFree(vpAddress); }
+  /* -- Time spent reading archives on this thread ------------------------- */
+  static uint64_t &ReadTime(void)
+    { static thread_local uint64_t qwTime = 0; return qwTime; }
+  /* -- Read function for lzma that records the time taken ----------------- */
+  static SRes ReadTimed(const ISeekInStream*const issStream,
+    void*const vpData, size_t*const stpBytes)
+  { // Get the original read function the first time
+    static const auto fpRead{ []
+      { CFileInStream cfisStream;
+        FileInStream_CreateVTable(&cfisStream);
+        return cfisStream.vt.Read; }() };
+    // Read and record the time taken
+    const ClockChrono<> ccRead;
+    const SRes srResult = fpRead(issStream, vpData, stpBytes);
+    ReadTime() += ccRead.CCDeltaNS();
+    return srResult;
+  }
 );/* ----------------------------------------------------------------------- */
 BUILD_FLAGS(Archive,
   /* ----------------------------------------------------------------------- */
@@ -86,15 +104,25 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
       size_t stCompressed = 0, stOffset = 0, stUncompressed = 0;
       // Block index returned in extractor function
       unsigned int uiBlockIndex = StdMaxUInt;
+      // The decoder reads as it decompresses so time the reads separately
+      const uint64_t qwReadStart = Archives::ReadTime();
+      const ClockChrono<> ccExtract;
       // Decompress the buffer using our base handles and throw error if it
       // failed
-      if(const int iCode = SzArEx_Extract(&csaeRef, &cltrRef.vt,
-        uiSrcId, &uiBlockIndex, &ucpData, &stUncompressed, &stOffset,
-        &stCompressed, &cParent->isaData, &cParent->isaData))
-          XC("Failed to extract file",
-             "Archive", IdentGet(), "File",  strFile,
-             "Index",   uiSrcId, "Code",  iCode,
-             "Reason",  CodecGetLzmaErrString(iCode));
+      const int iCode = SzArEx_Extract(&csaeRef, &cltrRef.vt, uiSrcId,
+        &uiBlockIndex, &ucpData, &stUncompressed, &stOffset, &stCompressed,
+        &cParent->isaData, &cParent->isaData);
+      // Record time spent reading and the rest as decompressing
+      const uint64_t qwExtract = ccExtract.CCDeltaNS(),
+        qwRead = UtilMinimum(Archives::ReadTime() - qwReadStart, qwExtract);
+      AssetStageAdd(AS_READ, qwRead);
+      AssetStageAdd(AS_DECOMPRESS, qwExtract - qwRead);
+      // Throw error if it failed
+      if(iCode)
+        XC("Failed to extract file",
+           "Archive", IdentGet(), "File",  strFile,
+           "Index",   uiSrcId, "Code",  iCode,
+           "Reason",  CodecGetLzmaErrString(iCode));
       // No data returned meaning a zero-byte file?
       if(!ucpData)
       { // Allocate a zero-byte array to a new class. Remember we need to send
@@ -153,6 +181,7 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
   void SetupLookToRead(CFileInStream &cfisRef, CLookToRead2 &cltrRef)
   { // Setup vtables and stream pointers
     FileInStream_CreateVTable(&cfisRef);
+    cfisRef.vt.Read = Archives::ReadTimed;
     LookToRead2_CreateVTable(&cltrRef, False);
     cltrRef.realStream = &cfisRef.vt;
     // Need to allocate transfer buffer in later LZMA.
@@ -182,6 +211,15 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Archives, Archive, ICHelperUnsafe),
   /* -- Returns uncompressed size of file by id ---------------------------- */
   uint64_t GetSize(const size_t stId) const
     { return static_cast<uint64_t>(SzArEx_GetFileSize(&csaeData, stId)); }
+  /* -- Returns position of the block holding the file by id --------------- */
+  uint64_t GetBlockPosition(const size_t stId) const
+  { // Empty files are not in a block so they can go anywhere
+    const UInt32 uiFolder = csaeData.FileToFolder[stId];
+    if(uiFolder == StdMaxUInt) return 0;
+    // Return where the packed data for the block starts in the file
+    return csaeData.dataPos + csaeData.db.PackPositions[
+      csaeData.db.FoStartPackStreamIndex[uiFolder]];
+  }
   /* -- Total files and directories in archive ----------------------------- */
   size_t GetTotal(void) const { return csaeData.NumFiles; }
   /* -- Get a file/dir and uid by zero-index ------------------------------- */
@@ -588,6 +626,23 @@ static FileMap ArchiveExtract(const string &strFile)
   } // FileMap not found
   return {};
 }
+/* -- Get the order to read a file in to keep reads sequential ------------ */
+static pair<size_t, uint64_t> ArchiveGetOrder(const string &strFile)
+{ // Lock archive list so it cannot be modified
+  const LockGuard lgArchivesSync{ cArchives->CollectorGetMutex() };
+  // Search archives in the same order as extract and return the archive and
+  // where the block holding the file starts in it.
+  size_t stArchive = 0;
+  for(Archives::const_reverse_iterator cArchIt{ cArchives->crbegin() };
+                                       cArchIt != cArchives->crend();
+                                     ++cArchIt, ++stArchive)
+  { const Archive &aRef = **cArchIt;
+    const StrUIntMapConstIt suimciIt{ aRef.GetFileIterator(strFile) };
+    if(aRef.IsFileIteratorValid(suimciIt))
+      return { stArchive, aRef.GetBlockPosition(suimciIt->second) };
+  } // Not in any archive so read it after everything else
+  return { StdMaxSizeT, 0 };
+}
 /* -- ArchiveGetNames ------------------------------------------------------ */
 static const string ArchiveGetNames(void)
 { // Set default archive name if no archives
@@ -14,8 +14,9 @@ using namespace IArchive::P;           using namespace IASync::P;
 using namespace ICodec::P;             using namespace ICollector::P;
 using namespace ICVarDef::P;           using namespace IDir::P;
 using namespace IError::P;             using namespace IEvtMain::P;
-using namespace IIdent::P;             using namespace IFlags;
-using namespace ILog::P;
+using namespace IClock::P;             using namespace IIdent::P;
+using namespace IFlags;                using namespace IJob::P;
+using namespace ILog::P;               using namespace ILuaUtil::P;
 using namespace IMemory::P;            using namespace IStd::P;
 using namespace IString::P;            using namespace ISysUtil::P;
 /* ------------------------------------------------------------------------- */
@@ -36,21 +37,57 @@ BUILD_FLAGS(Asset,                     // Asset loading flags
   CD_LEVEL_FASTEST         {Flag[60]}, CD_LEVEL_FAST            {Flag[61]},
   // Medium compression?               Good compression?
   CD_LEVEL_MODERATE        {Flag[62]}, CD_LEVEL_SLOW            {Flag[63]},
-  // Maximum compression (more mem)?
-  CD_LEVEL_SLOWEST         {Flag[64]},
+  // Maximum compression (more mem)?   Encode in chunks on many threads?
+  CD_LEVEL_SLOWEST         {Flag[64]}, CD_STREAM                {Flag[65]},
   /* -- All options -------------------------------------------------------- */
   CD_MASK{ CD_DECODE|CD_ENCODE_RAW|CD_ENCODE_AES|CD_ENCODE_ZLIB|CD_ENCODE_LZMA|
            CD_ENCODE_ZLIBAES|CD_ENCODE_LZMAAES|CD_LEVEL_FASTEST|CD_LEVEL_FAST|
-           CD_LEVEL_MODERATE|CD_LEVEL_SLOW|CD_LEVEL_SLOWEST }
-);/* == Asset collector class for collector and custom variables =========== */
+           CD_LEVEL_MODERATE|CD_LEVEL_SLOW|CD_LEVEL_SLOWEST|CD_STREAM }
+);/* -- File being extracted ahead of time ------------------------------- */
+struct AssetPrefetchItem               // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  FileMap          fmData;             // The extracted file
+  double           dExtract;           // Time taken to extract it
+  bool             bFailed;            // Extraction failed
+  Job              jExtract;           // Extracting (destroy first)
+  /* ----------------------------------------------------------------------- */
+  AssetPrefetchItem(void) :            // No parameters
+    /* -- Initialisers ----------------------------------------------------- */
+    dExtract(0),                       // Not extracted yet
+    bFailed(false)                     // Not failed yet
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+};/* ----------------------------------------------------------------------- */
+typedef shared_ptr<AssetPrefetchItem> AssetPrefetchItemPtr;
+typedef map<string, AssetPrefetchItemPtr> AssetPrefetchMap;
+/* == Asset collector class for collector and custom variables ============= */
 CTOR_BEGIN_ASYNC(Assets, Asset, CLHelperUnsafe,
 /* -- Asset collector variables -------------------------------------------- */
 bool               bOverride;          // Allow load of external files
 SafeSizeT          stPipeBufSize;      // Pipe buffer size for execute
+mutex              mPrefetch;          // Prefetch variables in use
+AssetPrefetchMap   apmPrefetch;        // Files being extracted ahead
+size_t             stPrefetchUsed,     // Prefetched files used
+                   stPrefetchFailed;   // Prefetched files that failed
+double             dPrefetchExtract,   // Time used files took to extract
+                   dPrefetchWait;      // Time spent waiting for them
+array<SafeUInt64, AS_MAX> aqStages;    // Time spent in each loading stage
 ); /* ---------------------------------------------------------------------- */
+/* -- Add time spent in a loading stage ------------------------------------ */
+static void AssetStageAdd(const AssetStage asStage, const uint64_t qwTime)
+  { cAssets->aqStages[asStage] += qwTime; }
+/* -- Push time spent in each loading stage -------------------------------- */
+static void AssetStageStats(lua_State*const lS)
+{ for(const SafeUInt64 &sqTime : cAssets->aqStages)
+    LuaUtilPushNum(lS, static_cast<lua_Number>(sqTime.load()) / 1e9); }
+/* -- Reset time spent in each loading stage ------------------------------- */
+static void AssetStageReset(void)
+  { for(SafeUInt64 &sqTime : cAssets->aqStages) sqTime = 0; }
 /* -- Function to load a file locally -------------------------------------- */
 static FileMap AssetLoadFromDisk(const string &strFile)
-{ // Open it and sending full-load flag and if succeeded?
+{ // Time mapping the file as reading it
+  const AssetStageScope assRead{ AS_READ };
+  // Open it and sending full-load flag and if succeeded?
   if(FileMap fmFile{ strFile })
   { // Put in the log that we loaded the file successfully
     cLog->LogDebugExSafe("Assets mapped resource '$'[$]!",
@@ -61,7 +98,7 @@ static FileMap AssetLoadFromDisk(const string &strFile)
   XCL("Failed to open local resource!", "File",  strFile, "Path", DirGetCWD());
 }
 /* -- Function to search local directory then archives for a file ---------- */
-static FileMap AssetExtract(const string &strFile)
+static FileMap AssetExtractNow(const string &strFile)
 { // Do we have the permission to load external files?
   if(cAssets->bOverride)
   { // Does the file exist on disk?
@@ -80,6 +117,40 @@ static FileMap AssetExtract(const string &strFile)
     "Count",    cArchives->CollectorCount(),
     "Archives", ArchiveGetNames());
 }
+/* -- Take a prefetched file ----------------------------------------------- */
+static FileMap AssetPrefetchTake(const string &strFile)
+{ // Remove the file from the prefetch list and return nothing if not there
+  AssetPrefetchItemPtr apipItem;
+  { const LockGuard lgPrefetch{ cAssets->mPrefetch };
+    const auto apmiIt{ cAssets->apmPrefetch.find(strFile) };
+    if(apmiIt == cAssets->apmPrefetch.end()) return {};
+    apipItem = StdMove(apmiIt->second);
+    cAssets->apmPrefetch.erase(apmiIt); }
+  // Wait for it to finish extracting. This runs it here if it didn't start.
+  const ClockChrono<> ccWait;
+  apipItem->jExtract.JobWait();
+  const double dWait = ccWait.CCDeltaToDouble();
+  // Update statistics
+  { const LockGuard lgPrefetch{ cAssets->mPrefetch };
+    if(apipItem->bFailed) ++cAssets->stPrefetchFailed;
+    else
+    { ++cAssets->stPrefetchUsed;
+      cAssets->dPrefetchExtract += apipItem->dExtract;
+      cAssets->dPrefetchWait += dWait;
+    } }
+  // Return the file if it succeeded else let the caller load it again so the
+  // caller gets the original error.
+  if(apipItem->bFailed) return {};
+  cLog->LogDebugExSafe("Assets used prefetched '$' (E:$;W:$).", strFile,
+    StrShortFromDuration(apipItem->dExtract), StrShortFromDuration(dWait));
+  return StdMove(apipItem->fmData);
+}
+/* -- Function to use prefetched file or search for it --------------------- */
+static FileMap AssetExtract(const string &strFile)
+{ // Use the file if it was prefetched else load it now
+  if(FileMap fmFile{ AssetPrefetchTake(strFile) }) return fmFile;
+  return AssetExtractNow(strFile);
+}
 /* == Asset object class =================================================== */
 CTOR_MEM_BEGIN_ASYNC_CSLAVE(Assets, Asset, ICHelperUnsafe),
   /* -- Base classes ------------------------------------------------------- */
@@ -87,7 +158,9 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Assets, Asset, ICHelperUnsafe),
   public AsyncLoaderAsset,             // For loading assets off main thread
   public Lockable,                     // Lua garbage collector instruction
   public AssetFlags                    // Asset settings
-{ /* -------------------------------------------------------------- */ private:
+{ /* -- Private variables -------------------------------------------------- */
+  AssetPrefetchMap apmBatch;           // Prefetched files to wait for
+  /* ----------------------------------------------------------------------- */
   void SwapAsset(Asset &aOther)
   { // Swap settings flags
     FlagSwap(aOther);
@@ -98,19 +171,57 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Assets, Asset, ICHelperUnsafe),
   }
   /* -- Perform decoding --------------------------------------------------- */
   template<class Codec>void CodecExec(FileMap &fmData, size_t stLevel=0)
-    { MemSwap(Block<Codec>{ fmData, stLevel }); }
-  /* -- Perform decoding converting flags to compression level ------------- */
+  { // Encode or decode the data and time it
+    const uint64_t qwStart = cmHiRes.GetTimeNS();
+    Block<Codec> bData{ fmData, stLevel };
+    const uint64_t qwTime = cmHiRes.GetTimeNS() - qwStart;
+    // Record throughput of the mode stored in the header
+    if constexpr(is_same_v<Codec, CoDecoder>)
+      CodecStatAdd(fmData.ReadIntLE<uint32_t>(ENCHDR_POS_FLAGS), true,
+        bData.MemSize(), qwTime);
+    else CodecStatAdd(bData.ReadIntLE<uint32_t>(ENCHDR_POS_FLAGS), false,
+      fmData.MemSize(), qwTime);
+    // Use the result
+    MemSwap(bData);
+  }
+  /* -- Perform encoding converting flags to compression level ------------- */
   template<class Codec>void CodecExecEx(FileMap &fmData)
-    { CodecExec<Codec>(fmData,
-        FlagIsSet(CD_LEVEL_FASTEST)  ? 1 : (FlagIsSet(CD_LEVEL_FAST) ? 3 :
-       (FlagIsSet(CD_LEVEL_MODERATE) ? 5 : (FlagIsSet(CD_LEVEL_SLOW) ? 7 :
-       (FlagIsSet(CD_LEVEL_SLOWEST)  ? 9 : 1))))); }
+  { // Convert flags to compression level
+    const size_t stLevel =
+      FlagIsSet(CD_LEVEL_FASTEST)  ? 1 : (FlagIsSet(CD_LEVEL_FAST) ? 3 :
+     (FlagIsSet(CD_LEVEL_MODERATE) ? 5 : (FlagIsSet(CD_LEVEL_SLOW) ? 7 :
+     (FlagIsSet(CD_LEVEL_SLOWEST)  ? 9 : 1))));
+    // Encode in chunks on the job pool or as one block
+    if(FlagIsSet(CD_STREAM))
+      CodecExec<CoStreamEncoder<Codec>>(fmData, stLevel);
+    else CodecExec<Codec>(fmData, stLevel);
+  }
+  /* -- Wait for a batch of prefetched files ------------------------------- */
+  void PrefetchWait(void)
+  { // Take the batch so the files are only kept by the prefetch list after
+    AssetPrefetchMap apmFiles;
+    apmFiles.swap(apmBatch);
+    // Wait for each file to finish extracting and report progress
+    size_t stDone = 0, stFailed = 0;
+    for(const auto &apmPair : apmFiles)
+    { AssetPrefetchItem &apiItem = *apmPair.second;
+      apiItem.jExtract.JobWait();
+      if(apiItem.bFailed) ++stFailed;
+      AsyncProgress(APC_PREFETCHED, static_cast<uint64_t>(++stDone),
+        static_cast<uint64_t>(apmFiles.size()));
+    } // Report the files that failed
+    if(stFailed)
+      XC("Failed to prefetch files!",
+         "Failed", stFailed, "Total", apmFiles.size());
+  }
   /* -- Load asset from memory ------------------------------------- */ public:
   void AsyncReady(FileMap &fmData)
-  { // Guest wants data put into a raw magic block (no user flags)
-    if(FlagIsSet(CD_ENCODE_RAW)) CodecExec<RAWEncoder>(fmData);
-    // Guest wants data encrypted into a magic block (no user flags)
-    else if(FlagIsSet(CD_ENCODE_AES)) CodecExec<AESEncoder>(fmData);
+  { // Waiting for a batch of prefetched files?
+    if(!apmBatch.empty()) PrefetchWait();
+    // Guest wants data put into a raw magic block (no level flags)
+    else if(FlagIsSet(CD_ENCODE_RAW)) CodecExecEx<RAWEncoder>(fmData);
+    // Guest wants data encrypted into a magic block (no level flags)
+    else if(FlagIsSet(CD_ENCODE_AES)) CodecExecEx<AESEncoder>(fmData);
     // Guest wants data deflated into a magic block
     else if(FlagIsSet(CD_ENCODE_ZLIB)) CodecExecEx<ZLIBEncoder>(fmData);
     // Guest wants data encrypted and deflated into a magic block
@@ -132,6 +243,15 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Assets, Asset, ICHelperUnsafe),
     // Dispatch the event
     AsyncInitArray(lS, strName, "assetdata", aCref);
   }
+  /* -- Wait for prefetched files asynchronously --------------------------- */
+  void InitAsyncPrefetch(lua_State*const lS, AssetPrefetchMap &apmFiles)
+  { // No flags and wait for the specified files
+    FlagReset(CD_NONE);
+    apmBatch.swap(apmFiles);
+    // Dispatch the request asynchronously
+    AsyncInitNone(lS, StrAppend("prefetch<", apmBatch.size(), '>'),
+      "prefetch");
+  }
   /* -- Load asset from file asynchronously -------------------------------- */
   void InitAsyncFile(lua_State*const lS, const string &strFile,
     const AssetFlagsConst &afcFlags)
@@ -223,7 +343,14 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Assets, Asset, ICHelperUnsafe),
   /* ----------------------------------------------------------------------- */
   DELETECOPYCTORS(Asset)               // Disable copy constructor and operator
 };/* ======================================================================= */
-CTOR_END_ASYNC_NOFUNCS(Assets, Asset, ASSET, bOverride(false));
+CTOR_END_ASYNC_NOFUNCS(Assets, Asset, ASSET, // Finish collector
+  /* -- Collector initialisers --------------------------------------------- */
+  bOverride(false),                    // Don't allow external files
+  stPrefetchUsed(0),                   // No prefetched files used
+  stPrefetchFailed(0),                 // No prefetched files failed
+  dPrefetchExtract(0),                 // No time spent extracting
+  dPrefetchWait(0)                     // No time spent waiting
+);
 /* -- Class to help enumerate files ---------------------------------------- */
 struct AssetList :
   /* -- Dependents --------------------------------------------------------- */
@@ -258,6 +385,414 @@ static CVarReturn AssetSetPipeBufferSize(const size_t stSize)
   { return CVarSimpleSetIntNLG(cAssets->stPipeBufSize, stSize, 1UL, 4096UL); }
 /* -- Set pipe buffer size ------------------------------------------------- */
 static size_t AssetGetPipeBufferSize(void) { return cAssets->stPipeBufSize; }
+/* == Prefetch manifest helpers ============================================ */
+typedef map<string, StrVector> AssetPrefetchGraph; // File and dependencies
+/* -- Add a manifest entry to the graph ------------------------------------ */
+static void AssetPrefetchAddEntry(lua_State*const lS, const int iEntry,
+  AssetPrefetchGraph &apgGraph)
+{ // Just a filename with no dependencies?
+  if(LuaUtilIsString(lS, iEntry))
+    { apgGraph.insert({ LuaUtilToCppString(lS, iEntry), {} }); return; }
+  // Else must be a table of the filename followed by its dependencies
+  LuaUtilCheckTable(lS, iEntry);
+  const lua_Integer liLen = UtilIntOrMax<lua_Integer>(
+    LuaUtilGetSize(lS, iEntry));
+  if(!liLen) XC("Manifest entry is empty!");
+  StrVector svFiles;
+  for(lua_Integer liIndex = 1; liIndex <= liLen; ++liIndex)
+  { LuaUtilGetRefEx(lS, iEntry, liIndex);
+    if(!LuaUtilIsString(lS, -1))
+      XC("Manifest entry item is not a string!", "Index", liIndex);
+    svFiles.emplace_back(LuaUtilToCppString(lS, -1));
+    LuaUtilRmStack(lS);
+  } // Add the dependencies as files too
+  for(StrVectorConstIt svciIt{ next(svFiles.cbegin()) };
+                       svciIt != svFiles.cend();
+                     ++svciIt)
+    apgGraph.insert({ *svciIt, {} });
+  // Add the dependencies to the file
+  StrVector &svDeps = apgGraph[svFiles.front()];
+  svDeps.insert(svDeps.end(), next(svFiles.cbegin()), svFiles.cend());
+}
+/* -- Get how many files must be loaded before this one -------------------- */
+typedef map<string, size_t> AssetPrefetchDepths; // File and load order
+static size_t AssetPrefetchDepth(const AssetPrefetchGraph &apgGraph,
+  const string &strFile, AssetPrefetchDepths &apdDepths)
+{ // Return the depth if we already know it. Zero means we are still working
+  // it out so the file must depend on itself.
+  const auto apdiPair{ apdDepths.insert({ strFile, 0 }) };
+  const auto apdiIt{ apdiPair.first };
+  if(!apdiPair.second)
+  { if(!apdiIt->second)
+      XC("Manifest has a circular dependency!", "File", strFile);
+    return apdiIt->second;
+  } // Load it after its deepest dependency
+  size_t stDepth = 1;
+  for(const string &strDep : apgGraph.at(strFile))
+    stDepth = UtilMaximum(stDepth,
+      AssetPrefetchDepth(apgGraph, strDep, apdDepths) + 1);
+  return apdiIt->second = stDepth;
+}
+/* -- Start extracting the files in a manifest ----------------------------- */
+static size_t AssetPrefetch(lua_State*const lS, const int iTable,
+  AssetPrefetchMap &apmBatch)
+{ // Build the graph of files and their dependencies from the table
+  LuaUtilCheckTable(lS, iTable);
+  AssetPrefetchGraph apgGraph;
+  const lua_Integer liLen = UtilIntOrMax<lua_Integer>(
+    LuaUtilGetSize(lS, iTable));
+  for(lua_Integer liIndex = 1; liIndex <= liLen; ++liIndex)
+  { LuaUtilGetRefEx(lS, iTable, liIndex);
+    AssetPrefetchAddEntry(lS, LuaUtilStackSize(lS), apgGraph);
+    LuaUtilRmStack(lS);
+  } // A new graph starts a new scene so time its stages from zero
+  AssetStageReset();
+  // Dependencies first, then in the order they are stored in the archives
+  // so reads are sequential, then by name.
+  typedef pair<size_t, uint64_t> ArchiveOrder;
+  struct Order { size_t stDepth; ArchiveOrder aoArchive; string strFile; };
+  vector<Order> oList;
+  oList.reserve(apgGraph.size());
+  AssetPrefetchDepths apdDepths;
+  for(const auto &apgPair : apgGraph)
+    oList.push_back({ AssetPrefetchDepth(apgGraph, apgPair.first,
+      apdDepths), ArchiveGetOrder(apgPair.first), apgPair.first });
+  StdSort(seq, oList.begin(), oList.end(),
+    [](const Order &oA, const Order &oB)
+      { if(oA.stDepth != oB.stDepth) return oA.stDepth < oB.stDepth;
+        if(oA.aoArchive != oB.aoArchive) return oA.aoArchive < oB.aoArchive;
+        return oA.strFile < oB.strFile; });
+  // Queue the files that aren't already being prefetched
+  size_t stQueued = 0;
+  const LockGuard lgPrefetch{ cAssets->mPrefetch };
+  for(const Order &oItem : oList)
+  { // Just add it to the batch if already prefetching
+    const auto apmiIt{ cAssets->apmPrefetch.find(oItem.strFile) };
+    if(apmiIt != cAssets->apmPrefetch.end())
+      { apmBatch.insert(*apmiIt); continue; }
+    // Add it to the list and the batch and start extracting it
+    const AssetPrefetchItemPtr apipItem{ new AssetPrefetchItem };
+    cAssets->apmPrefetch.insert({ oItem.strFile, apipItem });
+    apmBatch.insert({ oItem.strFile, apipItem });
+    AssetPrefetchItem &apiItem = *apipItem;
+    apiItem.jExtract.JobStart(StrAppend("prefetch:", oItem.strFile),
+      [&apiItem, strFile = oItem.strFile]
+      { // Extract the file and time it
+        const ClockChrono<> ccExtract;
+        try { apiItem.fmData = AssetExtractNow(strFile); }
+        catch(const exception &eReason)
+        { apiItem.bFailed = true;
+          cLog->LogWarningExSafe("Assets failed to prefetch '$': $",
+            strFile, eReason.what()); }
+        apiItem.dExtract = ccExtract.CCDeltaToDouble();
+      }, JP_BACKGROUND);
+    ++stQueued;
+  } // Log and return number of files queued
+  cLog->LogDebugExSafe("Assets queued $ of $ files to prefetch.",
+    stQueued, oList.size());
+  return stQueued;
+}
+/* -- Start extracting the files in a manifest without waiting ------------- */
+static size_t AssetPrefetch(lua_State*const lS, const int iTable)
+  { AssetPrefetchMap apmBatch; return AssetPrefetch(lS, iTable, apmBatch); }
+/* -- Throw away prefetched files that were not used ----------------------- */
+static size_t AssetPrefetchClear(void)
+{ // Take the list and stop the extraction without holding the lock
+  AssetPrefetchMap apmList;
+  { const LockGuard lgPrefetch{ cAssets->mPrefetch };
+    apmList.swap(cAssets->apmPrefetch); }
+  return apmList.size();
+}
+/* -- Push prefetch statistics --------------------------------------------- */
+static void AssetPrefetchStats(lua_State*const lS)
+{ const LockGuard lgPrefetch{ cAssets->mPrefetch };
+  LuaUtilPushVar(lS, cAssets->apmPrefetch.size(), cAssets->stPrefetchUsed,
+    cAssets->stPrefetchFailed, cAssets->dPrefetchExtract,
+    cAssets->dPrefetchWait);
+}
+/* == Bulk typed access helpers ============================================ */
+enum AssetBulkType : unsigned int      // Element types in a format string
+{ /* ----------------------------------------------------------------------- */
+  ABT_I8,  ABT_U8,  ABT_I16, ABT_U16,  // 8-bit and 16-bit integers
+  ABT_I32, ABT_U32, ABT_I64, ABT_U64,  // 32-bit and 64-bit integers
+  ABT_F32, ABT_F64, ABT_PAD            // Floats and one byte of padding
+};/* -- One element of a record -------------------------------------------- */
+struct AssetBulkItem                   // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  AssetBulkType    abtType;            // Type of element
+  bool             bSwap;              // Swap byte order on access
+};/* -- Parsed format string ----------------------------------------------- */
+typedef vector<AssetBulkItem> AssetBulkItems;
+struct AssetBulkFormat                 // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  AssetBulkItems   abiItems;           // Elements in one record
+  size_t           stBytes;            // Bytes in one record
+  size_t           stValues;           // Lua values in one record
+};/* -- Parse a struct style format string --------------------------------- */
+static AssetBulkFormat AssetBulkParse(const string &strFormat)
+{ // Byte order characters are '<' little, '>' big and '=' native. Each type
+  // character may be prefixed by a decimal repeat count and spaces are
+  // ignored. i.e. "<2f H 4x" is two floats, a word and four bytes of padding.
+  // The total number of items after expanding repeat counts is limited too
+  // so a short format cannot allocate without limit.
+  constexpr const size_t stMaximum = 65536;
+  AssetBulkFormat abfOut{ {}, 0, 0 };
+  bool bSwap = false;
+  size_t stRepeat = 0;
+  for(const char cChar : strFormat)
+  { // Compare character
+    AssetBulkType abtType;
+    size_t stSize;
+    switch(cChar)
+    { // Byte order
+#if defined(LITTLEENDIAN)
+      case '<': case '=': bSwap = false; continue;
+      case '>': bSwap = true; continue;
+#elif defined(BIGENDIAN)
+      case '<': bSwap = true; continue;
+      case '>': case '=': bSwap = false; continue;
+#endif
+      // Repeat count
+      case '0': case '1': case '2': case '3': case '4':
+      case '5': case '6': case '7': case '8': case '9':
+        stRepeat = stRepeat * 10 + static_cast<size_t>(cChar - '0');
+        if(stRepeat > stMaximum)
+          XC("Format repeat count too large!", "Format", strFormat);
+        continue;
+      // Ignore spaces
+      case ' ': continue;
+      // Types
+      case 'b': abtType = ABT_I8;  stSize = 1; break;
+      case 'B': abtType = ABT_U8;  stSize = 1; break;
+      case 'h': abtType = ABT_I16; stSize = 2; break;
+      case 'H': abtType = ABT_U16; stSize = 2; break;
+      case 'i': abtType = ABT_I32; stSize = 4; break;
+      case 'I': abtType = ABT_U32; stSize = 4; break;
+      case 'l': abtType = ABT_I64; stSize = 8; break;
+      case 'L': abtType = ABT_U64; stSize = 8; break;
+      case 'f': abtType = ABT_F32; stSize = 4; break;
+      case 'd': abtType = ABT_F64; stSize = 8; break;
+      case 'x': abtType = ABT_PAD; stSize = 1; break;
+      // Anything else is an error
+      default: XC("Invalid format character!",
+                  "Format", strFormat, "Character", cChar);
+    } // Add the element as many times as requested
+    if(!stRepeat) stRepeat = 1;
+    if(stRepeat > stMaximum - abfOut.abiItems.size())
+      XC("Format has too many items!",
+        "Format", strFormat, "Maximum", stMaximum);
+    abfOut.abiItems.insert(abfOut.abiItems.cend(), stRepeat,
+      { abtType, bSwap });
+    abfOut.stBytes += stSize * stRepeat;
+    if(abtType != ABT_PAD) abfOut.stValues += stRepeat;
+    stRepeat = 0;
+  } // Must not have a dangling repeat count and must have at least one value
+  if(stRepeat) XC("Format repeat count has no type!", "Format", strFormat);
+  if(!abfOut.stValues) XC("Format has no values!", "Format", strFormat);
+  // Return parsed format
+  return abfOut;
+}
+/* -- Call back with a typed zero and the byte swap flag ------------------- */
+template<bool bSwap, class Callback>
+  static void AssetBulkDispatchType(const AssetBulkType abtType,
+    Callback &&cbFunc)
+{ // Compare type
+  switch(abtType)
+  { case ABT_I8:  cbFunc(int8_t{},   bool_constant<bSwap>{}); break;
+    case ABT_U8:  cbFunc(uint8_t{},  bool_constant<bSwap>{}); break;
+    case ABT_I16: cbFunc(int16_t{},  bool_constant<bSwap>{}); break;
+    case ABT_U16: cbFunc(uint16_t{}, bool_constant<bSwap>{}); break;
+    case ABT_I32: cbFunc(int32_t{},  bool_constant<bSwap>{}); break;
+    case ABT_U32: cbFunc(uint32_t{}, bool_constant<bSwap>{}); break;
+    case ABT_I64: cbFunc(int64_t{},  bool_constant<bSwap>{}); break;
+    case ABT_U64: cbFunc(uint64_t{}, bool_constant<bSwap>{}); break;
+    case ABT_F32: cbFunc(float{},    bool_constant<bSwap>{}); break;
+    case ABT_F64: cbFunc(double{},   bool_constant<bSwap>{}); break;
+    default: break;
+  }
+}
+/* -- Dispatch a element to a typed callback ------------------------------- */
+template<class Callback>
+  static void AssetBulkDispatch(const AssetBulkItem &abiItem,
+    Callback &&cbFunc)
+{ // Instantiate the swapped or unswapped version
+  if(abiItem.bSwap) AssetBulkDispatchType<true>(abiItem.abtType, cbFunc);
+  else AssetBulkDispatchType<false>(abiItem.abtType, cbFunc);
+}
+/* -- Get the only value element of a format ------------------------------- */
+static const AssetBulkItem &AssetBulkSingle(const string &strFormat,
+  const AssetBulkFormat &abfFormat)
+{ // Element wise operations only take one type
+  if(abfFormat.stValues != 1 || abfFormat.abiItems.size() != 1)
+    XC("Format must be exactly one type!", "Format", strFormat);
+  return abfFormat.abiItems.front();
+}
+/* -- Push an integer element ---------------------------------------------- */
+template<typename Type>
+  static void AssetBulkPushInt(lua_State*const lS, const Type tV)
+{ // Unsigned qwords that do not fit in a lua integer are pushed as numbers
+  // so they are not shown as negative. These may lose precision.
+  if constexpr(is_same_v<Type, uint64_t>)
+    if(tV > static_cast<uint64_t>(LUA_MAXINTEGER))
+      return LuaUtilPushNum(lS, static_cast<lua_Number>(tV));
+  // Anything else fits in a lua integer
+  LuaUtilPushInt(lS, static_cast<lua_Integer>(tV));
+}
+/* -- Unpack records into a new flat table on the stack -------------------- */
+static void AssetBulkUnpack(lua_State*const lS, const MemConst &mcSrc,
+  const string &strFormat, const size_t stPos, const size_t stCount)
+{ // Parse format and check the whole range fits
+  const AssetBulkFormat abfFormat{ AssetBulkParse(strFormat) };
+  mcSrc.MemCheckRange(stPos, stCount, abfFormat.stBytes);
+  // Check the table would fit. Values can't exceed the bytes so no overflow.
+  const size_t stValues = stCount * abfFormat.stValues;
+  if(UtilIntWillOverflow<int>(stValues))
+    XC("Too many values to unpack!", "Values", stValues);
+  // Create the table and nothing to do if no records
+  LuaUtilPushTable(lS, stValues);
+  if(!stCount) return;
+  const char*const cpBase =
+    mcSrc.MemRead(stPos, stCount * abfFormat.stBytes);
+  // Walk one element at a time so each inner loop only has one type
+  size_t stOffset = 0;
+  lua_Integer liIndex = 1;
+  for(const AssetBulkItem &abiItem : abfFormat.abiItems)
+  { // Ignore padding
+    if(abiItem.abtType == ABT_PAD) { ++stOffset; continue; }
+    // Read every record for this element
+    AssetBulkDispatch(abiItem, [&](auto tType, auto bcSwap)
+    { // Get type info
+      typedef decltype(tType) Type;
+      const char *cpSrc = cpBase + stOffset;
+      lua_Integer liSlot = liIndex;
+      for(size_t stIndex = 0; stIndex < stCount; ++stIndex,
+        cpSrc += abfFormat.stBytes,
+        liSlot += static_cast<lua_Integer>(abfFormat.stValues))
+      { // Push value and store it in the table
+        const Type tV = UtilReadElement<Type, bcSwap.value>(cpSrc);
+        if constexpr(is_floating_point_v<Type>) LuaUtilPushNum(lS, tV);
+        else AssetBulkPushInt(lS, tV);
+        lua_rawseti(lS, -2, liSlot);
+      } // Next element
+      stOffset += sizeof(Type);
+    });
+    ++liIndex;
+  }
+}
+/* -- Pack values from a flat table into records --------------------------- */
+static size_t AssetBulkPack(lua_State*const lS, MemBase &mbDst,
+  const string &strFormat, const size_t stPos, const int iTable)
+{ // Parse format and check the table has whole records
+  const AssetBulkFormat abfFormat{ AssetBulkParse(strFormat) };
+  const size_t stValues = static_cast<size_t>(LuaUtilGetSize(lS, iTable));
+  if(stValues % abfFormat.stValues)
+    XC("Table is not a whole number of records!",
+       "Values", stValues, "PerRecord", abfFormat.stValues);
+  // Check the whole range fits and nothing to do if no records
+  const size_t stCount = stValues / abfFormat.stValues;
+  mbDst.MemCheckRange(stPos, stCount, abfFormat.stBytes);
+  if(!stCount) return 0;
+  const size_t stBytes = stCount * abfFormat.stBytes;
+  char*const cpBase = mbDst.MemRead(stPos, stBytes);
+  // Walk one element at a time so each inner loop only has one type
+  size_t stOffset = 0;
+  lua_Integer liIndex = 1;
+  for(const AssetBulkItem &abiItem : abfFormat.abiItems)
+  { // Zero padding
+    if(abiItem.abtType == ABT_PAD)
+    { for(size_t stIndex = 0; stIndex < stCount; ++stIndex)
+        cpBase[stIndex * abfFormat.stBytes + stOffset] = '\0';
+      ++stOffset;
+      continue;
+    } // Write every record for this element
+    AssetBulkDispatch(abiItem, [&](auto tType, auto bcSwap)
+    { // Get type info
+      typedef decltype(tType) Type;
+      char *cpDst = cpBase + stOffset;
+      lua_Integer liSlot = liIndex;
+      for(size_t stIndex = 0; stIndex < stCount; ++stIndex,
+        cpDst += abfFormat.stBytes,
+        liSlot += static_cast<lua_Integer>(abfFormat.stValues))
+      { // Get value and make sure it is a number
+        LuaUtilGetRefEx(lS, iTable, liSlot);
+        if(!LuaUtilIsNumber(lS, -1))
+          XC("Table value is not a number!", "Index", liSlot);
+        // Convert and write the value
+        if constexpr(is_floating_point_v<Type>)
+          UtilWriteElement<Type, bcSwap.value>(cpDst,
+            static_cast<Type>(lua_tonumber(lS, -1)));
+        else UtilWriteElement<Type, bcSwap.value>(cpDst,
+          LuaUtilIsInteger(lS, -1) ?
+            static_cast<Type>(lua_tointeger(lS, -1)) :
+            static_cast<Type>(lua_tonumber(lS, -1)));
+        LuaUtilRmStack(lS);
+      } // Next element
+      stOffset += sizeof(Type);
+    });
+    ++liIndex;
+  } // Return bytes written
+  return stBytes;
+}
+/* -- Add the value on the stack to every element in a range --------------- */
+static void AssetBulkAdd(lua_State*const lS, MemBase &mbDst,
+  const string &strFormat, const size_t stPos, const size_t stCount,
+  const int iValue)
+{ // Parse format and add to the elements
+  const AssetBulkFormat abfFormat{ AssetBulkParse(strFormat) };
+  AssetBulkDispatch(AssetBulkSingle(strFormat, abfFormat),
+    [&](auto tType, auto bcSwap)
+  { typedef decltype(tType) Type;
+    if constexpr(is_floating_point_v<Type>)
+      mbDst.MemAddEx<Type, bcSwap.value>(stPos, stCount,
+        LuaUtilGetNum<Type>(lS, iValue));
+    else mbDst.MemAddEx<Type, bcSwap.value>(stPos, stCount,
+      static_cast<Type>(LuaUtilGetInt<lua_Integer>(lS, iValue))); });
+}
+/* -- Multiply every element in a range ------------------------------------ */
+static void AssetBulkScale(MemBase &mbDst, const string &strFormat,
+  const size_t stPos, const size_t stCount, const double dScale)
+{ // Parse format and scale the elements
+  const AssetBulkFormat abfFormat{ AssetBulkParse(strFormat) };
+  AssetBulkDispatch(AssetBulkSingle(strFormat, abfFormat),
+    [&](auto tType, auto bcSwap)
+  { mbDst.MemScaleEx<decltype(tType), bcSwap.value>(stPos, stCount,
+      dScale); });
+}
+/* -- Push the lowest, highest or sum of elements in a range --------------- */
+enum AssetBulkOp { ABO_MIN, ABO_MAX, ABO_SUM };
+static void AssetBulkReduce(lua_State*const lS, const MemConst &mcSrc,
+  const string &strFormat, const size_t stPos, const size_t stCount,
+  const AssetBulkOp aboOp)
+{ // Parse format and reduce the elements
+  const AssetBulkFormat abfFormat{ AssetBulkParse(strFormat) };
+  AssetBulkDispatch(AssetBulkSingle(strFormat, abfFormat),
+    [&](auto tType, auto bcSwap)
+  { // Get type info and the result
+    typedef decltype(tType) Type;
+    constexpr bool bSwap = bcSwap.value;
+    // Integer sums wrap around so signed types keep their sign
+    typedef conditional_t<is_signed_v<Type>, int64_t, uint64_t> SumType;
+    if constexpr(is_floating_point_v<Type>) switch(aboOp)
+    { case ABO_MIN:
+        LuaUtilPushNum(lS, mcSrc.MemMinEx<Type, bSwap>(stPos, stCount));
+        break;
+      case ABO_MAX:
+        LuaUtilPushNum(lS, mcSrc.MemMaxEx<Type, bSwap>(stPos, stCount));
+        break;
+      default:
+        LuaUtilPushNum(lS, mcSrc.MemSumEx<Type, bSwap>(stPos, stCount));
+        break;
+    } // Integers are pushed as lua integers where they fit
+    else switch(aboOp)
+    { case ABO_MIN: AssetBulkPushInt(lS,
+        mcSrc.MemMinEx<Type, bSwap>(stPos, stCount)); break;
+      case ABO_MAX: AssetBulkPushInt(lS,
+        mcSrc.MemMaxEx<Type, bSwap>(stPos, stCount)); break;
+      default: AssetBulkPushInt(lS, static_cast<SumType>(
+        mcSrc.MemSumEx<Type, bSwap>(stPos, stCount))); break;
+    }
+  });
+}
 /* ------------------------------------------------------------------------- */
 }                                      // End of public module namespace
 /* ------------------------------------------------------------------------- */
@@ -20,14 +20,39 @@
 /* -- Prototypes ----------------------------------------------------------- */
 namespace IAsset {                     // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
-using namespace IFileMap::P;
+using namespace IClock::P;             using namespace IFileMap::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
-/* -- Prototypes ----------------------------------------------------------- */
+/* -- Stages of loading an asset that are timed ---------------------------- */
+enum AssetStage : size_t               // Stage being timed
+{ /* ----------------------------------------------------------------------- */
+  AS_READ,                             // Reading from disk or archives
+  AS_DECOMPRESS,                       // Decompressing from archives
+  AS_DECODE,                           // Decoding into an object
+  AS_UPLOAD,                           // Uploading to the graphics card
+  /* ----------------------------------------------------------------------- */
+  AS_MAX                               // Maximum number of stages
+};/* -- Prototypes --------------------------------------------------------- */
 static FileMap AssetExtract(const string&);      // Extract files from archives
 static FileMap AssetLoadFromDisk(const string&); // Load file from disk
 static size_t AssetGetPipeBufferSize(void);      // Get pipe buffer size
-/* ------------------------------------------------------------------------- */
+static void AssetStageAdd(const AssetStage, const uint64_t); // Add stage time
+/* -- Time a loading stage until the end of the scope ---------------------- */
+class AssetStageScope                  // Members initially private
+{ /* -- Private variables -------------------------------------------------- */
+  const AssetStage asStage;            // Stage being timed
+  const ClockChrono<> ccStart;         // Time the stage started
+  /* -- Constructor ------------------------------------------------ */ public:
+  explicit AssetStageScope(const AssetStage asNStage) :
+    /* -- Initialisers ----------------------------------------------------- */
+    asStage(asNStage)                  // Set stage
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+  /* -- Destructor --------------------------------------------------------- */
+  ~AssetStageScope(void) { AssetStageAdd(asStage, ccStart.CCDeltaNS()); }
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(AssetStageScope)     // No copy constructor
+};/* ----------------------------------------------------------------------- */
 }                                      // End of public namespace
 /* ------------------------------------------------------------------------- */
 }                                      // End of private namespace
@@ -37,11 +62,11 @@ namespace IASync {                     // Start of private module namespace
 using namespace IAsset::P;             using namespace IClock::P;
 using namespace ICollector::P;         using namespace IError::P;
 using namespace IEvtMain::P;           using namespace IFileMap::P;
-using namespace IIdent::P;             using namespace ILog::P;
-using namespace ILuaEvt::P;            using namespace ILuaUtil::P;
-using namespace IMemory::P;            using namespace IStd::P;
-using namespace IString::P;            using namespace ISystem::P;
-using namespace ISysUtil::P;           using namespace IThread::P;
+using namespace IIdent::P;             using namespace IJob::P;
+using namespace ILog::P;               using namespace ILuaEvt::P;
+using namespace ILuaUtil::P;           using namespace IMemory::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISystem::P;            using namespace ISysUtil::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* ------------------------------------------------------------------------- */
@@ -50,6 +75,7 @@ enum ASyncProgressCommand : unsigned int // For lua callback events
   APC_EXECSTART,                       // Exec started (2=Pid)
   APC_EXECDATAWRITE,                   // Exec writing data (2=Pos,3=Total)
   APC_FILESTART,                       // File opened (2=Siz,3=MTime,4=CTime)
+  APC_PREFETCHED,                      // File prefetched (2=Count,3=Total)
 };/* ----------------------------------------------------------------------- */
 template<class MemberType, class ColType>class AsyncLoader :
   /* -- Base classes ------------------------------------------------------- */
@@ -87,7 +113,7 @@ template<class MemberType, class ColType>class AsyncLoader :
   /* -- Private variables -------------------------------------------------- */
   Ident           &idName;             // Reference to name of object
   LuaEvtCallback   lecAsync;           // Async state and references
-  Thread           tAsyncThread;       // Asynchronous loading
+  Job              jAsync;             // Asynchronous loading
   string           strAsyncError;      // The last error exception
   ASyncCmdType     asctAsyncType;      // Async load init type
   SafeUInt         uiAsyncPid;         // Pid of executing process
@@ -103,13 +129,13 @@ template<class MemberType, class ColType>class AsyncLoader :
   void AsyncCompletion(void)
   { // Dispatch the result of the asynchronous event. Send a cancel instead if
     // the thread wants to terminate.
-    AsyncCompletionDispatch(tAsyncThread.ThreadShouldExit() ?
+    AsyncCompletionDispatch(jAsync.JobShouldExit() ?
       AR_ABORT : AR_SUCCESS);
   }
   /* -- Send completion ---------------------------------------------------- */
   void AsyncCompletionWithParam(const int64_t qwParam)
   { // If thread was asked to abort? Dispatch the asynchronous event and return
-    if(tAsyncThread.ThreadShouldExit())
+    if(jAsync.JobShouldExit())
       return AsyncCompletionDispatch(AR_ABORT);
     // Dispatch the asynchronous event with parameter. Unforunately we have to
     // cast any value we get into int64 because we read as int64 at the event
@@ -118,13 +144,6 @@ template<class MemberType, class ColType>class AsyncLoader :
     lecAsync.LuaEvtsDispatch(emcAsyncCmd,
       reinterpret_cast<void*>(&mtAsyncOwner), AR_SUCCESS_PARAM, qwParam);
   }
-  /* -- Send progress event ------------------------------------------------ */
-  template<typename ...VarArgs>
-    void AsyncProgress(const ASyncProgressCommand apcCmd,
-      const VarArgs &...vaVars)
-  { lecAsync.LuaEvtsDispatch(emcAsyncCmd,
-      reinterpret_cast<void*>(&mtAsyncOwner), AR_LOADING,
-      static_cast<uint64_t>(apcCmd), vaVars...); }
   /* -- Write to pipe assistant -------------------------------------------- */
   void AsyncWriteToPipe(SysBase::SysPipe &spProcess, size_t &stPosition,
     const size_t stBuffer)
@@ -156,7 +175,14 @@ template<class MemberType, class ColType>class AsyncLoader :
     // Also the member controls the 'Ident' class so it's up to them to manage
     // it.
   }
-  /* -- Init from file synchronously ---------------------------- */ protected:
+  /* -- Send progress event ------------------------------------- */ protected:
+  template<typename ...VarArgs>
+    void AsyncProgress(const ASyncProgressCommand apcCmd,
+      const VarArgs &...vaVars)
+  { lecAsync.LuaEvtsDispatch(emcAsyncCmd,
+      reinterpret_cast<void*>(&mtAsyncOwner), AR_LOADING,
+      static_cast<uint64_t>(apcCmd), vaVars...); }
+  /* -- Init from file synchronously --------------------------------------- */
   void SyncInitFile(const string &strFilename)
   { // Set filename
     idName.IdentSet(strFilename);
@@ -166,8 +192,7 @@ template<class MemberType, class ColType>class AsyncLoader :
     SyncLoadDataAndRegister(fmData);
   }
   /* -- Get thread --------------------------------------------------------- */
-  bool AsyncThreadIsCurrent(void) const
-    { return tAsyncThread.ThreadIsCurrent(); }
+  bool AsyncThreadIsCurrent(void) { return jAsync.JobIsCurrent(); }
   /* -- Execute function (returns exit code) ----------------------- */ public:
   int64_t AsyncExecute(void)
   { // Duration of execution
@@ -191,7 +216,7 @@ template<class MemberType, class ColType>class AsyncLoader :
       // If we are writing more than one page? Copy full pages of buffers
       // until we are left with remainders.
       if(stExtra > stBuffer)
-        while(stPosition < stEnd && tAsyncThread.ThreadShouldNotExit())
+        while(stPosition < stEnd && jAsync.JobShouldNotExit())
           AsyncWriteToPipe(spProcess, stPosition, stBuffer);
       // If theres remainder to write then write that too.
       if(stExtra) AsyncWriteToPipe(spProcess, stPosition, stExtra);
@@ -207,7 +232,7 @@ template<class MemberType, class ColType>class AsyncLoader :
     MemoryList mlBlocks;
     size_t stTotalRead = 0;
     // Until the thread says we should exit
-    while(tAsyncThread.ThreadShouldNotExit())
+    while(jAsync.JobShouldNotExit())
     { // Read process output and break out of loop if nothing read
       Memory mBuffer{ spProcess.ReadBlock() };
       if(mBuffer.MemIsEmpty()) break;
@@ -252,6 +277,7 @@ template<class MemberType, class ColType>class AsyncLoader :
       static_cast<uint64_t>(fmData.FileMapModifiedTime()),
       static_cast<uint64_t>(fmData.FileMapCreationTime()));
     // Move our memory block into a file map and send it to loader
+    const AssetStageScope assDecode{ AS_DECODE };
     mtAsyncOwner.AsyncReady(fmData);
   }
   /* -- Move the stored memory block into a new filemap and parse it ------- */
@@ -263,7 +289,7 @@ template<class MemberType, class ColType>class AsyncLoader :
     { FileMap fmData{ AssetExtract(idName.IdentGet()) };
       AsyncParseFileMap(fmData); }
   /* -- Async off-main thread function ------------------------------------- */
-  int AsyncThreadMain(Thread&)
+  void AsyncJobMain(void)
   { // Capture exceptions. Remember that after these operations the memory at
     // mAsyncLoadData should be de-initialised. So don't use it again.
     try
@@ -296,8 +322,7 @@ template<class MemberType, class ColType>class AsyncLoader :
           AsyncCompletion();
           break;
         }
-      } // Return success to thread manager
-      return 1;
+      }
     } // exception occured?
     catch(const exception &E)
     { // Prepend the reason incase there are nested exceptions
@@ -306,8 +331,6 @@ template<class MemberType, class ColType>class AsyncLoader :
       AsyncCompletionDispatch(AR_ERROR);
       // Report error in log
       cLog->LogErrorExSafe("(ASYNCLOADER THREAD EXCEPTION) $", strAsyncError);
-      // Return failure to thread manager
-      return -1;
     }
   }
   /* ----------------------------------------------------------------------- */
@@ -320,17 +343,17 @@ template<class MemberType, class ColType>class AsyncLoader :
     // Save the current stack because if an error occurs asynchronously, the
     // event subsystem executes the callback and will be empty.
     strAsyncError = StdMove(LuaUtilStack(lsS));
-    // Begin async thread
-    tAsyncThread.ThreadInit(StrAppend(strL, ':', strName),
-      bind(&AsyncLoader<MemberType,ColType>::AsyncThreadMain,
-        this, _1), this);
+    // Queue the load in the job pool
+    jAsync.JobStart(StrAppend(strL, ':', strName),
+      bind(&AsyncLoader<MemberType,ColType>::AsyncJobMain, this),
+      JP_STREAM);
   }
   /* ----------------------------------------------------------------------- */
   void AsyncStop(void)
   { // If a pid is set then we need to kill it
     if(uiAsyncPid) { cSystem->TerminatePid(uiAsyncPid); uiAsyncPid = 0; }
-    // Wait for thread to terminate
-    tAsyncThread.ThreadDeInit();
+    // Wait for the job to finish or remove it if it hasn't started yet
+    jAsync.JobStop();
   }
   /* -- Async do protected dispatch (assumes params already on lua stack) -- */
   void AsyncDoLuaThrowErrorHandler(const EvtMainEvent &emeEvent)
@@ -390,7 +413,7 @@ template<class MemberType, class ColType>class AsyncLoader :
     AsyncDoLuaProtectedDispatch(emeEvent, iParam, iHandler);
   }
   /* --------------------------------------------------------------- */ public:
-  void AsyncWait(void) { tAsyncThread.ThreadWait(); }
+  void AsyncWait(void) { jAsync.JobWait(); }
   /* ----------------------------------------------------------------------- */
   void AsyncCancel(void)
   { // Wait for the thread to stop
@@ -437,7 +460,8 @@ template<class MemberType, class ColType>class AsyncLoader :
   /* -- Send load data update and register in collector -------------------- */
   void SyncLoadDataAndRegister(FileMap &fmData)
   { // Send file map to derived class
-    mtAsyncOwner.AsyncReady(fmData);
+    { const AssetStageScope assDecode{ AS_DECODE };
+      mtAsyncOwner.AsyncReady(fmData); }
     // Load succeeded so register the block.
     static_cast<ColType&>(mtAsyncOwner).CollectorRegister();
   }
@@ -591,7 +615,6 @@ template<class MemberType, class ColType>class AsyncLoader :
     idName(idNName),                   // Initialise reference to identifier
     lecAsync{ mtNAsyncOwner,           // Initialise Lua event class...
               emcNAsyncCmd },          // ...with owner class and event cmd.
-    tAsyncThread{ STP_LOW },           // Initialise low priority thread
     asctAsyncType(BA_NONE),            // Initialise load source type
     uiAsyncPid(0)                      // Initialise pid for BA_EXECUTE
     /* --------------------------------------------------------------------- */
@@ -603,7 +626,7 @@ template<class MemberType, class ColType>class AsyncLoader :
   // memory leaks.
   ~AsyncLoader(void)
   { // Ignore if thread isn't running
-    if(tAsyncThread.ThreadIsNotRunning()) return;
+    if(jAsync.JobIsNotRunning()) return;
     // Print a warning to say that we should not be allowing this destructor
     // the clean up the thread
     cLog->LogWarningExSafe("AsyncLoader waiting for '$' to unload in its own "
@@ -0,0 +1,152 @@
+/* == BENCH.HPP ============================================================ **
+** ######################################################################### **
+** ## MS-ENGINE              Copyright (c) MS-Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## This module records the time taken by every tick of a benchmark run ## **
+** ## in bot mode and writes the results to a JSON report so they can be  ## **
+** ## compared between builds by automated tools.                         ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace IBench {                     // Start of private namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IClock::P;             using namespace IError::P;
+using namespace IFStream::P;           using namespace IJob::P;
+using namespace ILog::P;               using namespace ILua::P;
+using namespace ILuaUtil::P;           using namespace IProfile::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISystem::P;            using namespace ITimer::P;
+using namespace IUtil::P;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public namespace
+/* == Bench class ========================================================== */
+class Bench final                      // Members initially private
+{ /* -- Private variables -------------------------------------------------- */
+  vector<uint64_t> vqTimes;            // Time taken by each tick in ns
+  uint64_t         qwStart,            // Time benchmark started in ns
+                   qwAllocs;           // Lua allocations when started
+  size_t           stJobs;             // Jobs executed when started
+  bool             bDone;              // Report was written
+  /* -- Get a percentile from the sorted tick times ------------------------ */
+  static double BenchPercentile(const vector<uint64_t> &vqSorted,
+    const size_t stPercent)
+  { // Nearest rank so the result is always a time that was measured
+    const size_t stRank = (vqSorted.size() * stPercent + 99) / 100;
+    return static_cast<double>(vqSorted[UtilMaximum(stRank, 1) - 1]) / 1e9;
+  }
+  /* -- Write the report --------------------------------------------------- */
+  void BenchReport(const string &strFile)
+  { // Never write it again
+    bDone = true;
+    // Ticks that were meant to run
+    const size_t stTicks = static_cast<size_t>(cTimer->TimerGetBenchmark());
+    // Total time taken in real time
+    const double dElapsed = vqTimes.empty() ? 0.0 :
+      static_cast<double>(cmHiRes.GetTimeNS() - qwStart) / 1e9;
+    // Sort a copy of the tick times for the percentiles
+    vector<uint64_t> vqSorted{ vqTimes };
+    StdSort(par_unseq, vqSorted.begin(), vqSorted.end());
+    uint64_t qwTotal = 0;
+    for(const uint64_t qwTime : vqSorted) qwTotal += qwTime;
+    // Make sure process memory usage is current
+    cSystem->UpdateMemoryUsageData();
+    // Counters are only taken from when the first tick ran
+    const bool bStarted = !vqSorted.empty();
+    // Write the report to memory first
+    ostringstream osReport;
+    osReport << fixed << setprecision(9)
+      << "{\"ticks\":" << vqSorted.size()
+      << ",\"completed\":"
+      << (vqSorted.size() >= stTicks ? "true" : "false")
+      << ",\"tickrate\":" << cTimer->TimerGetLimit()
+      << ",\"elapsed\":" << dElapsed;
+    // Add tick times if any ticks ran
+    if(bStarted)
+      osReport << ",\"tick\":{\"mean\":"
+        << static_cast<double>(qwTotal) / 1e9 /
+             static_cast<double>(vqSorted.size())
+        << ",\"min\":" << static_cast<double>(vqSorted.front()) / 1e9
+        << ",\"p50\":" << BenchPercentile(vqSorted, 50)
+        << ",\"p90\":" << BenchPercentile(vqSorted, 90)
+        << ",\"p99\":" << BenchPercentile(vqSorted, 99)
+        << ",\"max\":" << static_cast<double>(vqSorted.back()) / 1e9
+        << '}';
+    osReport << ",\"lua\":{\"allocations\":"
+      << (bStarted ? cLua->GetAllocations() - qwAllocs : 0)
+      << ",\"memory\":" << LuaUtilGetUsage(cLua->GetState())
+      << "},\"process\":{\"memory\":" << cSystem->RAMProcUse()
+      << ",\"peak\":" << cSystem->RAMProcPeak()
+      << "},\"jobs\":{\"workers\":" << cJobs->JobsGetWorkers()
+      << ",\"executed\":"
+      << (bStarted ? cJobs->JobsGetExecuted() - stJobs : 0)
+      << ",\"stolen\":" << cJobs->JobsGetStolen()
+      << ",\"peak\":" << cJobs->JobsGetPeak()
+      << "},\"zones\":{";
+    // Add the profiler zones that were entered during the whole run
+    const ProfileStatsArray apsStats{ cProfile->ProfileGetTotals() };
+    bool bComma = false;
+    for(size_t stZone = 0; stZone < apsStats.size(); ++stZone)
+    { const ProfileStats &psRef = apsStats[stZone];
+      if(!psRef.stCount) continue;
+      osReport << (bComma ? "," : "") << '\"'
+        << cProfile->ProfileGetZoneName(stZone) << "\":{\"count\":"
+        << psRef.stCount << ",\"total\":" << psRef.dTotal
+        << ",\"min\":" << psRef.dMinimum << ",\"max\":" << psRef.dMaximum
+        << '}';
+      bComma = true;
+    } osReport << "}}";
+    // Write it to disk
+    const string strReport{ osReport.str() };
+    if(FStream fsReport{ strFile, FM_W_T })
+    { if(fsReport.FStreamWriteString(strReport) != strReport.size())
+        XCL("Failed to write benchmark report!", "File", strFile);
+    } else XCL("Failed to create benchmark report!", "File", strFile);
+    // Log the summary
+    if(!bStarted)
+      cLog->LogWarningExSafe("Bench stopped before any ticks ran to '$'.",
+        strFile);
+    else cLog->LogInfoExSafe("Bench $ $/$ ticks in $ (p50 $; p99 $) to '$'.",
+      vqSorted.size() >= stTicks ? "completed" : "stopped after",
+      vqSorted.size(), stTicks, StrShortFromDuration(dElapsed),
+      StrShortFromDuration(BenchPercentile(vqSorted, 50)),
+      StrShortFromDuration(BenchPercentile(vqSorted, 99)), strFile);
+  }
+  /* -- Record a tick and return true if the benchmark just finished */ public:
+  bool BenchTick(const uint64_t qwTime, const string &strFile)
+  { // Ignore if already finished (i.e. the end tick is running)
+    if(bDone) return false;
+    const size_t stTicks = static_cast<size_t>(cTimer->TimerGetBenchmark());
+    // First tick? Start counting and profile the subsystems
+    if(vqTimes.empty())
+    { vqTimes.reserve(stTicks);
+      qwStart = cmHiRes.GetTimeNS() - qwTime;
+      qwAllocs = cLua->GetAllocations();
+      stJobs = cJobs->JobsGetExecuted();
+      cProfile->ProfileSetEnabled(true);
+      cLog->LogInfoExSafe("Bench running $ ticks...", stTicks);
+    } // Record time taken and return if there are more ticks to run
+    vqTimes.push_back(qwTime);
+    if(vqTimes.size() < stTicks) return false;
+    // Write the report and finished
+    BenchReport(strFile);
+    return true;
+  }
+  /* -- Write the report if the engine is quitting before it finished ------ */
+  void BenchFinish(const string &strFile) { if(!bDone) BenchReport(strFile); }
+  /* -- Constructor -------------------------------------------------------- */
+  Bench(void) :                        // No parameters
+    /* -- Initialisers ----------------------------------------------------- */
+    qwStart(0),                        // Not started
+    qwAllocs(0),                       // No allocations
+    stJobs(0),                         // No jobs
+    bDone(false)                       // Report not written
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(Bench)               // No copy constructor
+};/* ----------------------------------------------------------------------- */
+}                                      // End of public namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private namespace
+/* == EoF =========================================================== EoF == */
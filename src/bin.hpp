@@ -30,12 +30,19 @@ class Pack :
   typedef vector<Rect> RectList;       // list of rectangles
   /* -------------------------------------------------------------- */ private:
   RectList         rlUsed, rlFree;     // Used and free data
-  /* -- Remove a rect (not that this can cause a realloc) ------------------ */
-  void PruneFreeRect(const size_t stIndex)
-    { rlFree.erase(next(rlFree.cbegin(), static_cast<ssize_t>(stIndex))); }
+  RectList         rlNew;              // Free data split by last insert
+  /* -- Remove a rect by moving the last one into its place ---------------- */
+  static void PruneRect(RectList &rlList, const size_t stIndex)
+  { // Order does not matter so no need to shift everything after it down
+    if(stIndex + 1 < rlList.size()) rlList[stIndex] = rlList.back();
+    rlList.pop_back();
+  }
   /* -- Add a rect (note this can cause a realloc) ------------------------- */
   void AddFreeRect(const Int iX, const Int iY, const Int iW, const int iH)
     { rlFree.push_back({ iX, iY, iW, iH }); }
+  /* -- Add a rect split from a free rect ---------------------------------- */
+  void AddNewRect(const Int iX, const Int iY, const Int iW, const int iH)
+    { rlNew.push_back({ iX, iY, iW, iH }); }
   /* ----------------------------------------------------------------------- */
   const Rect FindPositionForNewNodeBestShortSideFit(const Int iW,
     const Int iH, Int &iBestShortSideFit, Int &iBestLongSideFit) const
@@ -60,28 +67,28 @@ class Pack :
     } // Return what we found if we did
     return rFound;
   }
-  /* -- Do try to split a free node and ------------------------------------ */
-  void SplitFreeNodeUnsafe(const Rect &rFree, const Rect &rUsed,
+  /* -- Split a free node around a used node ------------------------------- */
+  void SplitFreeNodeEx(const Rect &rFree, const Rect &rUsed,
     const Int iFreeH, const Int iUsedH, const Int iFreeV, const Int iUsedV)
   { // Check horizontal bounds
     if(rUsed.CoordGetX() < iFreeH && iUsedH > rFree.CoordGetX())
     { // New node at the top side of the used node.
       if(rUsed.CoordGetY() > rFree.CoordGetY() && rUsed.CoordGetY() < iFreeV)
-        AddFreeRect(rFree.CoordGetX(), rFree.CoordGetY(),
+        AddNewRect(rFree.CoordGetX(), rFree.CoordGetY(),
           rFree.DimGetWidth(), rUsed.CoordGetY() - rFree.CoordGetY());
       // New node at the bottom side of the used node.
       if(iUsedV < iFreeV)
-        AddFreeRect(rFree.CoordGetX(), iUsedV,
+        AddNewRect(rFree.CoordGetX(), iUsedV,
           rFree.DimGetWidth(), iFreeV - iUsedV);
     } // Check vertical bounds
     if(rUsed.CoordGetY() < iFreeV && iUsedV > rFree.CoordGetY())
     { // New node at the left side of the used node.
       if(rUsed.CoordGetX() > rFree.CoordGetX() && rUsed.CoordGetX() < iFreeH)
-        AddFreeRect(rFree.CoordGetX(), rFree.CoordGetY(),
+        AddNewRect(rFree.CoordGetX(), rFree.CoordGetY(),
           rUsed.CoordGetX() - rFree.CoordGetX(), rFree.DimGetHeight());
       // New node at the right side of the used node.
       if(iUsedH < iFreeH)
-        AddFreeRect(iUsedH, rFree.CoordGetY(),
+        AddNewRect(iUsedH, rFree.CoordGetY(),
           iFreeH - iUsedH, rFree.DimGetHeight());
     }
   }
@@ -98,20 +105,9 @@ class Pack :
     if(rUsed.CoordGetX() >= iFreeH || iUsedH <= rFree.CoordGetX() ||
        rUsed.CoordGetY() >= iFreeV || iUsedV <= rFree.CoordGetY())
       return false;
-    // DANGER! There must be at least four reserved vector nodes or a
-    // push_back() could trigger a realloc() being a std::vector and &rFree
-    // would in succession point to freed memory and all havoc breaks lose in
-    // the engine! So if there is not enough room for four more push_back()'s?
-    if(rlFree.capacity() - rlFree.size() < 4)
-    { // Not enough room so try to reserve up to four more items. Reserve()
-      // will not grow exponentially so we should handle that instead.
-      rlFree.reserve(UtilNearestPow2<size_t>(rlFree.size() + 4));
-      // Do the split with a NEW evaluation of rlFree[stIndex] as again, the
-      // address of rlFree[stIndex] may have changed!
-      SplitFreeNodeUnsafe(rlFree[stIndex], rUsed,
-        iFreeH, iUsedH, iFreeV, iUsedV);
-    } // Enough room so we can just continue with the existing reference.
-    else SplitFreeNodeUnsafe(rFree, rUsed, iFreeH, iUsedH, iFreeV, iUsedV);
+    // Split pieces go in a seperate list so growing it can never move the
+    // free node we are referencing.
+    SplitFreeNodeEx(rFree, rUsed, iFreeH, iUsedH, iFreeV, iUsedV);
     // Success!
     return true;
   }
@@ -125,30 +121,44 @@ class Pack :
         && rSrc.CoordGetY() + rSrc.DimGetHeight()
         <= rDest.CoordGetY() + rDest.DimGetHeight();
   }
-  /* -- Goes through free rectangle list and removes any redundan ---------- */
-  void PruneFreeList(void)
-  { // Go through each free rectangle
-    for(size_t stIndex = 0; stIndex < rlFree.size(); ++stIndex)
-    { // Compare with all other rectangles
+  /* -- Remove split rects that are redundant ------------------------------ */
+  void PruneNewList(void)
+  { // Go through each new rectangle and compare with the other new ones
+    for(size_t stIndex = 0; stIndex < rlNew.size(); ++stIndex)
+    { // Compare with all the other new rectangles after it
       for(size_t stSubIndex = stIndex + 1;
-                 stSubIndex < rlFree.size();
+                 stSubIndex < rlNew.size();
                ++stSubIndex)
       { // If rectangle sub-rect is inside this rect
-        if(IsContainedIn(rlFree[stIndex], rlFree[stSubIndex]))
+        if(IsContainedIn(rlNew[stIndex], rlNew[stSubIndex]))
         { // Remove it
-          PruneFreeRect(stIndex);
+          PruneRect(rlNew, stIndex);
           // Decrement index
           --stIndex;
           // We're done with the sub-rect
           break;
         } // Ignore if subrect is inside this rect
-        if(!IsContainedIn(rlFree[stSubIndex], rlFree[stIndex])) continue;
+        if(!IsContainedIn(rlNew[stSubIndex], rlNew[stIndex])) continue;
         // Remove sub-rect
-        PruneFreeRect(stSubIndex);
+        PruneRect(rlNew, stSubIndex);
         // Decrement index
         --stSubIndex;
       }
-    }
+    } // A surviving old free rect was never touched by the insert so it
+    // can't be inside a new one. Only new ones inside old ones need removing
+    // so this is only new by old and not the old all by all comparison.
+    for(size_t stIndex = 0; stIndex < rlNew.size(); ++stIndex)
+      for(const Rect &rFree : rlFree)
+      { // Ignore if the new rect is not inside the old one
+        if(!IsContainedIn(rlNew[stIndex], rFree)) continue;
+        // Remove it and check the one moved into its place
+        PruneRect(rlNew, stIndex);
+        --stIndex;
+        break;
+      }
+    // Move the survivors into the free list
+    rlFree.insert(rlFree.cend(), rlNew.cbegin(), rlNew.cend());
+    rlNew.clear();
   }
   /* -- Swap --------------------------------------------------------------- */
   void BinSwap(Pack &pOther)
@@ -157,6 +167,7 @@ class Pack :
     // Swap used and free lists
     rlUsed.swap(pOther.rlUsed);
     rlFree.swap(pOther.rlFree);
+    rlNew.swap(pOther.rlNew);
   }
   /* -- (Re)initialise bin to empty state -------------------------- */ public:
   void Init(const UInt iNWidth, const UInt iNHeight)
@@ -223,14 +234,13 @@ class Pack :
     const Rect rNew{ FindPositionForNewNodeBestShortSideFit(
       static_cast<Int>(uiW), static_cast<Int>(uiH), iScore1, iScore2) };
     if(rNew.DimGetHeight() == 0) return rNew;
-    size_t stRectanglesToProcess = rlFree.size();
-    for(size_t stIndex = 0; stIndex < stRectanglesToProcess; ++stIndex)
-    { if(!SplitFreeNode(stIndex, rNew)) continue;
-      PruneFreeRect(stIndex);
-      --stIndex;
-      --stRectanglesToProcess;
-    }
-    PruneFreeList();
+    // Split every free rect the new one overlaps. The last free rect is
+    // moved into the place of a split one so check the same index again.
+    for(size_t stIndex = 0; stIndex < rlFree.size(); )
+      if(SplitFreeNode(stIndex, rNew)) PruneRect(rlFree, stIndex);
+      else ++stIndex;
+    // Remove redundant pieces and add the rest to the free list
+    PruneNewList();
     rlUsed.emplace_back(rNew);
     return rNew;
   }
@@ -272,6 +282,176 @@ class Pack :
     /* -- Do nothing ------------------------------------------------------- */
     { }
 };/* ----------------------------------------------------------------------- */
+/* == Skyline packer with the same interface as Pack ======================= */
+template<typename IntType=int,         // Unsigned type not allowed!
+         typename Int=typename make_signed<IntType>::type,
+         typename UInt=typename make_unsigned<IntType>::type,
+         class DimClass=Dimensions<Int>>
+class PackSkyline :
+  /* -- Initialisers ------------------------------------------------------- */
+  public DimClass                      // Dimensions of bin in pixels
+{ /* -- Checks ------------------------------------------------------------- */
+  static_assert(is_same_v<IntType, Int>, "Invalid type!");
+  /* --------------------------------------------------------------- */ public:
+  typedef DimCoords<Int> Rect;         // Rectangle of signed ints
+  /* -------------------------------------------------------------- */ private:
+  struct Segment { Int iX, iY, iW; };  // Top edge of a packed column
+  typedef vector<Segment> SegmentList; // Top edges from left to right
+  SegmentList      slSky;              // Segments covering the full width
+  size_t           stUsed;             // Number of rects inserted
+  double           dArea;              // Total area of rects inserted
+  /* -- Get lowest position a rect fits at starting at the segment --------- */
+  bool Fit(size_t stIndex, const Int iW, const Int iH, Int &iY) const
+  { // Bail if it would go off the right edge
+    const Int iX = slSky[stIndex].iX;
+    if(iX + iW > this->DimGetWidth()) return false;
+    // Rest on the highest segment under the rect. The segments always cover
+    // the full width so this can't go past the last one.
+    iY = 0;
+    for(Int iLeft = iW; iLeft > 0; iLeft -= slSky[stIndex++].iW)
+    { iY = UtilMaximum(iY, slSky[stIndex].iY);
+      if(iY + iH > this->DimGetHeight()) return false; }
+    // Fits
+    return true;
+  }
+  /* -- Find the segment giving the lowest bottom edge --------------------- */
+  size_t Find(const Int iW, const Int iH, Int &iBestY) const
+  { // Lowest bottom edge wins and narrowest segment breaks a tie
+    size_t stBest = StdMaxSizeT;
+    Int iBestBottom = numeric_limits<Int>::max(),
+        iBestWidth = numeric_limits<Int>::max();
+    for(size_t stIndex = 0; stIndex < slSky.size(); ++stIndex)
+    { Int iY;
+      if(!Fit(stIndex, iW, iH, iY)) continue;
+      const Int iBottom = iY + iH;
+      if(iBottom > iBestBottom || (iBottom == iBestBottom &&
+         slSky[stIndex].iW >= iBestWidth)) continue;
+      stBest = stIndex;
+      iBestBottom = iBottom;
+      iBestWidth = slSky[stIndex].iW;
+      iBestY = iY;
+    } // Return best segment or StdMaxSizeT if nothing fits
+    return stBest;
+  }
+  /* -- Raise the skyline over a new rect ---------------------------------- */
+  void AddSegment(const size_t stIndex, const Int iY, const Int iW)
+  { // Insert the new top edge
+    slSky.insert(next(slSky.cbegin(), static_cast<ssize_t>(stIndex)),
+      { slSky[stIndex].iX, iY, iW });
+    // Shrink or remove the segments it now covers
+    const Int iRight = slSky[stIndex].iX + iW;
+    for(size_t stNext = stIndex + 1; stNext < slSky.size(); )
+    { Segment &sRef = slSky[stNext];
+      if(sRef.iX >= iRight) break;
+      const Int iShrink = iRight - sRef.iX;
+      if(iShrink < sRef.iW) { sRef.iX += iShrink; sRef.iW -= iShrink; break; }
+      slSky.erase(next(slSky.cbegin(), static_cast<ssize_t>(stNext)));
+    } // Merge neighbours at the same height
+    for(size_t stNext = 1; stNext < slSky.size(); )
+    { Segment &sPrev = slSky[stNext - 1];
+      if(sPrev.iY != slSky[stNext].iY) { ++stNext; continue; }
+      sPrev.iW += slSky[stNext].iW;
+      slSky.erase(next(slSky.cbegin(), static_cast<ssize_t>(stNext)));
+    }
+  }
+  /* -- Swap --------------------------------------------------------------- */
+  void BinSwap(PackSkyline &pOther)
+  { // Swap dimensions
+    this->DimSwap(pOther);
+    // Swap skyline and usage
+    slSky.swap(pOther.slSky);
+    swap(stUsed, pOther.stUsed);
+    swap(dArea, pOther.dArea);
+  }
+  /* -- (Re)initialise bin to empty state -------------------------- */ public:
+  void Init(const UInt iNWidth, const UInt iNHeight)
+  { // Init iW and iH
+    this->DimSet(static_cast<Int>(iNWidth), static_cast<Int>(iNHeight));
+    // Clear current usage and start with a flat skyline
+    stUsed = 0;
+    dArea = 0;
+    slSky.clear();
+    slSky.push_back({ 0, 0, this->DimGetWidth() });
+  }
+  /* -- Reserve memory ----------------------------------------------------- */
+  void Reserve(const size_t, const size_t stFreeReserve)
+    { slSky.reserve(stFreeReserve); }
+  /* -- (Re)initialise bin to empty state ---------------------------------- */
+  void Init(const UInt uiNWidth, const UInt uiNHeight,
+     const size_t stUsedReserve, const size_t stFreeReserve)
+  { // Initialise rect
+    Init(uiNWidth, uiNHeight);
+    // Reserve memory
+    Reserve(stUsedReserve, stFreeReserve);
+  }
+  /* -- Englarge the bin --------------------------------------------------- */
+  bool Resize(const UInt uiNWidth, const UInt uiNHeight)
+  { // Convert values to int
+    const Int iNHeight = static_cast<Int>(uiNHeight);
+    const Int iNWidth = static_cast<Int>(uiNWidth);
+    // Return if it is not getting any bigger
+    if(iNWidth <= this->DimGetWidth() && iNHeight <= this->DimGetHeight())
+      return false;
+    // New width specified so add a flat segment on the right
+    if(iNWidth > this->DimGetWidth())
+    { slSky.push_back({ this->DimGetWidth(), 0,
+        iNWidth - this->DimGetWidth() });
+      this->DimSetWidth(iNWidth);
+    } // Extra height just makes room above the skyline
+    if(iNHeight > this->DimGetHeight()) this->DimSetHeight(iNHeight);
+    // Englarge complete
+    return true;
+  }
+  /* -- Test insert a single rectangle into the bin ------------------------ */
+  const Rect Test(const UInt uiW, const UInt uiH) const
+  { Int iY = 0;
+    const size_t stIndex =
+      Find(static_cast<Int>(uiW), static_cast<Int>(uiH), iY);
+    if(stIndex == StdMaxSizeT) return {};
+    return { slSky[stIndex].iX, iY,
+      static_cast<Int>(uiW), static_cast<Int>(uiH) };
+  }
+  /* -- Inserts a single rectangle into the bin ---------------------------- */
+  const Rect Insert(const UInt uiW, const UInt uiH)
+  { // Find the lowest place and return empty rect if it doesn't fit
+    const Int iW = static_cast<Int>(uiW), iH = static_cast<Int>(uiH);
+    Int iY = 0;
+    const size_t stIndex = Find(iW, iH, iY);
+    if(stIndex == StdMaxSizeT) return {};
+    // Place it and raise the skyline over it
+    const Rect rNew{ slSky[stIndex].iX, iY, iW, iH };
+    AddSegment(stIndex, iY + iH, iW);
+    ++stUsed;
+    dArea += static_cast<double>(iW) * iH;
+    return rNew;
+  }
+  /* ----------------------------------------------------------------------- */
+  double Occupancy(void) const
+    { return dArea / (this->template DimGetWidth<double>() *
+                      this->DimGetHeight()); }
+  /* ----------------------------------------------------------------------- */
+  size_t Used(void) const { return stUsed; }
+  size_t Free(void) const { return slSky.size(); }
+  size_t Total(void) const { return slSky.size() + stUsed; }
+  /* -- Default constructor that instantiates an empty bin of size 0x0 ----- */
+  PackSkyline(void) :
+    /* -- Initialisers ----------------------------------------------------- */
+    stUsed(0),                         // No rects inserted yet
+    dArea(0)                           // No area used yet
+    /* -- Do nothing ------------------------------------------------------- */
+    { }
+  /* -- Instantiates a bin of the given size ------------------------------- */
+  PackSkyline(const UInt uiNWidth,     // Width of new pack
+              const UInt uiNHeight) :  // Height of new pack
+    /* -- Initialisers ----------------------------------------------------- */
+    DimClass{ static_cast<Int>(uiNWidth),    // Set width of new pack
+              static_cast<Int>(uiNHeight) }, // Set height of new pack
+    slSky{{ 0, 0, this->DimGetWidth() }},    // Flat skyline
+    stUsed(0),                         // No rects inserted yet
+    dArea(0)                           // No area used yet
+    /* -- Do nothing ------------------------------------------------------- */
+    { }
+};/* ----------------------------------------------------------------------- */
 /* == Bin object collector and member class ================================ */
 CTOR_BEGIN_DUO(Bins, Bin, CLHelperUnsafe, ICHelperUnsafe),
   /* -- Base classes ------------------------------------------------------- */
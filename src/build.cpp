@@ -33,6 +33,7 @@ namespace Engine {                     // Put everything in engine namespace
 #include "ident.hpp"                   // Identifier class
 #include "dir.hpp"                     // Directory listing class
 #include "util.hpp"                    // Misc utilities
+#include "lines.hpp"                   // Ring of text lines
 #include "sysutil.hpp"                 // System level utilities
 #include "args.hpp"                    // Arguments class
 #include "cmdline.hpp"                 // Command line helper class
@@ -44,7 +45,9 @@ namespace Engine {                     // Put everything in engine namespace
 #include "log.hpp"                     // Logging class
 #include "collect.hpp"                 // Collector class
 #include "stat.hpp"                    // Statistic class
+#include "profile.hpp"                 // Frame profiler class
 #include "thread.hpp"                  // Thread class
+#include "job.hpp"                     // Job pool class
 #include "evtcore.hpp"                 // Events core class
 #include "evtmain.hpp"                 // Events main class
 #include "condef.hpp"                  // Console definitions
@@ -4399,9 +4402,11 @@ int ShowVersion(void)
     cSystem->ENGDrive(), cSystem->ENGDir(), cSystem->ENGFile(),
     cSystem->ENGExt(), cSystem->ENGFileExt(), cSystem->ENGLoc());
   // For each log entry, write the line to the buffer
-  for(const LogLine &llLine : *cLog)
+  for(uint64_t qwIndex = cLog->LinesBegin(); qwIndex < cLog->LinesEnd();
+    ++qwIndex)
+  { const LogLine llLine{ cLog->LinesGet(qwIndex) };
     cout << '[' << fixed << setprecision(6) << llLine.dTime << "] "
-         << llLine.strLine << endl;
+         << llLine.strvLine << endl; }
   // Success
   return 0;
 }
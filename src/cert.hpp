@@ -21,6 +21,7 @@ class Certs                            // Certificates store
 { /* -- Typedefs --------------------------------------------------- */ public:
   typedef pair<const string, X509*> X509Pair; // Do not &ref string
   typedef vector<X509Pair>          X509List; // A vector of pairs
+  typedef multimap<const unsigned long, const string> X509Index;
   /* -- X509 error database --------------------------------------- */ private:
   struct X509ErrInfo                   // Information about the X509 error
   { /* --------------------------------------------------------------------- */
@@ -55,7 +56,12 @@ class Certs                            // Certificates store
   };/* -- Variables -------------------------------------------------------- */
   SSL_CTX           *scStore;          // Context used for cerificate store
   X509_STORE        *xsCerts;          // Certificate store inside OpenSSL
+  X509_LOOKUP_METHOD *xlmLazy;         // Lookup method for lazy loading
   X509List           lCAStore;         // Certificate store
+  X509Index          xiIndex;          // Subject hashes of unloaded certs
+  string             strDir;           // Directory of unloaded certs
+  mutex              mLazy;            // Lazy loading in progress
+  bool               bLazy;            // Load certificates when needed
   SafeDoubleUInt64   qCertBypass;      // Certificate bypass flags
   const string       strExtension;     // Default extension
   const X509Err      xErrDB;           // X509 error database
@@ -110,10 +116,134 @@ class Certs                            // Certificates store
       "Certs rejected certificate '$/$' due to exception: $",
       strD, strF, e.what());
   }
+  /* -- Read the next DER header and make sure its contents fit ------------ */
+  static bool CertsDERNext(const unsigned char *&ucpPtr, long &lSize,
+    long &lLength, int &iTag, int &iClass)
+  { // Read the header and return failure if invalid
+    const unsigned char*const ucpStart = ucpPtr;
+    if(ASN1_get_object(&ucpPtr, &lLength, &iTag, &iClass, lSize) & 0x80)
+      return false;
+    // Remove the header from the remaining size and check contents fit
+    lSize -= static_cast<long>(ucpPtr - ucpStart);
+    return lLength <= lSize;
+  }
+  /* -- Find the subject in a DER certificate without parsing all of it ---- */
+  static const unsigned char *CertsDERSubject(const unsigned char *ucpPtr,
+    long lSize, long &lSubject)
+  { // Enter the certificate and tbsCertificate sequences
+    long lLength; int iTag, iClass;
+    for(size_t stSequence = 0; stSequence < 2; ++stSequence)
+    { if(!CertsDERNext(ucpPtr, lSize, lLength, iTag, iClass) ||
+        iTag != V_ASN1_SEQUENCE) return nullptr;
+      lSize = lLength; }
+    // Skip the optional version, serial number, signature algorithm, issuer
+    // and validity fields.
+    for(size_t stField = 0; stField < 4;)
+    { if(!CertsDERNext(ucpPtr, lSize, lLength, iTag, iClass)) return nullptr;
+      ucpPtr += lLength;
+      lSize -= lLength;
+      if(iClass != V_ASN1_CONTEXT_SPECIFIC) ++stField; }
+    // The subject is next so return it with its header included
+    const unsigned char*const ucpSubject = ucpPtr;
+    if(!CertsDERNext(ucpPtr, lSize, lLength, iTag, iClass) ||
+      iTag != V_ASN1_SEQUENCE) return nullptr;
+    lSubject = static_cast<long>(ucpPtr - ucpSubject) + lLength;
+    return ucpSubject;
+  }
+  /* -- Index certificate by subject hash so it can be loaded when needed -- */
+  template<class SyncMethod>void CertsIndex(SyncMethod &smClass,
+    const string &strD, const string &strF) try
+  { // Load the certificate and find the subject
+    const FileMap fC{ AssetExtract(StrAppend(strD, '/', strF)) };
+    long lSubject;
+    const unsigned char*ucpPtr = CertsDERSubject(fC.MemPtr<unsigned char>(),
+      fC.MemSize<long>(), lSubject);
+    if(!ucpPtr)
+    { cLog->LogWarningExSafe("Certs rejected '$' as unable to find subject!",
+        fC.IdentGet());
+      return; }
+    // Parse only the subject and if succeeded?
+    typedef unique_ptr<X509_NAME, function<decltype(X509_NAME_free)>>
+      X509NamePtr;
+    if(const X509NamePtr xnSubject{
+      d2i_X509_NAME(nullptr, &ucpPtr, lSubject), X509_NAME_free })
+    { // Hash it the same way OpenSSL does for hashed certificate directories
+      const unsigned long ulHash = X509_NAME_hash(xnSubject.get());
+      // Lock access to the index and add it
+      smClass.LockFunction();
+      xiIndex.insert({ ulHash, strF });
+      smClass.UnlockFunction();
+    } // Failed to parse subject so log the rejection
+    else cLog->LogWarningExSafe(
+      "Certs rejected '$' as unable to parse subject!", fC.IdentGet());
+  } // In the rare occurence that an exception occurs we should skip the cert
+  catch(const exception &e)
+  { // Show the exception and try the next certificate
+    cLog->LogErrorExSafe(
+      "Certs rejected certificate '$/$' due to exception: $",
+      strD, strF, e.what());
+  }
+  /* -- Load indexed certificates with the specified subject --------------- */
+  int CertsLazyLookup(const X509_NAME*const xnName, X509_OBJECT*const xoRet)
+  { // Find indexed certificates with the same subject hash
+    const unsigned long ulHash = X509_NAME_hash(xnName);
+    const LockGuard lgLazy{ mLazy };
+    const auto aRange{ xiIndex.equal_range(ulHash) };
+    if(aRange.first == aRange.second) return 0;
+    // Load them all as they could be cross-signed with the same subject
+    LoadSerialised lsSync;
+    for(auto aIt{ aRange.first }; aIt != aRange.second; ++aIt)
+      CertsLoad(lsSync, strDir, aIt->second);
+    xiIndex.erase(aRange.first, aRange.second);
+    ERR_clear_error();
+    // Find the certificate that is now in the store and return it
+    if(!X509_STORE_lock(xsCerts)) return 0;
+    const X509_OBJECT*const xoFound = X509_OBJECT_retrieve_by_subject(
+      X509_STORE_get0_objects(xsCerts), X509_LU_X509, xnName);
+    const int iResult = xoFound ?
+      X509_OBJECT_set1_X509(xoRet, X509_OBJECT_get0_X509(xoFound)) : 0;
+    X509_STORE_unlock(xsCerts);
+    return iResult;
+  }
+  /* -- Lookup method callback when a subject isn't in the store ----------- */
+  static int CertsLazyLookupCallback(X509_LOOKUP*const xlCtx,
+    const X509_LOOKUP_TYPE xltType, const X509_NAME*const xnName,
+    X509_OBJECT*const xoRet) try
+  { // Only certificates are indexed
+    if(xltType != X509_LU_X509) return 0;
+    // Get the store and lookup the subject
+    return reinterpret_cast<Certs*>(X509_LOOKUP_get_method_data(xlCtx))->
+      CertsLazyLookup(xnName, xoRet);
+  } // Exceptions must not cross into OpenSSL
+  catch(const exception &e)
+  { // Show the exception and report not found
+    cLog->LogErrorExSafe("Certs lazy lookup failed due to exception: $",
+      e.what());
+    return 0;
+  }
+  /* -- Run a function for every certificate file -------------------------- */
+  template<class Callback>
+    void CertsForEach(const AssetList &aList, const Callback &cbFunc)
+  { // Apple compiler does not support std::execution yet :(.
+#if defined(MACOS)
+    // Create sync method class
+    LoadSerialised ccaSync;
+    // Now initialising certificate store
+    for(const string &strF : aList) cbFunc(ccaSync, strF);
+#else
+    // Create async method class
+    LoadParallel ccaASync;
+    // Now initialising certificate store
+    StdForEach(par_unseq, aList.cbegin(), aList.cend(),
+      [&ccaASync, &cbFunc](const string &strF) { cbFunc(ccaASync, strF); });
+#endif
+  }
   /* -- Unload open ssl certificate store ---------------------------------- */
   void CertsUnload(void)
   { // Remove pointer to certificate store as it is above to become invalid
     if(xsCerts) xsCerts = nullptr;
+    // Forget certificates that were never needed
+    xiIndex.clear();
     // Return if ssl store is not available
     if(!scStore) return;
     // Log that were unloading the certificate store
@@ -161,25 +291,48 @@ class Certs                            // Certificates store
     // Get certificate store and failed if not retrieved
     xsCerts = SSL_CTX_get_cert_store(scStore);
     if(!xsCerts) XC("Failed to get cert store pointer!");
-    // Allocate memory for list (assuming all certs are valid)
+    // Loading certificates only when they are needed?
+    if(bLazy)
+    { // Create the lookup method if we haven't already
+      if(!xlmLazy)
+      { xlmLazy = X509_LOOKUP_meth_new("Lazy CA store");
+        if(!xlmLazy) XC("Failed to create lazy lookup method!");
+        if(!X509_LOOKUP_meth_set_get_by_subject(xlmLazy,
+          CertsLazyLookupCallback))
+            XC("Failed to set lazy lookup callback!"); }
+      // Add it to the store so it is asked for subjects not in the store
+      X509_LOOKUP*const xlLazy = X509_STORE_add_lookup(xsCerts, xlmLazy);
+      if(!xlLazy) XC("Failed to add lazy lookup to cert store!");
+      X509_LOOKUP_set_method_data(xlLazy, this);
+      // Log that we're indexing certificates
+      cLog->LogDebugExSafe(
+        "Certs store initialised. Indexing $ certificates...", aList.size());
+      // Only read the subject of each certificate for now
+      strDir = strD;
+      CertsForEach(aList, [this, &strD](auto &smClass, const string &strF)
+        { CertsIndex(smClass, strD, strF); });
+      // If no certs were indexed then there is no need to keep the context
+      if(xiIndex.empty()) CertsUnload();
+      // If we indexed all the certificates?
+      if(xiIndex.size() == aList.size())
+      { // Log that we indexed all the certificates
+        cLog->LogInfoExSafe("Certs indexed all $ certificates.",
+          xiIndex.size());
+      } // If we didn't index all the certificates?
+      else
+      { // Log a warning that we did not index all the certificates
+        cLog->LogWarningExSafe("Certs could only index $ of $ certificates!",
+          xiIndex.size(), aList.size());
+      } // Done
+      return;
+    } // Allocate memory for list (assuming all certs are valid)
     lCAStore.reserve(aList.size());
     // Log that we're loading certificates in parallel
     cLog->LogDebugExSafe("Certs store initialised. Loading $ certificates...",
       aList.size());
-    // Apple compiler does not support std::execution yet :(.
-#if defined(MACOS)
-    // Create sync method class
-    LoadSerialised ccaSync;
     // Now initialising certificate store
-    for(const string &strF : aList) CertsLoad(ccaSync, strD, strF);
-#else
-    // Create async method class
-    LoadParallel ccaASync;
-    // Now initialising certificate store
-    StdForEach(par_unseq, aList.cbegin(), aList.cend(),
-      [this, &ccaASync, &strD](const string &strF)
-        { CertsLoad(ccaASync, strD, strF); });
-#endif
+    CertsForEach(aList, [this, &strD](auto &smClass, const string &strF)
+      { CertsLoad(smClass, strD, strF); });
     // If no certs were loaded then there is no need to keep the context
     if(lCAStore.empty()) CertsUnload();
     // We hav certs so shrink memory to fit actual contents
@@ -201,6 +354,20 @@ class Certs                            // Certificates store
   /* ----------------------------------------------------------------------- */
   const X509List &GetCertList(void) const { return lCAStore; }
   size_t GetCertListSize(void) const { return GetCertList().size(); }
+  /* -- Load certificates that were indexed but not needed yet ------------- */
+  void CertsLoadAll(void)
+  { // Ignore if nothing left to load
+    const LockGuard lgLazy{ mLazy };
+    if(xiIndex.empty()) return;
+    // Log that we're loading the remaining certificates
+    cLog->LogDebugExSafe("Certs loading $ remaining certificates...",
+      xiIndex.size());
+    // Load them all and forget them
+    LoadSerialised lsSync;
+    for(const auto &aItem : xiIndex) CertsLoad(lsSync, strDir, aItem.second);
+    xiIndex.clear();
+    ERR_clear_error();
+  }
   /* ----------------------------------------------------------------------- */
   bool CertsIsStoreAvailable(void) const { return !!CertsGetStore(); }
   /* -- Find a X509 error -------------------------------------------------- */
@@ -220,6 +387,8 @@ class Certs                            // Certificates store
     /* -- Initialisers ----------------------------------------------------- */
     scStore(nullptr),                  // No store initialised
     xsCerts(nullptr),                  // No certificate chain initialised
+    xlmLazy(nullptr),                  // No lazy lookup method yet
+    bLazy(false),                      // Load all certificates at startup
     qCertBypass{{0, 0}},               // No bypass flags setup yet
     strExtension{ "." CER_EXTENSION }, // Default extension
 #define X509ERR(b,f,e) { X509_V_ERR_ ## e, { STR(e), b, 1ULL << f } }
@@ -301,7 +470,11 @@ class Certs                            // Certificates store
   /* -- No code ------------------------------------------------------------ */
   { }
   /* -- Destructor that unloads all x509 certificates ---------------------- */
-  ~Certs(void) { CertsEmpty(); }
+  ~Certs(void)
+  { // Unload the store first as it still uses the lookup method
+    CertsEmpty();
+    if(xlmLazy) X509_LOOKUP_meth_free(xlmLazy);
+  }
   /* ----------------------------------------------------------------------- */
   DELETECOPYCTORS(Certs)               // Disable copy constructor and operator
   /* --------------------------------------------------------------- */ public:
@@ -311,6 +484,9 @@ class Certs                            // Certificates store
   CVarReturn CertsSetBypassFlags2(const uint64_t uiFlags)
     { return CVarSimpleSetInt(qCertBypass.back(), uiFlags); }
   /* ----------------------------------------------------------------------- */
+  CVarReturn CertsSetLazy(const bool bState)
+    { return CVarSimpleSetInt(bLazy, bState); }
+  /* ----------------------------------------------------------------------- */
   CVarReturn CertsFileModified(const string &strD, string&)
   { // Empty string is ok, treat as no CA store
     if(strD.empty())
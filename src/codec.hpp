@@ -11,7 +11,8 @@
 namespace ICodec {                     // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace ICrypt::P;             using namespace IError::P;
-using namespace IMemory::P;            using namespace IStd::P;
+using namespace IJob::P;               using namespace IMemory::P;
+using namespace IStd::P;               using namespace IUtil::P;
 using namespace Lib::OS::OpenSSL;      using namespace Lib::OS::SevenZip;
 using namespace Lib::OS::ZLib;
 /* ------------------------------------------------------------------------- */
@@ -62,6 +63,7 @@ enum Header : unsigned long            // Buffer header integer location flags
 { /* ----------------------------------------------------------------------- */
   ENCHDR_MAGIC           = 0x1A43444D, // Magic (MDC[esc])
   ENCHDR_VERSION         =          1, // Structure version
+  ENCHDR_VERSION_STREAM  =          2, // Structure version of chunked data
   /* ----------------------------------------------------------------------- */
   ENCHDR_POS_MAGIC       =          0, // Offset of magic identifier
   ENCHDR_POS_VERSION     =          4, // Offset of version identifier
@@ -71,7 +73,46 @@ enum Header : unsigned long            // Buffer header integer location flags
   ENCHDR_POS_XLEN        =         20, // Offset of extra bytes length
   /* ----------------------------------------------------------------------- */
   ENCHDR_SIZE            =         24, // Size of compressed block header
+  /* -- Chunked data (version 2) re-uses the header as follows ------------- */
+  ENCHDR_POS_UBLEN64     =         12, // Offset of 64-bit uncompressed length
+  ENCHDR_POS_CHUNKSIZE   =         20, // Offset of uncompressed chunk size
+  /* -- Each frame is followed by a version 1 block of the chunk ----------- */
+  ENCFRM_POS_SIZE        =          0, // Offset of version 1 block length
+  ENCFRM_POS_CRC         =          4, // Offset of CRC32 of chunk
+  ENCFRM_SIZE            =          8, // Size of frame header
+  /* ----------------------------------------------------------------------- */
+  ENCFRM_CHUNKSIZE       =    1048576, // Uncompressed bytes in each chunk
+};/* -- Throughput of each mode -------------------------------------------- */
+struct CodecStat                       // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  SafeUInt64       qwBytes,            // Uncompressed bytes processed
+                   qwTime;             // Nanoseconds taken to process them
 };/* ----------------------------------------------------------------------- */
+static array<array<CodecStat, 2>, ENCMODE_MAX> aCodecStats; // Encode/decode
+/* -- Record time taken to encode or decode data --------------------------- */
+static void CodecStatAdd(const size_t stMode, const bool bDecode,
+  const size_t stBytes, const uint64_t qwTime)
+{ // Ignore if mode is invalid
+  if(stMode >= aCodecStats.size()) return;
+  // Add to totals
+  CodecStat &csRef = aCodecStats[stMode][bDecode];
+  csRef.qwBytes += stBytes;
+  csRef.qwTime += qwTime;
+}
+/* -- Return bytes processed and throughput in MB/s of a mode -------------- */
+static const pair<uint64_t, double> CodecStatGet(const EncMode eMode,
+  const bool bDecode)
+{ // Get the totals and return bytes and throughput
+  const CodecStat &csRef = aCodecStats[eMode][bDecode];
+  const uint64_t qwBytes = csRef.qwBytes, qwTime = csRef.qwTime;
+  return { qwBytes, qwTime ? static_cast<double>(qwBytes) / 1048576 /
+    (static_cast<double>(qwTime) / 1e9) : 0 };
+}
+/* -- Return CRC32 of a block ---------------------------------------------- */
+static uint32_t CodecGetCRC(const MemConst &mcSrc)
+  { return static_cast<uint32_t>(crc32(crc32(0, Z_NULL, 0),
+      mcSrc.MemPtr<Bytef>(), static_cast<uInt>(mcSrc.MemSize()))); }
+/* ------------------------------------------------------------------------- */
 static const EncData CodecEncodeAES(const MemConst &mcSrc, Memory &mDest,
   const size_t, const Crypt::QPKey &qaKey, const Crypt::QIVKey &qaIV,
   const size_t stPos)
@@ -450,6 +491,74 @@ class CoDecoder :                      // Magic decoder derivative class
       default: XC("Unknown decoding method!", "Mode", ulMode);
     }
   }
+  /* ----------------------------------------------------------------------- */
+  void DecodeV2(const MemConst &mcSrc)
+  { // Read total uncompressed length and chunk size
+    const uint64_t qwUBLen = mcSrc.ReadIntLE<uint64_t>(ENCHDR_POS_UBLEN64);
+    const size_t stChunkSize =
+      mcSrc.ReadIntLE<uint32_t>(ENCHDR_POS_CHUNKSIZE);
+    // Only the chunk size we write is accepted so a small header cannot ask
+    // for a huge number of chunks
+    if(stChunkSize != ENCFRM_CHUNKSIZE)
+      XC("Invalid chunk size!",
+         "Expect", static_cast<size_t>(ENCFRM_CHUNKSIZE),
+         "Actual", stChunkSize);
+    // Check that the frame headers fit in the input before allocating
+    // anything. This also stops a length too big for memory.
+    const uint64_t qwChunks =
+      qwUBLen / stChunkSize + (qwUBLen % stChunkSize != 0);
+    if(qwChunks > (mcSrc.MemSize() - ENCHDR_SIZE) / ENCFRM_SIZE ||
+       UtilIntWillOverflow<size_t>(qwUBLen))
+      XC("Invalid chunk count!", "Chunks", qwChunks,
+         "Uncompressed", qwUBLen, "Size", mcSrc.MemSize());
+    const size_t stChunks = static_cast<size_t>(qwChunks),
+      stUBLen = static_cast<size_t>(qwUBLen);
+    // Find the position of every frame so they can be decoded at once
+    vector<size_t> vstFrames;
+    vstFrames.reserve(stChunks);
+    size_t stPos = ENCHDR_SIZE;
+    for(size_t stChunk = 0; stChunk < stChunks; ++stChunk)
+    { if(mcSrc.MemSize() - stPos < ENCFRM_SIZE)
+        XC("Frame header truncated!", "Chunk", stChunk, "Position", stPos);
+      vstFrames.push_back(stPos);
+      const size_t stBlock =
+        mcSrc.ReadIntLE<uint32_t>(stPos + ENCFRM_POS_SIZE);
+      if(mcSrc.MemSize() - stPos - ENCFRM_SIZE < stBlock)
+        XC("Frame truncated!", "Chunk", stChunk, "Position", stPos,
+           "Size", stBlock);
+      stPos += ENCFRM_SIZE + stBlock;
+    } // Make sure there is nothing else
+    if(stPos != mcSrc.MemSize())
+      XC("Invalid data length!", "Expect", stPos, "Actual", mcSrc.MemSize());
+    // Allocate the output and decode and verify every chunk into it
+    MemResize(stUBLen);
+    JobForEach("decode", stChunks, [this, &mcSrc, &vstFrames, stChunkSize,
+      stUBLen](const size_t stChunk)
+    { // Get the version 1 block of this chunk. Don't allow nested chunks.
+      const size_t stFrame = vstFrames[stChunk], stBlock =
+        mcSrc.ReadIntLE<uint32_t>(stFrame + ENCFRM_POS_SIZE);
+      const MemConst mcBlock{ stBlock,
+        mcSrc.MemRead(stFrame + ENCFRM_SIZE, stBlock) };
+      if(stBlock < ENCHDR_SIZE ||
+         mcBlock.ReadIntLE<uint32_t>(ENCHDR_POS_VERSION) != ENCHDR_VERSION)
+        XC("Invalid frame!", "Size", stBlock);
+      // Decode it and verify the length and checksum
+      const CoDecoder cdChunk{ mcBlock, 0 };
+      const size_t stPosOut = stChunk * stChunkSize,
+        stExpect = UtilMinimum(stChunkSize, stUBLen - stPosOut);
+      if(cdChunk.MemSize() != stExpect)
+        XC("Frame length mismatch!",
+           "Expect", stExpect, "Actual", cdChunk.MemSize());
+      const uint32_t ulCRCExpect =
+        mcSrc.ReadIntLE<uint32_t>(stFrame + ENCFRM_POS_CRC),
+          ulCRCActual = CodecGetCRC(cdChunk);
+      if(ulCRCActual != ulCRCExpect)
+        XC("Frame checksum mismatch!",
+           "Expect", ulCRCExpect, "Actual", ulCRCActual);
+      // Chunks never overlap so they can all be written at once
+      MemWriteBlock(stPosOut, cdChunk);
+    });
+  }
   /* --------------------------------------------------------------- */ public:
   explicit CoDecoder(const MemConst &mcSrc, const size_t)
   { // Should have at least enough bytes for header
@@ -465,7 +574,9 @@ class CoDecoder :                      // Magic decoder derivative class
     switch(const unsigned int uiVersionActual =
       mcSrc.ReadIntLE<uint32_t>(ENCHDR_POS_VERSION))
     { // Version 1
-      case 1: DecodeV1(mcSrc); break;
+      case ENCHDR_VERSION: DecodeV1(mcSrc); break;
+      // Version 2 (chunked)
+      case ENCHDR_VERSION_STREAM: DecodeV2(mcSrc); break;
       // Unknown version
       default: XC("Invalid version!", "Version", uiVersionActual);
     }
@@ -476,9 +587,22 @@ template<class EncPlugin>class CoEncoder :
   /* -- Base classes ------------------------------------------------------- */
   public Memory,                       // Allocated memory block object
   public EncPlugin                     // Plugin object
-{ /* -- Initialises the header of the block ----------------------- */ private:
+{ /* -- Lengths in the header are 32-bit ---------------------- */ private:
+  static const MemConst &CheckSize(const MemConst &mcSrc)
+  { // Return the data if it fits else tell the caller to use chunks
+    if(UtilIntWillOverflow<uint32_t>(mcSrc.MemSize()))
+      XC("Data too big for a single block so encode it in chunks!",
+         "Size", mcSrc.MemSize(), "Maximum", numeric_limits<uint32_t>::max());
+    return mcSrc;
+  }
+  /* -- Initialises the header of the block -------------------------------- */
   void InitHeader(void)
-  { // Resize memory to fit actual output size
+  { // The encoded data can be bigger than the input so check it too
+    if(UtilIntWillOverflow<uint32_t>(this->GetCompressed() +
+         this->GetExtra()))
+      XC("Encoded data too big for a single block!",
+         "Compressed", this->GetCompressed(), "Extra", this->GetExtra());
+    // Resize memory to fit actual output size
     MemResize(ENCHDR_SIZE + this->GetCompressed() + this->GetExtra());
     // Set properties
     MemWriteIntLE<uint32_t>(ENCHDR_POS_MAGIC,
@@ -497,13 +621,13 @@ template<class EncPlugin>class CoEncoder :
   /* -- Constructor that doesn't initialise memory block size ------ */ public:
   CoEncoder(const MemConst &mcSrc, const size_t stLevel) :
     /* -- Initialisers ----------------------------------------------------- */
-    EncPlugin{ mcSrc, *this, stLevel }
+    EncPlugin{ CheckSize(mcSrc), *this, stLevel }
     /* -- Code ------------------------------------------------------------- */
     { InitHeader(); }
   /* -- Constructor that initialises memory block size --------------------- */
   CoEncoder(const MemConst &mcSrc, const size_t stInit, const size_t stLevel) :
     /* -- Initialisers ----------------------------------------------------- */
-    Memory{ ENCHDR_SIZE + mcSrc.MemSize() + stInit },
+    Memory{ ENCHDR_SIZE + CheckSize(mcSrc).MemSize() + stInit },
     EncPlugin{ mcSrc, *this, stLevel }
     /* -- Code ------------------------------------------------------------- */
     { InitHeader(); }
@@ -566,6 +690,64 @@ template<class EncoderType>class Block final : public EncoderType
   /* ----------------------------------------------------------------------- */
   DELETECOPYCTORS(Block)               // Omit copy constructor for safety
 };/* ----------------------------------------------------------------------- */
+/* == Chunked encoder class ================================================ **
+** ######################################################################### **
+** ## This only encodes the chunks in parallel. It still needs the whole  ## **
+** ## input and keeps every encoded chunk until they are copied into the  ## **
+** ## output, so it uses more memory than one block and does not stream.  ## **
+** ## Unlike one block it can hold more than 4GB because the total length ## **
+** ## in its header is 64-bit and each chunk fits in a 32-bit block.      ## **
+** ######################################################################### **
+** ------------------------------------------------------------------------- */
+template<class EncoderType>class CoStreamEncoder :
+  /* -- Base classes ------------------------------------------------------- */
+  public Memory                        // Allocated memory block object
+{ /* -- Encode in chunks on the job pool --------------------------- */ public:
+  CoStreamEncoder(const MemConst &mcSrc, const size_t stLevel)
+  { // Split the data into chunks and encode each one into a version 1 block
+    const size_t stChunks =
+      (mcSrc.MemSize() + ENCFRM_CHUNKSIZE - 1) / ENCFRM_CHUNKSIZE;
+    vector<Memory> vmFrames(stChunks);
+    vector<uint32_t> vulCRCs(stChunks);
+    JobForEach("encode", stChunks, [&mcSrc, &vmFrames, &vulCRCs,
+      stLevel](const size_t stChunk)
+    { const size_t stPos = stChunk * ENCFRM_CHUNKSIZE, stBytes =
+        UtilMinimum(static_cast<size_t>(ENCFRM_CHUNKSIZE),
+          mcSrc.MemSize() - stPos);
+      const MemConst mcChunk{ stBytes, mcSrc.MemRead(stPos, stBytes) };
+      vulCRCs[stChunk] = CodecGetCRC(mcChunk);
+      vmFrames[stChunk].MemSwap(Block<EncoderType>{ mcChunk, stLevel });
+    });
+    // Allocate memory for the header and every frame
+    size_t stTotal = ENCHDR_SIZE;
+    for(const Memory &mRef : vmFrames) stTotal += ENCFRM_SIZE + mRef.MemSize();
+    MemResize(stTotal);
+    // Write the header using the mode of the first chunk
+    MemWriteIntLE<uint32_t>(ENCHDR_POS_MAGIC,
+      static_cast<uint32_t>(ENCHDR_MAGIC));
+    MemWriteIntLE<uint32_t>(ENCHDR_POS_VERSION,
+      static_cast<uint32_t>(ENCHDR_VERSION_STREAM));
+    MemWriteIntLE<uint32_t>(ENCHDR_POS_FLAGS, vmFrames.empty() ?
+      static_cast<uint32_t>(ENCMODE_RAW) :
+      vmFrames.front().ReadIntLE<uint32_t>(ENCHDR_POS_FLAGS));
+    MemWriteIntLE<uint64_t>(ENCHDR_POS_UBLEN64,
+      static_cast<uint64_t>(mcSrc.MemSize()));
+    MemWriteIntLE<uint32_t>(ENCHDR_POS_CHUNKSIZE,
+      static_cast<uint32_t>(ENCFRM_CHUNKSIZE));
+    // Write every frame
+    size_t stPos = ENCHDR_SIZE;
+    for(size_t stChunk = 0; stChunk < stChunks; ++stChunk)
+    { const Memory &mRef = vmFrames[stChunk];
+      MemWriteIntLE<uint32_t>(stPos + ENCFRM_POS_SIZE,
+        static_cast<uint32_t>(mRef.MemSize()));
+      MemWriteIntLE<uint32_t>(stPos + ENCFRM_POS_CRC, vulCRCs[stChunk]);
+      MemWriteBlock(stPos + ENCFRM_SIZE, mRef);
+      stPos += ENCFRM_SIZE + mRef.MemSize();
+    }
+  }
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(CoStreamEncoder)     // Omit copy constructor for safety
+};/* ----------------------------------------------------------------------- */
 }                                      // End of public module namespace
 /* ------------------------------------------------------------------------- */
 }                                      // End of private module namespace
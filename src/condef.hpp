@@ -8,6 +8,8 @@
 #pragma once                           // Only one incursion allowed
 /* ------------------------------------------------------------------------- */
 namespace IConDef {                    // Start of private module namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace ILines::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Colour palette ------------------------------------------------------- */
@@ -33,16 +35,13 @@ const unsigned int uiNDXtoRGB[COLOUR_MAX] =
   0x01ffff00 /* 14=COLOUR_YELLOW  */, 0x01ffffff /* 15=COLOUR_WHITE    */
 };/* ----------------------------------------------------------------------- */
 /* -- Console stuff, no where else to put it really ------------------------ */
-struct ConLine                         // Console line data structure
+struct ConLineData                     // Console line data structure
 { /* ----------------------------------------------------------------------- */
-  const double     dTime;              // Line time
-  const Colour     cColour;            // Line colour index
-  const string     strLine;            // Line data
+  double           dTime;              // Line time
+  Colour           cColour;            // Line colour index
 };/* ----------------------------------------------------------------------- */
-typedef list<ConLine>                    ConLines;           // Con lines data
-typedef ConLines::const_iterator         ConLinesConstIt;    // " fwd const it
-typedef ConLines::reverse_iterator       ConLinesRevIt;      // " reverse it
-typedef ConLines::const_reverse_iterator ConLinesConstRevIt; // " const
+typedef Lines<ConLineData>     ConLines; // Ring of console lines
+typedef LinesItem<ConLineData> ConLine;  // A console line read from the ring
 /* ------------------------------------------------------------------------- */
 }                                      // End of public module namespace
 /* ------------------------------------------------------------------------- */
@@ -71,10 +70,10 @@ enum ConCmdEnums : unsigned int
   CC_LGC,       CC_LOG,     CC_LOGCLR,   CC_LPAUSE,    CC_LRESET,  CC_LRESUME,
   CC_LSTACK,    CC_LVARS,   CC_MASKS,    CC_MEM,       CC_MLIST,   CC_MODS,
   CC_OBJS,      CC_OGLEXT,  CC_OGLFUNC,  CC_PALETTES,  CC_PCMFMTS, CC_PCMS,
-  CC_QUIT,      CC_RESTART, CC_SAMPLES,  CC_SHADERS,   CC_SHOT,    CC_SOCKETS,
-  CC_SOCKRESET, CC_SOURCES, CC_SQLCHECK, CC_SQLDEFRAG, CC_SQLEND,  CC_SQLEXEC,
-  CC_STOPALL,   CC_STREAMS, CC_SYSTEM,   CC_TEXTURES,  CC_THREADS, CC_TIME,
-  CC_VERSION,   CC_VIDEOS,  CC_VMLIST,   CC_VRESET,    CC_WRESET,
+  CC_PROFILE,   CC_QUIT,    CC_RESTART,  CC_SAMPLES,   CC_SHADERS, CC_SHOT,
+  CC_SOCKETS,   CC_SOCKRESET, CC_SOURCES, CC_SQLCHECK, CC_SQLDEFRAG, CC_SQLEND,
+  CC_SQLEXEC,   CC_STOPALL, CC_STREAMS,  CC_SYSTEM,    CC_TEXTURES, CC_THREADS,
+  CC_TIME,      CC_VERSION, CC_VIDEOS,   CC_VMLIST,    CC_VRESET,  CC_WRESET,
   /* ----------------------------------------------------------------------- */
   MAX_CONCMD                           // Maximum console commands
 };/* ======================================================================= */
@@ -254,18 +254,18 @@ static class ConGraphics final :       // Members initially private
         cConsole->GetConsoleBegin(), cCursor,
         cConsole->GetConsoleEnd()).c_str()));
     // For each line or until we clip the top of the screen, print the text
-    for(ConLinesConstRevIt clI{ cConsole->GetConBufPos() };
-                           clI != cConsole->GetConBufPosEnd() && fY > 0.0f;
-                         ++clI)
-    { // Get reference to console line data structure
-      const ConLine &clD = *clI;
+    for(uint64_t qwIndex = cConsole->GetConBufPos();
+                 qwIndex > cConsole->GetConBufPosEnd() && fY > 0.0f;
+               --qwIndex)
+    { // Get console line data structure
+      const ConLine clD{ cConsole->LinesGet(qwIndex - 1) };
       // Set text foreground colour with opaqueness already set above
       GetFontRef().FboItemSetQuadRGBInt(uiNDXtoRGB[clD.cColour]);
       // Draw the text and move upwards of the height that was used
       fY -= GetFontRef().PrintWU(fboC.ffcStage.GetCoLeft(), fY,
         fboC.ffcStage.GetCoRight(),
           GetFontRef().dfScale.DimGetWidth(), reinterpret_cast<const GLubyte*>
-            (clD.strLine.c_str()));
+            (clD.strvLine.data()));
     } // Finish and render
     fboC.FboFinishAndRender();
     // Make sure the main fbo is updated
@@ -203,6 +203,8 @@ cConsole->AddLineA(sTable.Finish(),
 /* ------------------------------------------------------------------------- */
 { "certs", 1, 1, CFL_NONE, [](const Args &){
 /* ------------------------------------------------------------------------- */
+// Certificates not needed yet must be loaded to be listed
+cSockets->CertsLoadAll();
 // Make a table to automatically format our data neatly
 Statistic sTable;
 sTable.Header("X").Header("FILE", false).Header("C", false)
@@ -424,11 +426,18 @@ cConsole->AddLineA(StrCPluraliseNum(cCVars->LoadFromDatabase(),
 /* ========================================================================= */
 { "cvnpk", 1, 1, CFL_NONE, [](const Args &){
 /* ------------------------------------------------------------------------- */
-// Create the private key and if succeeded? Show the result
+// Create the private key and if succeeded? Re-encode the protected
+// variables and write them now because their saved values can no longer be
+// decoded with the new key.
 if(cSql->CreatePrivateKey())
-  cConsole->AddLineF("New private key set and $ variables re-encoded!",
-    cCVars->MarkAllEncodedVarsAsCommit());
-// Else failed so show the error
+{ const size_t stMarked = cCVars->MarkAllEncodedVarsAsCommit(),
+               stSaved = cCVars->SaveNow();
+  if(stSaved == string::npos)
+    cConsole->AddLineF("New private key set but $ re-encoded variables "
+      "could not be saved!", stMarked);
+  else cConsole->AddLineF("New private key set, $ variables re-encoded and "
+    "$ saved!", stMarked, stSaved);
+} // Else failed so show the error
 else cConsole->AddLine("Failed to create new private key!");
 /* ------------------------------------------------------------------------- */
 } },                                   // End of 'cvnpk' function
@@ -701,11 +710,16 @@ const function ShowFontInfo{ [](Statistic &sTable, const Font &fRef)
             { fRef.FlagIsSet(FF_STROKETYPE2),  'A' }
           }))
           .DataN(fRef.GetCharScale(), 6).DataN(fRef.GetTexOccupancy(), 6)
-          .DataN(fRef.GetCharCount()).Data(fRef.IdentGet()); }
+          .DataN(fRef.GetCharCount()).DataN(fRef.GetGlyphsSync())
+          .DataN(fRef.GetGlyphsAsync()).DataN(fRef.GetGlyphsPending())
+          .Data(StrToBytes(fRef.GetUploadLast()))
+          .Data(StrToBytes(fRef.GetUploadTotal())).Data(fRef.IdentGet()); }
 }; // Text table class to help us write neat output
 Statistic sTable;
 sTable.Header("ID").Header("R").Header("FLAG").Header("SCALE")
-      .Header("TEXOCPCY").Header("CC").Header("NAME", false)
+      .Header("TEXOCPCY").Header("CC").Header("SYNC").Header("ASYNC")
+      .Header("PEND").Header("UPLAST").Header("UPTOTAL")
+      .Header("NAME", false)
       .Reserve(1 + cFonts->size());
 // Include console font
 ShowFontInfo(sTable, cConGraphics->GetFontRef());
@@ -843,7 +857,8 @@ for(const Image*const iPtr : *cImages)
     { iRef.IsActiveBGROrder(),   'w' }, { iRef.IsConvertBinary(),    'N' },
     { iRef.IsActiveBinary(),     'n' }, { iRef.IsConvertGPUCompat(), 'O' },
     { iRef.IsActiveGPUCompat(),  'o' }, { iRef.IsConvertRGBOrder(),  'B' },
-    { iRef.IsActiveRGBOrder(),   'b' }, { iRef.IsCompressed(),       'C' },
+    { iRef.IsActiveRGBOrder(),   'b' }, { iRef.IsConvertDXT(),       'T' },
+    { iRef.IsActiveDXT(),        't' }, { iRef.IsCompressed(),       'C' },
     { iRef.IsPalette(),          'L' }, { iRef.IsMipmaps(),          'M' },
     { iRef.IsReversed(),         'R' }
   })).DataN(iRef.DimGetWidth()).DataN(iRef.DimGetHeight())
@@ -1106,11 +1121,15 @@ const LogLevelColours llcLookup{
 // Get reference to log class and lock it so it's not changed
 const LockGuard lgLogSync{ cLog->GetMutex() };
 // For each log line. Add the line to console buffer
-for(const LogLine &llRef : *cLog)
+for(uint64_t qwIndex = cLog->LinesBegin(); qwIndex < cLog->LinesEnd();
+  ++qwIndex)
+{ const LogLine llRef{ cLog->LinesGet(qwIndex) };
   cConsole->AddLineF(llcLookup[llRef.lhlLevel], "[$$$] $",
-    fixed, setprecision(6), llRef.dTime, llRef.strLine);
+    fixed, setprecision(6), llRef.dTime, llRef.strvLine); }
 // Number of items in buffer
-cConsole->AddLineA(StrCPluraliseNum(cLog->size(), "line.", "lines."));
+cConsole->AddLineA(StrCPluraliseNum(cLog->LinesSize(), "line", "lines"),
+  cLog->IsAsync() ? StrFormat(" ($ queued in $ batches, largest $).",
+    cLog->GetQueued(), cLog->GetBatches(), cLog->GetLargest()) : ".");
 /* ------------------------------------------------------------------------- */
 } },                                   // End of 'log' function
 /* ========================================================================= */
@@ -1122,9 +1141,9 @@ cConsole->AddLineA(StrCPluraliseNum(cLog->size(), "line.", "lines."));
 // Lock access to the log
 const LockGuard lgLogSync{ cLog->GetMutex() };
 // Ignore if not empty
-if(cLog->empty()) return cConsole->AddLine("No log lines to clear!");
+if(cLog->LinesEmpty()) return cConsole->AddLine("No log lines to clear!");
 // Get log lines count
-const size_t stCount = cLog->size();
+const size_t stCount = cLog->LinesSize();
 // Clear the log
 cLog->Clear();
 // Say we cleared it
@@ -1460,6 +1479,50 @@ cConsole->AddLineA(sTable.Finish(),
 /* ------------------------------------------------------------------------- */
 } },                                   // End of 'pcms' function
 /* ========================================================================= */
+// ! profile
+// ? Shows the time spent in each profiled zone from the most recent events.
+// ? Use 'on' or 'off' to enable or disable profiling, 'clear' to forget
+// ? the events recorded so far and 'save' followed by a filename to write
+// ? them as a Chrome trace.
+/* ========================================================================= */
+{ "profile", 1, 3, CFL_NONE, [](const Args &aArgs){
+/* ------------------------------------------------------------------------- */
+// Have an action?
+if(aArgs.size() > 1)
+{ // Get action and perform it
+  const string &strAction = aArgs[1];
+  if(strAction == "on" || strAction == "off")
+  { cProfile->ProfileSetEnabled(strAction == "on");
+    return cConsole->AddLineA("Profiling ",
+      cProfile->ProfileIsEnabled() ? "enabled." : "disabled."); }
+  if(strAction == "clear")
+    { cProfile->ProfileClear(); return cConsole->AddLine("Profile cleared."); }
+  if(strAction == "save" && aArgs.size() == 3)
+    return cConsole->AddLineA("Saved ",
+      StrCPluraliseNum(cProfile->ProfileExport(aArgs[2]),
+        "event", "events"), " to '", aArgs[2], "'.");
+  return cConsole->AddLine("Expected 'on', 'off', 'clear' or 'save <file>'!");
+} // Text table class to help us write neat output
+Statistic sTable;
+sTable.Header("ZONE", false).Header("COUNT").Header("AVERAGE")
+      .Header("MINIMUM").Header("MAXIMUM").Header("TOTAL").Reserve(PZ_MAX);
+// For each zone
+const array<ProfileStats, PZ_MAX> apsStats{ cProfile->ProfileGetStats() };
+for(size_t stZone = 0; stZone < PZ_MAX; ++stZone)
+{ // Get zone statistics and write them to the table
+  const ProfileStats &psRef = apsStats[stZone];
+  sTable.Data(Profile::ProfileGetZoneName(stZone)).DataN(psRef.stCount)
+        .Data(StrShortFromDuration(psRef.stCount ?
+           psRef.dTotal / static_cast<double>(psRef.stCount) : 0))
+        .Data(StrShortFromDuration(psRef.dMinimum))
+        .Data(StrShortFromDuration(psRef.dMaximum))
+        .Data(StrShortFromDuration(psRef.dTotal));
+} // Show table and whether profiling is enabled
+cConsole->AddLineA(sTable.Finish(), "Profiling is ",
+  cProfile->ProfileIsEnabled() ? "enabled." : "disabled.");
+/* ------------------------------------------------------------------------- */
+} },                                   // End of 'profile' function
+/* ========================================================================= */
 // ! quit
 // ? No explanation yet.
 /* ========================================================================= */
@@ -17,10 +17,10 @@ using namespace IConLib::P;            using namespace ICVar::P;
 using namespace ICVarDef::P;           using namespace ICVarLib::P;
 using namespace IError::P;             using namespace IEvtMain::P;
 using namespace IFlags;                using namespace IGlFW::P;
-using namespace ILog::P;               using namespace IStd::P;
-using namespace IString::P;            using namespace ISocket::P;
-using namespace ISystem::P;            using namespace ISysUtil::P;
-using namespace ITimer::P;             using namespace IToken::P;
+using namespace ILines::P;             using namespace ILog::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISocket::P;            using namespace ISystem::P;
+using namespace ISysUtil::P;           using namespace ITimer::P;
 using namespace IUtf;                  using namespace IUtil::P;
 using namespace Lib::OS::GlFW;
 /* ------------------------------------------------------------------------- */
@@ -61,16 +61,12 @@ MAPPACK_BUILD(Cmd, const string, const ConLib) // Map of commands type
 /* ========================================================================= */
 static class Console final :           // Members initially private
   /* -- Base classes ------------------------------------------------------- */
-  public ConLines,                     // Console text lines list
-  private ConLinesConstIt,             // Text lines forward iterator
-  private ConLinesConstRevIt,          // Text lines reverse iterator
+  public ConLines,                     // Console text lines ring
   private IHelper,                     // Initialisation helper
   public ConsoleFlags                  // Console flags
-{ /* -- Private typedefs --------------------------------------------------- */
-  typedef queue<ConLine> ConLineQueue; // Pending console lines
-  /* -- Input -------------------------------------------------------------- */
-  ConLineQueue     clqOutput;          // Console lines pending
-  ConLinesConstRevIt clriPosition;     // Console output position
+{ /* -- Input -------------------------------------------------------------- */
+  ConLines         clPending;          // Console lines pending
+  uint64_t         qwPosition;         // Line after bottom line shown
   StrList          slHistory;          // Console history
   StrListConstRevIt slriInputPosition; // History position
   size_t           stInputMaximum,     // Maximum no. of input lines
@@ -99,13 +95,23 @@ static class Console final :           // Members initially private
   /* -- Do clear console, clear history and reset position ----------------- */
   void DoFlush(void)
   { // Do clear the console output lines
-    clear();
+    LinesClear();
     // Reset position
-    clriPosition = rbegin();
+    qwPosition = LinesEnd();
     // Clear queued messages
-    ConLineQueue clqOutputNew;
-    clqOutput.swap(clqOutputNew);
-  }
+    clPending.LinesClear();
+  }
+  /* -- Move the oldest pending line to the output ------------------------- */
+  void MovePendingLine(void)
+  { // Copy the line which evicts the oldest output lines to fit
+    const ConLine clLine{ clPending.LinesFront() };
+    LinesPush(clLine, clLine.strvLine);
+    // Remove the pending line
+    clPending.LinesPop();
+  }
+  /* -- Make sure the position did not point to an evicted line ------------ */
+  void ClampPosition(void)
+    { if(qwPosition < LinesBegin()) qwPosition = LinesBegin(); }
   /* -- Reserve history items ---------------------------------------------- */
   void ReserveHistoryLines(const size_t stLines)
   { // Calculate total lines when added
@@ -129,7 +135,7 @@ static class Console final :           // Members initially private
       // Done
       break;
     } // ...Until we have cleared enough lines
-    while(size() > stRemove);
+    while(slHistory.size() > stRemove);
   }
   /* -- Clear console line ------------------------------------------------- */
   void DoClearInput(void) { strConsoleBegin.clear(); strConsoleEnd.clear(); }
@@ -309,15 +315,15 @@ static class Console final :           // Members initially private
   /* -- Scroll to the specified text in console backlog -------------------- */
   bool FindText(const string &strWhat)
   { // Return if we find the specified text where the viewer is viewing
-    if(empty() || clriPosition == crend()) return false;
-    // Find string in list and return if not found
-    const ConLinesConstRevIt clcriIt{
-      StdFindIf(seq, next(clriPosition, 1), crend(),
-        [&strWhat](const ConLine &clLine)->bool
-          { return clLine.strLine.find(strWhat) != string::npos; }) };
-    if(clcriIt == crend()) return false;
+    if(LinesEmpty() || qwPosition == LinesBegin()) return false;
+    // Search the lines above the bottom line shown and return if not found
+    uint64_t qwIndex = qwPosition - 1;
+    while(qwIndex > LinesBegin() &&
+      LinesGet(qwIndex - 1).strvLine.find(strWhat) == string::npos)
+        --qwIndex;
+    if(qwIndex == LinesBegin()) return false;
     // Set position where we found it
-    clriPosition = clcriIt;
+    qwPosition = qwIndex;
     // Redraw the console
     SetRedraw();
     // Block the execute function from updating the output position
@@ -326,34 +332,30 @@ static class Console final :           // Members initially private
     return true;
   }
   /* -- Move log by a certain amount --------------------------------------- */
-  void MoveLogPage(const ConLinesConstRevIt &clriBegin,
-    const ConLinesConstRevIt &clriEnd, const ConLinesConstRevIt &clriReset,
-    const ssize_t sstAmount, const ssize_t sstMove)
+  void MoveLogPage(const uint64_t qwReset, const ssize_t sstMove)
   { // Ignore if already at reset position
-    if(clriPosition == clriReset) return;
+    if(qwPosition == qwReset) return;
     // Redrawing
     SetRedraw();
-    // If we can advance that far? distance should always return positive
-    // value since we're moving forwards
-    if(distance(clriBegin, clriEnd) < sstAmount) clriPosition = clriReset;
-    // Can safely advance forwards
-    else advance(clriPosition, sstMove);
+    // If we can't move a whole page then stop at the reset position
+    if((qwPosition > qwReset ? qwPosition - qwReset : qwReset - qwPosition) <
+      static_cast<uint64_t>(sstPageLines)) qwPosition = qwReset;
+    // Can safely move a whole page
+    else qwPosition = static_cast<uint64_t>(
+      static_cast<int64_t>(qwPosition) + sstMove);
   }
   /* -- Functions to move the active console line -------------------------- */
   void MoveLogHome(void)
-    { if(clriPosition != crend()){ SetRedraw(); clriPosition = crend(); } }
+    { if(qwPosition != LinesBegin())
+        { SetRedraw(); qwPosition = LinesBegin(); } }
   void MoveLogEnd(void)
-    { if(clriPosition != crbegin()){ SetRedraw(); clriPosition = crbegin(); }}
+    { if(qwPosition != LinesEnd()) { SetRedraw(); qwPosition = LinesEnd(); } }
   void MoveLogUp(void)
-    { if(clriPosition != crend()){ SetRedraw(); ++clriPosition; }}
+    { if(qwPosition != LinesBegin()) { SetRedraw(); --qwPosition; } }
   void MoveLogDown(void)
-    { if(clriPosition != crbegin()){ SetRedraw(); --clriPosition; }}
-  void MoveLogPageUp(void)
-    { MoveLogPage(clriPosition, crend(), crend(),
-        sstPageLines, sstPageLines); }
-  void MoveLogPageDown(void)
-    { MoveLogPage(crbegin(), clriPosition, crbegin(),
-        sstPageLines, sstPageLinesNeg); }
+    { if(qwPosition != LinesEnd()) { SetRedraw(); ++qwPosition; } }
+  void MoveLogPageUp(void) { MoveLogPage(LinesBegin(), sstPageLinesNeg); }
+  void MoveLogPageDown(void) { MoveLogPage(LinesEnd(), sstPageLines); }
   /* -- OnLastItem event ---------------------- Selects last console item -- */
   void HistoryMoveBack(void)
   { // Ignore if no history lines or there is text after the cursor
@@ -467,16 +469,12 @@ static class Console final :           // Members initially private
     const string &strVarOrCmd = aList.front();
     if(strVarOrCmd.empty()) return;
     // Get if we're already at the bottom of the log
-    const bool bAtBottom = clriPosition == rbegin();
+    const bool bAtBottom = qwPosition == LinesEnd();
     // Make sure that all lines are processed immediately
-    while(!clqOutput.empty())
-    { // Move item into main console render buffer
-      emplace_back(StdMove(clqOutput.front()));
-      // remove the old item
-      clqOutput.pop();
-    } // Dump whole input to log
-    push_back({ cLog->CCDeltaToDouble(),
-      COLOUR_YELLOW, StrAppend('>', strCmd) });
+    while(!clPending.LinesEmpty()) MovePendingLine();
+    // Dump whole input to log
+    LinesPush({ cLog->CCDeltaToDouble(), COLOUR_YELLOW }, ">", strCmd);
+    ClampPosition();
     // Add command to input history
     AddHistory(strCmd);
     // Find console callback function and function not found?
@@ -580,14 +578,14 @@ static class Console final :           // Members initially private
         // hidden the console
         DoSetVisible(true);
         // Force scroll to bottom
-        clriPosition = rbegin();
+        qwPosition = LinesEnd();
       } // Carry on executing as normal
     } // Remove update block flag if set
     if(FlagIsSet(CF_BLOCKOUTPUTUPDATE)) FlagClear(CF_BLOCKOUTPUTUPDATE);
     // Were we already at the bottom or should we auto-scroll?
     else if(bAtBottom || FlagIsSet(CF_AUTOSCROLL))
     { // Autoscroll to bottom enabled? Scroll to bottom
-      clriPosition = rbegin();
+      qwPosition = LinesEnd();
       // Set console to redraw for input text at least
       SetRedraw();
     }
@@ -595,65 +593,32 @@ static class Console final :           // Members initially private
   /* -- Process queued console lines --------------------------------------- */
   void MoveQueuedLines(void)
   { // If there are console lines in the queue?
-    if(clqOutput.empty()) return;
+    if(clPending.LinesEmpty()) return;
     // Stagger the queue to the output buffer but enough so it completes fast
     // and compensates for a growing queue. At minimum the number of elements
     // or the most of half of the number of elements or five.
-    size_t stLines =
-      UtilMinimum(clqOutput.size(), UtilMaximum(5, clqOutput.size()/4));
-    // Calculate total lines
-    const size_t stTotal = size() + stLines;
-    // If writing this many lines wouldn't fit in the log, then the log needs
-    // pruning.
-    if(stTotal > GetOutputMaximum())
-    { // If not too many lines would be written?
-      if(stLines < GetOutputMaximum())
-      { // Iterator to find
-        const ConLinesConstIt clciIt{ clriPosition.base() };
-        // Lines to prune to
-        const size_t stRemove = size() - stLines;
-        // Repeat...
-        do
-        { // If this item is not selected in the output history? Erase and next
-          if(cbegin() != clciIt) { pop_front(); continue; }
-          // Get items remaining to remove
-          clriPosition = ConLinesConstRevIt{ erase(cbegin(),
-            next(cbegin(), static_cast<ssize_t>(size() - stRemove))) };
-          // Done
-          break;
-        } // ...Until we have cleared enough lines
-        while(size() > stRemove);
-      } // Too many lines would be written
-      else
-      { // Clear all lines
-        clear();
-        // Reset scroll position
-        clriPosition = rbegin();
-      }
-    } // Get if we're at the bottom of the log
-    const bool bAtBottom = clriPosition == rbegin();
-    // Repeat...
-    do
-    { // Move item into main console render buffer
-      emplace_back(StdMove(clqOutput.front()));
-      // remove the old item
-      clqOutput.pop();
-    } // ...until we've moved enough lines
-    while(--stLines);
+    size_t stLines = UtilMinimum(clPending.LinesSize(),
+      UtilMaximum(5, clPending.LinesSize()/4));
+    // Get if we're at the bottom of the log
+    const bool bAtBottom = qwPosition == LinesEnd();
+    // Move lines into the output which evicts the oldest lines to fit
+    do MovePendingLine(); while(--stLines);
     // Auto scroll enabled or were already at the bottom of log? Set the log
     // to the bottom.
-    if(FlagIsSet(CF_AUTOSCROLL) || bAtBottom) clriPosition = rbegin();
+    if(FlagIsSet(CF_AUTOSCROLL) || bAtBottom) qwPosition = LinesEnd();
+    // Else make sure we're not pointing at evicted lines
+    else ClampPosition();
     // Redraw the buffer, it changed
     SetRedraw();
   }
   /* -- SetRedraw -------------------------------------------------- */ public:
   void SetRedrawIfEnabled(void) { if(IsVisible()) SetRedraw(); }
   /* -- Get console lines -------------------------------------------------- */
-  size_t GetOutputCount(void) { return size(); }
+  size_t GetOutputCount(void) { return LinesSize(); }
   size_t GetInputCount(void) { return slHistory.size(); }
   /* -- Get buffer position ------------------------------------------------ */
-  const ConLinesConstRevIt GetConBufPos(void) const { return clriPosition; }
-  const ConLinesConstRevIt GetConBufPosEnd(void) { return rend(); }
+  uint64_t GetConBufPos(void) const { return qwPosition; }
+  uint64_t GetConBufPosEnd(void) const { return LinesBegin(); }
   /* -- Set console input status bar (left and right) ---------------------- */
   void SetStatusLeft(const string &strValue) { strStatusLeft = strValue; }
   void SetStatusRight(const string &strValue) { strStatusRight = strValue; }
@@ -697,11 +662,12 @@ static class Console final :           // Members initially private
       cSystem->UpdateMemoryUsageData();
       cSystem->UpdateCPUUsage();
       // Redraw title
-      cSystem->RedrawTitleBar(StrFormat("CPU:$$$%  FPS:$$  MEM:$  NET:$  UP:$",
-        fixed, setprecision(1), cSystem->CPUUsage(), setprecision(0),
-        cTimer->TimerGetFPS(), StrToBytes(cSystem->RAMProcUse(), 0),
-        cSockets->stConnected.load(),
-        StrShortFromDuration(cLog->CCDeltaToDouble(), 0)),
+      cSystem->RedrawTitleBar(
+        StrFormatTL("CPU:$$$%  FPS:$$  MEM:$  NET:$  UP:$",
+          fixed, setprecision(1), cSystem->CPUUsage(), setprecision(0),
+          cTimer->TimerGetFPS(), StrToBytes(cSystem->RAMProcUse(), 0),
+          cSockets->stConnected.load(),
+          StrShortFromDuration(cLog->CCDeltaToDouble(), 0)),
         cmSys.FormatTime(strvTimeFormat.data()));
       // Not redrawing?
       if(GetRedrawFlags().FlagIsClear(RD_TEXT))
@@ -716,7 +682,7 @@ static class Console final :           // Members initially private
     // Reset redraw flag as we're about to draw
     rfFlags.FlagClear(RD_TEXT);
     // Redraw the main text buffer
-    cSystem->RedrawBuffer(*this, clriPosition);
+    cSystem->RedrawBuffer(*this, qwPosition);
     // If no text is inputted? Redraw customised status bar
     if(InputEmpty()) cSystem->RedrawStatusBar(strStatusLeft, strStatusRight);
     // Text inputted so redraw input bar
@@ -727,8 +693,9 @@ static class Console final :           // Members initially private
   /* -- Copy all console lines to log -------------------------------------- */
   size_t ToLog(void)
   { // Write all console lines to log and return lines in buffer
-    for(const ConLine &clItem : *this) cLog->LogNLCDebugSafe(clItem.strLine);
-    return size();
+    for(uint64_t qwIndex = LinesBegin(); qwIndex < LinesEnd(); ++qwIndex)
+      cLog->LogNLCDebugSafe(string{ LinesGet(qwIndex).strvLine });
+    return LinesSize();
   }
   /* -- Command exists? ---------------------------------------------------- */
   bool CommandIsRegistered(const string &strName) const
@@ -745,31 +712,29 @@ static class Console final :           // Members initially private
   void UnregisterCommand(const CmdMapIt cmiIt) { cmMap.erase(cmiIt); }
   /* -- Add line as string with specified text colour ---------------------- */
   void AddLine(const Colour cColour, const string &strText)
-  { // Tokenise lines into a list limited by the maximum number of lines.
-    if(const TokenList tlLines{ strText, cCommon->Lf(), GetOutputMaximum() })
-    { // Add all the lines to the output queue
-      const double dTime = cLog->CCDeltaToDouble();
-      for(const string &strLine : tlLines)
-      { // Move the line across if it is long enough
-        if(strLine.length() <= stMaxOutputLine)
-          clqOutput.push({ dTime, cColour, StdMove(strLine) });
-        // Push a truncated line
-        else clqOutput.push({ dTime, cColour,
-          strLine.substr(0, stMaxOutputLineE) + cCommon->Ellipsis() });
-      }
-    }
+  { // Add all the lines to the output queue which only keeps the newest
+    const double dTime = cLog->CCDeltaToDouble();
+    LinesSplit(strText,
+      [this, dTime, cColour](const string_view &strvLine)
+    { // Copy the line across if it is short enough
+      if(strvLine.length() <= stMaxOutputLine)
+        clPending.LinesPush({ dTime, cColour }, strvLine);
+      // Push a truncated line
+      else clPending.LinesPush({ dTime, cColour },
+        strvLine.substr(0, stMaxOutputLineE), cCommon->Ellipsis());
+    });
   }
   /* -- Add line as string with default text colour ------------------- */
   void AddLine(const string &strText) { AddLine(cTextColour, strText); }
   /* -- Formatted console output ------------------------------------------- */
   template<typename ...VarArgs>
     void AddLineF(const char*const cpFormat, const VarArgs &...vaArgs)
-      { AddLine(StrFormat(cpFormat, vaArgs...)); }
+      { AddLine(StrFormatVarTL(cpFormat, vaArgs...)); }
   /* -- Formatted console output with colour ------------------------------- */
   template<typename ...VarArgs>
     void AddLineF(const Colour cColour, const char*const cpFormat,
       const VarArgs &...vaArgs)
-        { AddLine(cColour, StrFormat(cpFormat, vaArgs...)); }
+        { AddLine(cColour, StrFormatVarTL(cpFormat, vaArgs...)); }
   /* -- Formatted console output using StrAppend() ------------------------- */
   template<typename ...VarArgs>
     void AddLineAC(const Colour cColour, const VarArgs &...vaArgs)
@@ -820,7 +785,7 @@ static class Console final :           // Members initially private
     cLog->LogDebugExSafe("Console initialising with $ built-in commands...",
       ccslInt.size());
     // Reset cursor position
-    clriPosition = rbegin();
+    qwPosition = LinesEnd();
     // Using text mode?
     if(cSystem->IsTextMode())
     { // Add flag for it
@@ -877,9 +842,11 @@ static class Console final :           // Members initially private
   /* -- Constructor -------------------------------------------------------- */
   explicit Console(const ConCmdStaticList &ccslDef) :
     /* -- Initialisers ----------------------------------------------------- */
+    ConLines{ 1000 },                  // Default output lines ring
     IHelper{ __FUNCTION__ },           // Init helper function name
     Flags{ CF_NONE },                  // No initial flags
-    clriPosition{ rbegin() },          // Input position at beginning
+    clPending{ 1000 },                 // Default pending lines ring
+    qwPosition(0),                     // Output position at bottom
     slriInputPosition{                 // Init log position...
       slHistory.crend() },             // ...at beginning
     stInputMaximum(0),                 // No maximum input characters
@@ -956,12 +923,12 @@ static class Console final :           // Members initially private
   /* -- Set console buffers ------------------------------------------------ */
   CVarReturn SetConsoleOutputLines(const size_t stLines)
   { // Ignore if same value or invalid value or vector can't accept value
-    if(stLines < 1 || stLines > 1000000 || stLines > max_size()) return DENY;
-    // New value under previous amount? Remove excess lines
-    if(stLines < size())
-      clriPosition = ConLinesConstRevIt{ erase(cbegin(), next(cbegin(),
-        static_cast<ssize_t>(size() - stLines))) };
-    // Set new position
+    if(stLines < 1 || stLines > 1000000) return DENY;
+    // Resize the rings which keeps the newest lines and fix the position
+    LinesResize(stLines);
+    clPending.LinesResize(stLines);
+    ClampPosition();
+    // Set new maximum
     stOutputMaximum = stLines;
     // Completed successfully
     return ACCEPT;
@@ -11,7 +11,8 @@
 namespace ICore {                      // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IArchive::P;           using namespace IAsset::P;
-using namespace IAudio::P;             using namespace ICmdLine::P;
+using namespace IAudio::P;             using namespace IBench::P;
+using namespace IClock::P;             using namespace ICmdLine::P;
 using namespace IConDef::P;            using namespace IConsole::P;
 using namespace ICVar::P;              using namespace ICVarDef::P;
 using namespace ICVarLib::P;           using namespace IDir::P;
@@ -26,13 +27,14 @@ using namespace ILog::P;               using namespace ILua::P;
 using namespace ILuaCode::P;           using namespace ILuaUtil::P;
 using namespace ILuaVariable::P;       using namespace IOgl::P;
 using namespace IPalette::P;           using namespace IPcm::P;
-using namespace IPSplit::P;            using namespace IShaders::P;
-using namespace ISql::P;               using namespace ISource::P;
-using namespace IStd::P;               using namespace IStream::P;
-using namespace IString::P;            using namespace ISystem::P;
-using namespace ISysUtil::P;           using namespace ITexture::P;
-using namespace IThread::P;            using namespace ITimer::P;
-using namespace IToken::P;             using namespace IVideo::P;
+using namespace IProfile::P;           using namespace IPSplit::P;
+using namespace IShaders::P;           using namespace ISql::P;
+using namespace ISource::P;            using namespace IStd::P;
+using namespace IStream::P;            using namespace IString::P;
+using namespace ISystem::P;            using namespace ISysUtil::P;
+using namespace ITexture::P;           using namespace IThread::P;
+using namespace ITimer::P;             using namespace IToken::P;
+using namespace IVideo::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Prototype ------------------------------------------------------------ */
@@ -54,6 +56,7 @@ class Core final :                     // Members initially private
   CoreErrorFlags   cefMode;            // Lua error mode behaviour
   unsigned int     uiErrorCount,       // Number of errors occured
                    uiErrorLimit;       // Number of errors allowed
+  Bench            bcBench;            // Benchmark results
   /* -- Fired when lua needs to be paused (EMC_LUA_PAUSE) ------------------ */
   void OnLuaPause(const EvtMainEvent &emeEvent)
   { // Pause execution and if paused for the first time?
@@ -159,37 +162,68 @@ class Core final :                     // Members initially private
   /* -- Graphical core main thread tick ------------------------------------ */
   void CoreMainThreadTick(void)
   { // Process window event manager commands from other threads
-    cEvtWin->ManageUnsafe();
+    { const ProfileScope psEvents{ PZ_EVENTS };
+      cEvtWin->ManageUnsafe(); }
     // Is it time to execute a game tick?
     if(cTimer->TimerShouldTick())
     { // Render the console fbo (if update requested)
-      cConGraphics->Render();
+      { const ProfileScope psConsole{ PZ_CONSOLE };
+        cConGraphics->Render(); }
       // Render video textures (if any)
-      VideoRender();
+      { const ProfileScope psVideo{ PZ_VIDEO };
+        VideoRender(); }
       // Loop point incase we need to catchup game ticks
       for(;;)
       { // Process window events
-        GlFWPollEvents();
+        { const ProfileScope psInput{ PZ_INPUT };
+          GlFWPollEvents(); }
         // Set main fbo by default on each frame
         cFboCore->ActivateMain();
         // Poll joysticks
-        cInput->PollJoysticks();
+        { const ProfileScope psInput{ PZ_INPUT };
+          cInput->PollJoysticks(); }
         // Execute a tick for each frame missed
-        cLua->ExecuteMain();
+        { const ProfileScope psLua{ PZ_LUA };
+          cLua->ExecuteMain(); }
         // Break if we've caught up
         if(cTimer->TimerShouldNotTick()) break;
         // Flush the main fbo as we're not drawing it yet
-        cFboCore->RenderFbosAndFlushMain();
+        { const ProfileScope psRender{ PZ_RENDER };
+          cFboCore->RenderFbosAndFlushMain(); }
         // Render again until we've caught up
       } // Add console fbo to render list
-      cConGraphics->RenderToMain();
+      { const ProfileScope psConsole{ PZ_CONSOLE };
+        cConGraphics->RenderToMain(); }
       // Render all fbos and copy the main fbo to screen
-      cFboCore->Render();
+      { const ProfileScope psRender{ PZ_RENDER };
+        cFboCore->Render(); }
       // Update timer
       cTimer->TimerUpdateInteractive();
     } // Update interim timer without storing entire duration
     else cTimer->TimerUpdateInteractiveInterim();
   }
+  /* -- Execute and time a benchmark tick ---------------------------------- */
+  void CoreBenchTick(void)
+  { // Execute the main tick and time it
+    const uint64_t qwStart = cmHiRes.GetTimeNS();
+    { const ProfileScope psLua{ PZ_LUA };
+      cLua->ExecuteMain(); }
+    // Record it and quit the engine if that was the last tick
+    if(bcBench.BenchTick(cmHiRes.GetTimeNS() - qwStart,
+         cCVars->GetStrInternal(APP_BENCHREPORT)))
+      cEvtMain->RequestQuit();
+  }
+  /* -- Write the benchmark report if quitting before it finished ---------- */
+  void CoreBenchFinish(void) try
+  { // Ignore if not benchmarking in bot mode
+    if(!cTimer->TimerIsBenchmark() || cSystem->IsNotTextMode() ||
+       cSystem->IsGraphicalMode()) return;
+    // Write what was recorded so far
+    bcBench.BenchFinish(cCVars->GetStrInternal(APP_BENCHREPORT));
+  } // exception occured? Log it so the engine can still de-initialise
+  catch(const exception &E)
+  { cLog->LogErrorExSafe("Core failed to write benchmark report: $",
+      E.what()); }
   /* -- Fired when Lua enters the sandbox ---------------------------------- */
   int CoreThreadSandbox(lua_State*const lS)
   { // Capture exceptions...
@@ -244,7 +278,7 @@ class Core final :                     // Members initially private
       { // Graphical mode requested too?
         if(cSystem->IsGraphicalMode())
         { // Initialise accumulator for first time
-          cTimer->TimerUpdateInteractive();
+          cTimer->TimerStartInteractive();
           // Threading not enabled?
           if(cDisplay->FlagIsClear(DF_WINTHREADED))
           { // Loop until event manager says we should break
@@ -265,15 +299,20 @@ class Core final :                     // Members initially private
         else while(cEvtMain->HandleSafe())
         { // Calculate time elapsed in this tick
           cTimer->TimerUpdateBot();
-          // Execute the main tick
-          cLua->ExecuteMain();
+          // Execute and time the main tick if benchmarking
+          if(cTimer->TimerIsBenchmark()) CoreBenchTick();
+          // Else just execute the main tick
+          else
+          { const ProfileScope psLua{ PZ_LUA };
+            cLua->ExecuteMain();
+          }
           // Process bot console
           cConsole->FlushToLog();
         }
       } // Graphical mode requested?
       else if(cSystem->IsGraphicalMode())
       { // Initialise accumulator for first time
-        cTimer->TimerUpdateInteractive();
+        cTimer->TimerStartInteractive();
         // Threading not enabled? Loop until event manager says we should break
         if(cDisplay->FlagIsClear(DF_WINTHREADED))
           while(cEvtMain->HandleSafe() && cGlFW->WinShouldNotClose())
@@ -329,6 +368,8 @@ class Core final :                     // Members initially private
         break;
       // Were exiting to de-initialise everything
       default:
+        // Write the benchmark report while Lua is still available
+        CoreBenchFinish();
         // De-initialise Lua
         CoreLuaDeInitHelper();
         // Deregister lua pause and resume callbacks
@@ -698,18 +739,22 @@ class Core final :                     // Members initially private
       using namespace ICrypt::P;       using namespace IFile::P;
       using namespace IGlFWMonitor::P; using namespace IImageDef::P;
       using namespace IImageFormat::P; using namespace IImageLib::P;
-      using namespace ILuaCommand::P;  using namespace ILuaFunc::P;
-      using namespace IMask::P;        using namespace IMemory::P;
-      using namespace IOal::P;         using namespace IParser::P;
-      using namespace IPcmFormat::P;   using namespace IPcmLib::P;
-      using namespace ISample::P;      using namespace IShader::P;
-      using namespace ISocket::P;      using namespace ISShot::P;
-      using namespace IStat::P;        using namespace IUtil::P;
-      using namespace IUtf;            using namespace Lib::OpenAL;
-      using namespace Lib::OS::GlFW;   using namespace Lib::Sqlite;
+      using namespace IJob::P;         using namespace ILuaCommand::P;
+      using namespace ILuaFunc::P;     using namespace IMask::P;
+      using namespace IMemory::P;      using namespace IOal::P;
+      using namespace IParser::P;      using namespace IPcmFormat::P;
+      using namespace IPcmLib::P;      using namespace ISample::P;
+      using namespace IShader::P;      using namespace ISocket::P;
+      using namespace ISShot::P;       using namespace IStat::P;
+      using namespace IUtil::P;        using namespace IUtf;
+      using namespace Lib::OpenAL;     using namespace Lib::OS::GlFW;
+      using namespace Lib::Sqlite;
       // Initialise other systems. The order is important!
       INITSS(Stats);                   // cppcheck-suppress danglingLifetime
+      INITSS(Profile);                 // cppcheck-suppress danglingLifetime
       INITSS(Threads);                 // cppcheck-suppress danglingLifetime
+      INITSS(LogWriter);               // cppcheck-suppress danglingLifetime
+      INITSS(Jobs);                    // cppcheck-suppress danglingLifetime
       INITSS(EvtMain);                 // cppcheck-suppress danglingLifetime
       INITSS(System);                  // cppcheck-suppress danglingLifetime
       INITSS(LuaFuncs);                // cppcheck-suppress danglingLifetime
@@ -757,6 +802,7 @@ class Core final :                     // Members initially private
       INITSS(ConGraphics);             // cppcheck-suppress danglingLifetime
       INITSS(Variables);               // cppcheck-suppress danglingLifetime
       INITSS(Commands);                // cppcheck-suppress danglingLifetime
+      INITSS(LuaCodeBundle);           // cppcheck-suppress danglingLifetime
       INITSS(Lua);                     // cppcheck-suppress danglingLifetime
       // Done with this macro
 #undef INITSS
@@ -809,7 +855,7 @@ class Core final :                     // Members initially private
         if(cSystem->SysConIsClosing())
         { // Quickly save cvars, database and log, this is the priority since
           // Windows has a hardcoded termination time for console apps.
-          cCVars->Save();
+          cCVars->SaveAndWait();
           cSql->DeInit();
           cLog->DeInitSafe();
           // Now Windows can exit anytime it wants
@@ -11,12 +11,13 @@
 namespace ICrypt {                     // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IClock::P;             using namespace ICollector::P;
-using namespace IError::P;             using namespace ILog::P;
+using namespace IError::P;             using namespace IFStream::P;
+using namespace IJob::P;               using namespace ILog::P;
 using namespace IMemory::P;            using namespace IStd::P;
 using namespace IString::P;            using namespace ISystem::P;
 using namespace ISysUtil::P;           using namespace IUtf;
-using namespace IUtil::P;              using namespace Lib::OS::OpenSSL;
-using namespace Lib::OS::SevenZip;
+using namespace IUtil::P;
+using namespace Lib::OS::OpenSSL;      using namespace Lib::OS::SevenZip;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Convert the specified character to hexadecimal ----------------------- */
@@ -588,6 +589,152 @@ static unsigned int CryptToCRC32(const string &strIn)
 /* -- Create CRC32 hash of specified memory block using LZMA API ----------- */
 static unsigned int CryptToCRC32(const MemConst &mcSrc)
   { return CrcCalc(mcSrc.MemPtr<void>(), mcSrc.MemSize()); }
+/* -- Hash types for incremental hashing ----------------------------------- */
+enum CryptHashType : unsigned int      // Hash types (DONT REORDER!!!)
+{ /* ----------------------------------------------------------------------- */
+  CHT_CRC32,                           // CRC32 (7zip)
+  CHT_SHA1,                            // SHA1 (openssl, insecure)
+  CHT_SHA224,                          // SHA224 (openssl)
+  CHT_SHA256,                          // SHA256 (openssl)
+  CHT_SHA384,                          // SHA384 (openssl)
+  CHT_SHA512,                          // SHA512 (openssl)
+  /* ----------------------------------------------------------------------- */
+  CHT_MAX                              // Maximum number of hash types
+};/* -- Incremental hash context ------------------------------------------- */
+class CryptHash                        // Members initially private
+{ /* -- Private typedefs --------------------------------------------------- */
+  typedef unique_ptr<EVP_MD_CTX,
+    function<decltype(EVP_MD_CTX_free)>> EvpMdPtr;
+  /* -- Private variables -------------------------------------------------- */
+  const CryptHashType chtType;         // Type of hash
+  const EvpMdPtr   empCtx;             // OpenSSL digest context (if sha)
+  uint32_t         ulCRC;              // Running CRC32 (if crc)
+  uint64_t         qwBytes;            // Bytes hashed so far
+  /* -- Get OpenSSL digest of the specified type --------------------------- */
+  static const EVP_MD *CryptHashGetMD(const CryptHashType chtType)
+  { // Compare type
+    switch(chtType)
+    { case CHT_SHA1   : return EVP_sha1();
+      case CHT_SHA224 : return EVP_sha224();
+      case CHT_SHA256 : return EVP_sha256();
+      case CHT_SHA384 : return EVP_sha384();
+      case CHT_SHA512 : return EVP_sha512();
+      default         : return nullptr;
+    }
+  }
+  /* -- Start a new hash ------------------------------------------- */ public:
+  void CryptHashReset(void)
+  { // Reset counters
+    ulCRC = CRC_INIT_VAL;
+    qwBytes = 0;
+    // Restart the digest if using openssl
+    if(empCtx &&
+      EVP_DigestInit_ex(empCtx.get(), CryptHashGetMD(chtType), nullptr) != 1)
+        XC("Failed to initialise digest!", "Type", chtType);
+  }
+  /* -- Add data to the hash ----------------------------------------------- */
+  void CryptHashUpdate(const void*const vpSrc, const size_t stBytes)
+  { // Use openssl or 7zip
+    if(empCtx)
+    { if(EVP_DigestUpdate(empCtx.get(), vpSrc, stBytes) != 1)
+        XC("Failed to update digest!", "Type", chtType, "Bytes", stBytes); }
+    else ulCRC = CrcUpdate(ulCRC, vpSrc, stBytes);
+    // Add to bytes hashed
+    qwBytes += stBytes;
+  }
+  void CryptHashUpdate(const MemConst &mcSrc)
+    { CryptHashUpdate(mcSrc.MemPtr<void>(), mcSrc.MemSize()); }
+  /* -- Add the rest of a file to the hash in chunks ----------------------- */
+  uint64_t CryptHashUpdate(FStream &fsSrc, const size_t stChunk=1048576)
+  { // Read and hash the file a chunk at a time
+    Memory mChunk{ stChunk };
+    const uint64_t qwStart = qwBytes;
+    while(const size_t stRead =
+      fsSrc.FStreamReadSafe(mChunk.MemPtr<void>(), mChunk.MemSize()))
+        CryptHashUpdate(mChunk.MemPtr<void>(), stRead);
+    if(fsSrc.FStreamFErrorSafe())
+      XC("Failed to read file to hash!", "File", fsSrc.IdentGet(),
+         "Reason", fsSrc.FStreamGetErrStr());
+    return qwBytes - qwStart;
+  }
+  /* -- Return bytes hashed so far ----------------------------------------- */
+  uint64_t CryptHashGetBytes(void) const { return qwBytes; }
+  /* -- Finish the hash and return the digest ------------------------------ */
+  Memory CryptHashFinishRaw(void)
+  { // CRC32 stored in big-endian so it reads the same as hex
+    if(!empCtx)
+    { Memory mDigest{ sizeof(uint32_t) };
+      mDigest.MemWriteIntBE<uint32_t>(CRC_GET_DIGEST(ulCRC));
+      return mDigest; }
+    // Get the digest from openssl
+    Memory mDigest{ EVP_MAX_MD_SIZE };
+    unsigned int uiLen = 0;
+    if(EVP_DigestFinal_ex(empCtx.get(), mDigest.MemPtr<unsigned char>(),
+      &uiLen) != 1)
+        XC("Failed to finalise digest!", "Type", chtType);
+    mDigest.MemResize(uiLen);
+    return mDigest;
+  }
+  const string CryptHashFinish(void)
+    { return CryptBin2Hex(CryptHashFinishRaw()); }
+  /* -- Constructor -------------------------------------------------------- */
+  explicit CryptHash(const CryptHashType chtNType) :
+    /* -- Initialisers ----------------------------------------------------- */
+    chtType(chtNType),                 // Set type of hash
+    empCtx{ chtType == CHT_CRC32 ? nullptr : EVP_MD_CTX_new(),
+      EVP_MD_CTX_free },               // Create digest context if needed
+    ulCRC(CRC_INIT_VAL),               // Initial CRC32
+    qwBytes(0)                         // No bytes hashed yet
+  { // Check type and that the digest context was created
+    if(chtType >= CHT_MAX) XC("Invalid hash type!", "Type", chtType);
+    if(chtType != CHT_CRC32 && !empCtx)
+      XC("Failed to create digest context!", "Type", chtType);
+    // Start the hash
+    CryptHashReset();
+  }
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(CryptHash)           // Omit copy constructor for safety
+};/* -- Result of hashing data in chunks ----------------------------------- */
+struct CryptHashManifest               // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  string           strRoot;            // Hash of all the chunk hashes
+  StrVector        svChunks;           // Hash of each chunk
+};/* -- Hash data in chunks on the job pool -------------------------------- */
+static const CryptHashManifest CryptHashTree(const CryptHashType chtType,
+  const MemConst &mcSrc, const size_t stChunk)
+{ // Check chunk size
+  if(!stChunk) XC("Invalid chunk size!", "Size", stChunk);
+  // Always have at least one chunk so an empty block still has a root
+  const uint64_t qwStart = cmHiRes.GetTimeNS();
+  const size_t stChunks =
+    UtilMaximum((mcSrc.MemSize() + stChunk - 1) / stChunk, 1);
+  // Hash every chunk at once
+  vector<Memory> vmDigests(stChunks);
+  JobForEach("hash", stChunks,
+    [chtType, &mcSrc, stChunk, &vmDigests](const size_t stIndex)
+  { const size_t stPos = stIndex * stChunk;
+    CryptHash chChunk{ chtType };
+    chChunk.CryptHashUpdate(mcSrc.MemPtr<char>() + stPos,
+      UtilMinimum(stChunk, mcSrc.MemSize() - stPos));
+    vmDigests[stIndex] = chChunk.CryptHashFinishRaw();
+  });
+  // Hash the chunk hashes in order for the root
+  CryptHashManifest chmOut;
+  chmOut.svChunks.reserve(stChunks);
+  CryptHash chRoot{ chtType };
+  for(const Memory &mRef : vmDigests)
+  { chRoot.CryptHashUpdate(mRef);
+    chmOut.svChunks.emplace_back(CryptBin2Hex(mRef)); }
+  chmOut.strRoot = chRoot.CryptHashFinish();
+  // Log the throughput and return the result
+  const double dTime =
+    static_cast<double>(cmHiRes.GetTimeNS() - qwStart) / 1e9;
+  cLog->LogDebugExSafe("Crypt hashed $ bytes in $ chunks in $ ($/s).",
+    mcSrc.MemSize(), stChunks, StrShortFromDuration(dTime),
+    StrToBytes(dTime > 0 ? static_cast<uint64_t>(
+      static_cast<double>(mcSrc.MemSize()) / dTime) : 0));
+  return chmOut;
+}
 /* -- URL decode the specified c-string ------------------------------------ */
 static const string CryptURLDecode(const char*const cpURL)
 { // Bail if passed string is invalid
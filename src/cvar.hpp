@@ -77,13 +77,10 @@ class CVarItem :                       // Members initially private
   /* ----------------------------------------------------------------------- */
   enum CommitResult : unsigned int     // Result to a commit request
   { /* --------------------------------------------------------------------- */
-    CR_OK,                             // Sql call commited the variable
-    CR_FAIL,                           // Sql call update cvar failed
-    CR_OK_PURGE,                       // Sql call succeeded with purge
-    CR_FAIL_PURGE,                     // Sql call failed purge
-    CR_FAIL_PURGE_NOT_CHANGED,         // Sql call succeded but no changes
-    CR_FAIL_PURGE_UNKNOWN_ERROR,       // Unknown result from sql purge call
+    CR_OK,                             // Cvar staged to be commited
+    CR_OK_PURGE,                       // Cvar staged to be purged
     CR_FAIL_NOT_SAVEABLE,              // CVar is not saveable
+    CR_FAIL_NOT_DIRTY,                 // Cvar not changed since last commit
     CR_FAIL_LOADED_NOT_MODIFIED,       // Cvar loaded but not modified
     CR_FAIL_ENCRYPT,                   // Cvar could not be encrypted
     CR_FAIL_COMPRESS,                  // Cvar could not be compress
@@ -164,29 +161,26 @@ class CVarItem :                       // Members initially private
   bool MarkEncodedVarAsCommit(void)
   { // Ignore if appropriate flag not set
     if(FlagIsClear(CPROTECTED|CDEFLATE)) return false;
-    // Mark as commit
-    FlagSet(COMMIT);
-    // Commit the cvar and increment count if succeeded. 'this->'
-    // needed to stop clang whining about 'this' not being used but it
-    // is needed!
-    return Commit() == CR_OK;
+    // Mark as commit so the next save encodes it again
+    FlagSet(COMMIT|DIRTY);
+    return true;
   }
   /* ----------------------------------------------------------------------- */
-  bool Commit(const MemConst &mcSrc)
-    { return cSql->CVarCommitBlob(GetVar(), mcSrc); }
+  void Commit(SqlCVarWrites &scvwList, const MemConst &mcSrc)
+    { scvwList.push_back({ GetVar(), mcSrc.MemToString(), SQLITE_BLOB }); }
   /* ----------------------------------------------------------------------- */
-  CommitResult Commit(void)
-  { // Ignore if variable not modified, force saved or loaded
+  CommitResult Commit(SqlCVarWrites &scvwList)
+  { // Ignore if not changed since it was last commited
+    if(FlagIsClear(DIRTY)) return CR_FAIL_NOT_DIRTY;
+    // Ignore if variable not modified, force saved or loaded
     if(FlagIsClear(COMMIT|OSAVEFORCE|LOADED)) return CR_FAIL_NOT_SAVEABLE;
-    // If the value is the same as the default value?
+    // It is being dealt with now so it is not dirty anymore
+    FlagClear(DIRTY);
+    // If the value is the same as the default value? Purge it, no point in
+    // writing it.
     if(IsValueUnchanged())
-    { // Purge it, no point in writing it. Compare result
-      switch(cSql->CVarPurge(GetVar()))
-      { case Sql::PR_OK    : return CR_OK_PURGE;
-        case Sql::PR_FAIL  : return CR_FAIL_PURGE;
-        case Sql::PR_OK_NC : return CR_FAIL_PURGE_NOT_CHANGED;
-        default            : return CR_FAIL_PURGE_UNKNOWN_ERROR;
-      }
+    { scvwList.push_back({ GetVar(), {}, SQLITE_NULL });
+      return CR_OK_PURGE;
     } // Nothing to write if variable was just loaded
     else if(FlagIsSetAndClear(LOADED, COMMIT|OSAVEFORCE))
       return CR_FAIL_LOADED_NOT_MODIFIED;
@@ -195,14 +189,15 @@ class CVarItem :                       // Members initially private
     { // If we are to encrypt
       if(FlagIsSet(CPROTECTED)) try
       { // Try encryption and/or compression and store result in database
-        if(FlagIsSet(CDEFLATE)) Commit(Block<AESZLIBEncoder>(GetValue()));
-        else Commit(Block<AESEncoder>(GetValue()));
+        if(FlagIsSet(CDEFLATE))
+          Commit(scvwList, Block<AESZLIBEncoder>(GetValue()));
+        else Commit(scvwList, Block<AESEncoder>(GetValue()));
       } // exception occured
       catch(const exception &e)
       { // Log exception
         cLog->LogErrorExSafe("CVars encrypt exception: $", e.what());
         // Capture exceptions again, try raw encoder and return string
-        try { Commit(Block<RAWEncoder>(GetValue())); }
+        try { Commit(scvwList, Block<RAWEncoder>(GetValue())); }
         // exception occured again?
         catch(const exception &e2)
         { // Log exception and return failure
@@ -212,31 +207,31 @@ class CVarItem :                       // Members initially private
       } // If we are to compress
       else if(FlagIsSet(CDEFLATE)) try
       { // Try compression and commit the result to the database
-        Commit(Block<ZLIBEncoder>(GetValue()));
+        Commit(scvwList, Block<ZLIBEncoder>(GetValue()));
       } // exception occured
       catch(const exception &e)
       { // Log exception
         cLog->LogErrorExSafe("CVars compress exception: $", e.what());
         // Capture exceptions again, try raw encoder and return string
-        try { Commit(Block<RAWEncoder>(GetValue())); }
+        try { Commit(scvwList, Block<RAWEncoder>(GetValue())); }
         // exception occured again?
         catch(const exception &e2)
         { // Log exception and return failure
           cLog->LogErrorExSafe("CVars store exception: $", e2.what());
           return CR_FAIL_COMPRESS;
         } // Success
-      } // Commit the unencrypted cvar and return if failed
-      else if(!cSql->CVarCommitString(GetVar(), GetValue())) return CR_FAIL;
-    } // Successfully saved so remove commit flag
+      } // Commit the unencrypted cvar
+      else scvwList.push_back({ GetVar(), GetValue(), SQLITE_TEXT });
+    } // Successfully staged so remove commit flag
     FlagClear(COMMIT);
     // Success
     return CR_OK;
   }
   /* -- Save with counter increment ---------------------------------------- */
-  template<typename IntType>void Save(IntType &itCommit, IntType &itPurge)
-  { // Try to commit the cvar. 'this->' needed to stop clang whining about
-    // 'this' not being used but it is needed!
-    switch(Commit())
+  template<typename IntType>void Save(SqlCVarWrites &scvwList,
+    IntType &itCommit, IntType &itPurge)
+  { // Try to stage the cvar
+    switch(Commit(scvwList))
     { // enum CommitResult
       case CR_OK       : itCommit = itCommit + 1; break; // Saved
       case CR_OK_PURGE : itPurge = itPurge + 1; break;   // Purged
@@ -301,7 +296,7 @@ class CVarItem :                       // Members initially private
       // The new value is acceptable, but the caller set the value? Ignore
       case ACCEPT_HANDLED: break;
       // Same as above but forcing commit? Set commit flag as requested
-      case ACCEPT_HANDLED_FORCECOMMIT: FlagSet(COMMIT); break;
+      case ACCEPT_HANDLED_FORCECOMMIT: FlagSet(COMMIT|DIRTY); break;
       // Unknown return value?
       default:
         // Throw if requested
@@ -319,7 +314,7 @@ class CVarItem :                       // Members initially private
       { // Set commit flag if the cvar was not just registered or it was new
         // and initialised from the command line
         if(ccfcFlags.FlagIsClear(CCF_NEWCVAR) || FlagIsSet(SCMDLINE))
-          FlagSet(COMMIT);
+          FlagSet(COMMIT|DIRTY);
       } // Remove commit if set
       else if(FlagIsSet(COMMIT)) FlagClear(COMMIT);
     } // Log progress and return success
@@ -93,8 +93,8 @@ BUILD_FLAGS(CVar,
   LOCKED                   {Flag[50]}, COMMIT                   {Flag[51]},
   // Var should be purged from DB?     Variable not readable by lua?
   PURGE                    {Flag[52]}, CONFIDENTIAL             {Flag[53]},
-  // Variable value was loaded from db
-  LOADED                   {Flag[54]},
+  // Var value was loaded from db?     Var changed since last commit?
+  LOADED                   {Flag[54]}, DIRTY                    {Flag[55]},
   /* -- Sources (S) [Private] ---------------------------------------------- */
   // Set from engine internally?       Set from command-line?
   SENGINE                  {Flag[56]}, SCMDLINE                 {Flag[57]},
@@ -155,8 +155,8 @@ enum CVarEnums : size_t
   SQL_DB,           SQL_RETRYCOUNT,    SQL_RETRYSUSPEND,    SQL_ERASEEMPTY,
   SQL_TEMPSTORE,    SQL_SYNCHRONOUS,   SQL_JOURNALMODE,     SQL_AUTOVACUUM,
   SQL_FOREIGNKEYS,  SQL_INCVACUUM,     SQL_DEFAULTS,        SQL_LOADCONFIG,
-  APP_CFLAGS,       LOG_LINES,         LOG_FILE,            APP_LONGNAME,
-  APP_CLEARMUTEX,   ERR_INSTANCE,
+  SQL_WRITEBEHIND,  APP_CFLAGS,        LOG_LINES,           LOG_FILE,
+  APP_LONGNAME,     APP_CLEARMUTEX,    ERR_INSTANCE,
   /* -- Object cvars ------------------------------------------------------- */
   OBJ_CLIPMAX,      OBJ_CMDMAX,        OBJ_CVARMAX,         OBJ_CVARIMAX,
   OBJ_ARCHIVEMAX,   OBJ_ASSETMAX,      OBJ_BINMAX,          OBJ_FBOMAX,
@@ -167,7 +167,8 @@ enum CVarEnums : size_t
   OBJ_VIDEOMAX,
   /* -- Base cvars --------------------------------------------------------- */
   APP_DESCRIPTION,  APP_VERSION,       APP_ICON,            APP_COPYRIGHT,
-  APP_WEBSITE,      APP_TICKRATE,      APP_DELAY,           APP_TITLE,
+  APP_WEBSITE,      APP_TICKRATE,      APP_DELAY,           APP_PACING,
+  APP_TITLE,        APP_BENCHTICKS,    APP_BENCHREPORT,
   /* -- Error cvars -------------------------------------------------------- */
   ERR_ADMIN,        ERR_CHECKSUM,      ERR_DEBUGGER,        ERR_LUAMODE,
   ERR_LMRESETLIMIT, ERR_MINVRAM,       ERR_MINRAM,
@@ -196,8 +197,8 @@ enum CVarEnums : size_t
   INP_RAWMOUSE,     INP_STICKYKEY,     INP_STICKYMOUSE,
   /* -- Network cvars ------------------------------------------------------ */
   NET_CBPFLAG1,     NET_CBPFLAG2,      NET_BUFFER,          NET_RTIMEOUT,
-  NET_STIMEOUT,     NET_CIPHERTLSv1,   NET_CIPHERTLSv13,    NET_CASTORE,
-  NET_OCSP,         NET_USERAGENT,
+  NET_STIMEOUT,     NET_CIPHERTLSv1,   NET_CIPHERTLSv13,    NET_CALAZY,
+  NET_CASTORE,      NET_OCSP,          NET_USERAGENT,
   /* -- Video cvars -------------------------------------------------------- */
   VID_API,          VID_AUXBUFFERS,    VID_CTXMAJOR,        VID_CTXMINOR,
   VID_CLEAR,        VID_CLEARCOLOUR,   VID_DBLBUFF,         VID_DEBUG,
@@ -210,7 +211,7 @@ enum CVarEnums : size_t
   VID_RDFBO,        VID_RDTEX,         VID_RELEASE,         VID_RFBO,
   VID_RFLOATS,      VID_ROBUSTNESS,    VID_SIMPLEMATRIX,    VID_SRGB,
   VID_SSTYPE,       VID_STEREO,        VID_SUBPIXROUND,     VID_TEXFILTER,
-  VID_VSYNC,
+  VID_VSYNC,        VID_DXTCACHE,
   /* -- Window cvars ------------------------------------------------------- */
   WIN_ALPHA,        WIN_ASPECT,        WIN_BORDER,          WIN_CLOSEABLE,
   WIN_FLOATING,     WIN_FOCUSED,       WIN_HEIGHT,          WIN_HEIGHTMAX,
@@ -218,7 +219,7 @@ enum CVarEnums : size_t
   WIN_POSY,         WIN_SIZABLE,       WIN_THREAD,          WIN_WIDTH,
   WIN_WIDTHMAX,     WIN_WIDTHMIN,
   /* -- Logging cvars ------------------------------------------------------ */
-  LOG_CREDITS,      LOG_DYLIBS,
+  LOG_CREDITS,      LOG_DYLIBS,        LOG_ASYNC,
   /* -- Misc (do not (re)move) --------------------------------------------- */
   APP_COMFLAGS,                        // Compatibility flags
   CVAR_MAX,                            // Maximum cvars
@@ -220,6 +220,16 @@ const CVarItemStaticList cvislList{ {  // Default cvars (from cvars.hpp)
 { CFL_NONE, "sql_loadconfig", cCommon->One(),
   CB(cCVars->LoadSettings, bool), TBOOLEAN|PSYSTEM },
 /* ------------------------------------------------------------------------- */
+// ! SQL_WRITEBEHIND
+// ? Specifies to write changed cvars to the database from a background thread
+// ? with its own connection to the database so saving never waits on disk
+// ? access. Variables that fail to write are retried on the next save.
+// ? Creating a new private key with 'cvnpk' always saves straight away.
+// ? Has no effect when the database is in memory.
+/* ------------------------------------------------------------------------- */
+{ CFL_NONE, "sql_writebehind", cCommon->Zero(),
+  CB(cCVars->SetWriteBehind, bool), TBOOLEAN|PSYSTEM },
+/* ------------------------------------------------------------------------- */
 // ! APP_CFLAGS
 // ? Specifies how the host wants to be run with the following flags...
 // ? [0x1] CFL_TERMINAL = Opens (Win32) or reuses (Unix) a console window.
@@ -241,7 +251,7 @@ const CVarItemStaticList cvislList{ {  // Default cvars (from cvars.hpp)
 // ? parameters, the app.cfg file and the user.
 /* ------------------------------------------------------------------------- */
 { CFL_NONE, "log_file", cCommon->Blank(),
-  CBSTR(cLog->LogFileModified), TSTRING|CFILENAME|MTRIM|PBOOT|PUSR },
+  CBSTR(cLogWriter->LogFileModified), TSTRING|CFILENAME|MTRIM|PBOOT|PUSR },
 /* ------------------------------------------------------------------------- */
 // ! APP_LONGNAME
 // ? Specifies a long title name for the guest application. It is uses as the
@@ -534,6 +544,16 @@ const CVarItemStaticList cvislList{ {  // Default cvars (from cvars.hpp)
 { CFL_NONE, "app_delay", cCommon->One(),
   CB(cTimer->TimerSetDelay, unsigned int), TUINTEGERSAVE|PANY },
 /* ------------------------------------------------------------------------- */
+// ! APP_PACING
+// ? Paces frames in interactive mode by sleeping for most of the time left
+// ? until the next tick and yielding the rest, instead of sleeping for one
+// ? millisecond at a time. How long to yield is calibrated from how much
+// ? previous sleeps overslept. This gives smoother frame times at high tick
+// ? rates without keeping a core busy. 'app_delay' is ignored when enabled.
+/* ------------------------------------------------------------------------- */
+{ CFL_VIDEO, "app_pacing", cCommon->Zero(),
+  CB(cTimer->TimerSetPacing, bool), TBOOLEANSAVE|PANY },
+/* ------------------------------------------------------------------------- */
 // ! APP_TITLE
 // ? Sets a custom title for the window. This can only be changed at the
 // ? command-line or the application configuration file and not saved to the
@@ -545,6 +565,27 @@ const CVarItemStaticList cvislList{ {  // Default cvars (from cvars.hpp)
 /* ------------------------------------------------------------------------- */
 { CFL_NONE, "app_title", cCommon->Blank(),
   CBSTR(cCore->CoreTitleModified), TSTRING|MTRIM|PSYSTEM },
+/* ------------------------------------------------------------------------- */
+// ! APP_BENCHTICKS
+// ? Runs the startup script in bot mode for the specified number of ticks as
+// ? fast as possible and then quits. Every tick is treated as taking exactly
+// ? 'app_tickrate' nanoseconds so results are reproducible and the time taken
+// ? by each tick is written to the file named by 'app_benchreport'. This is
+// ? only honoured in bot mode. The default is 0 which disables benchmarking.
+/* ------------------------------------------------------------------------- */
+{ CFL_NONE, "app_benchticks", cCommon->Zero(),
+  CB(cTimer->TimerSetBenchmark, uint64_t), TUINTEGER|PSYSTEM },
+/* ------------------------------------------------------------------------- */
+// ! APP_BENCHREPORT
+// ? Specifies the file the benchmark report is written to when
+// ? 'app_benchticks' is set. The report is in JSON format and contains the
+// ? tick time percentiles, Lua allocations and per-subsystem counters so it
+// ? can be compared by automated tools. It is also written if the engine
+// ? quits before all the ticks ran, with 'completed' set to false. The
+// ? default is 'bench.json'.
+/* ------------------------------------------------------------------------- */
+{ CFL_NONE, "app_benchreport", "bench.json", NoOp,
+  TSTRING|CFILENAME|CNOTEMPTY|MTRIM|PSYSTEM },
 /* == Error cvars ========================================================== */
 // ! ERR_ADMIN
 // ? Throws an error if the user is running the engine with elevated
@@ -659,7 +700,9 @@ const CVarItemStaticList cvislList{ {  // Default cvars (from cvars.hpp)
 // ! LUA_CACHE
 // ? Specifies to compile any Lua code and store it in the user database for
 // ? later retrieval. When loading already compiled raw code, this feature
-// ? is ignored.
+// ? is ignored. Compiled functions are also written to a bundle file next to
+// ? the user database ending in '.lcb' when Lua de-initialises. The bundle
+// ? is memory mapped at startup and is checked before the database is.
 // ? [0] LCC_OFF      = Compile Lua code every time and not store.
 // ? [1] LCC_FULL     = " with full debug information and store result (Best).
 // ? [2] LCC_MINIMUM  = " with minimum debug information and store result.
@@ -1163,6 +1206,15 @@ const CVarItemStaticList cvislList{ {  // Default cvars (from cvars.hpp)
 { CFL_NONE, "net_ciphertlsv13", cCommon->Blank(), CBSTR(SocketSetCipher13),
   MTRIM|TSTRING|PSYSTEM },
 /* ------------------------------------------------------------------------- */
+// ! NET_CALAZY
+// ? Only reads the subject of each certificate in the client certificate
+// ? store at startup and loads and checks a certificate the first time an
+// ? SSL connection needs it. This keeps startup time and memory usage from
+// ? growing with the size of the store.
+/* ------------------------------------------------------------------------- */
+{ CFL_NONE, "net_calazy", cCommon->Zero(),
+  CB(cSockets->CertsSetLazy, bool), TBOOLEAN|PBOOT|PSYSTEM },
+/* ------------------------------------------------------------------------- */
 // ! NET_CASTORE
 // ? Specifies the relative directory to the client certificate store. These
 // ? are required CA certificates that are used for the basis of every SSL
@@ -1581,6 +1633,15 @@ const CVarItemStaticList cvislList{ {  // Default cvars (from cvars.hpp)
 { CFL_VIDEO, "vid_vsync", cCommon->One(),
   CB(cOgl->SetVSyncMode, int), TINTEGERSAVE|PANY },
 /* ------------------------------------------------------------------------- */
+// ! VID_DXTCACHE
+// ? Specifies to keep images compressed with the IL_TODXT flag in a cache
+// ? directory in the users home directory. The cached file is named after a
+// ? hash of the source file so the next load skips both decoding and
+// ? compression. Set to 0 to always compress images when they are loaded.
+/* ------------------------------------------------------------------------- */
+{ CFL_VIDEO, "vid_dxtcache", cCommon->One(),
+  CB(ImagesSetDXTCache, bool), TBOOLEAN|PANY },
+/* ------------------------------------------------------------------------- */
 // ! WIN_ALPHA
 // ? Specifies that the window has alpha which is needed for transparent
 // ? windows. Default is 0 for no.
@@ -1721,6 +1782,15 @@ const CVarItemStaticList cvislList{ {  // Default cvars (from cvars.hpp)
 { CFL_NONE, "log_dylibs", cCommon->Zero(),
   CB(cSystem->DumpModuleList, bool), TBOOLEAN|PANY },
 /* ------------------------------------------------------------------------- */
+// ! LOG_ASYNC
+// ? Specifies to write log lines to the log file from a background thread.
+// ? Threads that log then only copy the line into a queue that the writer
+// ? thread swaps out and never wait on disk access. Has no effect when not
+// ? logging to a file.
+/* ------------------------------------------------------------------------- */
+{ CFL_NONE, "log_async", cCommon->One(),
+  CB(cLogWriter->LogAsyncModified, bool), TBOOLEAN|PANY },
+/* ------------------------------------------------------------------------- */
 // ! APP_COMPATFLAGS
 // ? Specifies to test system for compatibility and override any settings
 // ? depending on the system environment.
@@ -18,7 +18,7 @@ using namespace IError::P;             using namespace ILog::P;
 using namespace IParser::P;            using namespace ISql::P;
 using namespace IStd::P;               using namespace IString::P;
 using namespace ISystem::P;            using namespace ISysUtil::P;
-using namespace Lib::Sqlite;
+using namespace IThread::P;            using namespace Lib::Sqlite;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public namespace
 /* ------------------------------------------------------------------------- */
@@ -48,6 +48,13 @@ static struct CVars final :            // Start of vars class
   ArrayVars        avInternal;         // Quick lookup to internal vars
   CVarMap          cvmActive;          // CVars active list
   string           strCBError;         // Callback error message
+  /* -- Write-behind thread variables -------------------------------------- */
+  SqlCVarConn      sccWriter;          // Database connection of writer
+  SqlCVarWrites    scvwQueue;          // Changed cvars waiting to be written
+  StrVector        svFailed;           // Cvars the writer failed to write
+  mutex            mWriter;            // Queue and failures being used
+  condition_variable cvWriter;         // Wakes up the writer thread
+  Thread           tWriter;            // Writer thread
   /* ----------------------------------------------------------------------- */
   struct CVarMapNameStruct             // Join initial with cvars
   { /* --------------------------------------------------------------------- */
@@ -364,6 +371,9 @@ static struct CVars final :            // Start of vars class
         // when we inserted it, we need to check if it is valid too.
         cvmiIt->second.SetValue(strValue, cvfcFlags|PANY,
           cvcfcFlags|CCF_THROWONERROR|CCF_NEWCVAR, strCBError);
+        // Forced saving needs writing on the next save even if not changed
+        if(cvmiIt->second.FlagIsSet(OSAVEFORCE))
+          cvmiIt->second.FlagSet(DIRTY);
       } // Exception occured?
       catch(const exception &)
       { // Unregister the variable that was created to not cause problems when
@@ -383,11 +393,12 @@ static struct CVars final :            // Start of vars class
       // LOADED flag to tell UnregisterVar() to move the variable back into the
       // initial list when unregistered for Lua reloads. Also maintain the
       // commit flag at least so the data is saved on exit when the cvar is
-      // unregistered and re-registered.
+      // unregistered and re-registered. It is also marked as changed so the
+      // next save reconciles the stored value with the new default once.
       CVarItem &cviRef = cvmiIt->second;
       cviRef.SetDefValue(strValue);
       cviRef.SetTrigger(cbTrigger);
-      cviRef.FlagReset(cvfcFlags | LOADED | (cviRef & CVREGMASK));
+      cviRef.FlagReset(cvfcFlags | LOADED | DIRTY | (cviRef & CVREGMASK));
       // Use the value in persistent storage instead
       cviRef.SetValue(cviRef.GetValue(), cvfcFlags|PANY,
         cvcfcFlags|CCF_THROWONERROR|CCF_NEWCVAR, strCBError);
@@ -462,39 +473,140 @@ static struct CVars final :            // Start of vars class
     // Return commit count
     return stCommitted;
   }
+  /* -- Mark a cvar as changed again so the next save retries it ----------- */
+  void MarkForRetry(const string &strVar)
+  { // Find the cvar in the pending or active list and mark it
+    for(const CVarMapNameStruct &cvmnsRef : cvmnsaList)
+    { const CVarMapIt cvmiIt{ cvmnsRef.cvmMap.find(strVar) };
+      if(cvmiIt == cvmnsRef.cvmMap.end()) continue;
+      cvmiIt->second.FlagSet(COMMIT|DIRTY);
+      break;
+    }
+  }
+  /* -- Mark cvars that failed to write so the next save retries them ------ */
+  void MarkForRetry(const StrVector &svVars)
+  { // Log and mark each one
+    if(svVars.empty()) return;
+    cLog->LogWarningExSafe("CVars will retry $ variables that failed to save.",
+      svVars.size());
+    for(const string &strVar : svVars) MarkForRetry(strVar);
+  }
   /* ----------------------------------------------------------------------- */
   size_t Save(void)
-  { // Done if sqlite database is not opened or vars table is not availabe
-    if(!cSql->IsOpened() || cSql->CVarCreateTable() == Sql::CTR_FAIL)
-      return string::npos;
-    // Begin transaction
-    cSql->Begin();
-    // Total number of commits attempted which may need to be read and
-    // written by multiple threads.
-    SafeSizeT stCommitTotal{0}, stPurgeTotal{0};
-    // Enumerate the lists asyncronously
-    StdForEach(par_unseq, cvmnsaList.cbegin(), cvmnsaList.cend(),
-      [&stCommitTotal, &stPurgeTotal](const CVarMapNameStruct &cvmpIt)
-    { // Total number of commits attempted which may need to be read and
-      // written by multiple threads.
-      SafeSizeT stCommit{0}, stPurge{0};
-      // Iterate through the initial list and try to commit the cvar. We might
-      // as well try to do this as quick as possible
-      StdForEach(par_unseq, cvmpIt.cvmMap.begin(), cvmpIt.cvmMap.end(),
-        [&stCommit, &stPurge](CVarMapPair &cvmpRef)
-          { cvmpRef.second.Save(stCommit, stPurge); });
-      // Log variables written
+  { // Done if sqlite database is not opened
+    if(!cSql->IsOpened()) return string::npos;
+    // Take the cvars the writer thread failed to write so they are retried
+    StrVector svRetry;
+    { const LockGuard lgWriter{ mWriter };
+      svRetry.swap(svFailed); }
+    MarkForRetry(svRetry);
+    // Stage every cvar that changed since it was last saved. The cvars are
+    // encoded here so the writer thread never has to touch them.
+    SqlCVarWrites scvwList;
+    for(const CVarMapNameStruct &cvmnsRef : cvmnsaList)
+    { // Stage the changed cvars in this list
+      size_t stCommit = 0, stPurge = 0;
+      for(CVarMapPair &cvmpRef : cvmnsRef.cvmMap)
+        cvmpRef.second.Save(scvwList, stCommit, stPurge);
+      // Log variables staged
       if(stCommit || stPurge)
         cLog->LogInfoExSafe("CVars commited $ and purged $ from $ pool.",
-          stCommit.load(), stPurge.load(), cvmpIt.strName);
-      // Add to totals
-      stCommitTotal += stCommit;
-      stPurgeTotal += stPurge;
-    });
-    // End transaction
-    cSql->End();
+          stCommit, stPurge, cvmnsRef.strName);
+    } // Done if nothing changed so the database is not touched at all
+    if(scvwList.empty()) return 0;
+    // Vars table is not available?
+    if(cSql->CVarCreateTable() == Sql::CTR_FAIL)
+    { // Mark the staged cvars as changed again so the next save retries them
+      for(const SqlCVarWrite &scvwRef : scvwList)
+        MarkForRetry(scvwRef.strVar);
+      // Nothing saved
+      return string::npos;
+    } // Writer thread running?
+    if(tWriter.ThreadIsJoinable())
+    { // Give the changes to the writer thread and return number queued
+      const size_t stQueued = scvwList.size();
+      { const LockGuard lgWriter{ mWriter };
+        if(scvwQueue.empty()) scvwQueue.swap(scvwList);
+        else for(SqlCVarWrite &scvwRef : scvwList)
+          scvwQueue.emplace_back(StdMove(scvwRef));
+      } cvWriter.notify_one();
+      return stQueued;
+    } // Write the changes now and retry the ones that failed next time
+    StrVector svWriteFailed;
+    const size_t stWritten = cSql->CVarWrite(scvwList, svWriteFailed);
+    MarkForRetry(svWriteFailed);
     // Return number of records saved or updated
-    return stCommitTotal + stPurgeTotal;
+    return stWritten;
+  }
+  /* -- Writer thread ------------------------------------------------------ */
+  int WriterMain(Thread &tRef)
+  { // Wait for changes or for the exit request
+    SqlCVarWrites scvwBatch;
+    { UniqueLock ulWriter{ mWriter };
+      cvWriter.wait(ulWriter, [this, &tRef]
+        { return !scvwQueue.empty() || tRef.ThreadShouldExit(); });
+      // Exit if nothing left to write
+      if(scvwQueue.empty()) return 1;
+      // Take the queue so it is written without holding the lock
+      scvwBatch.swap(scvwQueue); }
+    // Write the changes
+    StrVector svWriteFailed;
+    cLog->LogDebugExSafe("CVars writer wrote $ of $ variables.",
+      cSql->CVarWrite(sccWriter, scvwBatch, svWriteFailed), scvwBatch.size());
+    // Hand the failures back so the main thread retries them on next save
+    if(!svWriteFailed.empty())
+    { const LockGuard lgWriter{ mWriter };
+      if(svFailed.empty()) svFailed.swap(svWriteFailed);
+      else for(string &strVar : svWriteFailed)
+        svFailed.emplace_back(StdMove(strVar)); }
+    // Wait for more changes
+    return 0;
+  }
+  /* -- Start the writer thread -------------------------------------------- */
+  void WriterStart(void)
+  { // Ignore if already running
+    if(tWriter.ThreadIsJoinable()) return;
+    // Open a private connection to the database file
+    if(!cSql->CVarConnOpen(sccWriter))
+    { cLog->LogWarningSafe("CVars cannot write behind so saving directly.");
+      return; }
+    // Start the thread
+    tWriter.ThreadStart();
+    cLog->LogDebugSafe("CVars writer thread started.");
+  }
+  /* -- Stop the writer thread after everything queued is written ---------- */
+  void WriterStop(void)
+  { // Ignore if not running
+    if(tWriter.ThreadIsNotJoinable()) return;
+    // Signal exit while the thread can't be between checking and waiting
+    { const LockGuard lgWriter{ mWriter };
+      tWriter.ThreadSetExit(); }
+    // Wake it up and wait for it to finish
+    cvWriter.notify_one();
+    tWriter.ThreadStop();
+    // Write anything it did not get to before it exited
+    if(!scvwQueue.empty())
+    { cSql->CVarWrite(sccWriter, scvwQueue, svFailed);
+      scvwQueue.clear(); }
+    // Close the private connection
+    Sql::CVarConnClose(sccWriter);
+    cLog->LogDebugSafe("CVars writer thread stopped.");
+  }
+  /* -- Save everything and wait for it to be written ---------------------- */
+  size_t SaveAndWait(void)
+  { // Stop the writer so everything queued is written, then save the rest
+    WriterStop();
+    return Save();
+  }
+  /* -- Save everything now then carry on writing behind if we were -------- */
+  size_t SaveNow(void)
+  { // Remember if the writer was running and save without it
+    const bool bWriter = tWriter.ThreadIsJoinable();
+    const size_t stSaved = SaveAndWait();
+    // Start it again if it was running
+    if(bWriter) WriterStart();
+    // Return number of records saved or updated
+    return stSaved;
   }
   /* ----------------------------------------------------------------------- */
   const string GetInitialVar(const string &strKey)
@@ -668,8 +780,8 @@ static struct CVars final :            // Start of vars class
   void DeInit(void)
   { // Ignore if not initialised
     if(IHNotDeInitialise()) return;
-    // Save all variables
-    Save();
+    // Save all variables and wait for them to be written
+    SaveAndWait();
     // Log result then dereg core variables, they don't need testing
     cLog->LogDebugExSafe("CVars unregistering core variables...",
       GetInternalList().size());
@@ -723,6 +835,10 @@ static struct CVars final :            // Start of vars class
     /* -- Initialisers ----------------------------------------------------- */
     IHelper{ __FUNCTION__ },           // Set function name for init helper
     stMaxInactiveCount(CVAR_MAX),      // Initially set to max cvar count
+    sccWriter{},                       // No writer connection
+    tWriter{ "cvars", STP_LOW,         // Initialise low perf writer thread
+      bind(&CVars::WriterMain,         // " with reference to callback
+        this, _1) },                   // " function
     cvmnsaList{{                       // Set combined lists
       { cvmPending, "unregistered" },  // Inactive cvars list
       { cvmActive,  "registered" } }}, // Active cvars list
@@ -777,6 +893,13 @@ static struct CVars final :            // Start of vars class
     return ACCEPT_HANDLED;
   }
   /* ----------------------------------------------------------------------- */
+  CVarReturn SetWriteBehind(const bool bState)
+  { // Start or stop the writer thread
+    if(bState) WriterStart(); else WriterStop();
+    // Accepted
+    return ACCEPT;
+  }
+  /* ----------------------------------------------------------------------- */
   CVarReturn SetCompatFlags(const bool bEnabled)
   { // Compatibility flags are enabled?
     if(bEnabled)
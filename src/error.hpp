@@ -26,27 +26,25 @@ using namespace IUtf;
 namespace P {                          // Start of public module namespace
 /* ------------------------------------------------------------------------- */
 struct ErrorPluginGeneric final
-  { explicit ErrorPluginGeneric(ostringstream&) { } };
+  { explicit ErrorPluginGeneric(string&) { } };
 /* ------------------------------------------------------------------------- */
 template<class Plugin=ErrorPluginGeneric>class Error final :
   /* -- Derivced classes --------------------------------------------------- */
   public exception,                    // So we can capture as exception
   public string                        // String to store generated string
-{ /* -- Private variables -------------------------------------------------- */
-  ostringstream osS;                   // Error message builder
-  /* -- Write left part of var --------------------------------------------- */
+{ /* -- Write left part of var --------------------------------------------- */
   void Init(const char*const cpName, const char*const cpType)
-    { osS << "\n+ " << cpName << '<' << cpType << "> = "; }
+    { StrFormatTo(*this, "\n+ $<$> = ", cpName, cpType); }
   /* -- Last parameter processed ------------------------------------------- */
-  void Param(void) { const Plugin pPlugin(osS); assign(osS.str()); }
+  void Param(void) { const Plugin pPlugin(*this); }
   /* -- Show integer ------------------------------------------------------- */
   template<typename Type,typename UnsignedType=Type>
     void Int(const char*const cpName, const char*const cpType, const Type tVal)
   { // Write integer to stream
     Init(cpName, cpType);
     // Write value
-    osS << dec << tVal << " (0x" << hex
-        << static_cast<UnsignedType>(tVal) << ").";
+    StrFormatTo(*this, "$ (0x$$).", tVal, hex,
+      static_cast<UnsignedType>(tVal));
   }
   /* ----------------------------------------------------------------------- */
 #if defined(WINDOWS)                   // Using windows?
@@ -108,7 +106,7 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
   { // First show as integer
     Int<unsigned int>(cpName, "UInt8", static_cast<unsigned int>(ucByte));
     // Display only if valid
-    if(ucByte > 32) osS << " '" << static_cast<char>(ucByte) << "'.";
+    if(ucByte > 32) StrFormatTo(*this, " '$'.", static_cast<char>(ucByte));
     // Process more parameters
     Param(vaVars...);
   }
@@ -119,14 +117,14 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
   { // First show as integer
     Int<int,unsigned int>(cpName, "Int8", static_cast<int>(cByte));
     // Display only if valid
-    if(cByte > 32) osS << " '" << cByte << "'.";
+    if(cByte > 32) StrFormatTo(*this, " '$'.", cByte);
     // Process more parameters
     Param(vaVars...);
   }
   /* -- Show float --------------------------------------------------------- */
   template<typename FloatType>void Float(const char*const cpName,
     const char*const cpType, const FloatType tVal)
-  { Init(cpName, cpType); osS << fixed << tVal << '.'; }
+  { Init(cpName, cpType); StrFormatTo(*this, "$$.", fixed, tVal); }
   /* -- Process 64-bit double ---------------------------------------------- */
   template<typename ...VarArgs>
     void Param(const char*const cpName, const double dVal,
@@ -143,7 +141,7 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
       const VarArgs &...vaVars)
   { // Prepare parameter
     Init(cpName, "Bool");
-    osS << StrFromBoolTF(bFlag) << '.';
+    StrFormatTo(*this, "$.", StrFromBoolTF(bFlag));
     // Process more parameters
     Param(vaVars...);
   } /* -- Process pointer to address --------------------------------------- */
@@ -152,15 +150,15 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
   { // Get StringStream
     Init(cpName, "Ptr");
      // Get variable as a C-string
-    if(!vpPtr) osS << "<Null>";
+    if(!vpPtr) append("<Null>");
     // Valid? Display and translation if neccesary
-#if defined(WINDOWS)                   // Using Windows?
-    else osS << "0x" << vpPtr;         // Windows doesn't put in 0x for us
-#else                                  // Using anything but Windows?
-    else osS << vpPtr;                 // Already puts in 0x for us
+#if defined(WINDOWS)                   // Using Windows? No 0x prefix given
+    else StrFormatTo(*this, "0x$", vpPtr);
+#else                                  // Using anything else? Has 0x prefix
+    else StrFormatTo(*this, "$", vpPtr);
 #endif                                 // Windows check
     // Add full stop
-    osS << '.';
+    push_back('.');
     // Process more parameters
     Param(vaVars...);
   }
@@ -170,13 +168,13 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
   { // Initialise start of string
     Init(cpName, "CStr");
     // Get variable as a C-string
-    if(!cpStr) osS << "<Null>.";
+    if(!cpStr) append("<Null>.");
     // Empty?
-    else if(!*cpStr) osS << "<Empty>.";
+    else if(!*cpStr) append("<Empty>.");
     // Displayable?
-    else if(*cpStr < 32) osS << "<Invalid>.";
+    else if(*cpStr < 32) append("<Invalid>.");
     // Valid? Display and translation if neccesary
-    else osS << '\"' << cpStr << "\".";
+    else StrFormatTo(*this, "\"$\".", cpStr);
     // Process more parameters
     Param(vaVars...);
   }
@@ -187,13 +185,13 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
   { // Initialise start of string
     Init(cpName, "WCStr");
     // Get variable as a C-string
-    if(!wcpStr) osS << "<Null>.";
+    if(!wcpStr) append("<Null>.");
     // Empty?
-    else if(!*wcpStr) osS << "<Empty>.";
+    else if(!*wcpStr) append("<Empty>.");
     // Displayable?
-    else if(*wcpStr < 32) osS << "<Invalid>.";
+    else if(*wcpStr < 32) append("<Invalid>.");
     // Valid? Display and translation if neccesary
-    else osS << '\"' << UtfFromWide(wcpStr) << "\".";
+    else StrFormatTo(*this, "\"$\".", UtfFromWide(wcpStr));
     // Process more parameters
     Param(vaVars...);
   }
@@ -203,7 +201,7 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
   { // Initialise start of string
     Init(cpName, "Ex");
     // Valid? Display and translation if neccesary
-    osS << e.what() << '.';
+    StrFormatTo(*this, "$.", e.what());
     // Process more parameters
     Param(vaVars...);
   }
@@ -213,17 +211,15 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
   { // Initialise start of string
     Init(cpName, cpType);
     // String is empty?
-    if(tString.empty()) osS << "<Empty>.";
+    if(tString.empty()) append("<Empty>.");
     // String is not displayable?
-    else if(tString.front() < 32) osS << "<Invalid>.";
+    else if(tString.front() < 32) append("<Invalid>.");
     // Valid? Is a string view? (has no capacity())
     else if constexpr(is_same_v<StringType, string_view>)
-      osS << '\"' << tString << '\"' << dec
-                  << " [" << tString.length() << "].";
+      StrFormatTo(*this, "\"$\" [$].", tString, tString.length());
     // Valid? Display string
-    else osS << '\"' << tString << '\"' << dec
-             << " [" << tString.length() << '/'
-             << tString.capacity() << "].";
+    else StrFormatTo(*this, "\"$\" [$/$].", tString, tString.length(),
+      tString.capacity());
   }
   /* -- Process std::string lvalue ----------------------------------------- */
   template<typename ...VarArgs>
@@ -245,11 +241,11 @@ template<class Plugin=ErrorPluginGeneric>class Error final :
   /* -- Prepare error message constructor with C-string--------------------- */
   template<typename ...VarArgs>
     Error(const char*const cpErr, const VarArgs &...vaVars)
-      { osS << cpErr; Param(vaVars...); }
+      { append(cpErr); Param(vaVars...); }
   /* -- Prepare error message constructor with STL string ------------------ */
   template<typename ...VarArgs>
     Error(const string &strErr, const VarArgs &...vaVars)
-      { osS << strErr; Param(vaVars...); }
+      { append(strErr); Param(vaVars...); }
 };/* -- Helper macro to trigger exceptions --------------------------------- */
 #define XC(r,...) throw Error<>(r, ## __VA_ARGS__)
 /* ------------------------------------------------------------------------- */
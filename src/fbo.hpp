@@ -285,6 +285,18 @@ CTOR_MEM_BEGIN_CSLAVE(Fbos, Fbo, ICHelperUnsafe),
       // <--TexCoord---> <-Vertex (2D)-> <-------Colour (RGBA)------->
     }});
   }
+  /* -- Blit already built triangles that all use the same texture --------- */
+  void FboBlitTris(const GLuint uiTex, const FboTri*const ftpData,
+    const size_t stCount, const GLuint uiTexU, const Shader*const shProgram)
+  { // Ignore if no triangles
+    if(!stCount) return;
+    // Check caches exactly as if the first triangle was blitted normally
+    if(stTrianglesLast == FboGetTrisNow())
+      FboResetCache(uiTex, uiTexU, shProgram->GetProgram());
+    else FboCheckCache(uiTex, uiTexU, shProgram->GetProgram());
+    // Append them all in one copy
+    ftvActive.insert(ftvActive.cend(), ftpData, ftpData + stCount);
+  }
   /* -- Blit the specified triangle of the specifed fbo to this fbo -------- */
   void FboBlitTri(Fbo &fboSrc, const size_t stId)
     { FboBlit(fboSrc.uiFBOtex, fboSrc.FboItemGetVData(stId),
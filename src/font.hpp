@@ -15,14 +15,15 @@ namespace IFont {                      // Start of private namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IAsset::P;             using namespace IBin::P;
 using namespace ICollector::P;         using namespace IDim;
-using namespace IError::P;             using namespace IFboDef::P;
-using namespace IFileMap::P;           using namespace IFreeType::P;
-using namespace IFtf::P;               using namespace IImageDef::P;
-using namespace ILog::P;               using namespace IMemory::P;
-using namespace IOgl::P;               using namespace IParser::P;
-using namespace IPSplit::P;            using namespace IStd::P;
-using namespace IString::P;            using namespace ISysUtil::P;
-using namespace ITexDef::P;            using namespace ITexture::P;
+using namespace IError::P;             using namespace IFbo::P;
+using namespace IFboDef::P;            using namespace IFileMap::P;
+using namespace IFreeType::P;          using namespace IFtf::P;
+using namespace IImageDef::P;          using namespace ILog::P;
+using namespace IMemory::P;            using namespace IOgl::P;
+using namespace IParser::P;            using namespace IPSplit::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISysUtil::P;           using namespace ITexDef::P;
+using namespace ITexture::P;           using namespace IThread::P;
 using namespace IToken::P;             using namespace IUtf;
 using namespace IUtil::P;              using namespace Lib::FreeType;
 using namespace Lib::OS::GlFW;
@@ -83,11 +84,45 @@ class FontBase :                       // Members initially private
       { }
   };/* -- Variables -------------------------------------------------------- */
   typedef vector<Glyph> GlyphVector;   // Vector of Glyphs
-  typedef Pack<GLint> IntPack;         // Bin pack using GLint
+  typedef PackSkyline<GLint> IntPack;  // Skyline bin pack using GLint
   typedef IntPack::Rect IntPackRect;   // Bin pack rectangle
   typedef Rectangle<GLuint> RectUint;  // Reload glyph size
+  /* -- Sparse glyph positions --------------------------------------------- */
+  static constexpr size_t stGlyphDirect = 256; // Chars at a fixed position
+  static constexpr size_t stGlyphPage = 256;   // Chars per page
+  static constexpr size_t stGlyphMax = 0x10FFFF; // Highest unicode char
+  typedef array<size_t, stGlyphPage> GlyphPage; // Positions of page chars
+  typedef unique_ptr<GlyphPage> GlyphPagePtr;   // Allocated on first use
+  typedef vector<GlyphPagePtr> GlyphPages;      // Pages by char / page size
+  /* -- Glyph rendered by the rasteriser thread ---------------------------- */
+  struct GlyphBitmap                   // Members initially public
+  { /* --------------------------------------------------------------------- */
+    Memory         mData;              // 8-bit coverage pixels
+    unsigned int   uiWidth, uiRows;    // Dimensions of coverage pixels
+    FT_BBox        bbData;             // Glyph bounds in pixels
+  };/* --------------------------------------------------------------------- */
+  struct GlyphRaster                   // Members initially public
+  { /* --------------------------------------------------------------------- */
+    size_t         stChar;             // Character that was requested
+    bool           bValid;             // Character exists and was rendered
+    GLfloat        fAdvance;           // Unrounded advance of character
+    array<GlyphBitmap,2> gbData;       // Normal and outline glyph
+  };/* --------------------------------------------------------------------- */
+  typedef deque<size_t> GlyphQueue;    // Characters waiting to be rendered
+  typedef vector<GlyphRaster> GlyphRasters; // Rendered and waiting for atlas
+  typedef set<size_t> GlyphPending;    // Queued or not committed yet
+  /* -- Cached print layout ------------------------------------------------ */
+  struct Layout                        // Members initially public
+  { /* --------------------------------------------------------------------- */
+    FboTriVec      ftvData;            // Triangles that were printed
+    GLfloat        fX, fY,             // Position they were printed at
+                   fResult;            // Value the print function returned
+    size_t         stUsed;             // Value of use counter when last used
+  };/* --------------------------------------------------------------------- */
+  typedef map<string, Layout> LayoutMap; // Layouts by parameters and text
   /* --------------------------------------------------------------- */ public:
   GlyphVector      gvData;             // Glyph and outline data
+  GlyphPages       gpPages;            // Positions of chars above direct
   DimFloat         dfScale,            // Scaled font width and height
                    dfFont;             // Requested font size for OpenGL
   size_t           stMultiplier;       // 1 if no outline, 2 if outline
@@ -101,7 +136,8 @@ class FontBase :                       // Members initially private
   Texture         *tGlyphs;            // Texture for print calls only
   FboItem          fiOutline;          // Outline colour
   OglFilterEnum    ofeFilter;          // Selected texture filter
-  GLuint           uiPadding;          // Padding after each glyph
+  GLuint           uiPadding,          // Padding after each glyph
+                   uiSpread;           // Distance field range in pixels
   /* -- Freetype handles --------------------------------------------------- */
   IntPack          ipData;             // FT packed characters in image
   Ftf              ftfData;            // FT font data
@@ -109,6 +145,27 @@ class FontBase :                       // Members initially private
   /* -- Reload texture parameters ------------------------------------------ */
   enum RTCmd { RT_NONE, RT_FULL, RT_PARTIAL } rtCmd; // Reload texture command
   RectUint         rRedraw;            // Reload cordinates and dimensions
+  /* -- Background rasteriser ---------------------------------------------- */
+  Thread           tRaster;            // Rasteriser thread
+  mutex            mFace,              // Freetype face is in use
+                   mRaster;            // Queue or rasters are in use
+  condition_variable cvRaster;         // Waiting for characters or exit
+  GlyphQueue       gqQueue;            // Characters for rasteriser thread
+  GlyphRasters     grReady;            // Rasters for the atlas
+  GlyphPending     gpPending;          // Characters not in the atlas yet
+  /* -- Statistics --------------------------------------------------------- */
+  size_t           stGlyphsSync,       // Glyphs rendered when printing
+                   stGlyphsAsync,      // Glyphs rendered by thread
+                   stUploads,          // Number of texture uploads
+                   stUploadLast,       // Bytes sent in the last upload
+                   stUploadTotal;      // Bytes sent in all uploads
+  /* -- Cached print layouts ----------------------------------------------- */
+  LayoutMap        lmLayouts;          // Cached print layouts
+  size_t           stLayoutLimit,      // Maximum layouts before evicting
+                   stLayoutGen,        // Changed when atlas changes
+                   stLayoutUsed,       // Incremented when a layout is used
+                   stLayoutHits,       // Prints drawn from the cache
+                   stLayoutMisses;     // Prints that had to be laid out
   /* -- Default constructor ------------------------------------------------ */
   FontBase(void) :                     // No parameters
     /* --------------------------------------------------------------------- */
@@ -119,11 +176,18 @@ class FontBase :                       // Members initially private
     fGPad(0.0f),                       fGPadScaled(0.0f),
     tGlyphs(nullptr),                  fiOutline{ 0xFF000000 },
     ofeFilter(OF_N_N),                 uiPadding(0),
-    ulDefaultChar('?'),                rtCmd(RT_NONE),
+    uiSpread(0),                       ulDefaultChar('?'),
+    rtCmd(RT_NONE),
     rRedraw{
       numeric_limits<GLuint>::max(),
       numeric_limits<GLuint>::max(),
-      0, 0 }
+      0, 0 },
+    tRaster{ STP_LOW },                stGlyphsSync(0),
+    stGlyphsAsync(0),                  stUploads(0),
+    stUploadLast(0),                   stUploadTotal(0),
+    stLayoutLimit(128),                stLayoutGen(0),
+    stLayoutUsed(0),                   stLayoutHits(0),
+    stLayoutMisses(0)
     /* --------------------------------------------------------------------- */
     { }
   /* ----------------------------------------------------------------------- */
@@ -142,7 +206,9 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
 #include "fontblit.hpp"                // Include glyph blitting members inline
   /* -- Check if texture reload required -------------------------- */ private:
   void CheckReloadTexture(void)
-  { // Check reload command
+  { // Put glyphs from the rasteriser thread in the atlas
+    GlyphCommitReady();
+    // Check reload command
     switch(rtCmd)
     { // No reload so just return
       case RT_NONE: return;
@@ -152,6 +218,8 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
         rtCmd = RT_NONE;
         // Full reload of texture
         ReloadTexture();
+        // Record bytes sent
+        GlyphUploaded(DimGetWidth() * DimGetHeight() * 2);
         // Log that we reuploaded the texture
         cLog->LogDebugExSafe("Font '$' full texture reload (S:$,$).",
           IdentGet(), DimGetWidth(), DimGetHeight());
@@ -173,6 +241,10 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
           static_cast<GLsizei>(rRedraw.RectGetX2() - rRedraw.RectGetX1()),
           static_cast<GLsizei>(rRedraw.RectGetY2() - rRedraw.RectGetY1()),
           GetPixelType(), ucpSrc, DimGetWidth<GLsizei>());
+        // Record bytes sent
+        GlyphUploaded(
+          (rRedraw.RectGetX2() - rRedraw.RectGetX1()) *
+          (rRedraw.RectGetY2() - rRedraw.RectGetY1()) * 2);
         // Log that we partially reuploaded the texture
         cLog->LogDebugExSafe("Font '$' partial re-upload (B:$,$,$,$;P:$).",
           IdentGet(), rRedraw.RectGetX1(), rRedraw.RectGetY1(),
@@ -247,8 +319,8 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
     CheckReloadTexture();
     // Log success
     cLog->LogDebugExSafe(
-      "Font '$' finished pre-caching character range $ to $.",
-      IdentGet(), stStart, stEnd);
+      "Font '$' finished pre-caching character range $ to $ (G:$;M:$).",
+      IdentGet(), stStart, stEnd, GetCharCount(), GlyphMemory());
   }
   /* -- Do initialise all freetype characters in specified string ---------- */
   void InitFTCharString(const GLubyte*const ucpPtr)
@@ -259,6 +331,41 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
     // Check if any textures need reloading
     CheckReloadTexture();
   }
+  /* -- Queue specified freetype character range for rasteriser thread ----- */
+  void PrefetchFTCharRange(const size_t stStart, const size_t stEnd)
+  { // Ignore if not a freetype font.
+    if(!ftfData.IsLoaded()) return;
+    // Queue the specified character range
+    for(size_t stIndex = stStart; stIndex < stEnd; ++stIndex)
+      GlyphPrefetch(stIndex);
+    // Wake the rasteriser thread
+    GlyphPrefetchStart();
+  }
+  /* -- Queue all freetype characters in string for rasteriser thread ------ */
+  void PrefetchFTCharString(const GLubyte*const ucpPtr)
+  { // Ignore if string not valid or font not loaded
+    if(UtfIsCStringNotValid(ucpPtr) || !ftfData.IsLoaded()) return;
+    // Queue every character in the string
+    UtfDecoder utfRef{ ucpPtr };
+    while(const unsigned int uiChar = utfRef.Next()) GlyphPrefetch(uiChar);
+    // Wake the rasteriser thread
+    GlyphPrefetchStart();
+  }
+  /* -- Get glyph statistics ----------------------------------------------- */
+  size_t GetGlyphsSync(void) const { return stGlyphsSync; }
+  size_t GetGlyphsAsync(void) const { return stGlyphsAsync; }
+  size_t GetGlyphsPending(void) const { return gpPending.size(); }
+  size_t GetUploads(void) const { return stUploads; }
+  size_t GetUploadLast(void) const { return stUploadLast; }
+  size_t GetUploadTotal(void) const { return stUploadTotal; }
+  /* -- Set maximum cached print layouts ----------------------------------- */
+  void SetLayoutLimit(const size_t stLimit)
+    { stLayoutLimit = stLimit; LayoutFlush(); }
+  /* -- Get print layout cache statistics ---------------------------------- */
+  size_t GetLayoutLimit(void) const { return stLayoutLimit; }
+  size_t GetLayoutCount(void) const { return lmLayouts.size(); }
+  size_t GetLayoutHits(void) const { return stLayoutHits; }
+  size_t GetLayoutMisses(void) const { return stLayoutMisses; }
   /* -- Do initialise freetype font ---------------------------------------- */
   void InitFTFont(Ftf &_ftfData, const GLuint uiISize, const GLuint _uiPadding,
     const OglFilterEnum _ofeFilter, const ImageFlagsConst &ffFlags)
@@ -299,6 +406,13 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
     // thus doubling the size of the glyph data/texture coord lists. The
     // multiplier is already 1 by default so this just makes it equal 2.
     if(ftfData.IsOutline()) stMultiplier = 2;
+    // Distance field glyphs need room around them for the distance to fall
+    // off. With an outline the range is twice the outline width so that the
+    // outline edge always lands on the same value in the shader.
+    if(FlagIsSet(FF_SDF))
+      uiSpread = UtilMaximum(static_cast<GLuint>(ftfData.IsOutline() ?
+        ceil(ftfData.GetOutline() * 2) : ceil(dfFont.DimGetHeight() / 8)),
+          ftfData.IsOutline() ? 1U : 4U);
     // Set default scaled font size and line spacing adjust
     SetSize(1.0f);
     // Set initial size of image. The image size starts here and can
@@ -470,6 +584,8 @@ CTOR_MEM_BEGIN(Fonts, Font, ICHelperUnsafe, /* n/a */),
     ICHelperFont{ cFonts }             // Initially unregistered
     /* --------------------------------------------------------------------- */
     { }                                // Do nothing else
+  /* -- Destructor (stop the rasteriser before anything is freed) ---------- */
+  ~Font(void) { GlyphPrefetchStop(); }
   /* ----------------------------------------------------------------------- */
   DELETECOPYCTORS(Font)                // Omit copy constructor for safety
 };/* ----------------------------------------------------------------------- */
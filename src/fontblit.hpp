@@ -512,6 +512,111 @@ bool PrintSanityCheck(const UtfDecoder &utfRef, const Texture*const tGlyph)
   // Return if there are characters to process
   return true;
 }
+/* -- Remove all cached layouts -------------------------------------------- */
+void LayoutFlush(void) { lmLayouts.clear(); ++stLayoutGen; }
+/* -- Build cache key from everything that changes the output -------------- */
+string LayoutKey(const char cType, const GLfloat fW, const GLfloat fI,
+  const GLubyte*const ucpStr)
+{ // Parameters and colours that the triangles depend on
+  const array<GLfloat,6> aParams{ fW, fI, fScale, fCharSpacing, fLineSpacing,
+    fGPad };
+  const QuadColData &qcdFont = FboItemGetCData(),
+                    &qcdOutline = fiOutline.FboItemGetCData();
+  const char*const cpStr = reinterpret_cast<const char*>(ucpStr);
+  // Put them all together with the string
+  string strKey;
+  strKey.reserve(1 + sizeof(aParams) + sizeof(qcdFont) + sizeof(qcdOutline) +
+    strlen(cpStr));
+  strKey.push_back(cType);
+  strKey.append(reinterpret_cast<const char*>(aParams.data()),
+    sizeof(aParams));
+  strKey.append(reinterpret_cast<const char*>(qcdFont.data()),
+    sizeof(qcdFont));
+  strKey.append(reinterpret_cast<const char*>(qcdOutline.data()),
+    sizeof(qcdOutline));
+  strKey.append(cpStr);
+  // Return key
+  return strKey;
+}
+/* -- Blit a cached layout if there is one --------------------------------- */
+bool LayoutReplay(const string &strKey, const GLfloat fX, const GLfloat fY,
+  GLfloat &fResult)
+{ // Find the layout and return if we haven't seen it yet
+  const LayoutMap::iterator lmiIt{ lmLayouts.find(strKey) };
+  if(lmiIt == lmLayouts.end()) { ++stLayoutMisses; return false; }
+  Layout &lRef = lmiIt->second;
+  // Move the stored triangles if the text moved since last time so that
+  // next time it doesn't move it's just a copy.
+  if(fX != lRef.fX || fY != lRef.fY)
+  { const GLfloat fXA = fX - lRef.fX, fYA = fY - lRef.fY;
+    for(FboTri &ftRef : lRef.ftvData)
+      for(FboVert &fvRef : ftRef)
+        { fvRef.faVertex[0] += fXA; fvRef.faVertex[1] += fYA; }
+    lRef.fX = fX;
+    lRef.fY = fY; }
+  // Add all the triangles to the active fbo in one go
+  FboActive()->FboBlitTris(GetSubName(), lRef.ftvData.data(),
+    lRef.ftvData.size(), 0, shProgram);
+  // Success
+  lRef.stUsed = ++stLayoutUsed;
+  ++stLayoutHits;
+  fResult = lRef.fResult;
+  return true;
+}
+/* -- Store a layout evicting the least recently used one if full ---------- */
+void LayoutStore(string &strKey, const FboTriVec &ftvRef,
+  const size_t stStart, const GLfloat fX, const GLfloat fY,
+  const GLfloat fResult)
+{ // Triangles that were added by the print
+  const FboTriVec::const_iterator ftvciBegin{ ftvRef.cbegin() +
+    static_cast<ssize_t>(stStart) };
+  // Not full yet? Just add a new layout
+  if(lmLayouts.size() < stLayoutLimit)
+  { lmLayouts.insert({ StdMove(strKey), { FboTriVec{ ftvciBegin,
+      ftvRef.cend() }, fX, fY, fResult, ++stLayoutUsed } });
+    return; }
+  // Find the least recently used layout
+  LayoutMap::iterator lmiOldest{ lmLayouts.begin() };
+  for(LayoutMap::iterator lmiIt{ next(lmiOldest) };
+    lmiIt != lmLayouts.end(); ++lmiIt)
+      if(lmiIt->second.stUsed < lmiOldest->second.stUsed) lmiOldest = lmiIt;
+  // Take it out and reuse its memory for the new layout so text that
+  // changes every frame does not keep allocating.
+  LayoutMap::node_type ntNode{ lmLayouts.extract(lmiOldest) };
+  ntNode.key().assign(strKey);
+  Layout &lRef = ntNode.mapped();
+  lRef.ftvData.assign(ftvciBegin, ftvRef.cend());
+  lRef.fX = fX;
+  lRef.fY = fY;
+  lRef.fResult = fResult;
+  lRef.stUsed = ++stLayoutUsed;
+  lmLayouts.insert(StdMove(ntNode));
+}
+/* -- Print through the layout cache --------------------------------------- */
+template<class PrintFunc>GLfloat LayoutPrint(const char cType,
+  const GLfloat fX, const GLfloat fY, const GLfloat fW, const GLfloat fI,
+  const GLubyte*const ucpStr, const PrintFunc &pfFunc)
+{ // Print normally if caching disabled or control characters are used as
+  // they change the font colours and use other textures.
+  if(!stLayoutLimit ||
+     strchr(reinterpret_cast<const char*>(ucpStr), '\r'))
+    return pfFunc();
+  // Draw it from the cache if we can
+  string strKey{ LayoutKey(cType, fW, fI, ucpStr) };
+  GLfloat fResult;
+  if(LayoutReplay(strKey, fX, fY, fResult)) return fResult;
+  // Print it and record what triangles were added
+  const FboTriVec &ftvRef = FboActive()->ftvActive;
+  const size_t stStart = ftvRef.size(), stGen = stLayoutGen;
+  fResult = pfFunc();
+  // Don't store if glyphs were loaded as earlier triangles could have had
+  // texture co-ordinates from before the atlas grew.
+  if(stGen != stLayoutGen) return fResult;
+  // Store the layout
+  LayoutStore(strKey, ftvRef, stStart, fX, fY, fResult);
+  // Return result from print function
+  return fResult;
+}
 /* -- Print string of textures, wrap at width, return height ------- */ public:
 GLfloat PrintW(const GLfloat fX, const GLfloat fY, const GLfloat fW,
   const GLfloat fI, const GLubyte*const ucpStr)
@@ -521,8 +626,11 @@ GLfloat PrintW(const GLfloat fX, const GLfloat fY, const GLfloat fW,
   if(PrintSanityCheck(utfRef)) return fLineSpacingHeight;
   // Push tint
   FboItemPushQuadColour();
-  // Print with width
-  const GLfloat fHeight = DoPrintW(fX, fY, fW, fI, utfRef);
+  // Print with width. The wrap position is absolute so the key needs it to
+  // be relative to the text.
+  const GLfloat fHeight = LayoutPrint('W', fX, fY, fW - fX, fI, ucpStr,
+    [this, fX, fY, fW, fI, &utfRef]
+      { return DoPrintW(fX, fY, fW, fI, utfRef); });
   // Restore colour intensity
   FboItemPopQuadColour();
   // Check if texture needs reloading
@@ -762,7 +870,8 @@ void Print(const GLfloat fX, const GLfloat fY, const GLubyte*const ucpStr)
   // Save colour intensity
   FboItemPushQuadColour();
   // Print the utf string
-  DoPrint(fX, fY, fX, utfRef);
+  LayoutPrint('P', fX, fY, 0.0f, 0.0f, ucpStr, [this, fX, fY, &utfRef]
+    { DoPrint(fX, fY, fX, utfRef); return 0.0f; });
   // Restore colour intensity
   FboItemPopQuadColour();
   // Check if texture needs reloading
@@ -777,7 +886,8 @@ void PrintR(const GLfloat fX, const GLfloat fY, const GLubyte*const ucpStr)
   // Push tint
   FboItemPushQuadColour();
   // Print the string
-  DoPrintR(fX, fY, utfRef);
+  LayoutPrint('R', fX, fY, 0.0f, 0.0f, ucpStr, [this, fX, fY, &utfRef]
+    { DoPrintR(fX, fY, utfRef); return 0.0f; });
   // Restore colour intensity
   FboItemPopQuadColour();
   // Check if texture needs reloading
@@ -122,42 +122,37 @@ struct HandleGlyphFunc                 // Members initially public
   struct Auto                          // Members initially public
   { /* --------------------------------------------------------------------- */
     template<class StrokerCheckFuncType, class RoundCheckFuncType>
-      size_t DoHandleGlyph(Font*const fP, const size_t stChar,
-        const size_t stPos)
-          { return fP->DoSelectFontType<StrokerCheckFuncType,
-              RoundCheckFuncType>(stChar, stPos); }
+      size_t DoHandleGlyph(Font*const fP, const size_t stChar)
+        { return fP->DoSelectFontType<StrokerCheckFuncType,
+            RoundCheckFuncType>(stChar); }
   };/* -- Freetype font selector functor ----------------------------------- */
   struct FreeType                     // Members initially public
   { /* --------------------------------------------------------------------- */
     template<class StrokerCheckFuncType, class RoundCheckFuncType>
-      size_t DoHandleGlyph(Font*const fP, const size_t stChar,
-        const size_t stPos)
-          { return fP->DoHandleFTGlyph<StrokerCheckFuncType,
-              RoundCheckFuncType>(stChar, stPos); }
+      size_t DoHandleGlyph(Font*const fP, const size_t stChar)
+        { return fP->DoHandleFTGlyph<StrokerCheckFuncType,
+            RoundCheckFuncType>(stChar); }
   };/* -- Standard glyph font selector functor ----------------------------- */
   struct Glyph                        // Members initially public
   { /* --------------------------------------------------------------------- */
     template<class StrokerCheckFuncType, class RoundCheckFuncType>
-      size_t DoHandleGlyph(Font*const fP, const size_t stChar,
-        const size_t stPos)
-          { return fP->DoHandleStaticGlyph(stChar, stPos); }
+      size_t DoHandleGlyph(Font*const fP, const size_t stChar)
+        { return fP->DoHandleStaticGlyph(stChar); }
   };/* --------------------------------------------------------------------- */
 };                                    // End of HandleGlyphFunc
 /* -- Render Glyph to Memory ----------------------------------------------- */
-void GlyphToTexture(const IntPackRect &iprRef, const FT_Bitmap &ftbRef,
+void GlyphToTexture(const IntPackRect &iprRef, const GlyphBitmap &gbRef,
   CoordData &cdRef, Memory &mDst)
 { // Get source and destination sizes and return if they're different
   const size_t
-    stSrcWidth  = static_cast<size_t>(ftbRef.width),
-    stSrcHeight = static_cast<size_t>(ftbRef.rows),
+    stSrcWidth  = static_cast<size_t>(gbRef.uiWidth),
+    stSrcHeight = static_cast<size_t>(gbRef.uiRows),
     stDstWidth  = iprRef.DimGetWidth<size_t>(),
     stDstHeight = iprRef.DimGetHeight<size_t>();
   if(stSrcWidth != stDstWidth || stSrcHeight != stDstHeight) return;
   // Get destination X and Y position as size_t
   const size_t stDstX = iprRef.CoordGetX<size_t>(),
                stDstY = iprRef.CoordGetY<size_t>();
-  // Put glyph data and size in a managed class
-  const MemConst mcSrc{ stSrcWidth * stSrcHeight, ftbRef.buffer };
   // For each pixel row of glyph image
   for(size_t stPixPosY = 0; stPixPosY < stSrcHeight; ++stPixPosY)
   { // For each pixel column of glyph image
@@ -173,8 +168,8 @@ void GlyphToTexture(const IntPackRect &iprRef, const FT_Bitmap &ftbRef,
       // This will obviously need to be revised if compiling on big-endian.
       const size_t stSrcPos =
         CoordsToAbsolute(stPixPosX, stPixPosY, stSrcWidth);
-      const uint16_t usPixel = static_cast<uint16_t>(
-        static_cast<int>(mcSrc.MemReadInt<uint8_t>(stSrcPos)) << 8 | 0xFF);
+      const uint16_t usPixel = static_cast<uint16_t>(static_cast<int>(
+        gbRef.mData.MemReadInt<uint8_t>(stSrcPos)) << 8 | 0xFF);
       // ...and the final offset position value
       const size_t stDstPos =
         CoordsToAbsolute(stPosX, stPosY, DimGetWidth(), 2);
@@ -198,10 +193,119 @@ void GlyphToTexture(const IntPackRect &iprRef, const FT_Bitmap &ftbRef,
   tdT1[2] = tdT2[0] = tdT2[4] = fMaxX / fBW; // Right
   tdT1[5] = tdT2[1] = tdT2[3] = fMaxY / fBH; // Bottom
 }
-/* -- Do load character function ------------------------------------------- */
+/* -- Squared distance transform of one row or column ---------------------- */
+static void GlyphDistanceLine(const GLfloat*const fpSrc, GLfloat*const fpDst,
+  const size_t stCount, size_t*const stpRoot, GLfloat*const fpBound)
+{ // Find the lower envelope of the parabolas rooted at each sample. This is
+  // Felzenszwalb and Huttenlocher's linear time exact algorithm.
+  const GLfloat fInf = numeric_limits<GLfloat>::infinity();
+  const auto Intersect = [fpSrc](const size_t stQ, const size_t stV)
+  { const GLfloat fQ = static_cast<GLfloat>(stQ),
+                  fV = static_cast<GLfloat>(stV);
+    return ((fpSrc[stQ] + fQ * fQ) - (fpSrc[stV] + fV * fV)) /
+      (2.0f * fQ - 2.0f * fV); };
+  size_t stK = 0;
+  stpRoot[0] = 0;
+  fpBound[0] = -fInf;
+  fpBound[1] = fInf;
+  for(size_t stQ = 1; stQ < stCount; ++stQ)
+  { GLfloat fS = Intersect(stQ, stpRoot[stK]);
+    while(fS <= fpBound[stK]) fS = Intersect(stQ, stpRoot[--stK]);
+    stpRoot[++stK] = stQ;
+    fpBound[stK] = fS;
+    fpBound[stK + 1] = fInf;
+  } // Sample the envelope
+  stK = 0;
+  for(size_t stQ = 0; stQ < stCount; ++stQ)
+  { const GLfloat fQ = static_cast<GLfloat>(stQ);
+    while(fpBound[stK + 1] < fQ) ++stK;
+    const GLfloat fD = fQ - static_cast<GLfloat>(stpRoot[stK]);
+    fpDst[stQ] = fD * fD + fpSrc[stpRoot[stK]];
+  }
+}
+/* -- Squared distance transform of a grid --------------------------------- */
+static void GlyphDistanceGrid(vector<GLfloat> &vGrid, const size_t stWidth,
+  const size_t stHeight)
+{ // Scratch space for the longest side
+  const size_t stMax = UtilMaximum(stWidth, stHeight);
+  vector<GLfloat> vSrc(stMax), vDst(stMax), vBound(stMax + 1);
+  vector<size_t> vRoot(stMax);
+  // Transform each column
+  for(size_t stX = 0; stX < stWidth; ++stX)
+  { for(size_t stY = 0; stY < stHeight; ++stY)
+      vSrc[stY] = vGrid[CoordsToAbsolute(stX, stY, stWidth)];
+    GlyphDistanceLine(vSrc.data(), vDst.data(), stHeight, vRoot.data(),
+      vBound.data());
+    for(size_t stY = 0; stY < stHeight; ++stY)
+      vGrid[CoordsToAbsolute(stX, stY, stWidth)] = vDst[stY];
+  } // Transform each row
+  for(size_t stY = 0; stY < stHeight; ++stY)
+  { GLfloat*const fpRow = vGrid.data() + stY * stWidth;
+    memcpy(vSrc.data(), fpRow, stWidth * sizeof(GLfloat));
+    GlyphDistanceLine(vSrc.data(), fpRow, stWidth, vRoot.data(),
+      vBound.data());
+  }
+}
+/* -- Convert glyph coverage to a signed distance field -------------------- */
+void GlyphToDistance(GlyphBitmap &gbRef)
+{ // Source size and the size with room for the distance to fall off
+  const size_t
+    stSpread    = static_cast<size_t>(uiSpread),
+    stSrcWidth  = static_cast<size_t>(gbRef.uiWidth),
+    stSrcHeight = static_cast<size_t>(gbRef.uiRows),
+    stWidth     = stSrcWidth + stSpread * 2,
+    stHeight    = stSrcHeight + stSpread * 2,
+    stTotal     = stWidth * stHeight;
+  // Squared distances to the nearest pixel inside and outside the glyph.
+  // Every pixel starts as far away as possible from the other side.
+  const GLfloat fFar = 1e20f;
+  vector<GLfloat> vOutside(stTotal, fFar), vInside(stTotal, 0.0f);
+  for(size_t stY = 0; stY < stSrcHeight; ++stY)
+    for(size_t stX = 0; stX < stSrcWidth; ++stX)
+      if(gbRef.mData.MemReadInt<uint8_t>(
+           CoordsToAbsolute(stX, stY, stSrcWidth)) >= 0x80)
+      { const size_t stPos =
+          CoordsToAbsolute(stX + stSpread, stY + stSpread, stWidth);
+        vOutside[stPos] = 0.0f;
+        vInside[stPos] = fFar; }
+  GlyphDistanceGrid(vOutside, stWidth, stHeight);
+  GlyphDistanceGrid(vInside, stWidth, stHeight);
+  // Map the signed distance so the edge is at 0.5 and the spread reaches
+  // zero outside and one inside. The half pixel puts the edge between the
+  // last pixel inside and the first pixel outside.
+  const GLfloat fRange = static_cast<GLfloat>(stSpread * 2);
+  Memory mDst{ stTotal };
+  for(size_t stPos = 0; stPos < stTotal; ++stPos)
+  { const GLfloat fDist = vOutside[stPos] > 0.0f ?
+      sqrtf(vOutside[stPos]) - 0.5f : 0.5f - sqrtf(vInside[stPos]);
+    mDst.MemWriteInt<uint8_t>(stPos, static_cast<uint8_t>(
+      UtilClamp(0.5f - fDist / fRange, 0.0f, 1.0f) * 255.0f + 0.5f));
+  } // Replace the glyph and grow its bounds by the spread
+  gbRef.mData.MemSwap(mDst);
+  gbRef.uiWidth = static_cast<unsigned int>(stWidth);
+  gbRef.uiRows = static_cast<unsigned int>(stHeight);
+  gbRef.bbData.xMin -= static_cast<FT_Pos>(stSpread);
+  gbRef.bbData.yMin -= static_cast<FT_Pos>(stSpread);
+  gbRef.bbData.xMax += static_cast<FT_Pos>(stSpread);
+  gbRef.bbData.yMax += static_cast<FT_Pos>(stSpread);
+}
+/* -- Point distance field outline at its glyph ---------------------------- */
+void GlyphShareCoords(const size_t stPos)
+{ // Same texture co-ordinates moved one to the right which tells the shader
+  // to use the outline edge.
+  CoordData &cdOutline = clTiles[0][stPos + 1];
+  cdOutline = clTiles[0][stPos];
+  for(TriCoordData &tdRef : cdOutline)
+    for(size_t stFltId = 0; stFltId < stFloatsPerCoord; stFltId += 2)
+      tdRef[stFltId] += 1.0f;
+}
+/* -- Use distance field glyph as its own outline -------------------------- */
+void GlyphShareOutline(const size_t stPos)
+  { gvData[stPos + 1] = gvData[stPos]; GlyphShareCoords(stPos); }
+/* -- Render character in glyph slot to a bitmap --------------------------- */
 template<class StrokerFuncType>
-  void DoInitFTChar(FT_GlyphSlot &ftgsRef, const size_t stPos,
-    const size_t stChar, const GLfloat fAdvance)
+  void GlyphRasterise(FT_GlyphSlot &ftgsRef, const size_t stChar,
+    GlyphBitmap &gbRef)
 { // Move The Face's Glyph Into A Glyph Object to get outline
   FT_Glyph gData;
   cFreeType->CheckError(FT_Get_Glyph(ftgsRef, &gData),
@@ -210,11 +314,13 @@ template<class StrokerFuncType>
   typedef unique_ptr<FT_GlyphRec_,
     function<decltype(FT_Done_Glyph)>> GlyphPtr;
   if(GlyphPtr gPtr{ gData, FT_Done_Glyph })
-  { // Apply glyph border if requested
-    cFreeType->CheckError(StrokerFuncType{ gData,
-      ftfData.GetStroker() }.Result(),
-      "Failed to apply outline to glyph!",
-      "Identifier", IdentGet(), "Glyph", stChar);
+  { // Apply glyph border if requested. Distance field outlines are drawn by
+    // the shader from the same glyph so they never need stroking.
+    if(!uiSpread)
+      cFreeType->CheckError(StrokerFuncType{ gData,
+        ftfData.GetStroker() }.Result(),
+        "Failed to apply outline to glyph!",
+        "Identifier", IdentGet(), "Glyph", stChar);
     // Convert The Glyph To A Image.
     cFreeType->CheckError(FT_Glyph_To_Bitmap(&gData, FT_RENDER_MODE_NORMAL,
       nullptr, true),
@@ -225,151 +331,183 @@ template<class StrokerFuncType>
     // unique_ptr dtor knows to destroy the new one.
     gPtr.release();
     gPtr.reset(gData);
-    // Get glyph data class and set advanced and status to loaded
-    Glyph &gRef = gvData[stPos];
-    gRef.GlyphSetLoaded();
-    gRef.GlyphSetAdvance(fAdvance);
-    // Access image information and if has dimensions?
+    // Access image information and return if it has no dimensions
     const FT_Bitmap &bData = reinterpret_cast<FT_BitmapGlyph>(gData)->bitmap;
-    if(bData.width > 0 && bData.rows > 0)
-    { // Get glyph outline origins
-      FT_BBox bbData;
-      FT_Glyph_Get_CBox(gData, FT_GLYPH_BBOX_PIXELS, &bbData);
-      // Set glyph size
-      gRef.DimSet(static_cast<GLfloat>(bData.width),
-                  static_cast<GLfloat>(bData.rows));
-      // Set glyph bounds
-      gRef.RectSet(static_cast<GLfloat>(bbData.xMin),
-        -static_cast<GLfloat>(static_cast<int>(bData.rows)+bbData.yMin)+
-           dfFont.DimGetHeight(),
-         static_cast<GLfloat>(bbData.xMax),
-        -static_cast<GLfloat>(bbData.yMin)+dfFont.DimGetHeight());
-      // Calculate size plus padding and return if size not set
-      const GLuint uiWidth = bData.width + uiPadding,
-                   uiHeight = bData.rows + uiPadding;
-      // Get image slot and data we're writing to
-      ImageSlot &isRef = GetSlots().front();
-      // Get texcoord data
-      CoordData &cdRef = clTiles[0][stPos];
-      // Put this glyph in the bin packer and if succeeded
-      IntPackRect iprNew{ ipData.Insert(uiWidth, uiHeight) };
-      if(iprNew.DimGetHeight() > 0)
-      { // The result rect will include padding so remove it
-        iprNew.DimDecWidth(static_cast<int>(uiPadding));
-        iprNew.DimDecHeight(static_cast<int>(uiPadding));
-        // Copy the glyph to texture atlast
-        GlyphToTexture(iprNew, bData, cdRef, isRef);
-        // Full redraw not already specified?
-        if(rtCmd != RT_FULL)
-        { // Set partial redraw
-          rtCmd = RT_PARTIAL;
-          // Set lowest most left bound
-          if(iprNew.CoordGetX<GLuint>() < rRedraw.RectGetX1())
-            rRedraw.RectSetX1(iprNew.CoordGetX<GLuint>());
-          // Set lowest most top bound
-          if(iprNew.CoordGetY<GLuint>() < rRedraw.RectGetY1())
-            rRedraw.RectSetY1(iprNew.CoordGetY<GLuint>());
-          // Set highest most right bound
-          const GLuint uiX2 = static_cast<GLuint>(iprNew.CoordGetX() +
-            iprNew.DimGetWidth());
-          if(uiX2 > rRedraw.RectGetX2()) rRedraw.RectSetX2(uiX2);
-          // Set highest most bottom bound
-          const GLuint uiY2 = static_cast<GLuint>(iprNew.CoordGetY() +
-            iprNew.DimGetHeight());
-          if(uiY2 > rRedraw.RectGetY2()) rRedraw.RectSetY2(uiY2);
-        }
-      } // Failed
-      else
-      { // Get next biggest size from bounds
-        const GLuint uiSize =
-          GetMaxTexSizeFromBounds(ipData.DimGetWidth<GLuint>(),
-            ipData.DimGetHeight<GLuint>(), uiWidth, uiHeight, 2);
-        const GLuint uiMaximum = cOgl->MaxTexSize();
-        // Makle sure the size is supported by graphics
-        if(uiSize > uiMaximum)
-          XC("Cannot grow font texture any further due to GPU limitation!",
-             "BinWidth",     bData.width, "BinHeight",     bData.rows,
-             "BinWidth+Pad", uiWidth,     "BinHeight+Pad", uiHeight,
-             "Requested",    uiSize,      "Maximum",       uiMaximum);
-        // Double the size taking into account that the requested glyph size
-        // must fit inside it as well and the video card maximum texture
-        // space must support the glyph as well. Then try placing it in the
-        // bin again and if it still failed then there is nothing more we can
-        // do for now.
-        ipData.Resize(uiSize, uiSize);
-        iprNew = ipData.Insert(uiWidth, uiHeight);
-        if(iprNew.DimGetHeight() <= 0)
-          XC("No texture space left for glyph!",
-             "Identifier", IdentGet(),        "Glyph",   stChar,
-             "Width",      bData.width,       "Height",  bData.rows,
-             "Occupancy",  ipData.Occupancy(),"Maximum", cOgl->MaxTexSize());
-        // THe result rect will include padding so remove it
-        iprNew.DimDecWidth(static_cast<int>(uiPadding));
-        iprNew.DimDecHeight(static_cast<int>(uiPadding));
-        // We need to make a new image because we need to modify the data in
-        // the old obsolete image.
-        Memory mDst{ ipData.DimGetWidth<size_t>() *
-                     ipData.DimGetHeight<size_t>() * 2 };
-        // We need to fill it with transparent white pixels, since we can't
-        // use memset, we'll use fill instead. !FIXME: Don't need to write to
-        // 'all' pixels, just the new ones.
-        mDst.MemFill<uint16_t>(0x00FF);
-        // Copy scanlines from the old image
-        for(size_t stY = 0,
-                   stBWidthx2 = DimGetWidth() * 2,
-                   stBinWidth = ipData.DimGetWidth<size_t>();
-                   stY < DimGetHeight() ;
-                 ++stY)
-        { // Calculate source and destination position and copy the scanline
-          const size_t stSrcPos = (DimGetWidth() * stY) * 2,
-                       stDestPos = (stBinWidth * stY) * 2;
-          mDst.MemWrite(stDestPos, isRef.MemRead(stSrcPos, stBWidthx2),
-            stBWidthx2);
-        } // This is the new image and the old one will be destroyed
-        const size_t stOldAlloc = isRef.MemSize();
-        isRef.MemSwap(mDst);
-        mDst.MemDeInit();
-        AdjustAlloc(stOldAlloc, isRef.MemSize());
-        // Calculate how much the image increased. This should really be 2
-        // every time but we'll just make a calculation like this just
-        // incase.
-        const unsigned int uiDivisor =
-          ipData.DimGetWidth<unsigned int>() / DimGetWidth();
-        // Update the image dimensions of the font texture
-        DimSet(ipData.DimGetWidth<unsigned int>(),
-               ipData.DimGetHeight<unsigned int>());
-        // Update the dimensions in the image slot class
-        isRef.DimSet(*this);
-        // Now we need to walk through the char datas and reduce the values
-        // by the enlargement factor. A very simple and effective solution.
-        // Note that using transform is ~100% slower than this.
-        StdForEach(par_unseq, clTiles[0].begin(), clTiles[0].end(),
-          [uiDivisor](CoordData &tcI)
-            { for(size_t stTriId = 0; stTriId < stTrisPerQuad; ++stTriId)
-                for(size_t stFltId = 0; stFltId < stFloatsPerCoord; ++stFltId)
-                  tcI[stTriId][stFltId] /= uiDivisor; });
-        // Copy the glyph to texture atlast
-        GlyphToTexture(iprNew, bData, cdRef, isRef);
-        // Re-upload the whole texture to VRAM.
-        rtCmd = RT_FULL;
-        // Say that we resized the image
-        cLog->LogDebugExSafe("Font enlarged '$' by a factor of $ to $x$.",
-          IdentGet(), uiDivisor, DimGetWidth(), DimGetHeight());
-      } // Done with drawing glyph
-    } // Glyph has no dimensions so push default font size
-    else gRef.DimSet(dfFont);
+    gbRef.uiWidth = bData.width;
+    gbRef.uiRows = bData.rows;
+    if(!gbRef.uiWidth || !gbRef.uiRows) return;
+    // Get glyph outline origins
+    FT_Glyph_Get_CBox(gData, FT_GLYPH_BBOX_PIXELS, &gbRef.bbData);
+    // Copy the pixels as they belong to the glyph which is about to be freed
+    const size_t stWidth = static_cast<size_t>(bData.width),
+                 stPitch = static_cast<size_t>(abs(bData.pitch));
+    gbRef.mData = Memory{ stWidth * bData.rows };
+    for(size_t stY = 0; stY < bData.rows; ++stY)
+      gbRef.mData.MemWrite(stY * stWidth, bData.buffer + stY * stPitch,
+        stWidth);
+    // Convert coverage to distance if requested
+    if(uiSpread) GlyphToDistance(gbRef);
   } // Failed to grab pointer to glyph data
   else XC("Failed to get glyph pointer!",
           "Identifier", IdentGet(), "Glyph", stChar);
 }
+/* -- Put rendered character in the texture atlas -------------------------- */
+void GlyphCommit(const GlyphBitmap &gbRef, const size_t stPos,
+  const size_t stChar, const GLfloat fAdvance)
+{ // Texture co-ordinates in cached layouts are about to become stale
+  LayoutFlush();
+  // Get glyph data class and set advanced and status to loaded
+  Glyph &gRef = gvData[stPos];
+  gRef.GlyphSetLoaded();
+  gRef.GlyphSetAdvance(fAdvance);
+  // Glyph has no dimensions so push default font size
+  if(!gbRef.uiWidth || !gbRef.uiRows) return gRef.DimSet(dfFont);
+  // Set glyph size
+  const FT_BBox &bbData = gbRef.bbData;
+  gRef.DimSet(static_cast<GLfloat>(gbRef.uiWidth),
+              static_cast<GLfloat>(gbRef.uiRows));
+  // Set glyph bounds
+  gRef.RectSet(static_cast<GLfloat>(bbData.xMin),
+    -static_cast<GLfloat>(static_cast<int>(gbRef.uiRows)+bbData.yMin)+
+       dfFont.DimGetHeight(),
+     static_cast<GLfloat>(bbData.xMax),
+    -static_cast<GLfloat>(bbData.yMin)+dfFont.DimGetHeight());
+  // Calculate size plus padding and return if size not set
+  const GLuint uiWidth = gbRef.uiWidth + uiPadding,
+               uiHeight = gbRef.uiRows + uiPadding;
+  // Get image slot and data we're writing to
+  ImageSlot &isRef = GetSlots().front();
+  // Get texcoord data
+  CoordData &cdRef = clTiles[0][stPos];
+  // Put this glyph in the bin packer and if succeeded
+  IntPackRect iprNew{ ipData.Insert(uiWidth, uiHeight) };
+  if(iprNew.DimGetHeight() > 0)
+  { // The result rect will include padding so remove it
+    iprNew.DimDecWidth(static_cast<int>(uiPadding));
+    iprNew.DimDecHeight(static_cast<int>(uiPadding));
+    // Copy the glyph to texture atlast
+    GlyphToTexture(iprNew, gbRef, cdRef, isRef);
+    // Full redraw not already specified?
+    if(rtCmd != RT_FULL)
+    { // Set partial redraw
+      rtCmd = RT_PARTIAL;
+      // Set lowest most left bound
+      if(iprNew.CoordGetX<GLuint>() < rRedraw.RectGetX1())
+        rRedraw.RectSetX1(iprNew.CoordGetX<GLuint>());
+      // Set lowest most top bound
+      if(iprNew.CoordGetY<GLuint>() < rRedraw.RectGetY1())
+        rRedraw.RectSetY1(iprNew.CoordGetY<GLuint>());
+      // Set highest most right bound
+      const GLuint uiX2 = static_cast<GLuint>(iprNew.CoordGetX() +
+        iprNew.DimGetWidth());
+      if(uiX2 > rRedraw.RectGetX2()) rRedraw.RectSetX2(uiX2);
+      // Set highest most bottom bound
+      const GLuint uiY2 = static_cast<GLuint>(iprNew.CoordGetY() +
+        iprNew.DimGetHeight());
+      if(uiY2 > rRedraw.RectGetY2()) rRedraw.RectSetY2(uiY2);
+    }
+  } // Failed
+  else
+  { // Get next biggest size from bounds
+    const GLuint uiSize =
+      GetMaxTexSizeFromBounds(ipData.DimGetWidth<GLuint>(),
+        ipData.DimGetHeight<GLuint>(), uiWidth, uiHeight, 2);
+    const GLuint uiMaximum = cOgl->MaxTexSize();
+    // Makle sure the size is supported by graphics
+    if(uiSize > uiMaximum)
+      XC("Cannot grow font texture any further due to GPU limitation!",
+         "BinWidth",     gbRef.uiWidth, "BinHeight",     gbRef.uiRows,
+         "BinWidth+Pad", uiWidth,       "BinHeight+Pad", uiHeight,
+         "Requested",    uiSize,        "Maximum",       uiMaximum);
+    // Double the size taking into account that the requested glyph size
+    // must fit inside it as well and the video card maximum texture
+    // space must support the glyph as well. Then try placing it in the
+    // bin again and if it still failed then there is nothing more we can
+    // do for now.
+    ipData.Resize(uiSize, uiSize);
+    iprNew = ipData.Insert(uiWidth, uiHeight);
+    if(iprNew.DimGetHeight() <= 0)
+      XC("No texture space left for glyph!",
+         "Identifier", IdentGet(),        "Glyph",   stChar,
+         "Width",      gbRef.uiWidth,     "Height",  gbRef.uiRows,
+         "Occupancy",  ipData.Occupancy(),"Maximum", cOgl->MaxTexSize());
+    // THe result rect will include padding so remove it
+    iprNew.DimDecWidth(static_cast<int>(uiPadding));
+    iprNew.DimDecHeight(static_cast<int>(uiPadding));
+    // We need to make a new image because we need to modify the data in
+    // the old obsolete image.
+    Memory mDst{ ipData.DimGetWidth<size_t>() *
+                 ipData.DimGetHeight<size_t>() * 2 };
+    // We need to fill it with transparent white pixels, since we can't
+    // use memset, we'll use fill instead. !FIXME: Don't need to write to
+    // 'all' pixels, just the new ones.
+    mDst.MemFill<uint16_t>(0x00FF);
+    // Copy scanlines from the old image
+    for(size_t stY = 0,
+               stBWidthx2 = DimGetWidth() * 2,
+               stBinWidth = ipData.DimGetWidth<size_t>();
+               stY < DimGetHeight() ;
+             ++stY)
+    { // Calculate source and destination position and copy the scanline
+      const size_t stSrcPos = (DimGetWidth() * stY) * 2,
+                   stDestPos = (stBinWidth * stY) * 2;
+      mDst.MemWrite(stDestPos, isRef.MemRead(stSrcPos, stBWidthx2),
+        stBWidthx2);
+    } // This is the new image and the old one will be destroyed
+    const size_t stOldAlloc = isRef.MemSize();
+    isRef.MemSwap(mDst);
+    mDst.MemDeInit();
+    AdjustAlloc(stOldAlloc, isRef.MemSize());
+    // Calculate how much the image increased. This should really be 2
+    // every time but we'll just make a calculation like this just
+    // incase.
+    const unsigned int uiDivisor =
+      ipData.DimGetWidth<unsigned int>() / DimGetWidth();
+    // Update the image dimensions of the font texture
+    DimSet(ipData.DimGetWidth<unsigned int>(),
+           ipData.DimGetHeight<unsigned int>());
+    // Update the dimensions in the image slot class
+    isRef.DimSet(*this);
+    // Now we need to walk through the char datas and reduce the values
+    // by the enlargement factor. A very simple and effective solution.
+    // Note that using transform is ~100% slower than this.
+    StdForEach(par_unseq, clTiles[0].begin(), clTiles[0].end(),
+      [uiDivisor](CoordData &tcI)
+        { for(size_t stTriId = 0; stTriId < stTrisPerQuad; ++stTriId)
+            for(size_t stFltId = 0; stFltId < stFloatsPerCoord; ++stFltId)
+              tcI[stTriId][stFltId] /= uiDivisor; });
+    // Distance field outlines are offset from their glyph so redo them
+    if(uiSpread && stMultiplier > 1)
+      for(size_t stIndex = 0; stIndex < clTiles[0].size(); stIndex += 2)
+        GlyphShareCoords(stIndex);
+    // Copy the glyph to texture atlast
+    GlyphToTexture(iprNew, gbRef, cdRef, isRef);
+    // Re-upload the whole texture to VRAM.
+    rtCmd = RT_FULL;
+    // Say that we resized the image
+    cLog->LogDebugExSafe("Font enlarged '$' by a factor of $ to $x$.",
+      IdentGet(), uiDivisor, DimGetWidth(), DimGetHeight());
+  }
+}
+/* -- Do load character function ------------------------------------------- */
+template<class StrokerFuncType>
+  void DoInitFTChar(FT_GlyphSlot &ftgsRef, const size_t stPos,
+    const size_t stChar, const GLfloat fAdvance)
+{ // Render the glyph and put it in the atlas straight away
+  GlyphBitmap gbData{};
+  GlyphRasterise<StrokerFuncType>(ftgsRef, stChar, gbData);
+  GlyphCommit(gbData, stPos, stChar, fAdvance);
+}
 /* -- Initialise freetype char and set types ------------------------------- */
 template<class StrokerFuncNormalType, class StrokerFuncOutlineType>
   void DoInitFTCharOutline(FT_GlyphSlot &ftgsRef, const size_t stPos,
     const size_t stChar, const GLfloat fAdvance)
 { // Initialise main character
   DoInitFTChar<StrokerFuncNormalType>(ftgsRef, stPos, stChar, fAdvance);
-  // Initialise outline character
-  DoInitFTChar<StrokerFuncOutlineType>(ftgsRef, stPos+1, stChar, fAdvance);
+  // Initialise outline character which distance fields get for free
+  if(uiSpread) GlyphShareOutline(stPos);
+  else DoInitFTChar<StrokerFuncOutlineType>(ftgsRef, stPos+1, stChar,
+    fAdvance);
 }
 /* -- Function to select correct outline method ---------------------------- */
 void DoSelectOutlineType(FT_GlyphSlot &ftgsRef, const size_t stPos,
@@ -384,48 +522,237 @@ void DoSelectOutlineType(FT_GlyphSlot &ftgsRef, const size_t stPos,
   } // No outline, just load as normal
   else InitCharFunc::NoOutline{ this, ftgsRef, stPos, stChar, fAdvance };
 }
+/* -- Grow glyph and texture co-ordinate storage --------------------------- */
+void GlyphGrow(const size_t stSize)
+{ // For some reason, I need to add {} for .resize to invoke the default
+  // 'Glyph' constructor for some reason.
+  gvData.resize(stSize, {});
+  // Extend and initialise storage for gl texture co-ordinates
+  clTiles[0].resize(stSize);
+}
+/* -- Return position of a loaded character or StdMaxSizeT if not ---------- */
+size_t GlyphFind(const size_t stChar) const
+{ // Characters in the direct range are at a fixed position
+  if(stChar < stGlyphDirect)
+  { const size_t stPos = stChar * stMultiplier;
+    return stPos < gvData.size() && gvData[stPos].GlyphIsLoaded() ?
+      stPos : StdMaxSizeT; }
+  // Anything else needs its page to exist
+  const size_t stPage = stChar / stGlyphPage;
+  if(stPage >= gpPages.size() || !gpPages[stPage]) return StdMaxSizeT;
+  // Return position if it is set and finished loading
+  const size_t stPos = (*gpPages[stPage])[stChar % stGlyphPage];
+  return stPos != StdMaxSizeT && gvData[stPos].GlyphIsLoaded() ?
+    stPos : StdMaxSizeT;
+}
+/* -- Set position of a character outside the direct range ----------------- */
+void GlyphSetSparse(const size_t stChar, const size_t stPos)
+{ // Characters beyond unicode are never remembered
+  if(stChar > stGlyphMax) return;
+  // Grow the page list and allocate the page if needed
+  const size_t stPage = stChar / stGlyphPage;
+  if(stPage >= gpPages.size()) gpPages.resize(stPage + 1);
+  GlyphPagePtr &gppRef = gpPages[stPage];
+  if(!gppRef)
+  { gppRef = make_unique<GlyphPage>();
+    gppRef->fill(StdMaxSizeT); }
+  // Set the position
+  (*gppRef)[stChar % stGlyphPage] = stPos;
+}
+/* -- Allocate position for a new character -------------------------------- */
+size_t GlyphAlloc(const size_t stChar)
+{ // Characters in the direct range are at a fixed position. Remember we
+  // need double the space if we're using an outline. Also, a character of
+  // ASCII value 0 is still a character so we got to allocate space for it.
+  if(stChar < stGlyphDirect)
+  { const size_t stPos = stChar * stMultiplier;
+    if(stPos >= gvData.size()) GlyphGrow(stPos + stMultiplier);
+    return stPos;
+  } // Anything else goes after the direct range in the order it was loaded
+  // so a high plane character doesn't need everything before it allocated.
+  const size_t stPos =
+    UtilMaximum(gvData.size(), stGlyphDirect * stMultiplier);
+  GlyphGrow(stPos + stMultiplier);
+  GlyphSetSparse(stChar, stPos);
+  return stPos;
+}
+/* -- Return memory used by glyph storage ---------------------------------- */
+size_t GlyphMemory(void) const
+{ // Add up glyph and co-ordinate storage
+  size_t stBytes = gvData.capacity() * sizeof(Glyph) +
+    clTiles[0].capacity() * sizeof(CoordData) +
+    gpPages.capacity() * sizeof(GlyphPagePtr);
+  // Add allocated pages
+  for(const GlyphPagePtr &gppRef : gpPages)
+    if(gppRef) stBytes += sizeof(GlyphPage);
+  // Return total
+  return stBytes;
+}
+/* -- Queue a character for the rasteriser thread -------------------------- */
+void GlyphPrefetch(const size_t stChar)
+{ // Ignore if invalid, already in the atlas or already queued
+  if(stChar > stGlyphMax || GlyphFind(stChar) != StdMaxSizeT ||
+     !gpPending.insert(stChar).second) return;
+  // Give it to the rasteriser thread
+  const LockGuard lgRaster{ mRaster };
+  gqQueue.push_back(stChar);
+}
+/* -- Start rasteriser thread if needed and wake it up --------------------- */
+void GlyphPrefetchStart(void)
+{ // Ignore if there is nothing to do
+  if(gpPending.empty()) return;
+  // Start the thread on first use
+  if(tRaster.ThreadIsNotJoinable())
+    tRaster.ThreadInit(StrAppend("FR:", IdentGet()),
+      bind(&Font::GlyphRasterThreadMain, this, _1), this);
+  // Wake it up
+  cvRaster.notify_one();
+}
+/* -- Stop rasteriser thread and forget anything not committed ------------- */
+void GlyphPrefetchStop(void)
+{ // Ignore if the thread was never started
+  if(tRaster.ThreadIsNotJoinable()) return;
+  // Signal exit while the thread can't be between checking and waiting
+  { const LockGuard lgRaster{ mRaster };
+    tRaster.ThreadSetExit(); }
+  // Wake it up and wait for it to finish
+  cvRaster.notify_one();
+  tRaster.ThreadDeInit();
+  // Remove anything left over
+  gqQueue.clear();
+  grReady.clear();
+  gpPending.clear();
+}
+/* -- Render a queued character with the selected stroker ------------------ */
+void GlyphRasteriseAsync(GlyphRaster &grRef)
+{ // Nothing to render if the character doesn't exist
+  const FT_UInt uiGl =
+    ftfData.CharToGlyph(static_cast<FT_ULong>(grRef.stChar));
+  if(!uiGl) return;
+  // Load glyph and throw exception on failure
+  cFreeType->CheckError(ftfData.LoadGlyph(uiGl), "Failed to load glyph!",
+    "Identifier", IdentGet(), "Index", grRef.stChar);
+  // Get glyph slot handle and unrounded advance width
+  FT_GlyphSlot ftgsRef = ftfData.GetGlyphData();
+  grRef.fAdvance = static_cast<GLfloat>(ftgsRef->metrics.horiAdvance) / 64;
+  // Render with the same strokers as DoSelectOutlineType() would use
+  if(ftfData.IsStrokerLoaded() && !uiSpread)
+  { // Stroke inside and outside border or just the outside?
+    if(FlagIsSet(FF_STROKETYPE2))
+      GlyphRasterise<StrokerFunc::OutlineInside>(ftgsRef, grRef.stChar,
+        grRef.gbData[0]);
+    else GlyphRasterise<StrokerFunc::NoOutline>(ftgsRef, grRef.stChar,
+      grRef.gbData[0]);
+    // Render the outline
+    GlyphRasterise<StrokerFunc::Outline>(ftgsRef, grRef.stChar,
+      grRef.gbData[1]);
+  } // No outline, just render as normal
+  else GlyphRasterise<StrokerFunc::NoOutline>(ftgsRef, grRef.stChar,
+    grRef.gbData[0]);
+  // Ready for the atlas
+  grRef.bValid = true;
+}
+/* -- Rasteriser thread ---------------------------------------------------- */
+int GlyphRasterThreadMain(Thread &tRef)
+{ // Wait for a character or a request to exit
+  GlyphRaster grNew{};
+  { UniqueLock ulRaster{ mRaster };
+    cvRaster.wait(ulRaster, [this, &tRef]
+      { return !gqQueue.empty() || tRef.ThreadShouldExit(); });
+    if(tRef.ThreadShouldExit()) return 1;
+    grNew.stChar = gqQueue.front();
+    gqQueue.pop_front(); }
+  // Render it while nothing else is using the face. Any failure is left for
+  // the main thread to report when the character is actually printed.
+  try { const LockGuard lgFace{ mFace }; GlyphRasteriseAsync(grNew); }
+  catch(const exception &eReason)
+  { cLog->LogWarningExSafe("Font '$' failed to rasterise $ in thread: $",
+      IdentGet(), grNew.stChar, eReason.what());
+    grNew.bValid = false; }
+  // Hand it over to the main thread for the atlas
+  const LockGuard lgRaster{ mRaster };
+  grReady.emplace_back(StdMove(grNew));
+  // Next character
+  return 0;
+}
+/* -- Put glyphs from the rasteriser thread in the atlas ------------------- */
+void GlyphCommitReady(void)
+{ // Ignore if nothing was queued
+  if(gpPending.empty()) return;
+  // Take the glyphs that are ready
+  GlyphRasters grList;
+  { const LockGuard lgRaster{ mRaster };
+    grList.swap(grReady); }
+  // For each glyph that was rendered
+  for(const GlyphRaster &grRef : grList)
+  { // No longer need the placeholder
+    gpPending.erase(grRef.stChar);
+    // Missing and failed characters are loaded normally when printed
+    if(!grRef.bValid || GlyphFind(grRef.stChar) != StdMaxSizeT) continue;
+    // Apply advance rounding from the flags
+    const GLfloat fAdvance = RoundCheckFunc::
+      Auto<RoundFunc::Straight<GLfloat>>{ *this, grRef.fAdvance }.Result();
+    // Allocate storage and put the glyph and its outline in the atlas
+    const size_t stPos = GlyphAlloc(grRef.stChar);
+    GlyphCommit(grRef.gbData[0], stPos, grRef.stChar, fAdvance);
+    if(stMultiplier > 1)
+    { if(uiSpread) GlyphShareOutline(stPos);
+      else GlyphCommit(grRef.gbData[1], stPos + 1, grRef.stChar, fAdvance); }
+    // Rendered by the thread
+    ++stGlyphsAsync;
+  }
+}
+/* -- Record texture upload ------------------------------------------------ */
+void GlyphUploaded(const size_t stBytes)
+  { ++stUploads; stUploadLast = stBytes; stUploadTotal += stBytes; }
 /* ------------------------------------------------------------------------- */
 template<class StrokerCheckFuncType, class RoundCheckFuncType>
-  size_t DoHandleFTGlyph(const size_t stChar, const size_t stPos)
-{ // If position is not allocated?
-  if(stPos >= gvData.size())
-  { // Extend and initialise storage for glyph co-ordinates. Remember we
-    // need double the space if we're using an outline. Also, a character of
-    // ASCII value 0 is still a character so we got to allocate space for it.
-    // For some reason, I need to add {} for .resize to invoke the default
-    // 'Glyph' constructor for some reason.
-    gvData.resize(stMultiplier + stPos * stMultiplier, {});
-    // Extend and initialise storage for gl texture co-ordinates
-    clTiles[0].resize(gvData.size());
-  } // Return the position if already loaded
-  else if(gvData[stPos].GlyphIsLoaded()) return stPos;
-  // Translate character to glyph and if succeeded?
-  if(const FT_UInt uiGl = ftfData.CharToGlyph(static_cast<FT_ULong>(stChar)))
-  { // Load glyph and return glyph on success else throw exception
-    cFreeType->CheckError(ftfData.LoadGlyph(uiGl), "Failed to load glyph!",
-      "Identifier", IdentGet(), "Index", stChar);
-    // Get glyph slot handle and get advance width.
-    FT_GlyphSlot ftgsRef = ftfData.GetGlyphData();
-    // Compare type of border required
-    const GLfloat fAdvance = RoundCheckFuncType(*this,
-      static_cast<GLfloat>(ftgsRef->metrics.horiAdvance) / 64).Result();
-    // Begin initialisation of char by checking stroker setting. This can
-    // either be a pre-calculated or calculated right now.
-    StrokerCheckFuncType{ this, ftgsRef, stPos, stChar, fAdvance };
-    // Return position
-    return stPos;
+  size_t DoHandleFTGlyph(const size_t stChar)
+{ // Return the position if already loaded
+  size_t stPos = GlyphFind(stChar);
+  if(stPos != StdMaxSizeT) return stPos;
+  // Use the default character until the rasteriser thread has drawn it
+  if(stChar != ulDefaultChar && gpPending.contains(stChar))
+    return DoHandleFTGlyph<StrokerCheckFuncType, RoundCheckFuncType>(
+      static_cast<size_t>(ulDefaultChar));
+  // The face is shared with the rasteriser thread
+  { const LockGuard lgFace{ mFace };
+    // Translate character to glyph and if succeeded?
+    if(const FT_UInt uiGl = stChar > stGlyphMax ? 0 :
+         ftfData.CharToGlyph(static_cast<FT_ULong>(stChar)))
+    { // Load glyph and return glyph on success else throw exception
+      cFreeType->CheckError(ftfData.LoadGlyph(uiGl), "Failed to load glyph!",
+        "Identifier", IdentGet(), "Index", stChar);
+      // Get glyph slot handle and get advance width.
+      FT_GlyphSlot ftgsRef = ftfData.GetGlyphData();
+      // Compare type of border required
+      const GLfloat fAdvance = RoundCheckFuncType(*this,
+        static_cast<GLfloat>(ftgsRef->metrics.horiAdvance) / 64).Result();
+      // Allocate storage for the glyph
+      stPos = GlyphAlloc(stChar);
+      // Begin initialisation of char by checking stroker setting. This can
+      // either be a pre-calculated or calculated right now.
+      StrokerCheckFuncType{ this, ftgsRef, stPos, stChar, fAdvance };
+      // Rendered while printing
+      ++stGlyphsSync;
+      // Return position
+      return stPos;
+    }
   } // Show error if we couldn't load the default character
   if(stChar == ulDefaultChar)
     XC("Default character not available!",
-       "Identifier", IdentGet(), "Index", stChar, "Position", stPos);
-  // Try to load the default character instead.
-  return DoHandleFTGlyph<StrokerCheckFuncType, RoundCheckFuncType>(
-    static_cast<size_t>(ulDefaultChar),
-    static_cast<size_t>(ulDefaultChar) * stMultiplier);
+       "Identifier", IdentGet(), "Index", stChar);
+  // Try to load the default character instead and remember that this
+  // character uses it so we don't ask freetype again.
+  stPos = DoHandleFTGlyph<StrokerCheckFuncType, RoundCheckFuncType>(
+    static_cast<size_t>(ulDefaultChar));
+  if(stChar >= stGlyphDirect) GlyphSetSparse(stChar, stPos);
+  return stPos;
 }
 /* -- Do handle a static glyph --------------------------------------------- */
-size_t DoHandleStaticGlyph(const size_t stChar, const size_t stPos)
+size_t DoHandleStaticGlyph(const size_t stChar)
 { // Static font. If character is in range and loaded
+  const size_t stPos = stChar * stMultiplier;
   if(stPos < gvData.size() && gvData[stPos].GlyphIsLoaded()) return stPos;
   // Try to find the default character and return position if valiid
   const size_t stDefPos = static_cast<size_t>(ulDefaultChar) * stMultiplier;
@@ -441,11 +768,11 @@ size_t DoHandleStaticGlyph(const size_t stChar, const size_t stPos)
 }
 /* -- Function to select correct outline method ---------------------------- */
 template<class StrokerCheckFuncType, class RoundCheckFuncType>
-  size_t DoSelectFontType(const size_t stChar, const size_t stPos)
+  size_t DoSelectFontType(const size_t stChar)
 { // Stroker loaded?
   return ftfData.IsLoaded() ?
-    DoHandleFTGlyph<StrokerCheckFuncType, RoundCheckFuncType>(stChar,stPos) :
-    DoHandleStaticGlyph(stChar, stPos);
+    DoHandleFTGlyph<StrokerCheckFuncType, RoundCheckFuncType>(stChar) :
+    DoHandleStaticGlyph(stChar);
 }
 /* -- Check if a character needs initialising ------------------------------ */
 template<class FontCheckFunc, class StrokerCheckFuncType,
@@ -453,7 +780,7 @@ template<class FontCheckFunc, class StrokerCheckFuncType,
 size_t DoCheckGlyph(const size_t stChar)
 { // Get character position and if freetype font is assigned?
   return FontCheckFunc().template DoHandleGlyph<StrokerCheckFuncType,
-    RoundCheckFuncType>(this, stChar, stChar * stMultiplier);
+    RoundCheckFuncType>(this, stChar);
 }
 /* -- Do initialise all freetype characters in specified range ------------- */
 template<class HandleGlyphFuncType,
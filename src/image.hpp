@@ -11,21 +11,24 @@
 namespace IImage {                     // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IAsset::P;             using namespace IASync::P;
-using namespace ICollector::P;         using namespace IError::P;
+using namespace ICmdLine::P;           using namespace ICollector::P;
+using namespace ICrypt::P;             using namespace ICVarDef::P;
+using namespace IDir::P;               using namespace IError::P;
 using namespace IEvtMain::P;           using namespace IFileMap::P;
 using namespace IIdent::P;             using namespace IImageDef::P;
-using namespace IImageFormat::P;       using namespace IImageLib::P;
-using namespace ILog::P;               using namespace IMemory::P;
-using namespace IOgl::P;               using namespace IStd::P;
-using namespace IString::P;            using namespace ISysUtil::P;
-using namespace ITexDef::P;            using namespace IUtil::P;
-using namespace Lib::OS::GlFW;
+using namespace IImageDXT::P;          using namespace IImageFormat::P;
+using namespace IImageLib::P;          using namespace ILog::P;
+using namespace IMemory::P;            using namespace IOgl::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISysUtil::P;           using namespace ITexDef::P;
+using namespace IUtil::P;              using namespace Lib::OS::GlFW;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* == Image collector and member class ===================================== */
 CTOR_BEGIN_ASYNC(Images, Image, CLHelperUnsafe,
   /* ----------------------------------------------------------------------- */
-  IdMap<TextureType> idFormatModes;,   // Pixel format modes (log detail)
+  IdMap<TextureType> idFormatModes;    // Pixel format modes (log detail)
+  string           strDXTCache;,       // DXT cache directory (empty=off)
 );/* ----------------------------------------------------------------------- */
 template<typename IntType>             // Prototype
   static const string_view &ImageGetPixelFormat(const IntType);
@@ -157,8 +160,11 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     return true;
   }
   /* -- Pixel conversion process ------------------------------------------- */
+  typedef size_t (*BulkConversionFunction)(const uint8_t*const,
+    uint8_t*const, const size_t);
   template<class PixelConversionFunction, size_t stSrcStep, size_t stDstStep,
-    BitDepth bdNewBPP, TextureType ttType>
+    BitDepth bdNewBPP, TextureType ttType,
+    BulkConversionFunction bcfBulk = nullptr>
       void ConvertPixels(const char*const cpFilter)
   { // Some basic checks of parameters
     static_assert(stSrcStep > 0 && stSrcStep <= 2, "Invalid source step!");
@@ -187,10 +193,15 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
            "Height", isRef.DimGetHeight(), "Total",    stTotal,
            "Depth",  GetBytesPerPixel(),    "Filter",   cpFilter,
            "Step",   stDstStep,             "Unpadded", stUnpadded);
-      // Enumerate and filter through each pixel
-      for(uint8_t *ubpSrc = isRef.MemPtr<uint8_t>(),
+      // Convert as much as possible with vector instructions first
+      size_t stDone = 0;
+      if constexpr(bcfBulk != nullptr)
+        stDone = bcfBulk(isRef.MemPtr<uint8_t>(), mDst.MemPtr<uint8_t>(),
+          isRef.MemSize() / stSrcStep);
+      // Enumerate and filter through each remaining pixel
+      for(uint8_t *ubpSrc = isRef.MemPtr<uint8_t>() + stDone * stSrcStep,
          *const ubpSrcEnd = isRef.MemPtrEnd<uint8_t>(),
-                  *ubpDst = mDst.MemPtr<uint8_t>();
+                  *ubpDst = mDst.MemPtr<uint8_t>() + stDone * stDstStep;
                    ubpSrc < ubpSrcEnd;
                    ubpSrc += stSrcStep,
                    ubpDst += stDstStep)
@@ -211,10 +222,11 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
       { // Unpack one luminance alpha pixel into one RGB pixel
         *reinterpret_cast<uint16_t*>(ubpDst) =
           (static_cast<uint16_t>(*ubpSrc) * 0x0101);
-        *reinterpret_cast<uint8_t*>(ubpDst+1) = 0xFF;
+        *reinterpret_cast<uint8_t*>(ubpDst+2) = *ubpSrc;
       }
     }; // Do the conversion of luminance alpha to RGB
-    ConvertPixels<Filter, 2, 3, BD_RGB, TT_RGB>("LUMA>RGB");
+    ConvertPixels<Filter, 2, 3, BD_RGB, TT_RGB,
+      ImageSimdLumAlphaToRGB>("LUMA>RGB");
   }
   /* -- Force luminance pixel to RGB pixel type ---------------------------- */
   void ConvertLuminanceToRGB(void)
@@ -226,7 +238,8 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
         *reinterpret_cast<uint8_t*>(ubpDst+2) = *ubpSrc;
       }
     }; // Do the conversion of luminance to RGB
-    ConvertPixels<Filter, 1, 3, BD_RGB, TT_RGB>("LUM>RGB");
+    ConvertPixels<Filter, 1, 3, BD_RGB, TT_RGB,
+      ImageSimdLumToRGB>("LUM>RGB");
   }
   /* -- Force luminance alpha pixel to RGBA pixel type --------------------- */
   void ConvertLuminanceAlphaToRGBA(void)
@@ -239,7 +252,8 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
           (static_cast<uint32_t>(*(ubpSrc+1)) * 0x01000000);
       }
     }; // Do the conversion of luminance alpha to RGBA
-    ConvertPixels<Filter, 2, 4, BD_RGBA, TT_RGBA>("LUMA>RGBA");
+    ConvertPixels<Filter, 2, 4, BD_RGBA, TT_RGBA,
+      ImageSimdLumAlphaToRGBA>("LUMA>RGBA");
   }
   /* -- Force luminance pixel to RGBA pixel type --------------------------- */
   void ConvertLuminanceToRGBA(void)
@@ -247,10 +261,12 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     struct Filter{
       inline Filter(const uint8_t*const ubpSrc, uint8_t*const ubpDst)
       { // Unpack one luminance pixel into one RGBA pixel ignoring alpha
-        *reinterpret_cast<uint32_t*>(ubpDst) = (*ubpSrc * 0x01010100) | 0xFF;
+        *reinterpret_cast<uint32_t*>(ubpDst) =
+          (static_cast<uint32_t>(*ubpSrc) * 0x00010101) | 0xFF000000;
       }
     }; // Do the conversion of luminance alpha to RGBA
-    ConvertPixels<Filter, 1, 4, BD_RGBA, TT_RGBA>("LUM>RGBA");
+    ConvertPixels<Filter, 1, 4, BD_RGBA, TT_RGBA,
+      ImageSimdLumToRGBA>("LUM>RGBA");
   }
   /* -- Force binary pixel to luminance pixel type ------------------------- */
   void ConvertBinaryToLuminance(void)
@@ -547,6 +563,107 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     } // Success
     return true;
   }
+  /* -- Compress RGB(A) slots to DXT1, or DXT5 if any alpha is used -------- */
+  bool CompressDXT(double &dPSNR)
+  { // Only 24-bit RGB and 32-bit RGBA images can be compressed
+    if(IsNoSlots() || IsPalette() ||
+      (GetPixelType() != TT_RGB && GetPixelType() != TT_RGBA))
+      return false;
+    // Use DXT5 only if any slot has pixels that are not fully opaque
+    const size_t stBytes = GetBytesPerPixel<size_t>();
+    bool bAlpha = false;
+    for(const ImageSlot &isRef : GetSlotsConst())
+      if(!ImageDXTIsOpaque(isRef.MemPtr<unsigned char>(),
+        isRef.DimGetWidth<size_t>() * isRef.DimGetHeight<size_t>(), stBytes))
+        { bAlpha = true; break; }
+    // Total error and pixels scored of every slot
+    double dError = 0.0;
+    size_t stPixels = 0;
+    // For each slot
+    for(ImageSlot &isRef : GetSlots())
+    { // Compress the pixels into a new block
+      Memory mOut{ ImageDXTSize(isRef.DimGetWidth<size_t>(),
+        isRef.DimGetHeight<size_t>(), bAlpha) };
+      dError += ImageDXTEncode(isRef.MemPtr<unsigned char>(),
+        isRef.DimGetWidth<size_t>(), isRef.DimGetHeight<size_t>(), stBytes,
+        bAlpha, mOut.MemPtr<unsigned char>());
+      stPixels += ImageDXTPixels(isRef.DimGetWidth<size_t>(),
+        isRef.DimGetHeight<size_t>());
+      // Replace the pixels and update the allocation counter
+      AdjustAlloc(isRef.MemSize(), mOut.MemSize());
+      isRef.MemSwap(mOut);
+    } // Compressed pixels are always reported as 32-bit like DDS does
+    SetPixelType(bAlpha ? TT_DXT5 : TT_DXT1);
+    SetBitsAndBytesPerPixel(BD_RGBA);
+    SetCompressed();
+    // Set quality of the colours and return success
+    dPSNR = ImageDXTPSNR(dError, stPixels);
+    return true;
+  }
+  /* -- Get DXT cache filename for the specified source file --------------- */
+  const string DXTCacheFile(const FileMap &fmData) const
+  { // No cache if not compressing or if the cache is disabled. Atlases are
+    // not cached either because the tile layout is not stored in the file.
+    if(IsNotConvertDXT() || IsConvertAtlas() || cImages->strDXTCache.empty())
+      return {};
+    // The name is a hash of the source file and the load flags used
+    return StrAppend(cImages->strDXTCache, SHA1functions::HashMB(fmData),
+      '-', StrHexFromInt(FlagGet() & IL_MASK.FlagGet()));
+  }
+  /* -- Load compressed pixels from the DXT cache -------------------------- */
+  bool DXTCacheLoad(const string &strCache)
+  { // Ignore if nothing is cached
+    const string strFile{ StrAppend(strCache, ".DDS") };
+    if(!DirLocalFileExists(strFile)) return false;
+    // Capture exceptions so a bad cache file just means decoding again
+    try
+    { // Load the cached file as DDS
+      FileMap fmCache{ AssetLoadFromDisk(strFile) };
+      ImageLoad(IFMT_DDS, fmCache, *this);
+      // Set activated flag and report success
+      SetActiveDXT();
+      cLog->LogDebugExSafe("Image '$' loaded from DXT cache '$'.",
+        IdentGet(), strFile);
+      return true;
+    } // Error occured so remove the file and start again
+    catch(const exception &E)
+    { // Log the reason and remove the bad file
+      cLog->LogWarningExSafe("Image '$' removing bad DXT cache '$': $",
+        IdentGet(), strFile, E.what());
+      DirFileUnlink(strFile);
+      // Remove anything the loader set
+      ResetAllData();
+    } // Decode the original file instead
+    return false;
+  }
+  /* -- Save compressed pixels to the DXT cache ---------------------------- */
+  void DXTCacheSave(const string &strCache) const
+  { // Only single slot images can be stored
+    if(IsNotActiveDXT() || GetSlotCount() != 1) return;
+    // Write to a temporary file first so a crash or a failed write can't
+    // leave a partial cache file behind. The image id keeps concurrent
+    // loads of the same file from writing to the same temporary file.
+    const string strTemp{ StrFormat("$.$.tmp", strCache, CtrGet()) },
+                 strTempFile{ StrAppend(strTemp, ".DDS") },
+                 strFile{ StrAppend(strCache, ".DDS") };
+    // Capture exceptions as a failed save should not fail the load
+    try
+    { // Write the temporary file which is removed if it fails
+      ImageSave(IFMT_DDS, strTemp, *this, GetSlotsConst().front());
+      // Replace the old cache file and return if succeeded
+      DirFileUnlink(strFile);
+      if(DirFileRename(strTempFile, strFile)) return;
+      // Log the reason and remove the temporary file
+      cLog->LogWarningExSafe("Image '$' could not rename DXT cache '$': $",
+        IdentGet(), strFile, StrFromErrNo());
+      DirFileUnlink(strTempFile);
+    } // Error occured
+    catch(const exception &E)
+    { // Log the reason and carry on
+      cLog->LogWarningExSafe("Image '$' could not write DXT cache: $",
+        IdentGet(), E.what());
+    }
+  }
   /* -- Apply filters ------------------------------------------------------ */
   void ApplyFilters(void)
   { // Record current parameters
@@ -662,11 +779,28 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
         SetActiveAtlas();
       } // Conversion did not happen so log that too
       else cLog->LogDebugExSafe("Image '$' compact skipped!", IdentGet());
+    } // Compress to DXT. This must be last as the pixels can't be changed
+    // by anything else once they are compressed.
+    if(IsConvertDXT())
+    { // Log that we're running this function
+      cLog->LogDebugExSafe("Image '$' DXT compress request...", IdentGet());
+      // Run the function and log success if succeeded
+      double dPSNR;
+      if(CompressDXT(dPSNR))
+      { // Log the successful result
+        cLog->LogInfoExSafe("Image '$' compressed to $ ($$$dB RGB PSNR).",
+          IdentGet(), ImageGetPixelFormat(GetPixelType()), fixed,
+          setprecision(2), dPSNR);
+        // Set activated flag
+        SetActiveDXT();
+      } // Conversion did not happen so log that too
+      else cLog->LogDebugExSafe("Image '$' DXT compress skipped!",
+        IdentGet());
     } // Report status if we acticated anything
     if(IsActiveAtlas() || IsActiveReverse() || IsActiveRGB() ||
        IsActiveRGBA() || IsActiveBGROrder() || IsActiveBinary() ||
-       IsActiveGPUCompat() || IsActiveRGBOrder())
-      cLog->LogDebugExSafe("Image '$' filtering completed...$$$$$$$$$$$$$$$",
+       IsActiveGPUCompat() || IsActiveRGBOrder() || IsActiveDXT())
+      cLog->LogDebugExSafe("Image '$' filtering completed...$$$$$$$$$$$$$$$$",
         IdentGet(),
         duTileOR.DimGetWidth() && duTileOR.DimGetHeight() ?
           StrFormat("\n- Tile size override: $x$.",
@@ -708,11 +842,16 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
         IsActiveBinary() ? "\n- Pixels converted to monochrome." :
           cCommon->Blank(),
         IsActiveGPUCompat() ? "\n- Pixels made OpenGL compatible." :
+          cCommon->Blank(),
+        IsActiveDXT() ? "\n- Pixels compressed to DXT." :
           cCommon->Blank());
   }
   /* -- Load specified image ----------------------------------------------- */
   void AsyncReady(FileMap &fmData)
-  { // Force load a certain type of image (for speed?) but in Async mode,
+  { // Use previously compressed pixels if they are cached
+    const string strCache{ DXTCacheFile(fmData) };
+    if(!strCache.empty() && DXTCacheLoad(strCache)) return;
+    // Force load a certain type of image (for speed?) but in Async mode,
     // force detection doesn't really matter as much, but overall, still
     // needed if speed is absolutely neccesary.
     if(IsLoadAsPNG()) ImageLoad(IFMT_PNG, fmData, *this);
@@ -723,6 +862,8 @@ CTOR_MEM_BEGIN_ASYNC_CSLAVE(Images, Image, ICHelperUnsafe),
     else ImageLoad(fmData, *this);
     // Apply filters if image has no special circumstances
     if(IsNotCompressed() && IsNotMipmaps()) ApplyFilters();
+    // Cache the pixels if they were compressed so next time is quicker
+    if(!strCache.empty()) DXTCacheSave(strCache);
     // Recover slots memory if they were modified
     CompactSlots();
   }
@@ -935,6 +1076,24 @@ CTOR_END_ASYNC(Images, Image, IMAGE,,,, idFormatModes{{ // Pixel format modes
   IDMAPSTR(TT_RGB),                    IDMAPSTR(TT_RGBA),
   /* ----------------------------------------------------------------------- */
 }, "TT_UNKNOWN"})                      // Unknown pixel format mode
+/* -- Set DXT cache enabled ------------------------------------------------ */
+static CVarReturn ImagesSetDXTCache(const bool bEnabled)
+{ // Disable the cache if requested or there is nowhere to write it
+  if(!bEnabled || cCmdLine->IsNoHome())
+  { // Clear the directory so nothing is read or written
+    cImages->strDXTCache.clear();
+    return ACCEPT;
+  } // Cache goes in a sub-directory of the persistence directory
+  string strDir{ cCmdLine->GetHome("dxtcache/") };
+  if(!DirMkDirEx(strDir))
+  { // Log the failure and keep the cache disabled
+    cLog->LogWarningExSafe("Images could not create DXT cache '$'!", strDir);
+    return DENY;
+  } // Set the new directory
+  cImages->strDXTCache = StdMove(strDir);
+  // Success
+  return ACCEPT;
+}
 /* ------------------------------------------------------------------------- */
 template<typename IntType> // Forcing any type to GLenum
   static const string_view &ImageGetPixelFormat(const IntType itMode)
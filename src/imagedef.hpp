@@ -37,9 +37,11 @@ BUILD_FLAGS(Image,
   FF_USEGLYPHSIZE           {Flag[2]}, FF_ROUNDADVANCE            {Flag[3]},
   // Do floor() on advance width?      Do ceil() on advance width?
   FF_FLOORADVANCE           {Flag[4]}, FF_CEILADVANCE             {Flag[5]},
+  // Store glyphs as distance fields?
+  FF_SDF                    {Flag[6]},
   /* -- Font loader public mask bits --------------------------------------- */
   FF_MASK{ FF_USEGLYPHSIZE|FF_STROKETYPE2|FF_FLOORADVANCE|FF_CEILADVANCE|
-           FF_ROUNDADVANCE },
+           FF_ROUNDADVANCE|FF_SDF },
   /* -- Post processing (Only used in 'Image' class) ----------------------- */
   // Convert to atlas?                 Image will be loadable in OpenGL?
   IL_ATLAS                  {Flag[8]}, IL_TOGPU                   {Flag[9]},
@@ -49,6 +51,8 @@ BUILD_FLAGS(Image,
   IL_TOBGR                 {Flag[12]}, IL_TORGB                  {Flag[13]},
   // Convert loaded image to BINARY?   Force reverse the image?
   IL_TOBINARY              {Flag[14]}, IL_REVERSE                {Flag[15]},
+  // Compress loaded image to DXT?
+  IL_TODXT                 {Flag[16]},
   /* -- Force load formats (Only used in 'Image' class) -------------------- */
   // Force load as PNG?                Force load as JPEG?
   IL_FCE_PNG               {Flag[24]}, IL_FCE_JPG                {Flag[25]},
@@ -56,7 +60,8 @@ BUILD_FLAGS(Image,
   IL_FCE_GIF               {Flag[26]}, IL_FCE_DDS                {Flag[27]},
   /* -- Image loader public mask bits -------------------------------------- */
   IL_MASK{ IL_TOGPU|IL_TO24BPP|IL_TO32BPP|IL_TOBGR|IL_TORGB|IL_TOBINARY|
-    IL_REVERSE|IL_ATLAS|IL_FCE_JPG|IL_FCE_PNG|IL_FCE_GIF|IL_FCE_DDS },
+    IL_REVERSE|IL_ATLAS|IL_TODXT|IL_FCE_JPG|IL_FCE_PNG|IL_FCE_GIF|
+    IL_FCE_DDS },
   /* -- Active flags (Only used in 'Image' class) ----------------------- */
   // Image will be loadable in GL?     Convert loaded image to 24bpp?
   IA_TOGPU                 {Flag[32]}, IA_TO24BPP                {Flag[33]},
@@ -66,6 +71,8 @@ BUILD_FLAGS(Image,
   IA_TORGB                 {Flag[36]}, IA_TOBINARY               {Flag[37]},
   // Force reverse the image?          Convert to atlas?
   IA_REVERSE               {Flag[38]}, IA_ATLAS                  {Flag[39]},
+  // Compress loaded image to DXT?
+  IA_TODXT                 {Flag[40]},
   /* -- Image loaded flags (Only used in 'ImageData' class) ---------------- */
   // Bitmap has mipmaps?               Bitmap has reversed pixels?
   IF_MIPMAPS               {Flag[48]}, IF_REVERSED               {Flag[49]},
@@ -183,6 +190,7 @@ class ImageData :                      // Members initially private
   FH(ConvertBinary,    IL_TOBINARY)    // Is/IsNot/Set/ClearConvertBinary
   FH(ConvertGPUCompat, IL_TOGPU)       // Is/IsNot/Set/ClearConvertGPUCompat
   FH(ConvertRGBOrder,  IL_TORGB)       // Is/IsNot/Set/ClearConvertRGBOrder
+  FH(ConvertDXT,       IL_TODXT)       // Is/IsNot/Set/ClearConvertDXT
   FH(ActiveAtlas,      IA_ATLAS)       // Is/IsNot/Set/ClearActiveAtlas
   FH(ActiveReverse,    IA_REVERSE)     // Is/IsNot/Set/ClearActiveReverse
   FH(ActiveRGB,        IA_TO24BPP)     // Is/IsNot/Set/ClearActiveRGB
@@ -191,6 +199,7 @@ class ImageData :                      // Members initially private
   FH(ActiveBinary,     IA_TOBINARY)    // Is/IsNot/Set/ClearActiveBinary
   FH(ActiveGPUCompat,  IA_TOGPU)       // Is/IsNot/Set/ClearActiveGPUCompat
   FH(ActiveRGBOrder,   IA_TORGB)       // Is/IsNot/Set/ClearActiveRGBOrder
+  FH(ActiveDXT,        IA_TODXT)       // Is/IsNot/Set/ClearActiveDXT
   FH(PurposeFont,      IP_FONT)        // Is/IsNot/Set/ClearPurposeFont
   FH(PurposeImage,     IP_IMAGE)       // Is/IsNot/Set/ClearPurposeImage
   FH(PurposeTexture,   IP_TEXTURE)     // Is/IsNot/Set/ClearPurposeTexture
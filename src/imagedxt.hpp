@@ -0,0 +1,322 @@
+/* == IMAGEDXT.HPP ========================================================= **
+** ######################################################################### **
+** ## MS-ENGINE              Copyright (c) MS-Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## This module compresses decoded RGB(A) pixels into DXT1 (BC1) or     ## **
+** ## DXT5 (BC3) blocks so they can stay compressed in video memory. Each ## **
+** ## 4x4 block is split into channel arrays so the inner loops can be    ## **
+** ## vectorised by the compiler and rows of blocks run in parallel.      ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace IImageDXT {                  // Start of private module namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IStd::P;               using namespace IUtil::P;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public module namespace
+/* -- One 4x4 block of pixels split into channels -------------------------- */
+struct ImageDXTBlock                   // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  array<float, 16> aR, aG, aB;         // Colour channels
+  array<unsigned int, 16> aA;          // Alpha channel
+};/* -- Bytes needed to hold a compressed image ---------------------------- */
+static size_t ImageDXTSize(const size_t stWidth, const size_t stHeight,
+  const bool bAlpha)
+    { return ((stWidth + 3) / 4) * ((stHeight + 3) / 4) * (bAlpha ? 16 : 8); }
+/* -- Pixels scored by the encoder which always works on whole blocks ------ */
+static size_t ImageDXTPixels(const size_t stWidth, const size_t stHeight)
+  { return ((stWidth + 3) / 4) * ((stHeight + 3) / 4) * 16; }
+/* -- Returns if all pixels are fully opaque ------------------------------- */
+static bool ImageDXTIsOpaque(const unsigned char*const ucpSrc,
+  const size_t stPixels, const size_t stBytes)
+{ // Images without an alpha channel are always opaque
+  if(stBytes != 4) return true;
+  // Check every alpha value and fail if any of them are not fully opaque
+  for(size_t stIndex = 3, stEnd = stPixels * 4;
+             stIndex < stEnd;
+             stIndex += 4)
+    if(ucpSrc[stIndex] != 0xFF) return false;
+  // All pixels are opaque
+  return true;
+}
+/* -- Copy a block of pixels clamping at the right and bottom edges -------- */
+static void ImageDXTFetch(const unsigned char*const ucpSrc,
+  const size_t stWidth, const size_t stHeight, const size_t stBytes,
+  const size_t stBX, const size_t stBY, ImageDXTBlock &dbOut)
+{ // For each row of the block
+  for(size_t stY = 0; stY < 4; ++stY)
+  { // Clamp the row to the bottom edge of the image
+    const size_t stRow = UtilMinimum(stBY * 4 + stY, stHeight - 1) * stWidth;
+    // For each column of the block
+    for(size_t stX = 0; stX < 4; ++stX)
+    { // Clamp the column to the right edge and get the pixel
+      const unsigned char*const ucpPixel = ucpSrc +
+        (stRow + UtilMinimum(stBX * 4 + stX, stWidth - 1)) * stBytes;
+      // Split the pixel into channels
+      const size_t stIndex = stY * 4 + stX;
+      dbOut.aR[stIndex] = ucpPixel[0];
+      dbOut.aG[stIndex] = ucpPixel[1];
+      dbOut.aB[stIndex] = ucpPixel[2];
+      dbOut.aA[stIndex] = stBytes == 4 ? ucpPixel[3] : 0xFF;
+    }
+  }
+}
+/* -- Quantise a colour to 5:6:5 ------------------------------------------- */
+static unsigned int ImageDXTPack565(const float fR, const float fG,
+  const float fB)
+{ // Round each channel to the nearest representable value
+  const unsigned int
+    uiR = static_cast<unsigned int>(UtilClamp(fR, 0.0f, 255.0f) *
+      31.0f / 255.0f + 0.5f),
+    uiG = static_cast<unsigned int>(UtilClamp(fG, 0.0f, 255.0f) *
+      63.0f / 255.0f + 0.5f),
+    uiB = static_cast<unsigned int>(UtilClamp(fB, 0.0f, 255.0f) *
+      31.0f / 255.0f + 0.5f);
+  // Return packed colour
+  return (uiR << 11) | (uiG << 5) | uiB;
+}
+/* -- Expand a 5:6:5 colour to 8-bits per channel -------------------------- */
+static void ImageDXTUnpack565(const unsigned int uiColour,
+  array<int, 3> &aOut)
+{ // Replicate the high bits into the low bits like the GPU does
+  const int iR = static_cast<int>((uiColour >> 11) & 0x1F),
+            iG = static_cast<int>((uiColour >> 5) & 0x3F),
+            iB = static_cast<int>(uiColour & 0x1F);
+  aOut = { (iR << 3) | (iR >> 2), (iG << 2) | (iG >> 4),
+           (iB << 3) | (iB >> 2) };
+}
+/* -- Pick the nearest palette entry for every pixel ----------------------- */
+static unsigned int ImageDXTColourIndices(const ImageDXTBlock &dbIn,
+  const unsigned int uiC0, const unsigned int uiC1,
+  array<unsigned int, 16> &aIndices, float &fError)
+{ // Build the four colour palette the same way the decoder does
+  array<array<int, 3>, 4> aPal;
+  ImageDXTUnpack565(uiC0, aPal[0]);
+  ImageDXTUnpack565(uiC1, aPal[1]);
+  for(size_t stC = 0; stC < 3; ++stC)
+  { // Interpolated entries are a third and two thirds between the ends
+    aPal[2][stC] = (2 * aPal[0][stC] + aPal[1][stC]) / 3;
+    aPal[3][stC] = (aPal[0][stC] + 2 * aPal[1][stC]) / 3;
+  } // Find the nearest entry for every pixel by squared distance. Entries
+  // are the outer loop so the pixel loop has no dependencies between
+  // iterations and can be vectorised. Equal end points select the three
+  // colour mode where the last entry is black, so only use the first.
+  array<float, 16> aBest;
+  aBest.fill(numeric_limits<float>::max());
+  aIndices.fill(0);
+  for(unsigned int uiEntry = 0, uiEntries = uiC0 == uiC1 ? 1 : 4;
+                   uiEntry < uiEntries;
+                 ++uiEntry)
+  { // Get the palette colour
+    const float fR = static_cast<float>(aPal[uiEntry][0]),
+                fG = static_cast<float>(aPal[uiEntry][1]),
+                fB = static_cast<float>(aPal[uiEntry][2]);
+    // Keep the entry for each pixel it is nearer to
+    for(size_t stIndex = 0; stIndex < 16; ++stIndex)
+    { // Get distance to this entry and keep it if it is the best so far
+      const float fDR = dbIn.aR[stIndex] - fR, fDG = dbIn.aG[stIndex] - fG,
+                  fDB = dbIn.aB[stIndex] - fB,
+                  fDist = fDR * fDR + fDG * fDG + fDB * fDB;
+      const bool bNearer = fDist < aBest[stIndex];
+      aBest[stIndex] = bNearer ? fDist : aBest[stIndex];
+      aIndices[stIndex] = bNearer ? uiEntry : aIndices[stIndex];
+    }
+  } // Pack the indices and total the error
+  unsigned int uiBits = 0;
+  fError = 0.0f;
+  for(size_t stIndex = 0; stIndex < 16; ++stIndex)
+  { // Add index and error of this pixel
+    uiBits |= aIndices[stIndex] << (stIndex * 2);
+    fError += aBest[stIndex];
+  }
+  // Return packed indices
+  return uiBits;
+}
+/* -- Compress the colour part of a block and return its squared error ----- */
+static float ImageDXTColour(const ImageDXTBlock &dbIn,
+  unsigned char*const ucpDst)
+{ // Get the average colour
+  float fMR = 0.0f, fMG = 0.0f, fMB = 0.0f;
+  for(size_t stIndex = 0; stIndex < 16; ++stIndex)
+    fMR += dbIn.aR[stIndex], fMG += dbIn.aG[stIndex], fMB += dbIn.aB[stIndex];
+  fMR /= 16.0f, fMG /= 16.0f, fMB /= 16.0f;
+  // Build the covariance matrix of the colours
+  float fCRR = 0.0f, fCRG = 0.0f, fCRB = 0.0f,
+        fCGG = 0.0f, fCGB = 0.0f, fCBB = 0.0f;
+  for(size_t stIndex = 0; stIndex < 16; ++stIndex)
+  { // Get distance from the average and accumulate
+    const float fR = dbIn.aR[stIndex] - fMR,
+                fG = dbIn.aG[stIndex] - fMG,
+                fB = dbIn.aB[stIndex] - fMB;
+    fCRR += fR * fR, fCRG += fR * fG, fCRB += fR * fB;
+    fCGG += fG * fG, fCGB += fG * fB, fCBB += fB * fB;
+  } // Find the principal axis with a few rounds of power iteration
+  float fVR = 0.9f, fVG = 1.0f, fVB = 0.7f;
+  for(size_t stIter = 0; stIter < 4; ++stIter)
+  { // Multiply the axis by the matrix
+    const float fNR = fVR * fCRR + fVG * fCRG + fVB * fCRB,
+                fNG = fVR * fCRG + fVG * fCGG + fVB * fCGB,
+                fNB = fVR * fCRB + fVG * fCGB + fVB * fCBB,
+                fLen = UtilMaximum(UtilMaximum(fabs(fNR), fabs(fNG)),
+                  fabs(fNB));
+    // Block is a single colour so keep the current axis
+    if(fLen < 1e-6f) break;
+    // Normalise so the values don't overflow
+    fVR = fNR / fLen, fVG = fNG / fLen, fVB = fNB / fLen;
+  } // Use the pixels furthest along the axis as the initial end points
+  size_t stMin = 0, stMax = 0;
+  float fMin = numeric_limits<float>::max(), fMax = -fMin;
+  for(size_t stIndex = 0; stIndex < 16; ++stIndex)
+  { // Project the pixel onto the axis and keep the extremes
+    const float fDot = dbIn.aR[stIndex] * fVR + dbIn.aG[stIndex] * fVG +
+                       dbIn.aB[stIndex] * fVB;
+    if(fDot < fMin) { fMin = fDot; stMin = stIndex; }
+    if(fDot > fMax) { fMax = fDot; stMax = stIndex; }
+  }
+  const array<float, 3>
+    aE0{ dbIn.aR[stMax], dbIn.aG[stMax], dbIn.aB[stMax] },
+    aE1{ dbIn.aR[stMin], dbIn.aG[stMin], dbIn.aB[stMin] };
+  // Quantise the end points and make sure four colour mode is used
+  unsigned int uiC0 = ImageDXTPack565(aE0[0], aE0[1], aE0[2]),
+               uiC1 = ImageDXTPack565(aE1[0], aE1[1], aE1[2]);
+  if(uiC0 < uiC1) swap(uiC0, uiC1);
+  // Pick indices for the end points
+  array<unsigned int, 16> aIndices;
+  float fError;
+  unsigned int uiBits =
+    ImageDXTColourIndices(dbIn, uiC0, uiC1, aIndices, fError);
+  // Weight of the first end point for each palette index
+  static const array<float, 4> aWeight{ 1.0f, 0.0f, 2.0f/3.0f, 1.0f/3.0f };
+  // Accumulate the least squares fit of the end points to those indices
+  float fAA = 0.0f, fBB = 0.0f, fAB = 0.0f;
+  array<float, 3> aAX{ 0.0f, 0.0f, 0.0f }, aBX{ 0.0f, 0.0f, 0.0f };
+  for(size_t stIndex = 0; stIndex < 16; ++stIndex)
+  { // Get weights of both end points for this pixel
+    const float fA = aWeight[aIndices[stIndex]], fB = 1.0f - fA;
+    fAA += fA * fA, fBB += fB * fB, fAB += fA * fB;
+    aAX[0] += fA * dbIn.aR[stIndex], aBX[0] += fB * dbIn.aR[stIndex];
+    aAX[1] += fA * dbIn.aG[stIndex], aBX[1] += fB * dbIn.aG[stIndex];
+    aAX[2] += fA * dbIn.aB[stIndex], aBX[2] += fB * dbIn.aB[stIndex];
+  } // If the system can be solved?
+  const float fDet = fAA * fBB - fAB * fAB;
+  if(fabs(fDet) >= 1e-6f)
+  { // Solve for both end points
+    const float fInv = 1.0f / fDet;
+    array<float, 3> aR0, aR1;
+    for(size_t stC = 0; stC < 3; ++stC)
+    { // Set new end points for this channel
+      aR0[stC] = (aAX[stC] * fBB - aBX[stC] * fAB) * fInv;
+      aR1[stC] = (aBX[stC] * fAA - aAX[stC] * fAB) * fInv;
+    } // Quantise the refined end points
+    unsigned int uiR0 = ImageDXTPack565(aR0[0], aR0[1], aR0[2]),
+                 uiR1 = ImageDXTPack565(aR1[0], aR1[1], aR1[2]);
+    if(uiR0 < uiR1) swap(uiR0, uiR1);
+    // Keep the refined end points only if they are actually better
+    if(uiR0 != uiC0 || uiR1 != uiC1)
+    { // Pick indices for the refined end points
+      array<unsigned int, 16> aRIndices;
+      float fRError;
+      const unsigned int uiRBits =
+        ImageDXTColourIndices(dbIn, uiR0, uiR1, aRIndices, fRError);
+      if(fRError < fError)
+        uiC0 = uiR0, uiC1 = uiR1, uiBits = uiRBits, fError = fRError;
+    }
+  } // Write the block
+  ucpDst[0] = static_cast<unsigned char>(uiC0);
+  ucpDst[1] = static_cast<unsigned char>(uiC0 >> 8);
+  ucpDst[2] = static_cast<unsigned char>(uiC1);
+  ucpDst[3] = static_cast<unsigned char>(uiC1 >> 8);
+  for(size_t stByte = 0; stByte < 4; ++stByte)
+    ucpDst[4 + stByte] = static_cast<unsigned char>(uiBits >> (stByte * 8));
+  // Return the error of the end points used
+  return fError;
+}
+/* -- Compress the alpha part of a block ----------------------------------- */
+static void ImageDXTAlpha(const ImageDXTBlock &dbIn,
+  unsigned char*const ucpDst)
+{ // Use the alpha range of the block as the end points
+  unsigned int uiA0 = 0, uiA1 = 0xFF;
+  for(size_t stIndex = 0; stIndex < 16; ++stIndex)
+  { // Keep the highest and lowest
+    uiA0 = UtilMaximum(uiA0, dbIn.aA[stIndex]);
+    uiA1 = UtilMinimum(uiA1, dbIn.aA[stIndex]);
+  } // Write the end points
+  ucpDst[0] = static_cast<unsigned char>(uiA0);
+  ucpDst[1] = static_cast<unsigned char>(uiA1);
+  // Packed indices
+  uint64_t qBits = 0;
+  // Same end points selects the first alpha for every pixel
+  if(uiA0 != uiA1)
+  { // Build the eight alpha palette the same way the decoder does
+    array<int, 8> aPal;
+    aPal[0] = static_cast<int>(uiA0);
+    aPal[1] = static_cast<int>(uiA1);
+    for(int iEntry = 2; iEntry < 8; ++iEntry)
+      aPal[static_cast<size_t>(iEntry)] =
+        ((8 - iEntry) * aPal[0] + (iEntry - 1) * aPal[1]) / 7;
+    // For each pixel
+    for(size_t stIndex = 0; stIndex < 16; ++stIndex)
+    { // Find the nearest entry
+      uint64_t qBest = 0;
+      int iBest = numeric_limits<int>::max();
+      for(size_t stEntry = 0; stEntry < 8; ++stEntry)
+      { // Keep the entry if it is the best so far
+        const int iDist =
+          abs(static_cast<int>(dbIn.aA[stIndex]) - aPal[stEntry]);
+        if(iDist >= iBest) continue;
+        iBest = iDist;
+        qBest = stEntry;
+      } // Store the index
+      qBits |= qBest << (stIndex * 3);
+    }
+  } // Write the indices
+  for(size_t stByte = 0; stByte < 6; ++stByte)
+    ucpDst[2 + stByte] = static_cast<unsigned char>(qBits >> (stByte * 8));
+}
+/* -- Compress RGB or RGBA pixels and return the total squared RGB error --- */
+static double ImageDXTEncode(const unsigned char*const ucpSrc,
+  const size_t stWidth, const size_t stHeight, const size_t stBytes,
+  const bool bAlpha, unsigned char*const ucpDst)
+{ // Calculate block dimensions and the size of each compressed row
+  const size_t stBWidth = (stWidth + 3) / 4, stBHeight = (stHeight + 3) / 4,
+               stRow = stBWidth * (bAlpha ? 16 : 8);
+  // Rows of blocks are independent so compress them in parallel. Each row
+  // keeps its own error total so the rows do not need to synchronise.
+  vector<size_t> vRows(stBHeight);
+  for(size_t stBY = 0; stBY < stBHeight; ++stBY) vRows[stBY] = stBY;
+  vector<double> vErrors(stBHeight);
+  StdForEach(par_unseq, vRows.cbegin(), vRows.cend(),
+    [ucpSrc, stWidth, stHeight, stBytes, bAlpha, ucpDst, stBWidth, stRow,
+     &vErrors](const size_t stBY)
+  { // Block being compressed, destination and error total for this row
+    ImageDXTBlock dbData;
+    unsigned char *ucpOut = ucpDst + stBY * stRow;
+    double &dError = vErrors[stBY];
+    // For each block in this row
+    for(size_t stBX = 0; stBX < stBWidth; ++stBX)
+    { // Get the pixels
+      ImageDXTFetch(ucpSrc, stWidth, stHeight, stBytes, stBX, stBY, dbData);
+      // DXT5 stores the alpha block first
+      if(bAlpha) { ImageDXTAlpha(dbData, ucpOut); ucpOut += 8; }
+      // Then the colour block
+      dError += ImageDXTColour(dbData, ucpOut);
+      ucpOut += 8;
+    }
+  });
+  // Return the total error of every row
+  return accumulate(vErrors.cbegin(), vErrors.cend(), 0.0);
+}
+/* -- Convert a total squared RGB error to PSNR in decibels ---------------- */
+static double ImageDXTPSNR(const double dError, const size_t stPixels)
+{ // Get mean squared error of each channel of every pixel scored
+  const double dMSE = dError / static_cast<double>(stPixels * 3);
+  // Return infinity if there was no error
+  return dMSE > 0.0 ? 10.0 * log10(255.0 * 255.0 / dMSE) :
+    numeric_limits<double>::infinity();
+}
+/* ------------------------------------------------------------------------- */
+}                                      // End of public module namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private module namespace
+/* == EoF =========================================================== EoF == */
@@ -41,7 +41,7 @@ struct CodecDDS final :                // Members initially public
   // 020:016:     uint32_t    ulPitchOrLinearSize;
   // 024:020:     uint32_t    ulDepth;
   // 028:024:     uint32_t    ulMipMapCount;
-  // 032:028:     uint32_t    ulReserved1[11];
+  // 032:028:     uint32_t    ulReserved1[11]; // [0]=DDSE_MAGIC, [1]=DDSE_*
   // 076:072: *** DDS_PIXELFORMAT (32 bytes) *** [ddspf];
   // 076:072:000: uint32_t    ulSize;
   // 080:076:004: uint32_t    ulFlags;
@@ -78,6 +78,9 @@ struct CodecDDS final :                // Members initially public
   enum DDSFourCCFormat : unsigned int {
     FOURCC_DXT1      = 0x31545844,   FOURCC_DXT3      = 0x33545844,
     FOURCC_DXT5      = 0x35545844
+  };/* -- Engine values in reserved space (so our own saves load back) ----- */
+  enum DDSEngineFlags : unsigned int {
+    DDSE_MAGIC       = 0x2045534D,   DDSE_NOTREVERSED = 0x00000001
   };/* -- Capabilities primary flags --------------------------------------- */
   enum DDSCapsFlags : unsigned int {
     DDSCAPS_COMPLEX  = 0x00000008,   DDSCAPS_UNKNOWN  = 0x00000002,
@@ -122,9 +125,10 @@ struct CodecDDS final :                // Members initially public
       // We should have caps, width and pixelformat
       if(uiFlags & ~DDSD_REQUIRED)
         XC("Header flags required!", "Flags", uiFlags, "Mask", DDSD_REQUIRED);
-    } // Get and check dimensions
-    if(!idData.SetDimSafe(fmData.FileMapReadVar32LE(),
-          fmData.FileMapReadVar32LE()))
+    } // Get and check dimensions. Height is stored before width.
+    const unsigned int uiHeight = fmData.FileMapReadVar32LE(),
+                       uiWidth = fmData.FileMapReadVar32LE();
+    if(!idData.SetDimSafe(uiWidth, uiHeight))
       XC("Dimensions invalid!",
          "Width",  idData.DimGetWidth(), "Height", idData.DimGetHeight());
     // Check that scanline length is equal to the width
@@ -136,8 +140,11 @@ struct CodecDDS final :                // Members initially public
     const unsigned int uiMipMapCount = fmData.FileMapReadVar32LE() + 1;
     if(uiMipMapCount > 1) idData.SetMipmaps();
     // Ignore the next 44 bytes. Apps like GIMP can use this space to write
-    // whatever they want here, such as 'GIMP-DDS\'.
-    fmData.FileMapSeekCur(sizeof(uint32_t) * 11);
+    // whatever they want here, such as 'GIMP-DDS\'. We only check the first
+    // two values in case the file was written by our own saver.
+    const unsigned int uiEngMagic = fmData.FileMapReadVar32LE(),
+                       uiEngFlags = fmData.FileMapReadVar32LE();
+    fmData.FileMapSeekCur(sizeof(uint32_t) * 9);
     // Get pixel format size
     const unsigned int uiPFSize = fmData.FileMapReadVar32LE();
     if(uiPFSize != 32)
@@ -287,8 +294,9 @@ struct CodecDDS final :                // Members initially public
            "Calculated", uiScanSize, "Expected", uiPitchOrLinearSize);
     } // Alocate slots as mipmaps
     idData.ReserveSlots(uiMipMapCount);
-    // DDS's are reversed
-    idData.SetReversed();
+    // DDS's are reversed unless our saver said otherwise
+    if(uiEngMagic != DDSE_MAGIC || !(uiEngFlags & DDSE_NOTREVERSED))
+      idData.SetReversed();
     // DXT[n]? Compressed bitmaps need a special calculation
     if(idData.IsCompressed()) for(unsigned int
       // Pre-initialised variables
@@ -338,10 +346,51 @@ struct CodecDDS final :                // Members initially public
     } // Succeeded
     return true;
   }
+  /* -- Save compressed dds file ------------------------------------------- */
+  static bool Save(const FStream &fsData, const ImageData &idData,
+    const ImageSlot &isData)
+  { // Only pre-compressed pixels are supported
+    unsigned int uiFourCC;
+    switch(idData.GetPixelType())
+    { // Get FourCC for the compression type
+      case TT_DXT1: uiFourCC = FOURCC_DXT1; break;
+      case TT_DXT3: uiFourCC = FOURCC_DXT3; break;
+      case TT_DXT5: uiFourCC = FOURCC_DXT5; break;
+      // Unsupported pixel type
+      default: XC("Only DXT1, DXT3 or DXT5 compressed pixels supported!",
+                  "Type", idData.GetPixelType());
+    } // Check that dimensions are set
+    if(isData.DimIsNotSet())
+      XC("Dimensions are invalid!",
+         "Width",  isData.DimGetWidth(), "Height", isData.DimGetHeight());
+    // Check that there is data
+    if(isData.MemIsEmpty()) XC("No image data!", "Size", isData.MemSize());
+    // Build the header. Anything not written is zero.
+    Memory mHeader{ 128, true };
+    mHeader.MemWriteIntLE<uint32_t>(0, 0x20534444);
+    mHeader.MemWriteIntLE<uint32_t>(4, 124);
+    mHeader.MemWriteIntLE<uint32_t>(8,
+      DDSD_CAPS|DDSD_HEIGHT|DDSD_WIDTH|DDSD_PIXELFORMAT);
+    mHeader.MemWriteIntLE<uint32_t>(12, isData.DimGetHeight());
+    mHeader.MemWriteIntLE<uint32_t>(16, isData.DimGetWidth());
+    mHeader.MemWriteIntLE<uint32_t>(32, DDSE_MAGIC);
+    mHeader.MemWriteIntLE<uint32_t>(36,
+      idData.IsReversed() ? 0 : DDSE_NOTREVERSED);
+    mHeader.MemWriteIntLE<uint32_t>(76, 32);
+    mHeader.MemWriteIntLE<uint32_t>(80, DDPF_FOURCC);
+    mHeader.MemWriteIntLE<uint32_t>(84, uiFourCC);
+    mHeader.MemWriteIntLE<uint32_t>(108, DDSCAPS_TEXTURE);
+    // Write the header and the compressed pixels
+    FILE*const fpData = fsData.FStreamGetCtx();
+    return fwrite(mHeader.MemPtr(), 1, mHeader.MemSize(), fpData) ==
+             mHeader.MemSize() &&
+           fwrite(isData.MemPtr(), 1, isData.MemSize(), fpData) ==
+             isData.MemSize();
+  }
   /* -- Constructor -------------------------------------------------------- */
   CodecDDS(void) :
     /* -- Initialisers ----------------------------------------------------- */
-    ImageLib{ IFMT_DDS, "DirectDraw Surface", "DDS", Load }
+    ImageLib{ IFMT_DDS, "DirectDraw Surface", "DDS", Load, Save }
     /* -- No code ---------------------------------------------------------- */
     { }
   /* ----------------------------------------------------------------------- */
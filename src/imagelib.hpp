@@ -75,8 +75,10 @@ CTOR_MEM_BEGIN_CSLAVE(ImageLibs, ImageLib, ICHelperUnsafe)
     { }
   /* ----------------------------------------------------------------------- */
   DELETECOPYCTORS(ImageLib)            // Omit copy constructor for safety
-};/* -- End of objects collector (reserve and set limit for formats) ------- */
-CTOR_END(ImageLibs, ImageLib, reserve(IFMT_MAX); CollectorSetLimit(IFMT_MAX),)
+};/* -- End of objects collector (reserve formats and pick kernels) -------- */
+static void ImageSimdInit(void);       // Prototype
+CTOR_END(ImageLibs, ImageLib, reserve(IFMT_MAX); CollectorSetLimit(IFMT_MAX);
+  ImageSimdInit(),)
 /* -- Save a image using a specific type ----------------------------------- */
 static void ImageSave(const ImageFormat ifId, const string &strFile,
   const ImageData &idData, const ImageSlot &isData)
@@ -165,6 +167,395 @@ static void ImageLoad(FileMap &fmData, ImageData &idData)
   } // Could not detect so throw error
   XC("Unable to determine image format!", "Identifier", fmData.IdentGet());
 }
+/* -- Vector kernels ------------------------------------------------------- **
+** These convert as many pixels as the available instructions allow in one   **
+** go and return how many pixels they did. The caller finishes any pixels    **
+** left over one at a time. SSE2 and NEON are always there on targets that   **
+** define them. The SSSE3 and AVX2 kernels are only compiled for those       **
+** instructions and ImageSimdInit() picks them if the CPU has them.          **
+** ------------------------------------------------------------------------- */
+typedef size_t (*ImageSimdConvFunc)(const uint8_t*const, uint8_t*const,
+  const size_t);
+typedef size_t (*ImageSimdSwapFunc)(uint8_t*const, const size_t);
+/* -- No vector instructions so the caller does every pixel ---------------- */
+static size_t ImageSimdConvNone(const uint8_t*const, uint8_t*const,
+  const size_t) { return 0; }
+static size_t ImageSimdSwapNone(uint8_t*const, const size_t) { return 0; }
+#if defined(SIMD_SSE2)                 // SSE2 available?
+/* -- Write 16 luminance pixels as 48 bytes of RGB ------------------------- */
+SIMD_TARGET("ssse3") static void ImageSimdStoreLumAsRGB(const __m128i mLum,
+  uint8_t*const ubpDst)
+{ // Masks that repeat each byte three times across the three stores
+  const __m128i
+    mMask0{ _mm_setr_epi8(0,0,0,1,1,1,2,2,2,3,3,3,4,4,4,5) },
+    mMask1{ _mm_setr_epi8(5,5,6,6,6,7,7,7,8,8,8,9,9,9,10,10) },
+    mMask2{ _mm_setr_epi8(10,11,11,11,12,12,12,13,13,13,14,14,14,15,15,15) };
+  __m128i*const mpDst = reinterpret_cast<__m128i*>(ubpDst);
+  _mm_storeu_si128(mpDst,   _mm_shuffle_epi8(mLum, mMask0));
+  _mm_storeu_si128(mpDst+1, _mm_shuffle_epi8(mLum, mMask1));
+  _mm_storeu_si128(mpDst+2, _mm_shuffle_epi8(mLum, mMask2));
+}
+/* -- Luminance to RGB with SSSE3 ------------------------------------------ */
+SIMD_TARGET("ssse3") static size_t ImageSimdLumToRGBSSSE3(
+  const uint8_t*const ubpSrc, uint8_t*const ubpDst, const size_t stPixels)
+{ // Expand sixteen pixels at a time
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+    ImageSimdStoreLumAsRGB(_mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(ubpSrc + stPix)), ubpDst + stPix * 3);
+  return stPix;
+}
+/* -- Luminance alpha to RGB with SSSE3 ------------------------------------ */
+SIMD_TARGET("ssse3") static size_t ImageSimdLumAlphaToRGBSSSE3(
+  const uint8_t*const ubpSrc, uint8_t*const ubpDst, const size_t stPixels)
+{ // Drop the alpha from sixteen pixels then expand as luminance
+  const __m128i mLumMask{ _mm_set1_epi16(0x00FF) };
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+  { const __m128i*const mpSrc =
+      reinterpret_cast<const __m128i*>(ubpSrc + stPix * 2);
+    ImageSimdStoreLumAsRGB(_mm_packus_epi16(
+      _mm_and_si128(_mm_loadu_si128(mpSrc), mLumMask),
+      _mm_and_si128(_mm_loadu_si128(mpSrc+1), mLumMask)),
+        ubpDst + stPix * 3); }
+  return stPix;
+}
+/* -- Swap first and third byte of 24-bit pixels with SSSE3 ---------------- */
+SIMD_TARGET("ssse3") static size_t ImageSimdSwapRB24SSSE3(
+  uint8_t*const ubpData, const size_t stPixels)
+{ // Swap five pixels per load leaving the sixteenth byte as it was. The
+  // next load starts on that byte so it is never written with stale data.
+  const __m128i mMask{
+    _mm_setr_epi8(2,1,0,5,4,3,8,7,6,11,10,9,14,13,12,15) };
+  size_t stPix = 0;
+  for(; stPix * 3 + 16 <= stPixels * 3; stPix += 5)
+  { __m128i*const mpData = reinterpret_cast<__m128i*>(ubpData + stPix * 3);
+    _mm_storeu_si128(mpData,
+      _mm_shuffle_epi8(_mm_loadu_si128(mpData), mMask)); }
+  return stPix;
+}
+/* -- Luminance to RGBA with SSE2 ------------------------------------------ */
+static size_t ImageSimdLumToRGBASSE2(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+{ // Interleave the luminance with itself and with opaque alpha
+  const __m128i mOpaque{ _mm_set1_epi8(-1) };
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+  { const __m128i mLum{ _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(ubpSrc + stPix)) },
+      mLL0{ _mm_unpacklo_epi8(mLum, mLum) },
+      mLL1{ _mm_unpackhi_epi8(mLum, mLum) },
+      mLA0{ _mm_unpacklo_epi8(mLum, mOpaque) },
+      mLA1{ _mm_unpackhi_epi8(mLum, mOpaque) };
+    __m128i*const mpDst = reinterpret_cast<__m128i*>(ubpDst + stPix * 4);
+    _mm_storeu_si128(mpDst,   _mm_unpacklo_epi16(mLL0, mLA0));
+    _mm_storeu_si128(mpDst+1, _mm_unpackhi_epi16(mLL0, mLA0));
+    _mm_storeu_si128(mpDst+2, _mm_unpacklo_epi16(mLL1, mLA1));
+    _mm_storeu_si128(mpDst+3, _mm_unpackhi_epi16(mLL1, mLA1)); }
+  return stPix;
+}
+/* -- Luminance to RGBA with AVX2 ------------------------------------------ */
+SIMD_TARGET("avx2") static size_t ImageSimdLumToRGBAAVX2(
+  const uint8_t*const ubpSrc, uint8_t*const ubpDst, const size_t stPixels)
+{ // Widen eight pixels at a time and copy the luminance into RGB
+  const __m256i mAlpha{ _mm256_set1_epi32(static_cast<int>(0xFF000000)) };
+  size_t stPix = 0;
+  for(; stPix + 8 <= stPixels; stPix += 8)
+  { const __m256i mLum{ _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+      reinterpret_cast<const __m128i*>(ubpSrc + stPix))) };
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(ubpDst + stPix * 4),
+      _mm256_or_si256(_mm256_or_si256(mLum, mAlpha),
+        _mm256_or_si256(_mm256_slli_epi32(mLum, 8),
+          _mm256_slli_epi32(mLum, 16)))); }
+  return stPix;
+}
+/* -- Luminance alpha to RGBA with SSE2 ------------------------------------ */
+static size_t ImageSimdLumAlphaToRGBASSE2(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+{ // Double the luminance and interleave it with the original pair
+  const __m128i mLumMask{ _mm_set1_epi16(0x00FF) };
+  size_t stPix = 0;
+  for(; stPix + 8 <= stPixels; stPix += 8)
+  { const __m128i mLumAlpha{ _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(ubpSrc + stPix * 2)) },
+      mLum{ _mm_and_si128(mLumAlpha, mLumMask) },
+      mLumLum{ _mm_or_si128(mLum, _mm_slli_epi16(mLum, 8)) };
+    __m128i*const mpDst = reinterpret_cast<__m128i*>(ubpDst + stPix * 4);
+    _mm_storeu_si128(mpDst,   _mm_unpacklo_epi16(mLumLum, mLumAlpha));
+    _mm_storeu_si128(mpDst+1, _mm_unpackhi_epi16(mLumLum, mLumAlpha)); }
+  return stPix;
+}
+/* -- Luminance alpha to RGBA with AVX2 ------------------------------------ */
+SIMD_TARGET("avx2") static size_t ImageSimdLumAlphaToRGBAAVX2(
+  const uint8_t*const ubpSrc, uint8_t*const ubpDst, const size_t stPixels)
+{ // Widen eight pixels at a time and move alpha to the top byte
+  const __m256i mWideLumMask{ _mm256_set1_epi32(0x000000FF) },
+                mWideAlphaMask{ _mm256_set1_epi32(0x0000FF00) };
+  size_t stPix = 0;
+  for(; stPix + 8 <= stPixels; stPix += 8)
+  { const __m256i mLumAlpha{ _mm256_cvtepu16_epi32(_mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(ubpSrc + stPix * 2))) },
+      mLum{ _mm256_and_si256(mLumAlpha, mWideLumMask) };
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(ubpDst + stPix * 4),
+      _mm256_or_si256(_mm256_or_si256(mLum, _mm256_slli_epi32(mLum, 8)),
+        _mm256_or_si256(_mm256_slli_epi32(mLum, 16), _mm256_slli_epi32(
+          _mm256_and_si256(mLumAlpha, mWideAlphaMask), 16)))); }
+  return stPix;
+}
+/* -- Swap first and third byte of 32-bit pixels with SSE2 ----------------- */
+static size_t ImageSimdSwapRB32SSE2(uint8_t*const ubpData,
+  const size_t stPixels)
+{ // Keep green and alpha and rotate red and blue past each other
+  const __m128i mRBMask{ _mm_set1_epi32(0x00FF00FF) },
+                mGAMask{ _mm_set1_epi32(static_cast<int>(0xFF00FF00)) };
+  size_t stPix = 0;
+  for(; stPix + 4 <= stPixels; stPix += 4)
+  { __m128i*const mpData = reinterpret_cast<__m128i*>(ubpData + stPix * 4);
+    const __m128i mPixels{ _mm_loadu_si128(mpData) },
+                  mRB{ _mm_and_si128(mPixels, mRBMask) };
+    _mm_storeu_si128(mpData, _mm_or_si128(_mm_and_si128(mPixels, mGAMask),
+      _mm_or_si128(_mm_slli_epi32(mRB, 16), _mm_srli_epi32(mRB, 16)))); }
+  return stPix;
+}
+/* -- Swap first and third byte of 32-bit pixels with AVX2 ----------------- */
+SIMD_TARGET("avx2") static size_t ImageSimdSwapRB32AVX2(
+  uint8_t*const ubpData, const size_t stPixels)
+{ // Shuffle eight pixels at a time
+  const __m256i mMask{ _mm256_setr_epi8(2,1,0,3,6,5,4,7,10,9,8,11,14,13,12,
+    15,2,1,0,3,6,5,4,7,10,9,8,11,14,13,12,15) };
+  size_t stPix = 0;
+  for(; stPix + 8 <= stPixels; stPix += 8)
+  { __m256i*const mpData = reinterpret_cast<__m256i*>(ubpData + stPix * 4);
+    _mm256_storeu_si256(mpData,
+      _mm256_shuffle_epi8(_mm256_loadu_si256(mpData), mMask)); }
+  return stPix;
+}
+/* -- Check if the CPU and OS can run SSSE3 instructions ------------------- */
+static bool ImageSimdHaveSSSE3(void)
+{ // Leaf one has the SSSE3 bit
+# if defined(_MSC_VER)                 // Using MSVC?
+  int iRegs[4];
+  __cpuid(iRegs, 1);
+  return iRegs[2] & (1 << 9);
+# else                                 // Using GCC or Clang?
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("ssse3");
+# endif                                // Compiler check
+}
+/* -- Check if the CPU and OS can run AVX2 instructions -------------------- */
+static bool ImageSimdHaveAVX2(void)
+{ // Need leaf seven and the OS has to save the YMM registers
+# if defined(_MSC_VER)                 // Using MSVC?
+  int iRegs[4];
+  __cpuid(iRegs, 0);
+  if(iRegs[0] < 7) return false;
+  __cpuid(iRegs, 1);
+  if((iRegs[2] & (3 << 27)) != (3 << 27) || (_xgetbv(0) & 6) != 6)
+    return false;
+  __cpuidex(iRegs, 7, 0);
+  return iRegs[1] & (1 << 5);
+# else                                 // Using GCC or Clang?
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+# endif                                // Compiler check
+}
+#elif defined(SIMD_NEON)               // NEON available?
+/* -- Luminance to RGB with NEON ------------------------------------------- */
+static size_t ImageSimdLumToRGBNEON(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+{ // Store sixteen pixels at a time interleaved
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+  { const uint8x16_t u8Lum = vld1q_u8(ubpSrc + stPix);
+    vst3q_u8(ubpDst + stPix * 3, uint8x16x3_t{{ u8Lum, u8Lum, u8Lum }}); }
+  return stPix;
+}
+/* -- Luminance to RGBA with NEON ------------------------------------------ */
+static size_t ImageSimdLumToRGBANEON(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+{ // Store sixteen pixels at a time interleaved with opaque alpha
+  const uint8x16_t u8Opaque = vdupq_n_u8(0xFF);
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+  { const uint8x16_t u8Lum = vld1q_u8(ubpSrc + stPix);
+    vst4q_u8(ubpDst + stPix * 4,
+      uint8x16x4_t{{ u8Lum, u8Lum, u8Lum, u8Opaque }}); }
+  return stPix;
+}
+/* -- Luminance alpha to RGB with NEON ------------------------------------- */
+static size_t ImageSimdLumAlphaToRGBNEON(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+{ // Load sixteen pixels at a time deinterleaved and drop the alpha
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+  { const uint8x16x2_t u8LumAlpha = vld2q_u8(ubpSrc + stPix * 2);
+    vst3q_u8(ubpDst + stPix * 3, uint8x16x3_t{{ u8LumAlpha.val[0],
+      u8LumAlpha.val[0], u8LumAlpha.val[0] }}); }
+  return stPix;
+}
+/* -- Luminance alpha to RGBA with NEON ------------------------------------ */
+static size_t ImageSimdLumAlphaToRGBANEON(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+{ // Load sixteen pixels at a time deinterleaved and keep the alpha
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+  { const uint8x16x2_t u8LumAlpha = vld2q_u8(ubpSrc + stPix * 2);
+    vst4q_u8(ubpDst + stPix * 4, uint8x16x4_t{{ u8LumAlpha.val[0],
+      u8LumAlpha.val[0], u8LumAlpha.val[0], u8LumAlpha.val[1] }}); }
+  return stPix;
+}
+/* -- Swap first and third byte of 24-bit pixels with NEON ----------------- */
+static size_t ImageSimdSwapRB24NEON(uint8_t*const ubpData,
+  const size_t stPixels)
+{ // Swap the red and blue planes of sixteen pixels at a time
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+  { uint8x16x3_t u8Pixels = vld3q_u8(ubpData + stPix * 3);
+    const uint8x16_t u8Red = u8Pixels.val[0];
+    u8Pixels.val[0] = u8Pixels.val[2];
+    u8Pixels.val[2] = u8Red;
+    vst3q_u8(ubpData + stPix * 3, u8Pixels); }
+  return stPix;
+}
+/* -- Swap first and third byte of 32-bit pixels with NEON ----------------- */
+static size_t ImageSimdSwapRB32NEON(uint8_t*const ubpData,
+  const size_t stPixels)
+{ // Swap the red and blue planes of sixteen pixels at a time
+  size_t stPix = 0;
+  for(; stPix + 16 <= stPixels; stPix += 16)
+  { uint8x16x4_t u8Pixels = vld4q_u8(ubpData + stPix * 4);
+    const uint8x16_t u8Red = u8Pixels.val[0];
+    u8Pixels.val[0] = u8Pixels.val[2];
+    u8Pixels.val[2] = u8Red;
+    vst4q_u8(ubpData + stPix * 4, u8Pixels); }
+  return stPix;
+}
+#endif                                 // Instruction set check
+/* -- Kernels in use (ImageSimdInit() may pick faster ones) ---------------- */
+static struct ImageSimdKernels final
+{ ImageSimdConvFunc iscfLumToRGB,      // Luminance to RGB
+                    iscfLumToRGBA,     // Luminance to RGBA
+                    iscfLumAlphaToRGB, // Luminance alpha to RGB
+                    iscfLumAlphaToRGBA; // Luminance alpha to RGBA
+  ImageSimdSwapFunc issfSwapRB24,      // Swap red and blue of 24-bit pixels
+                    issfSwapRB32;      // Swap red and blue of 32-bit pixels
+} iskKernels{
+#if defined(SIMD_SSE2)                 // SSE2 available?
+  ImageSimdConvNone, ImageSimdLumToRGBASSE2, ImageSimdConvNone,
+  ImageSimdLumAlphaToRGBASSE2, ImageSimdSwapNone, ImageSimdSwapRB32SSE2
+#elif defined(SIMD_NEON)               // NEON available?
+  ImageSimdLumToRGBNEON, ImageSimdLumToRGBANEON, ImageSimdLumAlphaToRGBNEON,
+  ImageSimdLumAlphaToRGBANEON, ImageSimdSwapRB24NEON, ImageSimdSwapRB32NEON
+#else                                  // No vector instructions?
+  ImageSimdConvNone, ImageSimdConvNone, ImageSimdConvNone,
+  ImageSimdConvNone, ImageSimdSwapNone, ImageSimdSwapNone
+#endif                                 // Instruction set check
+};
+/* -- Check a conversion kernel against converting one pixel at a time ----- */
+template<size_t stSrcStep, size_t stDstStep, class PixelFunc>
+  static void ImageSimdCheckConv(ImageSimdConvFunc &iscfFunc,
+    const char*const cpFilter, const PixelFunc pfExpect)
+{ // Try every length up to a few vectors so every tail size is covered
+  for(size_t stPixels = 0; stPixels <= 67; ++stPixels)
+  { // Make varied source bytes and fill the destinations with a marker
+    vector<uint8_t> vSrc(stPixels * stSrcStep),
+                    vDst(stPixels * stDstStep, 0xA5),
+                    vExpect{ vDst };
+    for(size_t stIndex = 0; stIndex < vSrc.size(); ++stIndex)
+      vSrc[stIndex] = static_cast<uint8_t>(stIndex * 151 + stPixels * 7);
+    // Pixels the kernel did must match and the rest must be untouched
+    const size_t stDone = iscfFunc(vSrc.data(), vDst.data(), stPixels);
+    if(stDone <= stPixels)
+    { for(size_t stPix = 0; stPix < stDone; ++stPix)
+        pfExpect(vSrc.data() + stPix * stSrcStep,
+                 vExpect.data() + stPix * stDstStep);
+      if(vDst == vExpect) continue;
+    } // Kernel is broken so convert one pixel at a time instead
+    cLog->LogWarningExSafe("ImageLibs disabled bad $ kernel at $ pixels!",
+      cpFilter, stPixels);
+    iscfFunc = ImageSimdConvNone;
+    return;
+  }
+}
+/* -- Check a red and blue swap kernel against swapping one at a time ------ */
+template<size_t stStep>
+  static void ImageSimdCheckSwap(ImageSimdSwapFunc &issfFunc,
+    const char*const cpFilter)
+{ // Try every length up to a few vectors so every tail size is covered
+  for(size_t stPixels = 0; stPixels <= 67; ++stPixels)
+  { // Make varied bytes and the result expected
+    vector<uint8_t> vData(stPixels * stStep);
+    for(size_t stIndex = 0; stIndex < vData.size(); ++stIndex)
+      vData[stIndex] = static_cast<uint8_t>(stIndex * 151 + stPixels * 7);
+    vector<uint8_t> vExpect{ vData };
+    // Pixels the kernel did must be swapped and the rest must be untouched
+    const size_t stDone = issfFunc(vData.data(), stPixels);
+    if(stDone <= stPixels)
+    { for(size_t stPix = 0; stPix < stDone; ++stPix)
+        swap(vExpect[stPix * stStep], vExpect[stPix * stStep + 2]);
+      if(vData == vExpect) continue;
+    } // Kernel is broken so swap one pixel at a time instead
+    cLog->LogWarningExSafe("ImageLibs disabled bad $ kernel at $ pixels!",
+      cpFilter, stPixels);
+    issfFunc = ImageSimdSwapNone;
+    return;
+  }
+}
+/* -- Pick the fastest kernels the CPU can run and check them -------------- */
+static void ImageSimdInit(void)
+{ // Pick kernels for the extra instructions the CPU has
+#if defined(SIMD_SSE2)                 // SSE2 available?
+  string strSets{ "SSE2" };
+  if(ImageSimdHaveSSSE3())
+  { iskKernels.iscfLumToRGB = ImageSimdLumToRGBSSSE3;
+    iskKernels.iscfLumAlphaToRGB = ImageSimdLumAlphaToRGBSSSE3;
+    iskKernels.issfSwapRB24 = ImageSimdSwapRB24SSSE3;
+    strSets += "+SSSE3";
+  } // AVX2 replaces the SSE2 kernels
+  if(ImageSimdHaveAVX2())
+  { iskKernels.iscfLumToRGBA = ImageSimdLumToRGBAAVX2;
+    iskKernels.iscfLumAlphaToRGBA = ImageSimdLumAlphaToRGBAAVX2;
+    iskKernels.issfSwapRB32 = ImageSimdSwapRB32AVX2;
+    strSets += "+AVX2";
+  }
+#elif defined(SIMD_NEON)               // NEON available?
+  const string strSets{ "NEON" };
+#else                                  // No vector instructions?
+  const string strSets{ "no vector" };
+#endif                                 // Instruction set check
+  // Make sure each kernel gives the same result as the per-pixel filters
+  ImageSimdCheckConv<1, 3>(iskKernels.iscfLumToRGB, "LUM>RGB",
+    [](const uint8_t*const ubpSrc, uint8_t*const ubpDst)
+      { ubpDst[0] = ubpDst[1] = ubpDst[2] = ubpSrc[0]; });
+  ImageSimdCheckConv<1, 4>(iskKernels.iscfLumToRGBA, "LUM>RGBA",
+    [](const uint8_t*const ubpSrc, uint8_t*const ubpDst)
+      { ubpDst[0] = ubpDst[1] = ubpDst[2] = ubpSrc[0]; ubpDst[3] = 0xFF; });
+  ImageSimdCheckConv<2, 3>(iskKernels.iscfLumAlphaToRGB, "LUMA>RGB",
+    [](const uint8_t*const ubpSrc, uint8_t*const ubpDst)
+      { ubpDst[0] = ubpDst[1] = ubpDst[2] = ubpSrc[0]; });
+  ImageSimdCheckConv<2, 4>(iskKernels.iscfLumAlphaToRGBA, "LUMA>RGBA",
+    [](const uint8_t*const ubpSrc, uint8_t*const ubpDst)
+      { ubpDst[0] = ubpDst[1] = ubpDst[2] = ubpSrc[0];
+        ubpDst[3] = ubpSrc[1]; });
+  ImageSimdCheckSwap<3>(iskKernels.issfSwapRB24, "RGB>BGR");
+  ImageSimdCheckSwap<4>(iskKernels.issfSwapRB32, "RGBA>BGRA");
+  // Log what was picked
+  cLog->LogDebugExSafe("ImageLibs using $ pixel conversion kernels.",
+    strSets);
+}
+/* -- Convert with the kernels in use -------------------------------------- */
+static size_t ImageSimdLumToRGB(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+    { return iskKernels.iscfLumToRGB(ubpSrc, ubpDst, stPixels); }
+static size_t ImageSimdLumToRGBA(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+    { return iskKernels.iscfLumToRGBA(ubpSrc, ubpDst, stPixels); }
+static size_t ImageSimdLumAlphaToRGB(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+    { return iskKernels.iscfLumAlphaToRGB(ubpSrc, ubpDst, stPixels); }
+static size_t ImageSimdLumAlphaToRGBA(const uint8_t*const ubpSrc,
+  uint8_t*const ubpDst, const size_t stPixels)
+    { return iskKernels.iscfLumAlphaToRGBA(ubpSrc, ubpDst, stPixels); }
 /* ------------------------------------------------------------------------- */
 static int ImageSwapPixels(char*const cpSrc, const size_t stSrc,
   const size_t stPixel, const size_t stSwapA, const size_t stSwapB)
@@ -175,8 +566,16 @@ static int ImageSwapPixels(char*const cpSrc, const size_t stSrc,
   if(stSwapB >= stPixel) return -3;
   if(stPixel >= stSrc) return -4;
   if(stSwapA == stSwapB) return -5;
-  // Do swap the pixels
-  for(size_t stPos = 0; stPos < stSrc; stPos += stPixel)
+  // Swapping red and blue can be done many pixels at a time
+  size_t stStart = 0;
+  if((!stSwapA && stSwapB == 2) || (stSwapA == 2 && !stSwapB))
+  { uint8_t*const ubpSrc = reinterpret_cast<uint8_t*>(cpSrc);
+    if(stPixel == 3)
+      stStart = iskKernels.issfSwapRB24(ubpSrc, stSrc / 3) * 3;
+    else if(stPixel == 4)
+      stStart = iskKernels.issfSwapRB32(ubpSrc, stSrc / 4) * 4;
+  } // Do swap the remaining pixels
+  for(size_t stPos = stStart; stPos < stSrc; stPos += stPixel)
   { // Calculate source position and copy character at source
     const size_t stPosA = stPos+stSwapA;
     const char cByte = cpSrc[stPosA];
@@ -0,0 +1,325 @@
+/* == JOB.HPP ============================================================== **
+** ######################################################################### **
+** ## MS-ENGINE              Copyright (c) MS-Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## This module keeps a pool of worker threads sized to the hardware so ## **
+** ## short asynchronous tasks can share them instead of starting a new   ## **
+** ## thread each. Every worker has its own queues and steals from the    ## **
+** ## others when it runs out of work.                                    ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace IJob {                       // Start of private namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IError::P;             using namespace IIdent::P;
+using namespace ILog::P;               using namespace IProfile::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISysUtil::P;           using namespace IThread::P;
+using namespace IUtil::P;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public namespace
+/* -- Job priorities ------------------------------------------------------- */
+enum JobPriority : size_t              // Highest priority first
+{ /* ----------------------------------------------------------------------- */
+  JP_FRAME,                            // Something is waiting on it now
+  JP_STREAM,                           // Needed soon (asynchronous loads)
+  JP_BACKGROUND,                       // Needed whenever
+  /* ----------------------------------------------------------------------- */
+  JP_MAX                               // Maximum number of priorities
+};/* ----------------------------------------------------------------------- */
+class JobBase :                        // Job variables class
+  /* -- Base classes ------------------------------------------------------- */
+  public Ident                         // Name of job for logging
+{ /* -- Private typedefs ---------------------------------------- */ protected:
+  typedef function<void(void)> CBFunc; // Job callback function
+  enum JobState { JS_IDLE, JS_QUEUED, JS_RUNNING }; // Job states
+  /* -- Private variables -------------------------------------------------- */
+  CBFunc           cbfFunc;            // Job callback function
+  JobPriority      jpPriority;         // Job priority
+  SafeBool         sbShouldExit;       // Job should stop early
+  mutex            mState;             // State is being used
+  condition_variable cvState;          // State changed to idle
+  JobState         jsState;            // Job state
+  thread::id       tiWorker;           // Thread running the job
+  /* -- Execute the job (called by the worker that removed it) ----- */ public:
+  void JobExecute(void)
+  { // Now running on this thread
+    { const LockGuard lgState{ mState };
+      jsState = JS_RUNNING;
+      tiWorker = ::std::this_thread::get_id(); }
+    // Run the job and log any exception it did not handle itself
+    try { cbfFunc(); }
+    catch(const exception &eReason)
+    { cLog->LogErrorExSafe("Job '$' failed with exception: $",
+        IdentGet(), eReason.what()); }
+    // Finished so wake anything waiting. This must be done while the lock
+    // is held as a waiter that sees the job is idle may destroy it.
+    const LockGuard lgState{ mState };
+    jsState = JS_IDLE;
+    tiWorker = {};
+    cvState.notify_all();
+  }
+  /* ----------------------------------------------------------------------- */
+  JobPriority JobGetPriority(void) const { return jpPriority; }
+  /* -- Constructor ------------------------------------------- */ protected:
+  JobBase(void) :                      // No parameters
+    /* -- Initialisers ----------------------------------------------------- */
+    jpPriority(JP_STREAM),             // Default priority
+    sbShouldExit(false),               // Should never exit at first
+    jsState(JS_IDLE)                   // Not queued or running
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+};/* ----------------------------------------------------------------------- */
+static class Jobs final                // Members initially private
+{ /* -- Private typedefs --------------------------------------------------- */
+  typedef deque<JobBase*> JobQueue;    // Jobs waiting to run
+  struct Worker                        // Worker queues
+  { /* --------------------------------------------------------------------- */
+    mutex          mQueue;             // Queues are being used
+    array<JobQueue, JP_MAX> aQueues;   // Queue for each priority
+  };/* --------------------------------------------------------------------- */
+  typedef vector<Worker> Workers;      // Queues for each worker
+  /* -- Private variables -------------------------------------------------- */
+  Workers          wQueues;            // Queues for each worker
+  deque<Thread>    dThreads;           // Worker threads
+  mutex            mWake;              // Waking workers
+  condition_variable cvWake;           // Signalled when a job is queued
+  SafeSizeT        stQueued,           // Number of jobs queued
+                   stNext,             // Next worker to give a job to
+                   stBusy,             // Number of workers running a job
+                   stPeak,             // Most workers running at once
+                   stExecuted,         // Number of jobs run
+                   stStolen;           // Number of jobs taken from others
+  /* -- Take a job from a queue -------------------------------------------- */
+  JobBase *JobsTakeFrom(Worker &wRef, const size_t stPriority,
+    const bool bFront)
+  { // Lock the queues and return nothing if empty
+    const LockGuard lgQueue{ wRef.mQueue };
+    JobQueue &jqRef = wRef.aQueues[stPriority];
+    if(jqRef.empty()) return nullptr;
+    // Take the oldest job from our own queue and the newest from others
+    JobBase*const jbJob = bFront ? jqRef.front() : jqRef.back();
+    if(bFront) jqRef.pop_front(); else jqRef.pop_back();
+    --stQueued;
+    return jbJob;
+  }
+  /* -- Take the most important job available ------------------------------ */
+  JobBase *JobsTake(const size_t stWorker)
+  { // For each priority, try our own queue and then everybody else's
+    for(size_t stPriority = 0; stPriority < JP_MAX; ++stPriority)
+    { if(JobBase*const jbJob =
+           JobsTakeFrom(wQueues[stWorker], stPriority, true))
+        return jbJob;
+      for(size_t stIndex = 1; stIndex < wQueues.size(); ++stIndex)
+        if(JobBase*const jbJob = JobsTakeFrom(
+             wQueues[(stWorker + stIndex) % wQueues.size()], stPriority,
+             false))
+        { ++stStolen; return jbJob; }
+    } // Nothing to do
+    return nullptr;
+  }
+  /* -- Worker thread ------------------------------------------------------ */
+  int JobsWorkerMain(Thread &tRef, const size_t stWorker)
+  { // Get a job and if there isn't one?
+    JobBase*const jbJob = JobsTake(stWorker);
+    if(!jbJob)
+    { // Wait for a job to be queued or to be told to exit
+      UniqueLock ulWake{ mWake };
+      cvWake.wait(ulWake, [this, &tRef]
+        { return stQueued > 0 || tRef.ThreadShouldExit(); });
+      // Exit if requested else try again
+      return tRef.ThreadShouldExit() ? 1 : 0;
+    } // Record how many workers are busy
+    const size_t stNowBusy = ++stBusy;
+    size_t stOldPeak = stPeak;
+    while(stNowBusy > stOldPeak &&
+      !stPeak.compare_exchange_weak(stOldPeak, stNowBusy));
+    // Run the job
+    { const ProfileScope psJob{ PZ_JOB };
+      jbJob->JobExecute(); }
+    --stBusy;
+    ++stExecuted;
+    // Next job
+    return 0;
+  }
+  /* -- Queue a job ------------------------------------------------ */ public:
+  void JobsPush(JobBase &jbRef)
+  { // Count it first so the count never drops below zero when it is taken
+    { const LockGuard lgWake{ mWake };
+      ++stQueued; }
+    // Give it to the next worker in turn
+    Worker &wRef = wQueues[stNext++ % wQueues.size()];
+    { const LockGuard lgQueue{ wRef.mQueue };
+      wRef.aQueues[jbRef.JobGetPriority()].push_back(&jbRef); }
+    // Wake a worker up
+    cvWake.notify_one();
+  }
+  /* -- Remove a job if it has not been taken yet -------------------------- */
+  bool JobsRemove(JobBase &jbRef)
+  { // For each worker
+    for(Worker &wRef : wQueues)
+    { // Lock the queues and look for the job
+      const LockGuard lgQueue{ wRef.mQueue };
+      JobQueue &jqRef = wRef.aQueues[jbRef.JobGetPriority()];
+      const auto aJob{ StdFindIf(seq, jqRef.begin(), jqRef.end(),
+        [&jbRef](const JobBase*const jbOther)
+          { return jbOther == &jbRef; }) };
+      if(aJob == jqRef.end()) continue;
+      // Remove it
+      jqRef.erase(aJob);
+      --stQueued;
+      return true;
+    } // Already taken by a worker
+    return false;
+  }
+  /* -- Statistics --------------------------------------------------------- */
+  size_t JobsGetWorkers(void) const { return dThreads.size(); }
+  size_t JobsGetQueued(void) const { return stQueued; }
+  size_t JobsGetBusy(void) const { return stBusy; }
+  size_t JobsGetPeak(void) const { return stPeak; }
+  size_t JobsGetExecuted(void) const { return stExecuted; }
+  size_t JobsGetStolen(void) const { return stStolen; }
+  /* -- Constructor -------------------------------------------------------- */
+  Jobs(void) :                         // No parameters
+    /* -- Initialisers ----------------------------------------------------- */
+    wQueues(UtilMaximum(thread::hardware_concurrency(), 3U) - 1),
+    stQueued(0),                       // No jobs queued
+    stNext(0),                         // Start with the first worker
+    stBusy(0),                         // No workers busy
+    stPeak(0),                         // No workers busy yet
+    stExecuted(0),                     // No jobs run yet
+    stStolen(0)                        // No jobs stolen yet
+  { // Start a worker for each set of queues. Leave a core for the main
+    // thread but have at least two so a slow job doesn't block the rest.
+    for(size_t stIndex = 0; stIndex < wQueues.size(); ++stIndex)
+      dThreads.emplace_back(StrAppend("job", stIndex), STP_LOW,
+        bind(&Jobs::JobsWorkerMain, this, _1, stIndex), this);
+    // Log workers started
+    cLog->LogDebugExSafe("Jobs started $ workers.", dThreads.size());
+  }
+  /* -- Destructor --------------------------------------------------------- */
+  ~Jobs(void)
+  { // Tell every worker to exit while none can be between checking and
+    // waiting, then wake them all up and wait for them.
+    { const LockGuard lgWake{ mWake };
+      for(Thread &tRef : dThreads) tRef.ThreadSetExit(); }
+    cvWake.notify_all();
+    for(Thread &tRef : dThreads) tRef.ThreadDeInit();
+    // Log statistics
+    cLog->LogDebugExSafe("Jobs stopped $ workers after $ jobs ($ stolen, $ "
+      "at most at once).", dThreads.size(), stExecuted.load(),
+      stStolen.load(), stPeak.load());
+  }
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(Jobs)                // No copy constructor
+  /* ----------------------------------------------------------------------- */
+} *cJobs = nullptr;                    // Global access
+/* == Job class ============================================================ */
+class Job :                            // Members initially private
+  /* -- Base classes ------------------------------------------------------- */
+  public JobBase                       // Job variables class
+{ /* -- Is job queued or running? --------------------------------- */ public:
+  bool JobIsRunning(void)
+    { const LockGuard lgState{ mState }; return jsState != JS_IDLE; }
+  bool JobIsNotRunning(void) { return !JobIsRunning(); }
+  /* -- Is job running on this thread? ------------------------------------- */
+  bool JobIsCurrent(void)
+  { const LockGuard lgState{ mState };
+    return tiWorker == ::std::this_thread::get_id(); }
+  /* ----------------------------------------------------------------------- */
+  bool JobShouldExit(void) const { return sbShouldExit; }
+  bool JobShouldNotExit(void) const { return !JobShouldExit(); }
+  /* -- Queue the job ------------------------------------------------------ */
+  void JobStart(const string &strName, const CBFunc &cbfNFunc,
+    const JobPriority jpNPriority)
+  { // Can't start a job twice
+    if(JobIsRunning())
+      XC("Job already started!", "Identifier", IdentGet(), "New", strName);
+    // Set job parameters
+    IdentSet(strName);
+    cbfFunc = cbfNFunc;
+    jpPriority = jpNPriority;
+    sbShouldExit = false;
+    { const LockGuard lgState{ mState };
+      jsState = JS_QUEUED; }
+    // Give it to the pool
+    cJobs->JobsPush(*this);
+  }
+  /* -- Wait for the job to finish ----------------------------------------- */
+  void JobWait(void)
+  { // Done if not queued or running
+    if(JobIsNotRunning()) return;
+    // Waiting on ourself would never return
+    if(JobIsCurrent())
+      XC("Tried to wait for a job from itself!", "Identifier", IdentGet());
+    // Nothing has started it so do it here instead of waiting for a worker
+    if(cJobs->JobsRemove(*this)) return JobExecute();
+    // Wait for the worker to finish it
+    UniqueLock ulState{ mState };
+    cvState.wait(ulState, [this]{ return jsState == JS_IDLE; });
+  }
+  /* -- Stop the job ------------------------------------------------------- */
+  void JobStop(void)
+  { // Done if not queued or running
+    if(JobIsNotRunning()) return;
+    // Waiting on ourself would never return
+    if(JobIsCurrent())
+      XC("Tried to stop a job from itself!", "Identifier", IdentGet());
+    // Tell the job to stop if it is running
+    sbShouldExit = true;
+    // If nothing has started it then just forget about it
+    if(cJobs->JobsRemove(*this))
+    { const LockGuard lgState{ mState };
+      jsState = JS_IDLE;
+      return; }
+    // Wait for the worker to finish it
+    UniqueLock ulState{ mState };
+    cvState.wait(ulState, [this]{ return jsState == JS_IDLE; });
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  Job(void) { }
+  /* -- Destructor --------------------------------------------------------- */
+  ~Job(void) { JobStop(); }
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(Job)                 // No copy constructor
+};/* ----------------------------------------------------------------------- */
+/* -- Run a function for every index on the job pool and wait for them ----- */
+static void JobForEach(const string &strName, const size_t stCount,
+  const function<void(const size_t)> &fcbItem)
+{ // Run them all here if there is no job pool (e.g. the build tool)
+  if(!cJobs)
+  { for(size_t stIndex = 0; stIndex < stCount; ++stIndex) fcbItem(stIndex);
+    return; }
+  // Split the indexes into about one contiguous batch per worker so there
+  // are only a few jobs no matter how many indexes there are.
+  const size_t stBatches =
+    UtilMinimum(stCount, UtilMaximum(cJobs->JobsGetWorkers(), 1));
+  // Jobs catch exceptions so keep the first index that failed in each batch
+  // and the reason.
+  vector<pair<size_t, string>> vpErrors(stBatches);
+  // Queue a job for each batch. These are waited on in the same order so
+  // any job a worker did not take yet is run here instead of waiting.
+  deque<Job> dJobs;
+  for(size_t stBatch = 0; stBatch < stBatches; ++stBatch)
+  { const size_t stBegin = stCount * stBatch / stBatches,
+      stEnd = stCount * (stBatch + 1) / stBatches;
+    dJobs.emplace_back().JobStart(StrAppend(strName, stBegin),
+      [&fcbItem, &vpErrors, stBatch, stBegin, stEnd]
+      { for(size_t stIndex = stBegin; stIndex < stEnd; ++stIndex)
+          try { fcbItem(stIndex); }
+          catch(const exception &eReason)
+          { vpErrors[stBatch] = { stIndex, eReason.what() }; break; } },
+      JP_FRAME);
+  } // Wait for every job to finish
+  for(Job &jRef : dJobs) jRef.JobWait();
+  // Report the first index that failed
+  for(const pair<size_t, string> &pError : vpErrors)
+    if(!pError.second.empty())
+      XC("Job failed!", "Name", strName, "Index", pError.first,
+         "Reason", pError.second);
+}
+}                                      // End of public namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private namespace
+/* == EoF =========================================================== EoF == */
@@ -21,6 +21,231 @@ using namespace IUtil::P;              using namespace Lib::RapidJson;
 using Lib::RapidJson::Value;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
+/* -- Rapidjson output stream that writes into a memory block -------------- */
+class JsonMemoryStream
+{ /* -- Private variables -------------------------------------------------- */
+  Memory          &mOut;               // Memory block to write to
+  size_t           stUsed;             // Bytes written to memory block
+  /* -- Rapidjson character type ----------------------------------- */ public:
+  typedef char Ch;
+  /* -- Write a character growing the block if needed ---------------------- */
+  void Put(const Ch cChar)
+  { // Double the size of the block if full
+    if(stUsed >= mOut.MemSize())
+      mOut.MemResize(UtilMaximum(mOut.MemSize() * 2, 4096));
+    // Write the character
+    mOut.MemPtr<Ch>()[stUsed++] = cChar;
+  }
+  /* -- Nothing to flush --------------------------------------------------- */
+  void Flush(void) { }
+  /* -- Shrink the block to the bytes written ------------------------------ */
+  void Finish(void) { mOut.MemResize(stUsed); }
+  /* -- Constructor -------------------------------------------------------- */
+  explicit JsonMemoryStream(Memory &mDest) :
+    /* -- Initialisers ----------------------------------------------------- */
+    mOut(mDest),                       // Set memory block to write to
+    stUsed(0)                          // Nothing written yet
+    /* -- No code ---------------------------------------------------------- */
+    { }
+};/* -- Rapidjson handler that builds Lua tables as it parses -------------- */
+class JsonLuaHandler :
+  /* -- Base classes ------------------------------------------------------- */
+  public BaseReaderHandler<UTF8<>, JsonLuaHandler> // Default handlers
+{ /* -- Private variables -------------------------------------------------- */
+  lua_State*const  lS;                 // Lua state to build tables in
+  vector<lua_Integer> vIndexes;        // Next index per level (0=object)
+  /* -- Set the value on top of the stack in the parent table -------------- */
+  bool Set(void)
+  { // Nothing to do if this is the root value
+    if(vIndexes.empty()) return true;
+    // Set as next array index or as the value of the key below it
+    lua_Integer &liIndex = vIndexes.back();
+    if(liIndex) lua_rawseti(lS, -2, liIndex++);
+    else lua_rawset(lS, -3);
+    // Continue parsing
+    return true;
+  }
+  /* -- Create a new table level ------------------------------------------- */
+  bool Begin(const lua_Integer liIndex)
+  { // Need room for the table, a key and a value
+    if(!LuaUtilIsStackAvail(lS, 3)) return false;
+    // Create the table and start the level
+    LuaUtilPushTable(lS);
+    vIndexes.push_back(liIndex);
+    // Continue parsing
+    return true;
+  }
+  /* -- Finish a table level ----------------------------------------------- */
+  bool End(void) { vIndexes.pop_back(); return Set(); }
+  /* -- Values ----------------------------------------------------- */ public:
+  bool Null(void) { LuaUtilPushNil(lS); return Set(); }
+  bool Bool(const bool bValue) { LuaUtilPushBool(lS, bValue); return Set(); }
+  bool Int(const int iValue) { LuaUtilPushInt(lS, iValue); return Set(); }
+  bool Uint(const unsigned int uiValue)
+    { LuaUtilPushInt(lS, uiValue); return Set(); }
+  bool Int64(const int64_t qValue)
+    { LuaUtilPushInt(lS, qValue); return Set(); }
+  bool Uint64(const uint64_t qValue)
+  { // Too big for a Lua integer? Push as a number instead
+    if(qValue > static_cast<uint64_t>(numeric_limits<lua_Integer>::max()))
+      LuaUtilPushNum(lS, static_cast<lua_Number>(qValue));
+    else LuaUtilPushInt(lS, qValue);
+    // Set the value
+    return Set();
+  }
+  bool Double(const double dValue)
+    { LuaUtilPushNum(lS, dValue); return Set(); }
+  bool String(const char*const cpStr, const SizeType stLen, const bool)
+    { LuaUtilPushLStr(lS, cpStr, stLen); return Set(); }
+  /* -- Object and array events -------------------------------------------- */
+  bool StartObject(void) { return Begin(0); }
+  bool Key(const char*const cpStr, const SizeType stLen, const bool)
+    { LuaUtilPushLStr(lS, cpStr, stLen); return true; }
+  bool EndObject(const SizeType) { return End(); }
+  bool StartArray(void) { return Begin(1); }
+  bool EndArray(const SizeType) { return End(); }
+  /* -- Constructor -------------------------------------------------------- */
+  explicit JsonLuaHandler(lua_State*const lSNew) :
+    /* -- Initialisers ----------------------------------------------------- */
+    lS(lSNew)                          // Set lua state
+    /* -- No code ---------------------------------------------------------- */
+    { }
+};/* -- Decode json straight into a Lua table on the stack ----------------- */
+static void JsonDecode(lua_State*const lS, const char*const cpSrc,
+  const size_t stSize)
+{ // Remember stack position so it can be restored on error
+  const int iTop = LuaUtilStackSize(lS);
+  // Parse the data and build the tables as we go
+  JsonLuaHandler jlhHandler{ lS };
+  MemoryStream msData{ cpSrc, stSize };
+  Reader rReader;
+  const ParseResult prData{ rReader.Parse(msData, jlhHandler) };
+  if(!prData)
+  { // Remove partially built tables and show error
+    LuaUtilPruneStack(lS, iTop);
+    XC(GetParseError_En(prData.Code()),
+      "Size", stSize, "JsonSize", prData.Offset());
+  } // Root must be a table like Json:ToTable() requires
+  if(!LuaUtilIsTable(lS, -1))
+  { // Remove the value and show error
+    LuaUtilPruneStack(lS, iTop);
+    XC("Json value not array or object!");
+  }
+}
+/* -- Decode json in a Lua string straight into a Lua table ---------------- */
+static void JsonDecodeString(lua_State*const lS, const int iParam)
+{ // Check and get the string. It stays on the stack while parsing.
+  LuaUtilCheckStr(lS, iParam);
+  size_t stStr; const char*const cpStr = lua_tolstring(lS, iParam, &stStr);
+  // Decode it
+  JsonDecode(lS, cpStr, stStr);
+}
+/* -- Decode json in a memory block straight into a Lua table -------------- */
+static void JsonDecodeBlock(lua_State*const lS, const MemConst &mcSrc)
+  { JsonDecode(lS, mcSrc.MemPtr<char>(), mcSrc.MemSize()); }
+/* -- Prototype ------------------------------------------------------------ */
+template<class WriterType>static void JsonWriteTable(lua_State*const,
+  const int, WriterType&, const unsigned int);
+/* -- Write a Lua value straight to a rapidjson writer --------------------- */
+template<class WriterType>static void JsonWriteValue(lua_State*const lS,
+  const int iId, WriterType &rwWriter, const unsigned int uiDepth)
+{ // Write the value depending on its type. Strings are checked first so
+  // Lua does not convert numbered strings to numbers.
+  switch(lua_type(lS, iId))
+  { // Variable is a string
+    case LUA_TSTRING:
+    { // Get string and length and write it
+      size_t stStr; const char*const cpStr = lua_tolstring(lS, iId, &stStr);
+      rwWriter.String(cpStr, static_cast<SizeType>(stStr));
+      break;
+    } // Variable is a number
+    case LUA_TNUMBER:
+      if(LuaUtilIsInteger(lS, iId)) rwWriter.Int64(lua_tointeger(lS, iId));
+      else rwWriter.Double(lua_tonumber(lS, iId));
+      break;
+    // Variable is a boolean
+    case LUA_TBOOLEAN: rwWriter.Bool(lua_toboolean(lS, iId)); break;
+    // Variable is a table
+    case LUA_TTABLE: JsonWriteTable(lS, iId, rwWriter, uiDepth + 1); break;
+    // Anything else can't be represented
+    default: rwWriter.Null(); break;
+  }
+}
+/* -- Write a Lua table straight to a rapidjson writer --------------------- */
+template<class WriterType>static void JsonWriteTable(lua_State*const lS,
+  const int iId, WriterType &rwWriter, const unsigned int uiDepth)
+{ // Stop tables that reference themselves
+  if(uiDepth > 255) XC("Json table nesting too deep!", "Depth", uiDepth);
+  // We need room for a key, value and key copy
+  if(!LuaUtilIsStackAvail(lS, 3))
+    XC("Not enough stack to encode table!", "Depth", uiDepth);
+  // Get absolute index as we will be pushing values
+  const int iTable = lua_absindex(lS, iId);
+  // If we have length then write an array
+  if(const lua_Integer liLen =
+    UtilIntOrMax<lua_Integer>(LuaUtilGetSize(lS, iTable)))
+  { // Write each value in order
+    rwWriter.StartArray();
+    for(lua_Integer liIndex = 1; liIndex <= liLen; ++liIndex)
+    { // Get value, write it and remove it
+      LuaUtilGetRefEx(lS, iTable, liIndex);
+      JsonWriteValue(lS, -1, rwWriter, uiDepth);
+      LuaUtilRmStack(lS);
+    } // Finished array
+    rwWriter.EndArray(static_cast<SizeType>(liLen));
+    return;
+  } // Walk through all the object members
+  rwWriter.StartObject();
+  SizeType stMembers = 0;
+  for(LuaUtilPushNil(lS); lua_next(lS, iTable); LuaUtilRmStack(lS))
+  { // Convert a copy of the key so lua_next doesn't get confused when
+    // a number key is converted to a string.
+    lua_pushvalue(lS, -2);
+    size_t stKey; const char*const cpKey = lua_tolstring(lS, -1, &stKey);
+    // Write key and value if the key can be a string
+    if(cpKey)
+    { // Write the key and value
+      rwWriter.Key(cpKey, static_cast<SizeType>(stKey));
+      JsonWriteValue(lS, -2, rwWriter, uiDepth);
+      ++stMembers;
+    } // Remove the key copy
+    LuaUtilRmStack(lS);
+  } // Finished object
+  rwWriter.EndObject(stMembers);
+}
+/* -- Write a Lua table to the specified stream ---------------------------- */
+template<class StreamType>static void JsonWriteStream(lua_State*const lS,
+  const int iId, StreamType &jsOut, const bool bPretty)
+{ // Check the table then write it in the requested format
+  LuaUtilCheckTable(lS, iId);
+  if(bPretty)
+  { // Write in human readable format
+    PrettyWriter<StreamType, UTF8<>, UTF8<>> rwWriter{ jsOut };
+    JsonWriteTable(lS, iId, rwWriter, 0);
+  } // Write in compact format
+  else
+  { // Write in compact format
+    Writer<StreamType, UTF8<>, UTF8<>> rwWriter{ jsOut };
+    JsonWriteTable(lS, iId, rwWriter, 0);
+  }
+}
+/* -- Encode a Lua table and push the json string -------------------------- */
+static void JsonEncodeString(lua_State*const lS, const int iId,
+  const bool bPretty)
+{ // Write the table straight to a string buffer
+  StringBuffer rsbOut;
+  JsonWriteStream(lS, iId, rsbOut, bPretty);
+  // Push the string which Lua copies into its own storage
+  LuaUtilPushLStr(lS, rsbOut.GetString(), rsbOut.GetSize());
+}
+/* -- Encode a Lua table into a memory block ------------------------------- */
+static void JsonEncodeBlock(lua_State*const lS, const int iId,
+  const bool bPretty, Memory &mDest)
+{ // Write the table straight to the memory block
+  JsonMemoryStream jmsOut{ mDest };
+  JsonWriteStream(lS, iId, jmsOut, bPretty);
+  jmsOut.Finish();
+}
 /* == Json object collector and member class =============================== */
 CTOR_BEGIN_ASYNC_DUO(Jsons, Json, CLHelperUnsafe, ICHelperUnsafe),
   /* -- Base classes ------------------------------------------------------- */
@@ -0,0 +1,147 @@
+/* == LINES.HPP ============================================================ **
+** ######################################################################### **
+** ## MS-ENGINE              Copyright (c) MS-Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## A fixed capacity ring of text lines used by the log and console.    ## **
+** ## The text of every line is stored in one byte arena so appending and ## **
+** ## evicting a line is O(1) and never touches the allocator once the    ## **
+** ## ring is sized. Every line added gets the next index so positions    ## **
+** ## kept by the caller stay valid while the oldest lines are evicted.   ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace ILines {                     // Start of private module namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IStd::P;               using namespace IUtil::P;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public module namespace
+/* -- Call a function for every line in a string --------------------------- */
+template<class Callback>
+  static void LinesSplit(const string_view &strvText, const Callback &cFunc)
+{ // Ignore if empty
+  if(strvText.empty()) return;
+  // Send every line up to a line feed
+  size_t stStart = 0;
+  for(size_t stLoc; (stLoc = strvText.find('\n', stStart)) != string::npos;
+    stStart = stLoc + 1)
+      cFunc(strvText.substr(stStart, stLoc - stStart));
+  // Send the remainder which is empty if the text ended with a line feed
+  cFunc(strvText.substr(stStart));
+}
+/* -- A line read from the ring -------------------------------------------- */
+template<class Meta>struct LinesItem : public Meta
+{ /* ----------------------------------------------------------------------- */
+  string_view      strvLine;           // Text (always nul terminated)
+};/* ----------------------------------------------------------------------- */
+template<class Meta>class Lines        // Members initially private
+{ /* -- Private typedefs --------------------------------------------------- */
+  struct LinesSlot : public Meta       // A line in the ring
+  { /* --------------------------------------------------------------------- */
+    uint64_t       qwStart;            // Position of text in the arena
+    size_t         stLength;           // Length of text
+  };/* --------------------------------------------------------------------- */
+  typedef vector<LinesSlot> LinesSlots; // Vector of line slots
+  /* -- Private variables -------------------------------------------------- */
+  LinesSlots       lsSlots;            // Preallocated line slots
+  string           strArena;           // Text of every line
+  uint64_t         qwBegin,            // Index of oldest line
+                   qwEnd,              // Index after newest line
+                   qwBytes;            // Arena position after newest line
+  /* -- Get slot of the specified line ------------------------------------- */
+  LinesSlot &LinesGetSlot(const uint64_t qwIndex)
+    { return lsSlots[static_cast<size_t>(qwIndex % lsSlots.size())]; }
+  const LinesSlot &LinesGetSlot(const uint64_t qwIndex) const
+    { return lsSlots[static_cast<size_t>(qwIndex % lsSlots.size())]; }
+  /* -- Return index of oldest line -------------------------------- */ public:
+  uint64_t LinesBegin(void) const { return qwBegin; }
+  /* -- Return index after newest line ------------------------------------- */
+  uint64_t LinesEnd(void) const { return qwEnd; }
+  /* -- Return number of lines --------------------------------------------- */
+  size_t LinesSize(void) const { return static_cast<size_t>(qwEnd - qwBegin); }
+  /* -- Return if there are no lines --------------------------------------- */
+  bool LinesEmpty(void) const { return qwBegin == qwEnd; }
+  /* -- Return maximum number of lines ------------------------------------- */
+  size_t LinesCapacity(void) const { return lsSlots.size(); }
+  /* -- Get the specified line (must be >= begin and < end) ---------------- */
+  const LinesItem<Meta> LinesGet(const uint64_t qwIndex) const
+  { // Get the slot and return the data with a view of the text
+    const LinesSlot &lsRef = LinesGetSlot(qwIndex);
+    return { static_cast<const Meta&>(lsRef), { &strArena[
+      static_cast<size_t>(lsRef.qwStart % strArena.size())],
+      lsRef.stLength } };
+  }
+  /* -- Get the oldest line ------------------------------------------------ */
+  const LinesItem<Meta> LinesFront(void) const { return LinesGet(qwBegin); }
+  /* -- Evict the oldest line ---------------------------------------------- */
+  void LinesPop(void) { if(!LinesEmpty()) ++qwBegin; }
+  /* -- Evict every line (indexes keep counting) --------------------------- */
+  void LinesClear(void) { qwBegin = qwEnd; }
+  /* -- Add a line and optional extra text evicting old lines to fit ------- */
+  void LinesPush(const Meta &mData, const string_view &strvLine,
+    const string_view &strvAppend = {})
+  { // Ignore if the ring has no capacity
+    if(lsSlots.empty()) return;
+    // Truncate the text if it would not fit in the arena with its terminator
+    const size_t stArena = strArena.size(),
+      stAppend = UtilMinimum(strvAppend.size(), stArena - 1),
+      stLine = UtilMinimum(strvLine.size(), stArena - 1 - stAppend),
+      stLength = stLine + stAppend;
+    // Text never wraps so skip to the start of the arena if it won't fit
+    uint64_t qwStart = qwBytes;
+    const size_t stOffset = static_cast<size_t>(qwStart % stArena);
+    if(stOffset + stLength + 1 > stArena) qwStart += stArena - stOffset;
+    const uint64_t qwBytesNew = qwStart + stLength + 1;
+    // Evict the oldest lines until there is a free slot and the text would
+    // not overwrite them.
+    while(LinesSize() >= lsSlots.size() ||
+      (!LinesEmpty() && qwBytesNew - LinesGetSlot(qwBegin).qwStart > stArena))
+        LinesPop();
+    // Copy the text and terminate it
+    char*const cpDest = &strArena[static_cast<size_t>(qwStart % stArena)];
+    memcpy(cpDest, strvLine.data(), stLine);
+    if(stAppend) memcpy(cpDest + stLine, strvAppend.data(), stAppend);
+    cpDest[stLength] = '\0';
+    // Fill in the slot and publish it
+    LinesSlot &lsRef = LinesGetSlot(qwEnd);
+    static_cast<Meta&>(lsRef) = mData;
+    lsRef.qwStart = qwStart;
+    lsRef.stLength = stLength;
+    qwBytes = qwBytesNew;
+    ++qwEnd;
+  }
+  /* -- Change capacity keeping the newest lines and their indexes --------- */
+  void LinesResize(const size_t stLines)
+  { // Ignore if capacity not changed
+    if(stLines == LinesCapacity()) return;
+    // Create a new ring numbered from the oldest line and copy lines over
+    Lines lNew{ stLines };
+    lNew.qwBegin = lNew.qwEnd = qwBegin;
+    for(uint64_t qwIndex = qwBegin; qwIndex < qwEnd; ++qwIndex)
+    { const LinesItem<Meta> liLine{ LinesGet(qwIndex) };
+      lNew.LinesPush(liLine, liLine.strvLine); }
+    // Use the new ring
+    lsSlots.swap(lNew.lsSlots);
+    strArena.swap(lNew.strArena);
+    qwBegin = lNew.qwBegin;
+    qwEnd = lNew.qwEnd;
+    qwBytes = lNew.qwBytes;
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  explicit Lines(const size_t stLines) :
+    /* -- Initialisers ----------------------------------------------------- */
+    lsSlots(stLines),                  // Allocate all the line slots
+    strArena(stLines * 128 + 65536,    // Average of 128 bytes per line plus
+      '\0'),                           // room for one very long line
+    qwBegin(0),                        // No oldest line
+    qwEnd(0),                          // No newest line
+    qwBytes(0)                         // Start of arena
+    /* -- No code ---------------------------------------------------------- */
+    { }
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(Lines)               // Do not need defaults
+};/* ----------------------------------------------------------------------- */
+}                                      // End of public module namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private module namespace
+/* == EoF =========================================================== EoF == */
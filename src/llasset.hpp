@@ -19,9 +19,9 @@
 namespace LLAsset {                    // Asset namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IAsset::P;             using namespace IASync::P;
-using namespace IFStream::P;           using namespace ILuaCode::P;
-using namespace IStd::P;               using namespace IUtil::P;
-using namespace Common;
+using namespace ICodec::P;             using namespace IFStream::P;
+using namespace ILuaCode::P;           using namespace IStd::P;
+using namespace IUtil::P;              using namespace Common;
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## Archive common helper classes                                       ## **
@@ -456,38 +456,159 @@ LLFUNC(Id, 1, LuaUtilPushVar(lS, AgAsset{lS, 1}().CtrGet()))
 // ? This function returns that name which was assigned to it.
 /* ------------------------------------------------------------------------- */
 LLFUNC(Name, 1, LuaUtilPushVar(lS, AgAsset{lS, 1}().IdentGet()))
+/* ========================================================================= */
+// $ Asset:Unpack
+// > Format:string=The format of one record.
+// > Position:integer=Byte position of the first record.
+// > Count:integer=Number of records to read.
+// < Values:table=Every value of every record in one flat table.
+// ? Reads 'Count' consecutive records in one call instead of calling one of
+// ? the Read functions per value. Values are stored in record order so with
+// ? a format of "<ffH" the table is {x1, y1, id1, x2, y2, id2, ...}.
+// ?
+// ? Format characters (each may be prefixed with a decimal repeat count)...
+// ? - <  = Following types are little-endian.
+// ? - >  = Following types are big-endian.
+// ? - =  = Following types are native byte order (the default).
+// ? - b  = Signed character.      - B  = Unsigned character.
+// ? - h  = Signed word.           - H  = Unsigned word.
+// ? - i  = Signed dword.          - I  = Unsigned dword.
+// ? - l  = Signed qword.          - L  = Unsigned qword.
+// ? - f  = Float.                 - d  = Double.
+// ? - x  = One byte of padding which is skipped.
+// ?
+// ? A record may have at most 65536 items after repeat counts are expanded.
+// ? Unsigned qwords larger than the largest Lua integer are returned as
+// ? numbers instead which may lose precision.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Unpack, 1,
+  const AgAsset aAsset{lS, 1};
+  const AgString aFormat{lS, 2};
+  const AgSizeT aPosition{lS, 3}, aCount{lS, 4};
+  AssetBulkUnpack(lS, aAsset(), aFormat, aPosition, aCount))
+/* ========================================================================= */
+// $ Asset:Pack
+// > Format:string=The format of one record.
+// > Position:integer=Byte position of the first record.
+// > Values:table=Every value of every record in one flat table.
+// < Bytes:integer=Number of bytes written.
+// ? Writes every value in the table as consecutive records in one call. The
+// ? number of values must be a multiple of the values in one record and all
+// ? the records must fit in the array. Padding bytes are written as zero.
+// ? See Asset:Unpack for the format characters.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Pack, 1,
+  const AgAsset aAsset{lS, 1};
+  const AgString aFormat{lS, 2};
+  const AgSizeT aPosition{lS, 3};
+  LuaUtilCheckTable(lS, 4);
+  LuaUtilPushVar(lS, AssetBulkPack(lS, aAsset(), aFormat, aPosition, 4)))
+/* ========================================================================= */
+// $ Asset:Add
+// > Type:string=The format of one element (i.e. "<i").
+// > Position:integer=Byte position of the first element.
+// > Count:integer=Number of elements.
+// > Value:integer|number=The value to add to every element.
+// ? Adds the specified value to every element in the range. Integers wrap
+// ? around on overflow. The format must contain exactly one type.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Add, 0,
+  const AgAsset aAsset{lS, 1};
+  const AgString aFormat{lS, 2};
+  const AgSizeT aPosition{lS, 3}, aCount{lS, 4};
+  AssetBulkAdd(lS, aAsset(), aFormat, aPosition, aCount, 5))
+/* ========================================================================= */
+// $ Asset:Scale
+// > Type:string=The format of one element (i.e. "<f").
+// > Position:integer=Byte position of the first element.
+// > Count:integer=Number of elements.
+// > Scale:number=The value to multiply every element by.
+// ? Multiplies every element in the range by the specified value. Integers
+// ? are truncated and clamped to the range of the type.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Scale, 0,
+  const AgAsset aAsset{lS, 1};
+  const AgString aFormat{lS, 2};
+  const AgSizeT aPosition{lS, 3}, aCount{lS, 4};
+  const AgDouble aScale{lS, 5};
+  AssetBulkScale(aAsset(), aFormat, aPosition, aCount, aScale))
+/* ========================================================================= */
+// $ Asset:Min
+// > Type:string=The format of one element (i.e. "<h").
+// > Position:integer=Byte position of the first element.
+// > Count:integer=Number of elements which must be at least one.
+// < Value:integer|number=The lowest element.
+// ? Returns the lowest element in the range.
+// ? Large unsigned qwords are returned as numbers like Asset:Unpack.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Min, 1,
+  const AgAsset aAsset{lS, 1};
+  const AgString aFormat{lS, 2};
+  const AgSizeT aPosition{lS, 3}, aCount{lS, 4};
+  AssetBulkReduce(lS, aAsset(), aFormat, aPosition, aCount, ABO_MIN))
+/* ========================================================================= */
+// $ Asset:Max
+// > Type:string=The format of one element (i.e. "<h").
+// > Position:integer=Byte position of the first element.
+// > Count:integer=Number of elements which must be at least one.
+// < Value:integer|number=The highest element.
+// ? Returns the highest element in the range.
+// ? Large unsigned qwords are returned as numbers like Asset:Unpack.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Max, 1,
+  const AgAsset aAsset{lS, 1};
+  const AgString aFormat{lS, 2};
+  const AgSizeT aPosition{lS, 3}, aCount{lS, 4};
+  AssetBulkReduce(lS, aAsset(), aFormat, aPosition, aCount, ABO_MAX))
+/* ========================================================================= */
+// $ Asset:Sum
+// > Type:string=The format of one element (i.e. "<d").
+// > Position:integer=Byte position of the first element.
+// > Count:integer=Number of elements.
+// < Value:integer|number=The total of all the elements.
+// ? Returns the total of every element in the range. Integers wrap around on
+// ? overflow and floats are added up as doubles.
+// ? Large unsigned qwords are returned as numbers like Asset:Unpack.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Sum, 1,
+  const AgAsset aAsset{lS, 1};
+  const AgString aFormat{lS, 2};
+  const AgSizeT aPosition{lS, 3}, aCount{lS, 4};
+  AssetBulkReduce(lS, aAsset(), aFormat, aPosition, aCount, ABO_SUM))
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## Asset:* member functions structure                                  ## **
 ** ######################################################################### **
 ** ------------------------------------------------------------------------- */
 LLRSMFBEGIN                            // Asset:* member functions begin
-  LLRSFUNC(BitClear),                  LLRSFUNC(BitFlip),
-  LLRSFUNC(BitSet),                    LLRSFUNC(BitState),
-  LLRSFUNC(Clear),                     LLRSFUNC(Crop),
-  LLRSFUNC(Destroy),                   LLRSFUNCEX(FF32,FillN<float>),
-  LLRSFUNC(FF32BE),                    LLRSFUNC(FF32LE),
-  LLRSFUNCEX(FF64,FillN<double>),      LLRSFUNC(FF64BE),
-  LLRSFUNC(FF64LE),                    LLRSFUNCEX(FI16,FillI<int16_t>),
-  LLRSFUNCEX(FI16BE,FI16BE<int16_t>),  LLRSFUNCEX(FI16LE,FI16LE<int16_t>),
-  LLRSFUNCEX(FI32,FillI<int32_t>),     LLRSFUNCEX(FI32BE,FI32BE<int32_t>),
-  LLRSFUNCEX(FI32LE,FI32LE<int32_t>),  LLRSFUNCEX(FI64,FillI<int64_t>),
-  LLRSFUNCEX(FI64BE,FI64BE<int64_t>),  LLRSFUNCEX(FI64LE,FI64LE<int64_t>),
-  LLRSFUNCEX(FI8,FillI<int8_t>),       LLRSFUNCEX(FU16,FillI<uint16_t>),
-  LLRSFUNCEX(FU16BE,FI16BE<uint16_t>), LLRSFUNCEX(FU16LE,FI16LE<uint16_t>),
-  LLRSFUNCEX(FU32,FillI<uint32_t>),    LLRSFUNCEX(FU32BE,FI32BE<uint32_t>),
-  LLRSFUNCEX(FU32LE,FI32LE<uint32_t>), LLRSFUNCEX(FU64,FillI<uint64_t>),
-  LLRSFUNCEX(FU64BE,FI64BE<uint64_t>), LLRSFUNCEX(FU64LE,FI64LE<uint64_t>),
-  LLRSFUNCEX(FU8,FillI<uint8_t>),      LLRSFUNC(Find),
-  LLRSFUNC(FindEx),                    LLRSFUNCEX(I16,Invert<uint16_t>),
-  LLRSFUNCEX(I16F,InvertEx<uint16_t>), LLRSFUNC(I16FBE),
-  LLRSFUNC(I16FLE),                    LLRSFUNCEX(I32,Invert<uint32_t>),
-  LLRSFUNCEX(I32F,InvertEx<uint32_t>), LLRSFUNC(I32FBE),
-  LLRSFUNC(I32FLE),                    LLRSFUNCEX(I64,Invert<uint64_t>),
-  LLRSFUNCEX(I64F,InvertEx<uint64_t>), LLRSFUNC(I64FBE),
-  LLRSFUNC(I64FLE),                    LLRSFUNCEX(I8,Invert<uint8_t>),
-  LLRSFUNCEX(I8F,InvertEx<uint8_t>),   LLRSFUNC(Id),
-  LLRSFUNC(Name),                      LLRSFUNC(Resize),
+  LLRSFUNC(Add),                       LLRSFUNC(BitClear),
+  LLRSFUNC(BitFlip),                   LLRSFUNC(BitSet),
+  LLRSFUNC(BitState),                  LLRSFUNC(Clear),
+  LLRSFUNC(Crop),                      LLRSFUNC(Destroy),
+  LLRSFUNCEX(FF32,FillN<float>),       LLRSFUNC(FF32BE),
+  LLRSFUNC(FF32LE),                    LLRSFUNCEX(FF64,FillN<double>),
+  LLRSFUNC(FF64BE),                    LLRSFUNC(FF64LE),
+  LLRSFUNCEX(FI16,FillI<int16_t>),     LLRSFUNCEX(FI16BE,FI16BE<int16_t>),
+  LLRSFUNCEX(FI16LE,FI16LE<int16_t>),  LLRSFUNCEX(FI32,FillI<int32_t>),
+  LLRSFUNCEX(FI32BE,FI32BE<int32_t>),  LLRSFUNCEX(FI32LE,FI32LE<int32_t>),
+  LLRSFUNCEX(FI64,FillI<int64_t>),     LLRSFUNCEX(FI64BE,FI64BE<int64_t>),
+  LLRSFUNCEX(FI64LE,FI64LE<int64_t>),  LLRSFUNCEX(FI8,FillI<int8_t>),
+  LLRSFUNCEX(FU16,FillI<uint16_t>),    LLRSFUNCEX(FU16BE,FI16BE<uint16_t>),
+  LLRSFUNCEX(FU16LE,FI16LE<uint16_t>), LLRSFUNCEX(FU32,FillI<uint32_t>),
+  LLRSFUNCEX(FU32BE,FI32BE<uint32_t>), LLRSFUNCEX(FU32LE,FI32LE<uint32_t>),
+  LLRSFUNCEX(FU64,FillI<uint64_t>),    LLRSFUNCEX(FU64BE,FI64BE<uint64_t>),
+  LLRSFUNCEX(FU64LE,FI64LE<uint64_t>), LLRSFUNCEX(FU8,FillI<uint8_t>),
+  LLRSFUNC(Find),                      LLRSFUNC(FindEx),
+  LLRSFUNCEX(I16,Invert<uint16_t>),    LLRSFUNCEX(I16F,InvertEx<uint16_t>),
+  LLRSFUNC(I16FBE),                    LLRSFUNC(I16FLE),
+  LLRSFUNCEX(I32,Invert<uint32_t>),    LLRSFUNCEX(I32F,InvertEx<uint32_t>),
+  LLRSFUNC(I32FBE),                    LLRSFUNC(I32FLE),
+  LLRSFUNCEX(I64,Invert<uint64_t>),    LLRSFUNCEX(I64F,InvertEx<uint64_t>),
+  LLRSFUNC(I64FBE),                    LLRSFUNC(I64FLE),
+  LLRSFUNCEX(I8,Invert<uint8_t>),      LLRSFUNCEX(I8F,InvertEx<uint8_t>),
+  LLRSFUNC(Id),                        LLRSFUNC(Max),
+  LLRSFUNC(Min),                       LLRSFUNC(Name),
+  LLRSFUNC(Pack),                      LLRSFUNC(Resize),
   LLRSFUNC(ResizeUp),                  LLRSFUNC(Reverse),
   LLRSFUNCEX(RF32,ReadN<float>),       LLRSFUNC(RF32BE),
   LLRSFUNC(RF32LE),                    LLRSFUNCEX(RF64,ReadN<double>),
@@ -504,21 +625,22 @@ LLRSMFBEGIN                            // Asset:* member functions begin
   LLRSFUNCEX(RU64LE,RI64LE<uint64_t>), LLRSFUNCEX(RU8,ReadI<uint8_t>),
   LLRSFUNC(S16),                       LLRSFUNC(S32),
   LLRSFUNC(S64),                       LLRSFUNC(S8),
-  LLRSFUNC(Size),                      LLRSFUNC(ToFile),
-  LLRSFUNC(ToString),                  LLRSFUNCEX(WF32,WriteN<float>),
-  LLRSFUNC(WF32BE),                    LLRSFUNC(WF32LE),
-  LLRSFUNCEX(WF64,WriteN<double>),     LLRSFUNC(WF64BE),
-  LLRSFUNC(WF64LE),                    LLRSFUNCEX(WI16,WriteI<int16_t>),
-  LLRSFUNCEX(WI16BE,WI16BE<int16_t>),  LLRSFUNCEX(WI16LE,WI16LE<int16_t>),
-  LLRSFUNCEX(WI32,WriteI<int32_t>),    LLRSFUNCEX(WI32BE,WI32BE<int32_t>),
-  LLRSFUNCEX(WI32LE,WI32LE<int32_t>),  LLRSFUNCEX(WI64,WriteI<int64_t>),
-  LLRSFUNCEX(WI64BE,WI64BE<int64_t>),  LLRSFUNCEX(WI64LE,WI64LE<int64_t>),
-  LLRSFUNCEX(WI8,WriteI<int8_t>),      LLRSFUNCEX(WU16,WriteI<uint16_t>),
-  LLRSFUNCEX(WU16BE,WI16BE<uint16_t>), LLRSFUNCEX(WU16LE,WI16LE<uint16_t>),
-  LLRSFUNCEX(WU32,WriteI<uint32_t>),   LLRSFUNCEX(WU32BE,WI32BE<uint32_t>),
-  LLRSFUNCEX(WU32LE,WI32LE<uint32_t>), LLRSFUNCEX(WU64,WriteI<uint64_t>),
-  LLRSFUNCEX(WU64BE,WI64BE<uint64_t>), LLRSFUNCEX(WU64LE,WI64LE<uint64_t>),
-  LLRSFUNCEX(WU8,WriteI<uint8_t>),
+  LLRSFUNC(Scale),                     LLRSFUNC(Size),
+  LLRSFUNC(Sum),                       LLRSFUNC(ToFile),
+  LLRSFUNC(ToString),                  LLRSFUNC(Unpack),
+  LLRSFUNCEX(WF32,WriteN<float>),      LLRSFUNC(WF32BE),
+  LLRSFUNC(WF32LE),                    LLRSFUNCEX(WF64,WriteN<double>),
+  LLRSFUNC(WF64BE),                    LLRSFUNC(WF64LE),
+  LLRSFUNCEX(WI16,WriteI<int16_t>),    LLRSFUNCEX(WI16BE,WI16BE<int16_t>),
+  LLRSFUNCEX(WI16LE,WI16LE<int16_t>),  LLRSFUNCEX(WI32,WriteI<int32_t>),
+  LLRSFUNCEX(WI32BE,WI32BE<int32_t>),  LLRSFUNCEX(WI32LE,WI32LE<int32_t>),
+  LLRSFUNCEX(WI64,WriteI<int64_t>),    LLRSFUNCEX(WI64BE,WI64BE<int64_t>),
+  LLRSFUNCEX(WI64LE,WI64LE<int64_t>),  LLRSFUNCEX(WI8,WriteI<int8_t>),
+  LLRSFUNCEX(WU16,WriteI<uint16_t>),   LLRSFUNCEX(WU16BE,WI16BE<uint16_t>),
+  LLRSFUNCEX(WU16LE,WI16LE<uint16_t>), LLRSFUNCEX(WU32,WriteI<uint32_t>),
+  LLRSFUNCEX(WU32BE,WI32BE<uint32_t>), LLRSFUNCEX(WU32LE,WI32LE<uint32_t>),
+  LLRSFUNCEX(WU64,WriteI<uint64_t>),   LLRSFUNCEX(WU64BE,WI64BE<uint64_t>),
+  LLRSFUNCEX(WU64LE,WI64LE<uint64_t>), LLRSFUNCEX(WU8,WriteI<uint8_t>),
 LLRSEND                                // Asset:* member functions end
 /* ========================================================================= */
 // $ Asset.Asset
@@ -552,6 +674,22 @@ LLFUNC(AssetAsync, 0,
   LuaUtilCheckFunc(lS, 4, 5, 6);
   AcAsset{lS}().InitAsyncAsset(lS, aIdentifier, aFlags, aAsset))
 /* ========================================================================= */
+// $ Asset.CodecStats
+// > Mode:integer=The codec mode from Asset.Codecs.
+// < Encoded:integer=Uncompressed bytes encoded with this mode.
+// < EncodeRate:number=Average encoding throughput in MB/s.
+// < Decoded:integer=Uncompressed bytes decoded with this mode.
+// < DecodeRate:number=Average decoding throughput in MB/s.
+// ? Returns the amount of data encoded and decoded with the specified mode
+// ? by assets loaded with encoding or decoding flags and how fast it was.
+/* ------------------------------------------------------------------------- */
+LLFUNC(CodecStats, 4,
+  const AgIntegerLGE<EncMode> aMode{lS, 1, ENCMODE_RAW, ENCMODE_MAX};
+  const pair<uint64_t, double> pEncode{ CodecStatGet(aMode, false) },
+                               pDecode{ CodecStatGet(aMode, true) };
+  LuaUtilPushVar(lS, pEncode.first, pEncode.second, pDecode.first,
+    pDecode.second))
+/* ========================================================================= */
 // $ Asset.Compile
 // > Filename:string=The name of the file to parse
 // < Params...:*=The parameters the function returned
@@ -757,6 +895,75 @@ LLFUNCBEGIN(ParseString)
   LuaUtilPushVar(lS, LuaCodeExecuteString(lS, aCode, aReturns, aIdentifier));
 LLFUNCENDEX(1 + aReturns)
 /* ========================================================================= */
+// $ Asset.Prefetch
+// > Manifest:table=The files to extract ahead of time.
+// < Queued:integer=The number of files queued.
+// ? Starts extracting the specified files off the main thread so later loads
+// ? of them don't have to wait for the disk or decompression. Each entry in
+// ? the table is either a filename or a table with the filename first followed
+// ? by the filenames it depends on. Dependencies are extracted first and the
+// ? rest follows the order the files are stored in the archives. Files that
+// ? are already being prefetched are ignored. The times returned by
+// ? Asset.Stages are reset to zero so they only cover the new manifest.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Prefetch, 1, LuaUtilPushVar(lS, AssetPrefetch(lS, 1)))
+/* ========================================================================= */
+// $ Asset.PrefetchAsync
+// > Manifest:table=The files to extract ahead of time.
+// > ErrorFunc:function(Reason:string)=Error callback.
+// > ProgressFunc:function(Cmd:integer,...)=In-progress callback.
+// > SuccessFunc:function(Data:Asset)=Succession callback.
+// ? Same as Asset.Prefetch but calls the success callback once when every
+// ? file in the manifest has been extracted, including files that were
+// ? already being prefetched, so the whole scene can be handed to the
+// ? loaders in one go without any of them waiting. The progress callback
+// ? receives Asset.Progress.PREFETCHED with the number of files finished
+// ? and the total as each file finishes. The error callback is called
+// ? instead if any of the files failed to extract. The asset sent to the
+// ? success callback is empty.
+/* ------------------------------------------------------------------------- */
+LLFUNC(PrefetchAsync, 0,
+  LuaUtilCheckParams(lS, 4);
+  LuaUtilCheckFunc(lS, 2, 3, 4);
+  AssetPrefetchMap apmBatch;
+  AssetPrefetch(lS, 1, apmBatch);
+  AcAsset{lS}().InitAsyncPrefetch(lS, apmBatch))
+/* ========================================================================= */
+// $ Asset.PrefetchClear
+// < Cleared:integer=The number of files thrown away.
+// ? Stops and throws away any prefetched files that have not been used yet.
+/* ------------------------------------------------------------------------- */
+LLFUNC(PrefetchClear, 1, LuaUtilPushVar(lS, AssetPrefetchClear()))
+/* ========================================================================= */
+// $ Asset.PrefetchStats
+// < Pending:integer=The number of prefetched files not used yet.
+// < Used:integer=The number of prefetched files used.
+// < Failed:integer=The number of prefetched files that failed to extract.
+// < Extract:number=Seconds taken to extract the used files.
+// < Wait:number=Seconds spent waiting for used files to finish extracting.
+// ? Returns statistics about prefetched files.
+/* ------------------------------------------------------------------------- */
+LLFUNC(PrefetchStats, 5, AssetPrefetchStats(lS))
+/* ========================================================================= */
+// $ Asset.Stages
+// < Read:number=Seconds spent reading files from disk or archives.
+// < Decompress:number=Seconds spent decompressing files from archives.
+// < Decode:number=Seconds spent decoding files into objects.
+// < Upload:number=Seconds spent uploading textures to the graphics card.
+// ? Returns the time spent in each stage of loading assets on all threads
+// ? since the engine started, Asset.StagesReset was last called or
+// ? Asset.Prefetch or Asset.PrefetchAsync last started a manifest. Calling
+// ? this function after the files in a prefetched manifest are loaded gives
+// ? the timings for that scene. Call Asset.StagesReset before loading a
+// ? scene that is not prefetched.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Stages, 4, AssetStageStats(lS))
+/* ========================================================================= */
+// $ Asset.StagesReset
+// ? Resets the times returned by Asset.Stages to zero.
+/* ------------------------------------------------------------------------- */
+LLFUNC(StagesReset, 0, AssetStageReset())
+/* ========================================================================= */
 // $ Asset.String
 // > Id:string=The filename of the file to load
 // > Text:string=The string of the data to process
@@ -781,13 +988,20 @@ LLFUNC(WaitAsync, 0, cAssets->WaitAsync())
 ** ######################################################################### **
 ** ------------------------------------------------------------------------- */
 LLRSBEGIN                              // Asset.* namespace functions begin
-  LLRSFUNC(Asset),         LLRSFUNC(AssetAsync),      LLRSFUNC(Compile),
-  LLRSFUNC(CompileBlock),  LLRSFUNC(CompileFunction), LLRSFUNC(CompileString),
-  LLRSFUNC(Create),        LLRSFUNC(Duplicate),       LLRSFUNC(Enumerate),
-  LLRSFUNC(EnumerateEx),   LLRSFUNC(Exec),            LLRSFUNC(ExecEx),
-  LLRSFUNC(File),          LLRSFUNC(FileAsync),       LLRSFUNC(FileExists),
-  LLRSFUNC(Parse),         LLRSFUNC(ParseBlock),      LLRSFUNC(ParseString),
-  LLRSFUNC(String),        LLRSFUNC(WaitAsync),
+  LLRSFUNC(Asset),                     LLRSFUNC(AssetAsync),
+  LLRSFUNC(CodecStats),                LLRSFUNC(Compile),
+  LLRSFUNC(CompileBlock),              LLRSFUNC(CompileFunction),
+  LLRSFUNC(CompileString),             LLRSFUNC(Create),
+  LLRSFUNC(Duplicate),                 LLRSFUNC(Enumerate),
+  LLRSFUNC(EnumerateEx),               LLRSFUNC(Exec),
+  LLRSFUNC(ExecEx),                    LLRSFUNC(File),
+  LLRSFUNC(FileAsync),                 LLRSFUNC(FileExists),
+  LLRSFUNC(Parse),                     LLRSFUNC(ParseBlock),
+  LLRSFUNC(ParseString),               LLRSFUNC(Prefetch),
+  LLRSFUNC(PrefetchAsync),             LLRSFUNC(PrefetchClear),
+  LLRSFUNC(PrefetchStats),             LLRSFUNC(Stages),
+  LLRSFUNC(StagesReset),               LLRSFUNC(String),
+  LLRSFUNC(WaitAsync),
 LLRSEND                                // Asset.* namespace functions end
 /* ========================================================================= **
 ** ######################################################################### **
@@ -806,9 +1020,19 @@ LLRSKTBEGIN(Flags)                     // Beginning of loading flags
   LLRSKTITEM(CD_,ENCODE_ZLIBAES),      LLRSKTITEM(CD_,LEVEL_FAST),
   LLRSKTITEM(CD_,LEVEL_FASTEST),       LLRSKTITEM(CD_,LEVEL_MODERATE),
   LLRSKTITEM(CD_,LEVEL_SLOW),          LLRSKTITEM(CD_,LEVEL_SLOWEST),
-  LLRSKTITEM(CD_,NONE),
+  LLRSKTITEM(CD_,NONE),                LLRSKTITEM(CD_,STREAM),
 LLRSKTEND                              // End of loading flags
 /* ========================================================================= */
+// @ Asset.Codecs
+// < Codes:table=The table of key/value pairs of codec modes
+// ? A table of codec modes that can be sent to Asset.CodecStats.
+/* ------------------------------------------------------------------------- */
+LLRSKTBEGIN(Codecs)                    // Beginning of codec modes
+  LLRSKTITEM(ENCMODE_,AES),     LLRSKTITEM(ENCMODE_,DEFLATE),
+  LLRSKTITEM(ENCMODE_,LZMA),    LLRSKTITEM(ENCMODE_,LZMAAES),
+  LLRSKTITEM(ENCMODE_,RAW),     LLRSKTITEM(ENCMODE_,ZLIBAES),
+LLRSKTEND                              // End of codec modes
+/* ========================================================================= */
 // @ Asset.Progress
 // < Codes:table=The table of key/value pairs of available progress commands
 // ? A table of loading commands for the progress callback. The first paramter
@@ -816,7 +1040,7 @@ LLRSKTEND                              // End of loading flags
 /* ------------------------------------------------------------------------- */
 LLRSKTBEGIN(Progress)                  // Beginning of progress flags
   LLRSKTITEM(APC_,EXECSTART), LLRSKTITEM(APC_,EXECDATAWRITE),
-  LLRSKTITEM(APC_,FILESTART),
+  LLRSKTITEM(APC_,FILESTART), LLRSKTITEM(APC_,PREFETCHED),
 LLRSKTEND                              // End of progress flags
 /* ========================================================================= */
 // @ Asset.ParseResult
@@ -826,6 +1050,7 @@ LLRSKTEND                              // End of progress flags
 LLRSKTBEGIN(ParseResult)               // Beginning of parse results
   LLRSKTITEM(LCR_,CACHED), LLRSKTITEM(LCR_,RECOMPILE),
   LLRSKTITEM(LCR_,DBERR),  LLRSKTITEM(LCR_,NOCACHE),
+  LLRSKTITEM(LCR_,BUNDLED),
 LLRSKTEND                              // End of parse results
 /* ========================================================================= **
 ** ######################################################################### **
@@ -833,7 +1058,8 @@ LLRSKTEND                              // End of parse results
 ** ######################################################################### **
 ** ========================================================================= */
 LLRSCONSTBEGIN                         // Asset.* namespace consts begin
-  LLRSCONST(Flags), LLRSCONST(Progress), LLRSCONST(ParseResult),
+  LLRSCONST(Codecs), LLRSCONST(Flags), LLRSCONST(Progress),
+  LLRSCONST(ParseResult),
 LLRSCONSTEND                           // Asset.* namespace consts end
 /* ========================================================================= */
 }                                      // End of Asset namespace
@@ -19,9 +19,10 @@ namespace LLCore {                     // Core namespace
 using namespace IConDef::P;            using namespace IConsole::P;
 using namespace ICore::P;              using namespace IDisplay::P;
 using namespace IEvtMain::P;           using namespace ILog::P;
-using namespace ILua::P;               using namespace IStd::P;
-using namespace IString::P;            using namespace ISystem::P;
-using namespace ITimer::P;             using namespace Common;
+using namespace ILua::P;               using namespace IProfile::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace ISystem::P;            using namespace ITimer::P;
+using namespace Common;
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## Core common helper classes                                          ## **
@@ -30,6 +31,29 @@ using namespace ITimer::P;             using namespace Common;
 struct AgPid : public AgIntegerL<unsigned int> {
   explicit AgPid(lua_State*const lS, const int iArg) :
     AgIntegerL{lS, iArg, 1}{} };
+/* -- Push profile statistics as a table of zone names --------------------- */
+static void ProfilePushStats(lua_State*const lS)
+{ // Get statistics and create table keyed by zone name
+  const array<ProfileStats, PZ_MAX> apsStats{ cProfile->ProfileGetStats() };
+  LuaUtilPushTable(lS, 0, PZ_MAX);
+  for(size_t stZone = 0; stZone < PZ_MAX; ++stZone)
+  { // Push count, average, minimum, maximum and total for the zone
+    const ProfileStats &psRef = apsStats[stZone];
+    LuaUtilPushTable(lS, 5);
+    LuaUtilPushInt(lS, psRef.stCount);
+    lua_rawseti(lS, -2, 1);
+    LuaUtilPushNum(lS, psRef.stCount ?
+      psRef.dTotal / static_cast<double>(psRef.stCount) : 0);
+    lua_rawseti(lS, -2, 2);
+    LuaUtilPushNum(lS, psRef.dMinimum);
+    lua_rawseti(lS, -2, 3);
+    LuaUtilPushNum(lS, psRef.dMaximum);
+    lua_rawseti(lS, -2, 4);
+    LuaUtilPushNum(lS, psRef.dTotal);
+    lua_rawseti(lS, -2, 5);
+    lua_setfield(lS, -2, Profile::ProfileGetZoneName(stZone));
+  }
+}
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## Core.* namespace functions                                          ## **
@@ -157,6 +181,30 @@ LLFUNC(SetIcon, 0, cDisplay->SetIconFromLua(AgString{lS, 1}))
 /* ------------------------------------------------------------------------- */
 LLFUNC(WaitAsync, 0, cCore->CoreWaitAllAsync())
 /* ========================================================================= */
+// $ Core.Profile
+// > State:boolean=Enable or disable profiling.
+// ? Enables or disables timing of the main loop and worker thread zones.
+// ? Enabling it forgets any events recorded before.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Profile, 0, cProfile->ProfileSetEnabled(AgBoolean{lS, 1}))
+/* ========================================================================= */
+// $ Core.ProfileSave
+// > Filename:string=The file to write the trace to.
+// < Events:integer=The number of events written.
+// ? Writes the most recent events of every thread as a Chrome trace which can
+// ? be loaded in 'chrome://tracing' or Perfetto.
+/* ------------------------------------------------------------------------- */
+LLFUNC(ProfileSave, 1,
+  LuaUtilPushVar(lS, cProfile->ProfileExport(AgFilename{lS, 1})))
+/* ========================================================================= */
+// $ Core.ProfileStats
+// < Stats:table=Zone names and a table of their statistics.
+// ? Returns statistics from the most recent events of each profiled zone.
+// ? Each zone has a table of the count and the average, minimum, maximum and
+// ? total time spent in it in seconds.
+/* ------------------------------------------------------------------------- */
+LLFUNC(ProfileStats, 1, ProfilePushStats(lS))
+/* ========================================================================= */
 // $ Core.Stack
 // < Stack:string=The current stack trace.
 // > Text:string=The message to prefix.
@@ -238,7 +286,8 @@ LLRSBEGIN                              // Core.* namespace functions begin
   LLRSFUNC(Delay),        LLRSFUNC(Done),        LLRSFUNC(End),
   LLRSFUNC(Events),       LLRSFUNC(KillPid),     LLRSFUNC(Log),
   LLRSFUNC(LogEx),        LLRSFUNC(OnEnd),       LLRSFUNC(OnTick),
-  LLRSFUNC(Pause),        LLRSFUNC(PidRunning),  LLRSFUNC(Quit),
+  LLRSFUNC(Pause),        LLRSFUNC(PidRunning),  LLRSFUNC(Profile),
+  LLRSFUNC(ProfileSave),  LLRSFUNC(ProfileStats), LLRSFUNC(Quit),
   LLRSFUNC(Reset),        LLRSFUNC(Restart),     LLRSFUNC(RestartNP),
   LLRSFUNC(RestoreDelay), LLRSFUNC(ScrollDown),  LLRSFUNC(ScrollUp),
   LLRSFUNC(SetDelay),     LLRSFUNC(SetIcon),     LLRSFUNC(Stack),
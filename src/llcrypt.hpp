@@ -18,6 +18,7 @@
 namespace LLCrypt {                    // Crypt namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IAsset::P;             using namespace ICrypt::P;
+using namespace IDir::P;               using namespace IFStream::P;
 using namespace IMemory::P;            using namespace Common;
 /* ========================================================================= **
 ** ######################################################################### **
@@ -88,6 +89,50 @@ LLFUNC(EntDecode, 1, LuaUtilPushVar(lS, cCrypt->EntDecode(AgString{lS, 1})))
 /* ------------------------------------------------------------------------- */
 LLFUNC(EntEncode, 1, LuaUtilPushVar(lS, CryptEntEncode(AgString{lS, 1})))
 /* ========================================================================= */
+// $ Crypt.HashFile
+// > Type:integer=The hash type from Crypt.Hashes.
+// > File:string=The filename of the file to hash.
+// < Hash:string=The calculated hash in hexadecimal.
+// ? Calculates the hash of the specified file from disk or from the loaded
+// ? archives without copying it into an asset first. Files on disk are read
+// ? and hashed a chunk at a time so they are never fully loaded. Files in
+// ? archives are extracted whole into memory first, because 7-zip decodes
+// ? solid blocks in one go, so make sure there is enough memory for them.
+/* ------------------------------------------------------------------------- */
+LLFUNC(HashFile, 1,
+  const AgIntegerLGE<CryptHashType> aType{lS, 1, CHT_CRC32, CHT_MAX};
+  const AgFilename aFilename{lS, 2};
+  CryptHash chFile{ aType };
+  // Read files on disk in chunks, if allowed, else extract from archives
+  if(cAssets->bOverride && DirLocalFileExists(aFilename))
+  { FStream fsFile{ aFilename, FM_R_B };
+    if(!fsFile)
+      XCL("Failed to open file to hash!",
+          "File", aFilename(), "Path", DirGetCWD());
+    chFile.CryptHashUpdate(fsFile);
+  } else chFile.CryptHashUpdate(AssetExtract(aFilename));
+  LuaUtilPushVar(lS, chFile.CryptHashFinish()))
+/* ========================================================================= */
+// $ Crypt.HashManifest
+// > Type:integer=The hash type from Crypt.Hashes.
+// > File:string=The filename of the file to hash.
+// > Size:integer=The size of each chunk in bytes.
+// < Root:string=The hash of all the chunk hashes in hexadecimal.
+// < Chunks:table=The hash of each chunk in hexadecimal.
+// ? Splits the specified file into chunks of the specified size and hashes
+// ? them all at the same time using the job pool. The root hash is the hash
+// ? of the binary chunk hashes in order so a patcher only needs to compare
+// ? the root to know if anything changed and the chunks to find out what.
+/* ------------------------------------------------------------------------- */
+LLFUNC(HashManifest, 2,
+  const AgIntegerLGE<CryptHashType> aType{lS, 1, CHT_CRC32, CHT_MAX};
+  const AgFilename aFilename{lS, 2};
+  const AgSizeTLG aSize{lS, 3, 4096, 1073741824};
+  const CryptHashManifest chmFile{
+    CryptHashTree(aType, AssetExtract(aFilename), aSize) };
+  LuaUtilPushVar(lS, chmFile.strRoot);
+  LuaUtilToTable(lS, chmFile.svChunks))
+/* ========================================================================= */
 // $ Crypt.HexDecode
 // > Text:string=The hex encoded string to decode.
 // < Text:Asset=The text decoded string.
@@ -288,18 +333,40 @@ LLFUNC(UrlEncode, 1, LuaUtilPushVar(lS, CryptURLEncode(AgCStringChar{lS, 1})))
 ** ######################################################################### **
 ** ------------------------------------------------------------------------- */
 LLRSBEGIN                              // Crypt.* namespace functions begin
-  LLRSFUNC(B64D),       LLRSFUNC(B64DA),       LLRSFUNC(B64E),
-  LLRSFUNC(B64EA),      LLRSFUNC(CRC),         LLRSFUNC(CRCA),
-  LLRSFUNC(EntDecode),  LLRSFUNC(EntEncode),   LLRSFUNC(HexDecode),
-  LLRSFUNC(HexDecodeA), LLRSFUNC(HexEncode),   LLRSFUNC(HexEncodeA),
-  LLRSFUNC(HexEncodeL), LLRSFUNC(HexEncodeLA), LLRSFUNC(HMSHA1),
-  LLRSFUNC(HMSHA224),   LLRSFUNC(HMSHA256),    LLRSFUNC(HMSHA384),
-  LLRSFUNC(HMSHA512),   LLRSFUNC(SHA1),        LLRSFUNC(SHA1A),
-  LLRSFUNC(SHA224),     LLRSFUNC(SHA224A),     LLRSFUNC(SHA256),
-  LLRSFUNC(SHA256A),    LLRSFUNC(SHA384),      LLRSFUNC(SHA384A),
-  LLRSFUNC(SHA512),     LLRSFUNC(SHA512A),     LLRSFUNC(UrlDecode),
-  LLRSFUNC(UrlEncode),
+  LLRSFUNC(B64D),          LLRSFUNC(B64DA),         LLRSFUNC(B64E),
+  LLRSFUNC(B64EA),         LLRSFUNC(CRC),           LLRSFUNC(CRCA),
+  LLRSFUNC(EntDecode),     LLRSFUNC(EntEncode),     LLRSFUNC(HashFile),
+  LLRSFUNC(HashManifest),  LLRSFUNC(HexDecode),     LLRSFUNC(HexDecodeA),
+  LLRSFUNC(HexEncode),     LLRSFUNC(HexEncodeA),    LLRSFUNC(HexEncodeL),
+  LLRSFUNC(HexEncodeLA),   LLRSFUNC(HMSHA1),        LLRSFUNC(HMSHA224),
+  LLRSFUNC(HMSHA256),      LLRSFUNC(HMSHA384),      LLRSFUNC(HMSHA512),
+  LLRSFUNC(SHA1),          LLRSFUNC(SHA1A),         LLRSFUNC(SHA224),
+  LLRSFUNC(SHA224A),       LLRSFUNC(SHA256),        LLRSFUNC(SHA256A),
+  LLRSFUNC(SHA384),        LLRSFUNC(SHA384A),       LLRSFUNC(SHA512),
+  LLRSFUNC(SHA512A),       LLRSFUNC(UrlDecode),     LLRSFUNC(UrlEncode),
 LLRSEND                                // Crypt.* namespace functions end
+/* ========================================================================= **
+** ######################################################################### **
+** ## Crypt.* namespace constants                                         ## **
+** ######################################################################### **
+** ========================================================================= */
+// @ Crypt.Hashes
+// < Codes:table=The table of key/value pairs of available hash types
+// ? A table of hash types that can be sent to Crypt.HashFile and
+// ? Crypt.HashManifest.
+/* ------------------------------------------------------------------------- */
+LLRSKTBEGIN(Hashes)                    // Beginning of hash types
+  LLRSKTITEM(CHT_,CRC32),  LLRSKTITEM(CHT_,SHA1),   LLRSKTITEM(CHT_,SHA224),
+  LLRSKTITEM(CHT_,SHA256), LLRSKTITEM(CHT_,SHA384), LLRSKTITEM(CHT_,SHA512),
+LLRSKTEND                              // End of hash types
+/* ========================================================================= **
+** ######################################################################### **
+** ## Crypt.* namespace constants structure                               ## **
+** ######################################################################### **
+** ========================================================================= */
+LLRSCONSTBEGIN                         // Crypt.* namespace consts begin
+  LLRSCONST(Hashes),
+LLRSCONSTEND                           // Crypt.* namespace consts end
 /* ========================================================================= */
 }                                      // End of Crypt namespace
 /* == EoF =========================================================== EoF == */
@@ -69,6 +69,20 @@ LLFUNC(Dump, 0,
   const AgFilename aFilename{lS, 3};
   aFont().Dump(aTextureId, aFilename))
 /* ========================================================================= */
+// $ Font:GetCacheStats
+// < Hits:integer=Prints drawn from a cached layout.
+// < Misses:integer=Prints that had to be laid out.
+// < Count:integer=Layouts currently cached.
+// < Limit:integer=Maximum layouts cached.
+// ? Returns statistics for the print layout cache of the font. Print, PrintR
+// ? and PrintW store the triangles they generate and draw them again with a
+// ? single copy when called with the same string, size, spacing and colours.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetCacheStats, 4,
+  const AgFont aFont{lS, 1};
+  LuaUtilPushVar(lS, aFont().GetLayoutHits(), aFont().GetLayoutMisses(),
+    aFont().GetLayoutCount(), aFont().GetLayoutLimit()))
+/* ========================================================================= */
 // $ Font:GetHeight
 // < Height:integer=The tile height of the font.
 // ? Returns height of the font tile. If this font is a free-type font, this
@@ -90,6 +104,21 @@ LLFUNC(GetId, 1, LuaUtilPushVar(lS, AgFont{lS, 1}().CtrGet()))
 /* ------------------------------------------------------------------------- */
 LLFUNC(GetName, 1, LuaUtilPushVar(lS, AgFont{lS, 1}().IdentGet()))
 /* ========================================================================= */
+// $ Font:GetStats
+// < Sync:integer=Glyphs rendered while printing.
+// < Async:integer=Glyphs rendered by the prefetch thread.
+// < Pending:integer=Glyphs queued or waiting to be added to the texture.
+// < Uploads:integer=Number of texture uploads.
+// < Last:integer=Bytes sent in the last texture upload.
+// < Total:integer=Bytes sent in all texture uploads.
+// ? Returns glyph rendering and texture upload statistics for the font.
+/* ------------------------------------------------------------------------- */
+LLFUNC(GetStats, 6,
+  const AgFont aFont{lS, 1};
+  LuaUtilPushVar(lS, aFont().GetGlyphsSync(), aFont().GetGlyphsAsync(),
+    aFont().GetGlyphsPending(), aFont().GetUploads(),
+    aFont().GetUploadLast(), aFont().GetUploadTotal()))
+/* ========================================================================= */
 // $ Font:GetWidth
 // < Width:integer=The tile width of the font.
 // ? Returns width of the font tile. If this font is a free-type font, this
@@ -122,6 +151,32 @@ LLFUNC(LoadRange, 0,
                 aEnd{lS, 3};
   aFont().InitFTCharRange(aStart, aEnd))
 /* ========================================================================= */
+// $ Font:Prefetch
+// > Characters:string=A utf-8 string of characters you want to pre-cache.
+// ? Queues the characters in the specified utf-8 string to be rendered by a
+// ? background thread. Unlike LoadChars, this returns straight away and the
+// ? default character is drawn instead until each character has been added
+// ? to the texture on a later print call.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Prefetch, 0,
+  const AgFont aFont{lS, 1};
+  const AgGLString aString{lS, 2};
+  aFont().PrefetchFTCharString(aString))
+/* ========================================================================= */
+// $ Font:PrefetchRange
+// > Start:integer=The starting UNICODE character index.
+// > End:integer=The ending UNICODE character index.
+// ? Queues the specified UNICODE character range to be rendered by a
+// ? background thread. Unlike LoadRange, this returns straight away and the
+// ? default character is drawn instead until each character has been added
+// ? to the texture on a later print call.
+/* ------------------------------------------------------------------------- */
+LLFUNC(PrefetchRange, 0,
+  const AgFont aFont{lS, 1};
+  const AgSizeT aStart{lS, 2},
+                aEnd{lS, 3};
+  aFont().PrefetchFTCharRange(aStart, aEnd))
+/* ========================================================================= */
 // $ Font:Print
 // > X:number=The X screen position of the string.
 // > Y:number=The Y screen position of the string.
@@ -493,6 +548,17 @@ LLFUNC(SetCA, 0,
   const AgGLfloat aColour{lS, 2};
   aFont().FboItemSetQuadAlpha(aColour))
 /* ========================================================================= */
+// $ Font:SetCache
+// > Count:integer=Maximum number of print layouts to cache.
+// ? Sets the maximum number of print layouts the font will cache. When the
+// ? cache is full the least recently drawn layout is replaced. Specify zero
+// ? to disable the cache. The default is 128.
+/* ------------------------------------------------------------------------- */
+LLFUNC(SetCache, 0,
+  const AgFont aFont{lS, 1};
+  const AgSizeT aCount{lS, 2};
+  aFont().SetLayoutLimit(aCount))
+/* ========================================================================= */
 // $ Font:SetCB
 // > Blue:number=The colour intensity of the texture's blue component (0-1).
 // ? Sets the colour intensity of the texture for the blue component. The
@@ -694,23 +760,24 @@ LLFUNC(SetSpacing, 0,
 ** ######################################################################### **
 ** ------------------------------------------------------------------------- */
 LLRSMFBEGIN                            // Font:* member functions begin
-  LLRSFUNC(Destroy),    LLRSFUNC(Dump),        LLRSFUNC(GetHeight),
-  LLRSFUNC(GetId),      LLRSFUNC(GetName),     LLRSFUNC(GetWidth),
-  LLRSFUNC(LoadChars),  LLRSFUNC(LoadRange),   LLRSFUNC(Print),
-  LLRSFUNC(PrintC),     LLRSFUNC(PrintCT),     LLRSFUNC(PrintM),
-  LLRSFUNC(PrintMT),    LLRSFUNC(PrintR),      LLRSFUNC(PrintRT),
-  LLRSFUNC(PrintS),     LLRSFUNC(PrintT),      LLRSFUNC(PrintTS),
-  LLRSFUNC(PrintU),     LLRSFUNC(PrintUC),     LLRSFUNC(PrintUCT),
-  LLRSFUNC(PrintUR),    LLRSFUNC(PrintURT),    LLRSFUNC(PrintUS),
-  LLRSFUNC(PrintW),     LLRSFUNC(PrintWS),     LLRSFUNC(PrintWT),
-  LLRSFUNC(PrintWTS),   LLRSFUNC(PrintWU),     LLRSFUNC(PrintWUT),
-  LLRSFUNC(SetCA),      LLRSFUNC(SetCB),       LLRSFUNC(SetCG),
-  LLRSFUNC(SetCOA),     LLRSFUNC(SetCOB),      LLRSFUNC(SetCOG),
-  LLRSFUNC(SetCOR),     LLRSFUNC(SetCORGB),    LLRSFUNC(SetCORGBA),
-  LLRSFUNC(SetCORGBAI), LLRSFUNC(SetCR),       LLRSFUNC(SetCRGBAI),
-  LLRSFUNC(SetCRGB),    LLRSFUNC(SetCRGBA),    LLRSFUNC(SetGPad),
-  LLRSFUNC(SetGSize),   LLRSFUNC(SetLSpacing), LLRSFUNC(SetSize),
-  LLRSFUNC(SetSpacing),
+  LLRSFUNC(Destroy),     LLRSFUNC(Dump),      LLRSFUNC(GetCacheStats),
+  LLRSFUNC(GetHeight),   LLRSFUNC(GetId),     LLRSFUNC(GetName),
+  LLRSFUNC(GetStats),    LLRSFUNC(GetWidth),  LLRSFUNC(LoadChars),
+  LLRSFUNC(LoadRange),   LLRSFUNC(Prefetch),  LLRSFUNC(PrefetchRange),
+  LLRSFUNC(Print),       LLRSFUNC(PrintC),    LLRSFUNC(PrintCT),
+  LLRSFUNC(PrintM),      LLRSFUNC(PrintMT),   LLRSFUNC(PrintR),
+  LLRSFUNC(PrintRT),     LLRSFUNC(PrintS),    LLRSFUNC(PrintT),
+  LLRSFUNC(PrintTS),     LLRSFUNC(PrintU),    LLRSFUNC(PrintUC),
+  LLRSFUNC(PrintUCT),    LLRSFUNC(PrintUR),   LLRSFUNC(PrintURT),
+  LLRSFUNC(PrintUS),     LLRSFUNC(PrintW),    LLRSFUNC(PrintWS),
+  LLRSFUNC(PrintWT),     LLRSFUNC(PrintWTS),  LLRSFUNC(PrintWU),
+  LLRSFUNC(PrintWUT),    LLRSFUNC(SetCA),     LLRSFUNC(SetCache),
+  LLRSFUNC(SetCB),       LLRSFUNC(SetCG),     LLRSFUNC(SetCOA),
+  LLRSFUNC(SetCOB),      LLRSFUNC(SetCOG),    LLRSFUNC(SetCOR),
+  LLRSFUNC(SetCORGB),    LLRSFUNC(SetCORGBA), LLRSFUNC(SetCORGBAI),
+  LLRSFUNC(SetCR),       LLRSFUNC(SetCRGBAI), LLRSFUNC(SetCRGB),
+  LLRSFUNC(SetCRGBA),    LLRSFUNC(SetGPad),   LLRSFUNC(SetGSize),
+  LLRSFUNC(SetLSpacing), LLRSFUNC(SetSize),   LLRSFUNC(SetSpacing),
 LLRSEND                                // Font:* member functions end
 /* ========================================================================= */
 // $ Font.Image
@@ -781,6 +848,7 @@ LLRSKTBEGIN(Flags)                     // Beginning of ft font loading flags
   LLRSKTITEM(IL_,NONE),                LLRSKTITEM(FF_,USEGLYPHSIZE),
   LLRSKTITEM(FF_,FLOORADVANCE),        LLRSKTITEM(FF_,CEILADVANCE),
   LLRSKTITEM(FF_,ROUNDADVANCE),        LLRSKTITEM(FF_,STROKETYPE2),
+  LLRSKTITEM(FF_,SDF),
 LLRSKTEND                              // End of ft font loading flags
 /* ========================================================================= **
 ** ######################################################################### **
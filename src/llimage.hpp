@@ -230,7 +230,7 @@ LLRSKTBEGIN(Flags)                     // Beginning of image flags codes
   LLRSKTITEM(IL_,TO32BPP), LLRSKTITEM(IL_,TOBGR),    LLRSKTITEM(IL_,TORGB),
   LLRSKTITEM(IL_,REVERSE), LLRSKTITEM(IL_,TOBINARY), LLRSKTITEM(IL_,ATLAS),
   LLRSKTITEM(IL_,FCE_DDS), LLRSKTITEM(IL_,FCE_GIF),  LLRSKTITEM(IL_,FCE_JPG),
-  LLRSKTITEM(IL_,FCE_PNG),
+  LLRSKTITEM(IL_,FCE_PNG), LLRSKTITEM(IL_,TODXT),
 LLRSKTEND                              // End of image flags codes
 /* ------------------------------------------------------------------------- */
 // @ Image.Formats
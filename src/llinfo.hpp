@@ -284,6 +284,42 @@ LLFUNC(IsOSMac, 1, LuaUtilPushVar(lS, false))
 /* ------------------------------------------------------------------------- */
 LLFUNC(Catchup, 0, cTimer->TimerCatchup())
 /* ========================================================================= */
+// $ Info.FrameStats
+// < Frames:integer=Number of frames measured.
+// < Mean:number=Average time between frames in seconds.
+// < StdDev:number=Standard deviation of the time between frames.
+// < Minimum:number=Shortest time between frames in seconds.
+// < Maximum:number=Longest time between frames in seconds.
+// < Oversleep:number=Current estimate of how long a suspend oversleeps.
+// ? Returns statistics of the time between rendered frames since the
+// ? environment was last reset or Info.FrameReset() was called. The oversleep
+// ? estimate is only calibrated when 'app_pacing' is enabled.
+/* ------------------------------------------------------------------------- */
+LLFUNC(FrameStats, 6,
+  const TimerFrameStats tfsStats{ cTimer->TimerGetFrameStats() };
+  LuaUtilPushVar(lS, tfsStats.uqFrames, tfsStats.dMean, tfsStats.dStdDev,
+    tfsStats.dMinimum, tfsStats.dMaximum, tfsStats.dOversleep))
+/* ========================================================================= */
+// $ Info.FrameTimes
+// < Counts:table=Number of frames that fell into each bucket.
+// < Width:number=Width of each bucket in seconds.
+// ? Returns a histogram of the time between rendered frames. Bucket 'n'
+// ? counts frames that took from 'Width*(n-1)' to 'Width*n' seconds and the
+// ? last bucket also counts every frame that took longer.
+/* ------------------------------------------------------------------------- */
+LLFUNC(FrameTimes, 2,
+  const auto &aHistogram = cTimer->TimerGetHistogram();
+  LuaUtilPushTable(lS, aHistogram.size());
+  for(size_t stIndex = 0; stIndex < aHistogram.size(); ++stIndex)
+    LuaUtilSetTableIdxInt(lS, -3, static_cast<lua_Integer>(stIndex + 1),
+      aHistogram[stIndex]);
+  LuaUtilPushVar(lS, cTimer->TimerGetHistogramBucket()))
+/* ========================================================================= */
+// $ Info.FrameReset
+// ? Forgets all frame time statistics and the histogram.
+/* ------------------------------------------------------------------------- */
+LLFUNC(FrameReset, 0, cTimer->TimerResetFrameStats())
+/* ========================================================================= */
 // $ Info.Env
 // > Value:string=The name of the variable to query.
 // < Value:string=The value of the specified variable.
@@ -301,6 +337,7 @@ LLRSBEGIN                              // Info.* namespace functions begin
   LLRSFUNC(CPU),          LLRSFUNC(CPUFPS),       LLRSFUNC(CPUProcUsage),
   LLRSFUNC(CPUSysUsage),  LLRSFUNC(CPUUsage),     LLRSFUNC(Catchup),
   LLRSFUNC(Delay),        LLRSFUNC(Engine),       LLRSFUNC(Env),
+  LLRSFUNC(FrameReset),   LLRSFUNC(FrameStats),   LLRSFUNC(FrameTimes),
   LLRSFUNC(IsOSLinux),    LLRSFUNC(IsOSMac),      LLRSFUNC(IsOSWindows),
   LLRSFUNC(LUAMicroTime), LLRSFUNC(LUAMilliTime), LLRSFUNC(LUANanoTime),
   LLRSFUNC(LUATime),      LLRSFUNC(LUAUsage),     LLRSFUNC(Locale),
@@ -104,6 +104,47 @@ LLRSMFBEGIN                            // Json:* member functions begin
   LLRSFUNC(ToFile),  LLRSFUNC(ToHRFile),
 LLRSEND                                // Json:* member functions end
 /* ========================================================================= */
+// $ Json.Decode
+// > Code:string=The string of JSON encoded data to decode
+// < Result:table=The decoded data
+// ? Decodes the specified string straight into a table without creating a
+// ? Json object first. This is faster and uses less memory than
+// ? Json.String() followed by Json:ToTable() for large strings.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Decode, 1, JsonDecodeString(lS, 1))
+/* ========================================================================= */
+// $ Json.DecodeAsset
+// > Data:Asset=The asset containing JSON encoded data to decode
+// < Result:table=The decoded data
+// ? Decodes the specified asset straight into a table without creating a
+// ? Json object first.
+/* ------------------------------------------------------------------------- */
+LLFUNC(DecodeAsset, 1, JsonDecodeBlock(lS, AgAsset{lS, 1}))
+/* ========================================================================= */
+// $ Json.Encode
+// > Table:table=The table to encode
+// > Pretty:boolean=Encode in human readable format
+// < Code:string=The JSON encoded data
+// ? Encodes the specified table straight into a string without creating a
+// ? Json object first. The level depth is limited to 255.
+/* ------------------------------------------------------------------------- */
+LLFUNC(Encode, 1,
+  const AgBoolean aPretty{lS, 2};
+  JsonEncodeString(lS, 1, aPretty))
+/* ========================================================================= */
+// $ Json.EncodeAsset
+// > Table:table=The table to encode
+// > Pretty:boolean=Encode in human readable format
+// < Data:Asset=The JSON encoded data
+// ? Encodes the specified table straight into a new asset without creating a
+// ? Json object first. The level depth is limited to 255.
+/* ------------------------------------------------------------------------- */
+LLFUNC(EncodeAsset, 1,
+  const AgBoolean aPretty{lS, 2};
+  Memory mData;
+  JsonEncodeBlock(lS, 1, aPretty, mData);
+  AcAsset{lS}().MemSwap(mData))
+/* ========================================================================= */
 // $ Json.File
 // > Filename:string=The filename of the json to load
 // ? Decodes the specified string as JSON encoded. The level depth is limited
@@ -156,8 +197,10 @@ LLFUNC(WaitAsync, 0, cJsons->WaitAsync())
 ** ######################################################################### **
 ** ------------------------------------------------------------------------- */
 LLRSBEGIN                              // Json.* namespace functions begin
-  LLRSFUNC(File),        LLRSFUNC(FileAsync), LLRSFUNC(String),
-  LLRSFUNC(StringAsync), LLRSFUNC(Table),     LLRSFUNC(WaitAsync),
+  LLRSFUNC(Decode),      LLRSFUNC(DecodeAsset), LLRSFUNC(Encode),
+  LLRSFUNC(EncodeAsset), LLRSFUNC(File),        LLRSFUNC(FileAsync),
+  LLRSFUNC(String),      LLRSFUNC(StringAsync), LLRSFUNC(Table),
+  LLRSFUNC(WaitAsync),
 LLRSEND                                // Json.* namespace functions end
 /* ========================================================================= */
 }                                      // End of Json namespace
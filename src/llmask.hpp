@@ -37,6 +37,33 @@ struct AcMask : public ArClass<Mask> {
 struct AgTileId : public AgSizeTLGE {
   explicit AgTileId(lua_State*const lS, const int iArg, const Mask &mCref) :
     AgSizeTLGE{ lS, iArg, 0, mCref.size() }{} };
+/* -- Read list of overlap tests ------------------------------------------- */
+struct AgMaskTests { MaskTests mtList;
+  MaskTests &operator()(void) { return mtList; }
+  explicit AgMaskTests(lua_State*const lS, const int iArg,
+    const Mask &mCref)
+  { // Check table and get its size which must be a multiple of three
+    LuaUtilCheckTable(lS, iArg);
+    const lua_Integer liLen = UtilIntOrMax<lua_Integer>(LuaUtilGetSize(lS,
+      iArg));
+    if(liLen % 3)
+      XC("Candidates must be sub-mask id, X and Y triples!",
+         "Parameter", iArg, "Count", liLen);
+    // Read each triple
+    mtList.reserve(static_cast<size_t>(liLen / 3));
+    for(lua_Integer liIndex = 1; liIndex <= liLen; liIndex += 3)
+    { // Push the three values
+      LuaUtilGetRefEx(lS, iArg, liIndex);
+      LuaUtilGetRefEx(lS, iArg, liIndex + 1);
+      LuaUtilGetRefEx(lS, iArg, liIndex + 2);
+      // Check and add them
+      mtList.push_back({
+        LuaUtilGetIntLGE<size_t>(lS, -3, 0, mCref.size()),
+        LuaUtilGetInt<int>(lS, -2), LuaUtilGetInt<int>(lS, -1), false });
+      // Remove the three values
+      LuaUtilPruneStack(lS, -4);
+    }
+  } };
 /* ========================================================================= **
 ** ######################################################################### **
 ** ## Mask:* member functions                                             ## **
@@ -95,6 +122,29 @@ LLFUNC(IsCollideEx, 1,
   LuaUtilPushVar(lS, aSrcMask().IsCollide(aSrcTileId, aSrcX, aSrcY, aDestMask,
     aDestTileId, aDestX, aDestY)))
 /* ========================================================================= */
+// $ Mask:IsCollideList
+// > Dest:Mask=The destination mask to test upon
+// > Candidates:table=Destination sub-mask id, X and Y of each test in turn
+// < Hits:table=Indexes of the candidates that overlap the source mask
+// ? Tests many destination sub-masks against the first mask in one call and
+// ? returns a list of which candidates collided. The candidates table is a
+// ? flat list of triples, i.e. { id1, x1, y1, id2, x2, y2, ... } and the
+// ? returned indexes count each triple from one. Large lists are tested on
+// ? multiple threads.
+/* ------------------------------------------------------------------------- */
+LLFUNC(IsCollideList, 1,
+  const AgMask aSrcMask{lS, 1},
+               aDestMask{lS, 2};
+  AgMaskTests aTests{lS, 3, aDestMask};
+  MaskTests &mtList = aTests();
+  const size_t stHits =
+    aSrcMask().IsCollideList(0, 0, 0, aDestMask, mtList);
+  LuaUtilPushTable(lS, stHits);
+  lua_Integer liHit = 0;
+  for(size_t stIndex = 0; stIndex < mtList.size(); ++stIndex)
+    if(mtList[stIndex].bHit)
+      LuaUtilSetTableIdxInt(lS, -3, ++liHit, stIndex + 1))
+/* ========================================================================= */
 // $ Mask:Clear
 // > DestX:integer=Destination X position to start filling at.
 // > DestY:integer=Destination Y position to start filling at.
@@ -236,11 +286,12 @@ LLFUNC(Width, 1, LuaUtilPushVar(lS, AgMask{lS, 1}().DimGetWidth()))
 ** ######################################################################### **
 ** ------------------------------------------------------------------------- */
 LLRSMFBEGIN                            // Mask:* member functions begin
-  LLRSFUNC(Clear),       LLRSFUNC(Copy),  LLRSFUNC(Count),
-  LLRSFUNC(Destroy),     LLRSFUNC(Erase), LLRSFUNC(Fill),
-  LLRSFUNC(Height),      LLRSFUNC(Id),    LLRSFUNC(IsCollide),
-  LLRSFUNC(IsCollideEx), LLRSFUNC(Merge), LLRSFUNC(Name),
-  LLRSFUNC(Raycast),     LLRSFUNC(Save),  LLRSFUNC(Width),
+  LLRSFUNC(Clear),       LLRSFUNC(Copy),          LLRSFUNC(Count),
+  LLRSFUNC(Destroy),     LLRSFUNC(Erase),         LLRSFUNC(Fill),
+  LLRSFUNC(Height),      LLRSFUNC(Id),            LLRSFUNC(IsCollide),
+  LLRSFUNC(IsCollideEx), LLRSFUNC(IsCollideList), LLRSFUNC(Merge),
+  LLRSFUNC(Name),        LLRSFUNC(Raycast),       LLRSFUNC(Save),
+  LLRSFUNC(Width),
 LLRSEND                                // Mask:* member functions end
 /* ========================================================================= */
 // $ Mask.Create
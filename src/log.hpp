@@ -12,8 +12,8 @@ namespace ILog {                       // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IClock::P;             using namespace ICVarDef::P;
 using namespace IFStream::P;           using namespace IIdent::P;
-using namespace IStd::P;               using namespace IString::P;
-using namespace ISysUtil::P;           using namespace IToken::P;
+using namespace ILines::P;             using namespace IStd::P;
+using namespace IString::P;            using namespace ISysUtil::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Log levels ----------------------------------------------------------- */
@@ -26,14 +26,13 @@ enum LHLevel : unsigned int            // Log helper level flags
   LH_DEBUG,                            // Log message is for debugging
   LH_MAX,                              // Maximum log message level
 };/* ----------------------------------------------------------------------- */
-struct LogLine                         // Log line structure
+struct LogLineData                     // Log line structure
 { /* ----------------------------------------------------------------------- */
-  const double     dTime;              // The time it happend
-  const LHLevel    lhlLevel;           // The type of log entry
-  const string     strLine;            // The log entry string
+  double           dTime;              // The time it happend
+  LHLevel          lhlLevel;           // The type of log entry
 };/* ----------------------------------------------------------------------- */
-typedef list<LogLine>            LogLines;        // List of log lines
-typedef LogLines::const_iterator LogLinesConstIt; // Log lines iterator
+typedef Lines<LogLineData>     LogLines; // Ring of log lines
+typedef LinesItem<LogLineData> LogLine;  // A log line read from the ring
 /* == Log class ============================================================ */
 static class Log final :
   /* -- Base classes ------------------------------------------------------- */
@@ -43,82 +42,173 @@ static class Log final :
   private mutex                        // Because logger needs thread safe
 { /* -- Private typedefs --------------------------------------------------- */
   typedef IdList<LH_MAX> LogLevels;    // Log levels as human readable strings
+  /* ----------------------------------------------------------------------- */
+  struct LogBatchLine                  // Line taken by the writer thread
+  { /* --------------------------------------------------------------------- */
+    double         dTime;              // The time it happend
+    LHLevel        lhlLevel;           // The type of log entry
+    string         strLine;            // The log entry string
+  };/* --------------------------------------------------------------------- */
+  typedef vector<LogBatchLine> LogBatch; // Lines written as one batch
   /* -- Private variables -------------------------------------------------- */
   const LogLevels  llLevels;           // Log level strings
   const string     strStdOut,          // Label for 'stdout'
                    strStdErr;          // Label for 'stderr'
   atomic<LHLevel>  lhlLevel;           // Log helper level for this instance
-  size_t           stMaximum;          // Maximum log lines
-  /* ----------------------------------------------------------------------- */
-  void ReserveLines(const size_t stLines)
-  { // Calculate total liens
-    const size_t stTotal = size() + stLines;
-    // If writing this many lines would fit in the log, then the log does not
-    // need pruning.
-    if(stTotal <= stMaximum) return;
-    // If too many lines would be written? Just clear the log
-    if(stLines >= stMaximum) return clear();
-    // Erase enough lines for the new ones to fit
-    erase(begin(), next(begin(), static_cast<ssize_t>(stTotal - stMaximum)));
+  SafeBool         bAsync,             // Lines are queued for writer thread
+                   bWriterExit;        // Writer thread should exit
+  SafeUInt64       uqQueued,           // Lines queued to the writer thread
+                   uqLargest,          // Largest batch written
+                   uqBatches;          // Batches written by writer thread
+  condition_variable cvWriter;         // Wakes up the writer thread
+  mutex            mWrite;             // Serialises writes to the log file
+  LogBatch         lbQueue,            // Lines queued for the writer thread
+                   lbBatch;            // Lines taken by the writer thread
+  size_t           stQueue,            // Number of lines in the queue
+                   stBatch;            // Number of lines in the batch
+  string           strWrite;           // Reused line buffer for writing
+  /* -- Close the log file and leave the reason in the backlog ------------- */
+  void FlushFailed(const char*const cpReason)
+  { // Close file and write closure reason. We cannot call the safe logging
+    // functions here as we already own the mutex.
+    FStreamClose();
+    LinesPush({ CCDeltaToDouble(), LH_ERROR },
+      StrFormat("Log file closed ($ error: $)!", cpReason, StrFromErrNo()));
+  }
+  /* -- Write a line to the log file (must own the write mutex) ------------ */
+  bool WriteLine(const double dTime, const LHLevel lhL,
+    const string_view &strvLine)
+  { // Format into the reused buffer so no allocation occurs per line
+    strWrite.clear();
+    StrFormatTo(strWrite, "[$$$]<$> $\n", fixed, setprecision(6), dTime,
+      LogLevelToString(lhL).front(), strvLine);
+    // Write the line and return if succeeded
+    return !!FStreamWriteString(strWrite);
   }
   /* ----------------------------------------------------------------------- */
   void FlushLog(void)
-  { // Ignore if file not opened or there is nothing to write
-    if(empty() || FStreamClosed()) return;
-    // Get start of log
-    LogLinesConstIt llciItem{ cbegin() };
-    // Repeat...
-    do
-    { // Get reference to line
-      const LogLine &llLine = *llciItem;
-      // Write stored line and if succeeded
-      if(FStreamWriteStringEx("[$$$]<$> $\n", fixed, setprecision(6),
-        llLine.dTime, LogLevelToString(llLine.lhlLevel).front(),
-        llLine.strLine))
-      { // Flush the line to file straight away and continue if succeeded
-        if(FStreamFlush()) continue;
-        // Flush failed so close file and write closure reason
-        FStreamClose();
-        LogErrorExSafe("Log file closed (flush error: $)!", StrFromErrNo());
-      } // Write string failed?
-      else
-      { // Close file and write closure reason
-        FStreamClose();
-        LogErrorExSafe("Log file closed (write error: $)!", StrFromErrNo());
-      } // Erase the lines we actually wrote. Never erase the first line.
-      erase(begin(), llciItem);
-      // Do not write anymore lines
-      return;
-    } // ... until all lines written
-    while(++llciItem != end());
-    // We wrote all the lines
-    clear();
+  { // Ignore if file not opened
+    if(FStreamClosed()) return;
+    // Wait for the writer thread to finish writing its batch
+    const LockGuard lgWriteSync{ mWrite };
+    // Until there are no more lines in the backlog
+    while(!LinesEmpty())
+    { // Write the oldest line and close the file if it failed
+      const LogLine llLine{ LinesFront() };
+      if(!WriteLine(llLine.dTime, llLine.lhlLevel, llLine.strvLine))
+        return FlushFailed("write");
+      // Remove the line we wrote
+      LinesPop();
+    } // Flush the lines to file once for the whole batch
+    if(!FStreamFlush()) FlushFailed("flush");
+  }
+  /* -- Add a line to a queue or batch reusing the memory of old lines ----- */
+  static void BatchPush(LogBatch &lbDest, size_t &stUsed, const double dTime,
+    const LHLevel lhL, const string_view &strvLine)
+  { // Reuse the memory of a line from an earlier batch if there is one
+    if(stUsed < lbDest.size())
+    { // Overwrite the old line
+      LogBatchLine &lblLine = lbDest[stUsed];
+      lblLine.dTime = dTime;
+      lblLine.lhlLevel = lhL;
+      lblLine.strLine.assign(strvLine);
+    } // Else grow the batch
+    else lbDest.push_back({ dTime, lhL, string{ strvLine } });
+    // Added another line
+    ++stUsed;
+  }
+  /* -- Write queued lines to file or backlog (must own the mutex) --------- */
+  void DrainQueue(void)
+  { // Ignore if nothing is queued
+    if(!stQueue) return;
+    // Wait for the writer thread to finish writing its batch
+    const LockGuard lgWriteSync{ mWrite };
+    // For each queued line
+    for(size_t stIndex = 0; stIndex < stQueue; ++stIndex)
+    { // Get the line
+      const LogBatchLine &lblLine = lbQueue[stIndex];
+      // Write straight to the file if the backlog was already written
+      if(LinesEmpty() && FStreamOpened())
+      { // Write the line and try the next line if succeeded
+        if(WriteLine(lblLine.dTime, lblLine.lhlLevel, lblLine.strLine))
+          continue;
+        // Close file and write closure reason
+        FlushFailed("write");
+      } // Add line to backlog
+      LinesPush({ lblLine.dTime, lblLine.lhlLevel }, lblLine.strLine);
+    } // Queue is empty now
+    stQueue = 0;
   }
-  /* -- Write lines to log ------------------------------------------------- */
-  void WriteLines(const LHLevel lhL, const TokenList &tLines) noexcept(true)
+  /* -- Take the queued lines for the writer thread (must own the mutex) --- */
+  size_t BatchTake(void)
+  { // Lines in the backlog were logged first so they are written first
+    for(stBatch = 0; !LinesEmpty(); LinesPop())
+    { const LogLine llLine{ LinesFront() };
+      BatchPush(lbBatch, stBatch, llLine.dTime, llLine.lhlLevel,
+        llLine.strvLine); }
+    // Nothing in the backlog so swap the queue with the batch. Both keep the
+    // memory of their lines so neither needs the allocator after warm-up.
+    if(!stBatch) { lbQueue.swap(lbBatch); stBatch = stQueue; }
+    // Else copy the queued lines after the backlog
+    else for(size_t stIndex = 0; stIndex < stQueue; ++stIndex)
+    { const LogBatchLine &lblLine = lbQueue[stIndex];
+      BatchPush(lbBatch, stBatch, lblLine.dTime, lblLine.lhlLevel,
+        lblLine.strLine); }
+    // Queue is empty now so return number of lines taken
+    stQueue = 0;
+    return stBatch;
+  }
+  /* -- Write the batch and return failure reason (must own write mutex) --- */
+  const char *BatchWrite(size_t &stDone)
+  { // Write each line and return if it failed
+    for(stDone = 0; stDone < stBatch; ++stDone)
+    { const LogBatchLine &lblLine = lbBatch[stDone];
+      if(!WriteLine(lblLine.dTime, lblLine.lhlLevel, lblLine.strLine))
+        return "write"; }
+    // Flush the lines to file once for the whole batch
+    return FStreamFlush() ? nullptr : "flush";
+  }
+  /* -- Keep unwritten lines and close the file (must own the mutex) ------- */
+  void BatchFailed(const char*const cpReason, const size_t stDone)
+  { // Put lines that were not written back into the backlog
+    for(size_t stIndex = stDone; stIndex < stBatch; ++stIndex)
+    { const LogBatchLine &lblLine = lbBatch[stIndex];
+      LinesPush({ lblLine.dTime, lblLine.lhlLevel }, lblLine.strLine); }
+    // Close file and write closure reason
+    FlushFailed(cpReason);
+    // Lines should go through the backlog now
+    bAsync = false;
+  }
+  /* -- Queue a string to the writer thread (must own the mutex) ----------- */
+  void QueueString(const LHLevel lhL, const string &strL)
+  { // Get current time for all the lines
+    const double dTime = CCDeltaToDouble();
+    // Split and queue each line
+    LinesSplit(strL, [this, dTime, lhL](const string_view &strvLine)
+      { BatchPush(lbQueue, stQueue, dTime, lhL, strvLine); ++uqQueued; });
+    // Wake the writer thread
+    cvWriter.notify_one();
+  }
+  /* -- Write string to log. Line feed creates multiple lines -------------- */
+  void WriteString(const LHLevel lhL, const string &strL) noexcept(true)
   { // Ignore if no lines
-    if(tLines.empty()) return;
-    // Prune log to fit this many lines
-    ReserveLines(tLines.size());
-    // For each line, print to log. Note that I tried using string
-    // appending for this and it turned out to be almost twice as slow as
-    // using formatstring due to the fact that less memory management
-    // is required!
-    for(const string &strLine : tLines)
-      push_back({ CCDeltaToDouble(), lhL, StdMove(strLine) });
+    if(strL.empty()) return;
+    // Lines still queued for the writer thread must be written first
+    DrainQueue();
+    // Copy each line into the backlog which evicts the oldest lines to fit
+    const double dTime = CCDeltaToDouble();
+    LinesSplit(strL, [this, dTime, lhL](const string_view &strvLine)
+      { LinesPush({ dTime, lhL }, strvLine); });
     // Write lines to log
     FlushLog();
   }
-  /* -- Write string to log. Line feed creates multiple lines -------------- */
-  void WriteString(const LHLevel lhL, const string &strL) noexcept(true)
-    { WriteLines(lhL, { strL, cCommon->Lf(), stMaximum }); }
   /* ----------------------------------------------------------------------- */
   void WriteString(const string &strL) { WriteString(LH_CRITICAL, strL); }
   /* ----------------------------------------------------------------------- */
   void DeInit(void)
   { // Bail if initialised
     if(FStreamClosed()) return;
-    // Log file closure
+    // Log file closure (also writes any lines still queued)
     WriteString("Log file closed.");
     // Flush all remaining strings
     FlushLog();
@@ -147,13 +237,64 @@ static class Log final :
   /* ----------------------------------------------------------------------- */
   size_t Clear(void)
   { // Get num log lines for returning
-    const size_t stSize = size();
+    const size_t stSize = LinesSize();
     // Clear the log
-    clear();
+    LinesClear();
     // Return number of lines cleared
     return stSize;
   }
   /* ----------------------------------------------------------------------- */
+  bool IsAsync(void) const { return bAsync; }
+  uint64_t GetQueued(void) const { return uqQueued; }
+  uint64_t GetLargest(void) const { return uqLargest; }
+  uint64_t GetBatches(void) const { return uqBatches; }
+  /* -- Start queueing lines for the writer thread ------------------------- */
+  bool WriterBegin(void)
+  { // Lock the log
+    const LockGuard lgLogSync{ GetMutex() };
+    // Ignore if there is no file to write to
+    if(FStreamClosed()) return false;
+    // Write the backlog first then start queueing lines
+    FlushLog();
+    bWriterExit = false;
+    bAsync = true;
+    // Success
+    return true;
+  }
+  /* -- Wait for and write one batch of queued lines (writer thread) ------- */
+  void WriterTick(void)
+  { // Own the log while we are awake. Waiting releases it for other threads.
+    UniqueLock ulLogSync{ GetMutex() };
+    // Wait for lines to be queued or for a timeout
+    cvWriter.wait_for(ulLogSync, milliseconds(100),
+      [this]{ return bWriterExit || (bAsync && stQueue); });
+    // Done if lines go through the backlog or there is nothing to write
+    if(!bAsync || !BatchTake()) return;
+    // Write the batch without owning the log so threads can keep queueing
+    size_t stDone;
+    const char *cpReason;
+    { const LockGuard lgWriteSync{ mWrite };
+      ulLogSync.unlock();
+      cpReason = BatchWrite(stDone); }
+    // Own the log again to count the batch and handle a failure
+    ulLogSync.lock();
+    ++uqBatches;
+    if(stBatch > uqLargest) uqLargest = stBatch;
+    if(cpReason) BatchFailed(cpReason, stDone);
+  }
+  /* -- Stop queueing lines and wake the writer thread so it exits --------- */
+  void WriterEnd(void)
+  { // Lock the log and stop queueing lines
+    { const LockGuard lgLogSync{ GetMutex() };
+      bAsync = false;
+      bWriterExit = true; }
+    // Wake the writer thread
+    cvWriter.notify_one();
+  }
+  /* -- Write lines still queued after the writer thread exited ------------ */
+  void WriterFinish(void)
+    { const LockGuard lgLogSync{ GetMutex() }; DrainQueue(); FlushLog(); }
+  /* ----------------------------------------------------------------------- */
   bool HasLevel(const LHLevel lhReq) const { return lhReq <= lhlLevel; }
   /* ----------------------------------------------------------------------- */
   bool NotHasLevel(const LHLevel lhReq) const { return !HasLevel(lhReq); }
@@ -169,13 +310,23 @@ static class Log final :
     { const LockGuard lgLogSync{ GetMutex() }; return FStreamOpened(); }
   /* ----------------------------------------------------------------------- */
   void DeInitSafe(void)
-    { const LockGuard lgLogSync{ GetMutex() }; DeInit(); }
+  { // Lock the log and stop queueing lines for the writer thread
+    const LockGuard lgLogSync{ GetMutex() };
+    bAsync = false;
+    // Close the log which writes lines still queued
+    DeInit();
+  }
   /* ----------------------------------------------------------------------- */
   const string GetNameSafe(void)
     { const LockGuard lgLogSync{ GetMutex() }; return IdentGet(); }
   /* -- Unformatted logging without level check (specified level) ---------- */
   void LogNLCSafe(const LHLevel lhL, const string& strLine)
-    { const LockGuard lgLogSync{ GetMutex() }; WriteString(lhL, strLine); }
+  { // Own the log so the writer thread cannot stop while we queue
+    const LockGuard lgLogSync{ GetMutex() };
+    // Queue lines if the writer thread is running else write them ourselves
+    if(bAsync) QueueString(lhL, strLine);
+    else WriteString(lhL, strLine);
+  }
   /* -- Unformatted logging without level check (error level) -------------- */
   void LogNLCErrorSafe(const string& strLine)
     { LogNLCSafe(LH_ERROR, strLine); }
@@ -191,7 +342,7 @@ static class Log final :
   /* -- Formatted logging without level check (specified level) ------------ */
   template<typename ...VarArgs>void LogNLCExSafe(const LHLevel lhLev,
     const char*const cpFormat, const VarArgs &...vaArgs)
-      { LogNLCSafe(lhLev, StrFormat(cpFormat, vaArgs...)); }
+      { LogNLCSafe(lhLev, StrFormatVarTL(cpFormat, vaArgs...)); }
   /* -- Formatted logging without level check (error level) ---------------- */
   template<typename ...VarArgs>
     void LogNLCErrorExSafe(const char*const cpFormat, const VarArgs &...vaArgs)
@@ -248,10 +399,13 @@ static class Log final :
   void GetBufferLines(ostringstream &osS)
   { // Gain exclusive access to log lines
     const LockGuard lgLogSync{ GetMutex() };
+    // Include lines that are still queued for the writer thread
+    DrainQueue();
     // For each log entry, write the line to the buffer
-    for(const LogLine &llLine : *this) osS
-      << '[' << fixed << setprecision(6) << llLine.dTime << "] "
-      << llLine.strLine << '\n';
+    for(uint64_t qwIndex = LinesBegin(); qwIndex < LinesEnd(); ++qwIndex)
+    { const LogLine llLine{ LinesGet(qwIndex) };
+      osS << '[' << fixed << setprecision(6) << llLine.dTime << "] "
+          << llLine.strvLine << '\n'; }
   }
   /* -- Initialise log to built-in standard output ------------------------- */
   void Init(FILE*const fpDevice, const string &strLabel)
@@ -270,6 +424,7 @@ static class Log final :
   /* -- Constructor -------------------------------------------------------- */
   Log(void) :
     /* -- Initialisers ----------------------------------------------------- */
+    LogLines{ 1000 },                  // Initialise backlog ring
     llLevels{{                         // Initialise log level strings
       "Critical",                      // Log line is critical
       "Error",                         // Log line is an error
@@ -280,14 +435,20 @@ static class Log final :
     strStdOut{ "/dev/stdout" },        // Initialise display label for stdout
     strStdErr{ "/dev/stderr" },        // Initialise display label for stderr
     lhlLevel{ LH_DEBUG },              // Initialise default level
-    stMaximum(1000)                    // Initialise maximum output lines
+    bAsync{ false },                   // Not queueing to writer thread yet
+    bWriterExit{ false },              // Writer thread should not exit yet
+    uqQueued{ 0 },                     // No lines queued yet
+    uqLargest{ 0 },                    // No largest batch yet
+    uqBatches{ 0 },                    // No batches written yet
+    stQueue{ 0 },                      // No lines queued yet
+    stBatch{ 0 }                       // No lines taken by writer thread yet
     /* -- No code ---------------------------------------------------------- */
     { }
   /* -- Destructor --------------------------------------------------------- */
   DTORHELPER(~Log, DeInitSafe())
   /* -- Macros ------------------------------------------------------------- */
   DELETECOPYCTORS(Log)                 // Do not need defaults
-  /* -- Conlib callback function for APP_LOG variable ---------------------- */
+  /* -- Conlib callback function for APP_LOG (writer must be stopped) ------ */
   CVarReturn LogFileModified(const string &strFN, string &strCV)
   { // Lock mutex
     const LockGuard lgLogSync{ GetMutex() };
@@ -314,14 +475,12 @@ static class Log final :
   /* -- Conlib callback function for APP_LOGLINES variable ----------------- */
   CVarReturn LogLinesModified(const size_t stL)
   { // Must have at least one line and lets also set a safe maximum
-    if(stL < 1 || stL > 1000000 || stL > max_size()) return DENY;
+    if(stL < 1 || stL > 1000000) return DENY;
     // Prevent use of variables off the main thread
     const LockGuard lgLogSync{ GetMutex() };
-    // Current size is over the new maximum? Trim the oldest entries out
-    if(size() > stMaximum)
-      erase(begin(), next(begin(), static_cast<ssize_t>(size() - stMaximum)));
-    // Set new maximum and return success
-    stMaximum = stL;
+    // Resize the backlog which keeps the newest lines that fit
+    LinesResize(stL);
+    // Success
     return ACCEPT;
   }
   /* -- End ---------------------------------------------------------------- */
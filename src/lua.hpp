@@ -52,6 +52,7 @@ static class Lua final :
   int              iGCPause;           // Default GC pause time
   int              iGCStep;            // Default GC step counter
   lua_Integer      liSeed;             // Default seed
+  uint64_t         qwAllocs;           // Number of (re)allocations made
   /* -- References ------------------------------------------------- */ public:
   LuaFunc          lrMainTick;         // Main tick function callback
   LuaFunc          lrMainEnd;          // End function callback
@@ -59,6 +60,8 @@ static class Lua final :
   /* -- Generic end tick to quit the engine  ------------------------------- */
   static int OnGenericEndTick(lua_State*const)
     { cEvtMain->ConfirmExit(); return 0; }
+  /* -- Return number of (re)allocations made by the state ----------------- */
+  uint64_t GetAllocations(void) const { return qwAllocs; }
   /* -- Return lua state --------------------------------------------------- */
   lua_State *GetState(void) const { return lsState.get(); }
   /* -- Set a lua reference (LuaFunc can't have this check) ---------------- */
@@ -391,6 +394,8 @@ static class Lua final :
     // Report execution time
     cLog->LogInfoExSafe("Lua execution took $ seconds.",
       StrShortFromDuration(CCDeltaToDouble()));
+    // Report bundle usage and write any newly compiled functions to it
+    cLuaCodeBundle->Close();
     // Report progress
     cLog->LogDebugSafe("Lua sandbox de-initialising...");
     // De-init instruction count hook?
@@ -410,11 +415,13 @@ static class Lua final :
     cLog->LogDebugSafe("Lua sandbox successfully deinitialised.");
   }
   /* -- Default allocator that uses malloc() ------------------------------- */
-  static void *LuaDefaultAllocator(void*const, void*const vpAddr,
+  static void *LuaDefaultAllocator(void*const vpLua, void*const vpAddr,
     size_t, size_t stSize)
   { // (Re)allocate if memory needed and return
-    if(stSize) return UtilMemReAlloc<void>(vpAddr, stSize);
-    // Zero for free memory
+    if(stSize)
+    { ++static_cast<Lua*>(vpLua)->qwAllocs;
+      return UtilMemReAlloc<void>(vpAddr, stSize);
+    } // Zero for free memory
     UtilMemFree(vpAddr);
     // Return nothing
     return nullptr;
@@ -490,6 +497,7 @@ static class Lua final :
     iGCPause(0),                       // No GC pause
     iGCStep(0),                        // No GC step
     liSeed(0),                         // Random seed
+    qwAllocs(0),                       // No allocations
     lrMainTick{ "MainTick" },          // Main tick event
     lrMainEnd{ "EndTick" },            // End tick event
     lrMainRedraw{ "OnRedraw" }         // Redraw event
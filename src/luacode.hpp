@@ -10,8 +10,9 @@
 namespace ILuaCode {                   // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IAsset::P;             using namespace IClock::P;
-using namespace ICVarDef::P;           using namespace IError::P;
-using namespace IFileMap::P;           using namespace ILog::P;
+using namespace ICVarDef::P;           using namespace IDir::P;
+using namespace IError::P;             using namespace IFileMap::P;
+using namespace IFStream::P;           using namespace ILog::P;
 using namespace ILuaUtil::P;           using namespace IMemory::P;
 using namespace ISql::P;               using namespace IStd::P;
 using namespace IString::P;            using namespace Lib::OS::SevenZip;
@@ -35,8 +36,9 @@ enum LuaCompResult : unsigned int
   LCR_RECOMPILE,                       // [1] Code compiled and stored
   LCR_DBERR,                           // [2] Code compiled but not stored
   LCR_NOCACHE,                         // [3] Code compiled cache disabled
+  LCR_BUNDLED,                         // [4] Using mapped bundle version
   /* ----------------------------------------------------------------------- */
-  LCR_MAX,                             // [6] Number of used result codes
+  LCR_MAX,                             // [5] Number of used result codes
 };/* ----------------------------------------------------------------------- */
 /* -- Set lua cache setting ------------------------------------------------ */
 static CVarReturn LuaCodeSetCache(const LuaCache lcVal)
@@ -126,6 +128,245 @@ static void LuaCodeDoCompileBuffer(lua_State*const lS, const char *cpBuf,
     default: XC("Unknown error executing script!", "Result", iR);
   }
 }
+/* == Memory mapped bundle of compiled functions =========================== **
+** ######################################################################### **
+** ## The bundle file is stored next to the user database. The header is  ## **
+** ## the magic, cache setting, entry count and a reserved value (uint32  ## **
+** ## each) followed by the average time it took to load a script without ## **
+** ## the bundle in nanoseconds (uint64). Each index entry is the CRC,    ## **
+** ## offset, size and name length (uint32 each) followed by the name.    ## **
+** ## The bytecode of every entry follows the index. All integers are     ## **
+** ## little-endian.                                                      ## **
+** ######################################################################### **
+** ------------------------------------------------------------------------- */
+static class LuaCodeBundle final       // Members initially private
+{ /* -- Settings ----------------------------------------------------------- */
+  constexpr static const uint32_t uiMagic = 0x3142434C; // "LCB1" magic
+  constexpr static const size_t
+    stHeader = 24,                     // Size of header
+    stEntry  = 16;                     // Size of index entry
+  /* -- Private typedefs --------------------------------------------------- */
+  struct Entry { uint32_t uiCRC, uiOffset, uiSize; };
+  struct Added { unsigned int uiCRC; Memory mCode; };
+  typedef map<string, Entry> EntryMap; // Index of mapped functions
+  typedef map<string, Added> AddedMap; // Functions waiting to be written
+  /* -- Private variables -------------------------------------------------- */
+  FileMap          fmBundle;           // Mapped bundle file
+  EntryMap         emIndex;            // Index of the mapped bundle
+  AddedMap         amAdded;            // Functions to add to the bundle
+  string           strFile;            // Bundle filename
+  bool             bTried,             // Tried to map the bundle?
+                   bDirty;             // Bundle needs rewriting?
+  size_t           stHits,             // Scripts loaded from the bundle
+                   stMisses;           // Scripts loaded without the bundle
+  uint64_t         qHitNS,             // Time spent loading from the bundle
+                   qMissNS,            // Time spent loading without bundle
+                   qFallbackNS;        // Average fallback time from file
+  /* -- Map the bundle if it exists ---------------------------------------- */
+  void Open(void)
+  { // Only try once per Lua session
+    if(bTried) return;
+    bTried = true;
+    // No bundle if the user database is not stored on disk
+    if(cSql->IdentGet() == cSql->strMemoryDBName) return;
+    strFile = StrAppend(cSql->IdentGet(), ".lcb");
+    // Done if the bundle has not been written yet
+    if(!DirLocalFileExists(strFile)) return;
+    // Capture exceptions so a bad bundle just means using the fallback
+    try
+    { // Map the file and check the header
+      FileMap fmNew{ strFile };
+      if(fmNew.MemSize() < stHeader ||
+         fmNew.ReadIntLE<uint32_t>(0) != uiMagic)
+        XC("Invalid header!");
+      if(fmNew.ReadIntLE<uint32_t>(4) != lcSetting)
+        XC("Cache setting changed!",
+          "Stored", fmNew.ReadIntLE<uint32_t>(4), "Current", lcSetting);
+      const size_t stCount = fmNew.ReadIntLE<uint32_t>(8);
+      qFallbackNS = fmNew.ReadIntLE<uint64_t>(16);
+      // Read each index entry. Reads outside the file will throw.
+      for(size_t stIndex = 0, stPos = stHeader; stIndex < stCount; ++stIndex)
+      { // Read the entry
+        const Entry eNew{ fmNew.ReadIntLE<uint32_t>(stPos),
+          fmNew.ReadIntLE<uint32_t>(stPos + 4),
+          fmNew.ReadIntLE<uint32_t>(stPos + 8) };
+        const size_t stLen = fmNew.ReadIntLE<uint32_t>(stPos + 12);
+        stPos += stEntry;
+        // Make sure the code is inside the file
+        if(eNew.uiOffset > fmNew.MemSize() ||
+           eNew.uiSize > fmNew.MemSize() - eNew.uiOffset)
+          XC("Entry out of bounds!", "Index", stIndex,
+            "Offset", eNew.uiOffset, "Size", eNew.uiSize);
+        // Add the entry to the index
+        emIndex.insert({ string{ fmNew.MemRead<char>(stPos, stLen), stLen },
+          eNew });
+        stPos += stLen;
+      } // Keep the mapping
+      fmBundle.FileMapSwap(fmNew);
+      cLog->LogDebugExSafe("LuaCode mapped bundle '$' with $ functions.",
+        strFile, emIndex.size());
+    } // Error occured so just use the fallback
+    catch(const exception &E)
+    { // Log the reason and rewrite the bundle later
+      cLog->LogWarningExSafe("LuaCode ignoring bundle '$': $",
+        strFile, E.what());
+      emIndex.clear();
+      bDirty = true;
+    }
+  }
+  /* -- Load a function from the bundle ---------------------------- */ public:
+  bool Load(lua_State*const lS, const string &strRef,
+    const unsigned int uiCRC)
+  { // Map the bundle if not tried yet and find the function
+    Open();
+    const auto emiIt{ emIndex.find(strRef) };
+    if(emiIt == emIndex.cend() || emiIt->second.uiCRC != uiCRC) return false;
+    // Load the bytecode directly from the mapping
+    const ClockChrono<CoreClock> ccLoad;
+    const Entry &eRef = emiIt->second;
+    if(luaL_loadbuffer(lS, fmBundle.MemRead<char>(eRef.uiOffset, eRef.uiSize),
+      eRef.uiSize, strRef.c_str()) != LUA_OK)
+    { // Log the problem and drop the entry so it is replaced
+      cLog->LogWarningExSafe("LuaCode bundle entry '$' is bad: $",
+        strRef, LuaUtilGetAndPopStr(lS));
+      emIndex.erase(emiIt);
+      bDirty = true;
+      return false;
+    } // Record statistics
+    ++stHits;
+    qHitNS += ccLoad.CCDeltaNS();
+    // Success
+    return true;
+  }
+  /* -- Add a function that was loaded without the bundle ------------------ */
+  void Add(const string &strRef, const unsigned int uiCRC,
+    Memory &&mCode, const uint64_t qNS)
+  { // Record statistics
+    ++stMisses;
+    qMissNS += qNS;
+    // Store the function if the bundle is enabled
+    if(!strFile.empty()) amAdded.insert_or_assign(strRef,
+      Added{ uiCRC, StdMove(mCode) });
+  }
+  /* -- Write a new bundle ---------------------------------------- */ private:
+  void Save(const uint64_t qAverageNS)
+  { // Calculate size of the index and the code. Old entries are kept
+    // unless they were replaced.
+    size_t stCount = 0, stCode = stHeader, stTotal = 0;
+    for(const auto &emPair : emIndex)
+      if(!amAdded.contains(emPair.first))
+      { ++stCount;
+        stCode += stEntry + emPair.first.length();
+        stTotal += emPair.second.uiSize; }
+    for(const auto &amPair : amAdded)
+    { ++stCount;
+      stCode += stEntry + amPair.first.length();
+      stTotal += amPair.second.mCode.MemSize(); }
+    stTotal += stCode;
+    if(stTotal > numeric_limits<uint32_t>::max())
+    { // Offsets are 32-bit so don't write a bundle this size
+      cLog->LogWarningExSafe("LuaCode bundle of $ bytes is too big!",
+        stTotal);
+      return;
+    } // Write the header
+    Memory mOut{ stTotal };
+    mOut.MemWriteIntLE<uint32_t>(0, uiMagic);
+    mOut.MemWriteIntLE<uint32_t>(4, lcSetting);
+    mOut.MemWriteIntLE<uint32_t>(8, static_cast<uint32_t>(stCount));
+    mOut.MemWriteIntLE<uint32_t>(12, 0);
+    mOut.MemWriteIntLE<uint64_t>(16, qAverageNS);
+    // Function to write an entry
+    size_t stPos = stHeader;
+    const auto fcbWrite = [&mOut, &stPos, &stCode](const string &strName,
+      const unsigned int uiCRC, const char*const cpCode, const size_t stSize)
+    { // Write the index entry
+      mOut.MemWriteIntLE<uint32_t>(stPos, uiCRC);
+      mOut.MemWriteIntLE<uint32_t>(stPos + 4, static_cast<uint32_t>(stCode));
+      mOut.MemWriteIntLE<uint32_t>(stPos + 8, static_cast<uint32_t>(stSize));
+      mOut.MemWriteIntLE<uint32_t>(stPos + 12,
+        static_cast<uint32_t>(strName.length()));
+      mOut.MemWrite(stPos + stEntry, strName.data(), strName.length());
+      stPos += stEntry + strName.length();
+      // Write the code
+      mOut.MemWrite(stCode, cpCode, stSize);
+      stCode += stSize;
+    };
+    // Write kept entries from the old bundle then the new entries
+    for(const auto &emPair : emIndex)
+      if(!amAdded.contains(emPair.first))
+      { const Entry &eRef = emPair.second;
+        fcbWrite(emPair.first, eRef.uiCRC,
+          fmBundle.MemRead<char>(eRef.uiOffset, eRef.uiSize), eRef.uiSize); }
+    for(const auto &amPair : amAdded)
+      fcbWrite(amPair.first, amPair.second.uiCRC,
+        amPair.second.mCode.MemPtr<char>(), amPair.second.mCode.MemSize());
+    // Unmap the old bundle so it can be replaced
+    { FileMap fmOld; fmBundle.FileMapSwap(fmOld); }
+    // Write to a temporary file first so a failed write can't leave a
+    // partial bundle behind.
+    const string strTemp{ StrAppend(strFile, ".tmp") };
+    if(FStream fsOut{ strTemp, FM_W_B })
+    { // Write the data and close the file
+      const bool bWritten = fsOut.FStreamWriteBlock(mOut) == mOut.MemSize();
+      if(fsOut.FStreamClose() && bWritten)
+      { // Replace the old bundle
+        DirFileUnlink(strFile);
+        if(DirFileRename(strTemp, strFile))
+        { // Log success and return
+          cLog->LogDebugExSafe("LuaCode wrote bundle '$' with $ functions.",
+            strFile, stCount);
+          return;
+        }
+      } // Failed so remove the temporary file
+      DirFileUnlink(strTemp);
+    } // Log failure
+    cLog->LogWarningExSafe("LuaCode could not write bundle '$': $",
+      strFile, StrFromErrNo());
+  }
+  /* -- Report statistics, write changes and unmap the bundle ------ */ public:
+  void Close(void)
+  { // Ignore if the bundle was never used
+    if(!bTried) return;
+    // Get average time a load without the bundle takes
+    const uint64_t qAverageNS = stMisses ? qMissNS / stMisses : qFallbackNS;
+    const uint64_t qEstimateNS = qAverageNS * stHits;
+    // Report cache hits and the estimated startup time saved
+    if(stHits || stMisses)
+      cLog->LogInfoExSafe("LuaCode bundle served $ of $ functions in $ "
+        "(fallback $ in $, saved ~$).", stHits, stHits + stMisses,
+        StrShortFromDuration(static_cast<double>(qHitNS) / 1e9),
+        stMisses, StrShortFromDuration(static_cast<double>(qMissNS) / 1e9),
+        StrShortFromDuration(qEstimateNS > qHitNS ?
+          static_cast<double>(qEstimateNS - qHitNS) / 1e9 : 0.0));
+    // Write a new bundle if anything changed
+    if(!strFile.empty() && (bDirty || !amAdded.empty())) Save(qAverageNS);
+    // Reset everything for the next Lua session
+    { FileMap fmOld; fmBundle.FileMapSwap(fmOld); }
+    emIndex.clear();
+    amAdded.clear();
+    strFile.clear();
+    bTried = bDirty = false;
+    stHits = stMisses = 0;
+    qHitNS = qMissNS = qFallbackNS = 0;
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  LuaCodeBundle(void) :                // No parameters
+    /* -- Initialisers ----------------------------------------------------- */
+    bTried(false),                     // Bundle not mapped yet
+    bDirty(false),                     // Bundle does not need rewriting
+    stHits(0),                         // No scripts loaded from bundle
+    stMisses(0),                       // No scripts loaded without bundle
+    qHitNS(0),                         // No time spent loading from bundle
+    qMissNS(0),                        // No time spent loading without it
+    qFallbackNS(0)                     // No fallback time recorded yet
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+  /* -- Destructor --------------------------------------------------------- */
+  DTORHELPER(~LuaCodeBundle, Close())
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(LuaCodeBundle)       // Omit copy constructor for safety
+  /* -- End ---------------------------------------------------------------- */
+} *cLuaCodeBundle = nullptr;           // Pointer to static class
 /* -- Compile a buffer ----------------------------------------------------- */
 static LuaCompResult LuaCodeCompileBuffer(lua_State*const lS,
   const char*const cpBuf, const size_t stSize, const string &strRef)
@@ -139,6 +380,10 @@ static LuaCompResult LuaCodeCompileBuffer(lua_State*const lS,
     return LCR_NOCACHE;
   } // Get checksum of module
   const unsigned int uiCRC = CrcCalc(cpBuf, stSize);
+  // Load straight from the mapped bundle if it is in there
+  if(cLuaCodeBundle->Load(lS, strRef, uiCRC)) return LCR_BUNDLED;
+  // Time the fallback so we can report the time the bundle saves
+  const ClockChrono<CoreClock> ccFallback;
   // Check if we have cached this in the sql database and if we have?
   if(cSql->ExecuteAndSuccess(StrFormat("SELECT `$` from `$` WHERE R=? AND C=?",
     cSql->strvLCCodeColumn, cSql->strvLCTable), strRef, uiCRC))
@@ -160,6 +405,10 @@ static LuaCompResult LuaCodeCompileBuffer(lua_State*const lS,
           // Do compile the buffer
           LuaCodeDoCompileBuffer(lS,
             sdRef.MemPtr<char>(), sdRef.MemSize(), strRef);
+          // Add it to the bundle
+          cLuaCodeBundle->Add(strRef, uiCRC,
+            Memory{ sdRef.MemSize(), sdRef.MemPtr<void>() },
+            ccFallback.CCDeltaNS());
           // Return that we used the cached version
           return LCR_CACHED;
         } // Invalid type
@@ -180,13 +429,15 @@ static LuaCompResult LuaCodeCompileBuffer(lua_State*const lS,
   LuaCodeDoCompileBuffer(lS, cpBuf, stSize, strRef);
   // Compile the function
   Memory mbData{ LuaCodeCompileFunction(lS, lcSetting == LCC_FULL) };
-  // Send to sql database and return if succeeded
-  if(cSql->ExecuteAndSuccess(StrFormat(
-         "INSERT or REPLACE into `$`(`$`,`$`,`$`,`$`) VALUES(?,?,?,?)",
-         cSql->strvLCTable, cSql->strvLCCRCColumn, cSql->strvLCTimeColumn,
-         cSql->strvLCRefColumn, cSql->strvLCCodeColumn),
-       uiCRC, cmSys.GetTimeNS<sqlite3_int64>(), strRef, mbData))
-    return LCR_RECOMPILE;
+  // Send to sql database
+  const bool bStored = cSql->ExecuteAndSuccess(StrFormat(
+      "INSERT or REPLACE into `$`(`$`,`$`,`$`,`$`) VALUES(?,?,?,?)",
+      cSql->strvLCTable, cSql->strvLCCRCColumn, cSql->strvLCTimeColumn,
+      cSql->strvLCRefColumn, cSql->strvLCCodeColumn),
+    uiCRC, cmSys.GetTimeNS<sqlite3_int64>(), strRef, mbData);
+  // Add it to the bundle and return if the database stored it
+  cLuaCodeBundle->Add(strRef, uiCRC, StdMove(mbData), ccFallback.CCDeltaNS());
+  if(bStored) return LCR_RECOMPILE;
   // Show error
   cLog->LogWarningExSafe(
     "LuaCode failed to store cache for '$' because $ ($)!",
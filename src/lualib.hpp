@@ -134,7 +134,7 @@ const LuaLibStaticArray llsaAPI{
   LLSXX(Audio,    CFL_AUDIO),          LLSMX(Bin,     CFL_NONE),
   LLSMX(Clip,     CFL_VIDEO),          LLSXC(Core,    CFL_NONE),
   LLSXC(Credit,   CFL_NONE),           LLSMX(Command, CFL_NONE),
-  LLSXX(Crypt,    CFL_NONE),           LLSXC(Display, CFL_VIDEO),
+  LLSXC(Crypt,    CFL_NONE),           LLSXC(Display, CFL_VIDEO),
   LLSMC(Fbo,      CFL_VIDEO),          LLSMC(File,    CFL_NONE),
   LLSMC(Font,     CFL_VIDEO),          LLSMX(Ftf,     CFL_NONE),
   LLSMC(Image,    CFL_NONE),           LLSXX(Info,    CFL_NONE),
@@ -177,7 +177,7 @@ imcveOther{{                           // Misc flags
   IDMAPSTR(MTRIM),                     IDMAPSTR(OSAVEFORCE),
   IDMAPSTR(LOCKED),                    IDMAPSTR(COMMIT),
   IDMAPSTR(PURGE),                     IDMAPSTR(CONFIDENTIAL),
-  IDMAPSTR(LOADED),
+  IDMAPSTR(LOADED),                    IDMAPSTR(DIRTY),
 }, "NONE" }
 );/* -- Return human readable string about CVar ---------------------------- */
 static const string VariablesMakeInformation(const CVarItem &cviVar)
@@ -18,6 +18,22 @@ using namespace ISysUtil::P;           using namespace ITexDef::P;
 using namespace IUtil::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
+/* == Mask occupancy pyramid ============================================== */
+struct MaskLevel                       // One level of the pyramid
+{ /* -- Variables ---------------------------------------------------------- */
+  size_t           stWidth, stHeight;  // Cells across and down in level
+  vector<unsigned char> vCells;        // Occupancy flags of each cell
+};/* ----------------------------------------------------------------------- */
+typedef vector<MaskLevel>   MaskPyramid;  // Levels of one mask slot
+typedef vector<MaskPyramid> MaskPyramids; // Pyramids of every mask slot
+/* == One entry in a list of overlap tests ================================= */
+struct MaskTest                        // Members initially public
+{ /* -- Variables ---------------------------------------------------------- */
+  size_t           stId;               // Destination sub-mask id
+  int              iX, iY;             // Destination position
+  bool             bHit;               // Set if overlapping source mask
+};/* ----------------------------------------------------------------------- */
+typedef vector<MaskTest> MaskTests;    // List of overlap tests
 /* == Mask collector and member class ====================================== */
 CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
   /* -- Base classes ------------------------------------------------------- */
@@ -25,8 +41,159 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
   public Lockable,                     // Lua garbage collector instruction
   public Ident,                        // Name of mask object
   public Dimensions<int>               // Size of mask image
-{ /* -- Variables ---------------------------------------------------------- */
+{ /* -- Private typedefs --------------------------------------------------- */
+  enum CellFlags : unsigned char       // Occupancy flags of a pyramid cell
+  { CF_ANY = 0x1,                      // Cell has at least one bit set
+    CF_ALL = 0x2                       // Cell has every bit set
+  };/* -- Variables -------------------------------------------------------- */
   size_t           stAlloc;            // Size of all mask bitmaps in array
+  MaskPyramids     mpSlots;            // Occupancy pyramid for each slot
+  /* -- Pyramid constants -------------------------------------------------- */
+  static constexpr size_t stCellShift = 3; // Level zero cells are 8x8 pixels
+  static constexpr int iPyramidMin = 64;   // Smaller masks have no pyramid
+  static constexpr size_t stParallelMin = 256; // Tests before using threads
+  /* -- Recalculate pyramid cells covering the specified area -------------- */
+  void PyramidUpdate(const size_t stId, const int iX1, const int iY1,
+    const int iX2, const int iY2)
+  { // Ignore if this slot has no pyramid
+    MaskPyramid &mpSlot = mpSlots[stId];
+    if(mpSlot.empty()) return;
+    // Clamp the area to the mask and ignore if empty
+    const int iXC1 = UtilClamp(iX1, 0, DimGetWidth()),
+              iYC1 = UtilClamp(iY1, 0, DimGetHeight()),
+              iXC2 = UtilClamp(iX2, 0, DimGetWidth()),
+              iYC2 = UtilClamp(iY2, 0, DimGetHeight());
+    if(iXC2 <= iXC1 || iYC2 <= iYC1) return;
+    // Get bitmask surface and dimensions
+    const MemConst &mcSlot = (*this)[stId];
+    const unsigned char*const cpD = mcSlot.MemPtr<unsigned char>();
+    const size_t stBytes = mcSlot.MemSize(),
+                 stWidth = DimGetWidth<size_t>(),
+                 stHeight = DimGetHeight<size_t>();
+    // Get inclusive range of level zero cells the area touches
+    size_t stCX1 = static_cast<size_t>(iXC1) >> stCellShift,
+           stCY1 = static_cast<size_t>(iYC1) >> stCellShift,
+           stCX2 = static_cast<size_t>(iXC2 - 1) >> stCellShift,
+           stCY2 = static_cast<size_t>(iYC2 - 1) >> stCellShift;
+    // Rescan each level zero cell from the bitmask
+    MaskLevel &mlZero = mpSlot.front();
+    for(size_t stCY = stCY1; stCY <= stCY2; ++stCY)
+      for(size_t stCX = stCX1; stCX <= stCX2; ++stCX)
+      { // Calculate pixel position and size of cell clamped to the mask
+        const size_t stPX = stCX << stCellShift, stPY = stCY << stCellShift,
+          stBits = UtilMinimum(stWidth - stPX, size_t{1} << stCellShift),
+          stRows = UtilMinimum(stHeight - stPY, size_t{1} << stCellShift);
+        const uint64_t uqFull = (UINT64_C(1) << stBits) - 1;
+        // Test every row of the cell
+        unsigned char ucAny = 0, ucAll = CF_ALL;
+        for(size_t stRow = 0; stRow < stRows; ++stRow)
+        { // Get the row of bits in this cell and update flags
+          const uint64_t uqRow = UtilBitGetWord(cpD, stBytes,
+            (stPY + stRow) * stWidth + stPX, stBits);
+          if(uqRow) ucAny = CF_ANY;
+          if(uqRow != uqFull) ucAll = 0;
+        } // Store flags for cell
+        mlZero.vCells[stCY * mlZero.stWidth + stCX] =
+          static_cast<unsigned char>(ucAny | ucAll);
+      }
+    // Combine each 2x2 block of cells into the level above
+    for(size_t stLevel = 1; stLevel < mpSlot.size(); ++stLevel)
+    { // Get levels and the range of cells in this level
+      const MaskLevel &mlBelow = mpSlot[stLevel - 1];
+      MaskLevel &mlLevel = mpSlot[stLevel];
+      stCX1 >>= 1; stCY1 >>= 1; stCX2 >>= 1; stCY2 >>= 1;
+      // Enumerate cells to update
+      for(size_t stCY = stCY1; stCY <= stCY2; ++stCY)
+        for(size_t stCX = stCX1; stCX <= stCX2; ++stCX)
+        { // Combine flags of up to four cells below
+          unsigned char ucAny = 0, ucAll = CF_ALL;
+          for(size_t stBY = stCY * 2; stBY < stCY * 2 + 2; ++stBY)
+            for(size_t stBX = stCX * 2; stBX < stCX * 2 + 2; ++stBX)
+            { // Ignore cells past the edge of the mask
+              if(stBX >= mlBelow.stWidth || stBY >= mlBelow.stHeight)
+                continue;
+              // Any cell with bits and all cells full
+              const unsigned char ucCell =
+                mlBelow.vCells[stBY * mlBelow.stWidth + stBX];
+              ucAny |= ucCell & CF_ANY;
+              ucAll &= ucCell;
+            } // Store flags for cell
+          mlLevel.vCells[stCY * mlLevel.stWidth + stCX] =
+            static_cast<unsigned char>(ucAny | ucAll);
+        }
+    }
+  }
+  /* -- Build pyramid for specified slot ----------------------------------- */
+  void PyramidBuild(const size_t stId)
+  { // Make sure there is a pyramid entry for every slot
+    if(mpSlots.size() < size()) mpSlots.resize(size());
+    // Small masks do not benefit from a pyramid so do not build one
+    MaskPyramid &mpSlot = mpSlots[stId];
+    mpSlot.clear();
+    if(DimGetWidth() <= iPyramidMin && DimGetHeight() <= iPyramidMin) return;
+    // Add levels, halving the cells each time, until there is one cell
+    size_t stCW = (DimGetWidth<size_t>() + 7) >> stCellShift,
+           stCH = (DimGetHeight<size_t>() + 7) >> stCellShift;
+    for(;;)
+    { // Add the level with all cells empty and stop if it is the last one
+      mpSlot.push_back({ stCW, stCH, vector<unsigned char>(stCW * stCH) });
+      if(stCW == 1 && stCH == 1) break;
+      // Next level is half the size
+      stCW = (stCW + 1) >> 1;
+      stCH = (stCH + 1) >> 1;
+    } // Scan the whole mask
+    PyramidUpdate(stId, 0, 0, DimGetWidth(), DimGetHeight());
+  }
+  /* -- Check if a pyramid cell might have bits in the specified area ------ */
+  bool PyramidProbe(const MaskPyramid &mpSlot, const size_t stLevel,
+    const size_t stCX, const size_t stCY, const int iX1, const int iY1,
+    const int iX2, const int iY2) const
+  { // Ignore if cell is past the edge of the mask
+    const MaskLevel &mlLevel = mpSlot[stLevel];
+    if(stCX >= mlLevel.stWidth || stCY >= mlLevel.stHeight) return false;
+    // Calculate area of cell clamped to the mask
+    const int iShift = static_cast<int>(stLevel + stCellShift),
+              iCX1 = static_cast<int>(stCX) << iShift,
+              iCY1 = static_cast<int>(stCY) << iShift,
+              iCX2 = UtilMinimum(iCX1 + (1 << iShift), DimGetWidth()),
+              iCY2 = UtilMinimum(iCY1 + (1 << iShift), DimGetHeight());
+    // Cell is not in the area?
+    if(iCX2 <= iX1 || iCX1 >= iX2 || iCY2 <= iY1 || iCY1 >= iY2)
+      return false;
+    // Cell is empty? Nothing to find here
+    const unsigned char ucCell = mlLevel.vCells[stCY * mlLevel.stWidth + stCX];
+    if(!(ucCell & CF_ANY)) return false;
+    // Cell is full or it is entirely inside the area? Bits are there
+    if(ucCell & CF_ALL ||
+      (iCX1 >= iX1 && iCX2 <= iX2 && iCY1 >= iY1 && iCY2 <= iY2))
+        return true;
+    // Bottom level and only partly covered? Caller must test the bits
+    if(!stLevel) return true;
+    // Check each of the four cells below
+    const size_t stBX = stCX * 2, stBY = stCY * 2, stBelow = stLevel - 1;
+    return PyramidProbe(mpSlot, stBelow, stBX, stBY, iX1, iY1, iX2, iY2) ||
+      PyramidProbe(mpSlot, stBelow, stBX + 1, stBY, iX1, iY1, iX2, iY2) ||
+      PyramidProbe(mpSlot, stBelow, stBX, stBY + 1, iX1, iY1, iX2, iY2) ||
+      PyramidProbe(mpSlot, stBelow, stBX + 1, stBY + 1, iX1, iY1, iX2, iY2);
+  }
+  /* -- Slot has a pyramid? ------------------------------------------------ */
+  bool PyramidHas(const size_t stId) const
+    { return stId < mpSlots.size() && !mpSlots[stId].empty(); }
+  /* -- Might have bits in area? (false means definitely empty) ------------ */
+  bool PyramidAny(const size_t stId, const int iX1, const int iY1,
+    const int iX2, const int iY2) const
+  { // No pyramid so we can't tell
+    if(!PyramidHas(stId)) return true;
+    // Clamp area to the mask and if empty then there is nothing there
+    const int iXC1 = UtilMaximum(iX1, 0), iYC1 = UtilMaximum(iY1, 0),
+              iXC2 = UtilMinimum(iX2, DimGetWidth()),
+              iYC2 = UtilMinimum(iY2, DimGetHeight());
+    if(iXC2 <= iXC1 || iYC2 <= iYC1) return false;
+    // Walk down from the top level
+    const MaskPyramid &mpSlot = mpSlots[stId];
+    return PyramidProbe(mpSlot, mpSlot.size() - 1, 0, 0,
+      iXC1, iYC1, iXC2, iYC2);
+  }
   /* -- Two masks overlap? ----------------------------------------- */ public:
   bool IsCollide(const size_t stSourceId, const int iSrcX, const int iSrcY,
     const Mask &mCdest, const size_t stDestId, const int iDestX,
@@ -44,23 +211,71 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
     // Bail if out of bounds
     if(iXMax <= iXMin || iYMax <= iYMin) return false;
     // Get bitmask surfaces for both masks
-    const unsigned char*const cpS = at(stSourceId).MemPtr<unsigned char>(),
-                       *const cpD = mCdest[stDestId].MemPtr<unsigned char>();
-    // Walk through the pixels of the intersection and check the bits and
-    // return if we found a match, else try next pixel
-    for(int iY = iYMin; iY < iYMax; ++iY)
-    { // Pre-calculate source and destination Y
-      const int iSrcYPos = (iY - iSrcY) * DimGetWidth(),
-                iDestYPos = (iY - iDestY) * mCdest.DimGetWidth();
-      // Enumerate X-axis
-      for(int iX = iXMin; iX < iXMax; ++iX)
-        if(UtilBitTest(cpS, iSrcYPos + (iX - iSrcX)) &&
-           UtilBitTest(cpD, iDestYPos + (iX - iDestX)))
-          return true;
+    const MemConst &mcS = at(stSourceId), &mcD = mCdest[stDestId];
+    const unsigned char*const cpS = mcS.MemPtr<unsigned char>(),
+                       *const cpD = mcD.MemPtr<unsigned char>();
+    const size_t stSBytes = mcS.MemSize(), stDBytes = mcD.MemSize(),
+                 stWidth = static_cast<size_t>(iXMax - iXMin);
+    // Use occupancy pyramids if either mask has one and bail early if either
+    // mask has nothing at all in the intersection.
+    const bool bPyramid =
+      PyramidHas(stSourceId) || mCdest.PyramidHas(stDestId);
+    if(bPyramid &&
+      (!PyramidAny(stSourceId, iXMin - iSrcX, iYMin - iSrcY,
+                               iXMax - iSrcX, iYMax - iSrcY) ||
+       !mCdest.PyramidAny(stDestId, iXMin - iDestX, iYMin - iDestY,
+                                    iXMax - iDestX, iYMax - iDestY)))
+      return false;
+    // Walk through the rows of the intersection in bands aligned to the
+    // source pyramid cells
+    for(int iY = iYMin; iY < iYMax;)
+    { // Calculate end of this band
+      const int iYEnd = UtilMinimum(iY + 8 - ((iY - iSrcY) & 7), iYMax);
+      // Skip the band if either mask is empty there
+      if(bPyramid &&
+        (!PyramidAny(stSourceId, iXMin - iSrcX, iY - iSrcY,
+                                 iXMax - iSrcX, iYEnd - iSrcY) ||
+         !mCdest.PyramidAny(stDestId, iXMin - iDestX, iY - iDestY,
+                                      iXMax - iDestX, iYEnd - iDestY)))
+        { iY = iYEnd; continue; }
+      // Test up to 64 pixels at a time. Return as soon as any word from both
+      // masks shares a bit.
+      for(; iY < iYEnd; ++iY)
+      { // Pre-calculate source and destination bit positions
+        const size_t
+          stSrcPos = static_cast<size_t>((iY - iSrcY) * DimGetWidth() +
+            (iXMin - iSrcX)),
+          stDestPos = static_cast<size_t>((iY - iDestY) *
+            mCdest.DimGetWidth() + (iXMin - iDestX));
+        // Enumerate X-axis in words
+        for(size_t stX = 0; stX < stWidth; stX += 64)
+        { // Number of bits to test in this word
+          const size_t stBits = stWidth - stX < 64 ? stWidth - stX : 64;
+          if(UtilBitGetWord(cpS, stSBytes, stSrcPos + stX, stBits) &
+             UtilBitGetWord(cpD, stDBytes, stDestPos + stX, stBits))
+            return true;
+        }
+      }
     }
     // No collision
     return false;
   }
+  /* -- Many masks overlap? ------------------------------------------------ */
+  size_t IsCollideList(const size_t stSourceId, const int iSrcX,
+    const int iSrcY, const Mask &mCdest, MaskTests &mtList) const
+  { // Function to test one entry
+    const auto fcbTest = [&](MaskTest &mtItem)
+      { mtItem.bHit = IsCollide(stSourceId, iSrcX, iSrcY, mCdest,
+          mtItem.stId, mtItem.iX, mtItem.iY); };
+    // Spread tests across threads if there are enough to be worth it
+    if(mtList.size() >= stParallelMin)
+      StdForEach(par, mtList.begin(), mtList.end(), fcbTest);
+    else StdForEach(seq, mtList.begin(), mtList.end(), fcbTest);
+    // Count and return the hits
+    size_t stHits = 0;
+    for(const MaskTest &mtItem : mtList) if(mtItem.bHit) ++stHits;
+    return stHits;
+  }
   /* -- Two masks overlap with raycasting? --------------------------------- */
   bool Raycast(const size_t stSourceId, const int iSrcX, const int iSrcY,
     const Mask &mCdest, const size_t stDestId, const int iFromX,
@@ -75,14 +290,42 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
     // Make further calculations
     iDX *= 2;
     iDY *= 2;
+    // Move one step along the line
+    const auto Step = [&](void)
+    { // Check for errors
+      if(iError > 0) { iLX = iX; iX += iXinc; iError -= iDY; }
+      else           { iLY = iY; iY += iYinc; iError += iDX; }
+    };
+    // Steps to try skipping at once when the source mask has a pyramid
+    int iSkip = PyramidHas(stSourceId) ? 64 : 0;
     // Iterations
-    for(;iN > 0; --iN)
-    { // Check collision and return if found? Set last good position
+    while(iN > 0)
+    { // Try to skip a run of steps if the source mask is empty everywhere
+      // the destination mask would be during the run.
+      if(iSkip > 1)
+      { // Calculate position at the end of the run
+        const int iRun = UtilMinimum(iSkip, iN),
+                  iEX = iX + iXinc * (iRun - 1),
+                  iEY = iY + iYinc * (iRun - 1);
+        // Nothing in the way? Take all the steps and try a longer run
+        if(!PyramidAny(stSourceId,
+          UtilMinimum(iX, iEX) - iSrcX, UtilMinimum(iY, iEY) - iSrcY,
+          UtilMaximum(iX, iEX) + mCdest.DimGetWidth() - iSrcX,
+          UtilMaximum(iY, iEY) + mCdest.DimGetHeight() - iSrcY))
+        { // Take the steps without testing
+          for(int iStep = 0; iStep < iRun; ++iStep) Step();
+          iN -= iRun;
+          if(iSkip < 4096) iSkip *= 2;
+          continue;
+        } // Something is in the way so try a shorter run next time
+        iSkip /= 2;
+      } // Check collision and return if found? Set last good position
       if(IsCollide(stSourceId, iSrcX, iSrcY, mCdest, stDestId, iX, iY))
         { iToX = iLX; iToY = iLY; return true; }
-      // Check for errors
-      else if(iError > 0) { iLX = iX; iX += iXinc; iError -= iDY; }
-      else                { iLY = iY; iY += iYinc; iError += iDX; }
+      // Next step and try skipping again later
+      Step();
+      --iN;
+      if(iSkip) ++iSkip;
     }
     // No collision
     return false;
@@ -116,7 +359,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
         UtilBitClear(cpD, iDestPos);
         UtilBitSet2(cpD, iDestPos, cpS, iSrcYPos + (iX - iDestX));
       }
-    }
+    } // Update occupancy of changed area
+    PyramidUpdate(stDestId, iXMin, iYMin, iXMax, iYMax);
   }
   /* -- Merge specified mask into this one --------------------------------- */
   void Merge(const Mask &mCsrc, const size_t stSourceId,
@@ -142,7 +386,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       // Enumerate X-axis and merge the specified bits
       for(int iX = iXMin; iX < iXMax; ++iX)
         UtilBitSet2(cpD, iDestYPos + iX, cpS, iSrcYPos + (iX - iDestX));
-    }
+    } // Update occupancy of changed area
+    PyramidUpdate(0, iXMin, iYMin, iXMax, iYMax);
   }
   /* -- Erase specified mask into this one --------------------------------- */
   void Erase(const size_t stDestId)
@@ -157,7 +402,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       // Enumerate X-axis positions and clear the bits
       for(int iX = 0; iX < DimGetWidth(); ++iX)
         UtilBitClear(cpD, iDestYPos + iX);
-    }
+    } // Update occupancy of whole mask
+    PyramidUpdate(stDestId, 0, 0, DimGetWidth(), DimGetHeight());
   }
   /* -- Fill specified mask ------------------------------------------------ */
   void Fill(const int iDX, const int iDY, const int iW, const int iH)
@@ -178,7 +424,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       // Enumerate X-axis positions and fill the bits
       for(int iX = iXMin; iX < iXMax; ++iX)
         UtilBitSet(cpD, iDestYPos + iX);
-    }
+    } // Update occupancy of changed area
+    PyramidUpdate(0, iXMin, iYMin, iXMax, iYMax);
   }
   /* -- Clear specified mask ----------------------------------------------- */
   void Clear(const int iDX, const int iDY, const int iW, const int iH)
@@ -187,7 +434,7 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       iXMax2 = iDX + iW,               iYMax2 = iDY + iH,
       iXMin  = UtilMaximum(iDX, 0),    iYMin  = UtilMaximum(iDY, 0),
       iXMax  = UtilMinimum(DimGetWidth(), iXMax2),
-      iYMax  = UtilMaximum(DimGetHeight(), iYMax2);
+      iYMax  = UtilMinimum(DimGetHeight(), iYMax2);
     // Bail if out of bounds
     if(iXMax <= iXMin || iYMax <= iYMin) return;
     // Get bitmask surfaces for both masks
@@ -199,7 +446,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       // Enumerate X-axis positions and fill the bits
       for(int iX = iXMin; iX < iXMax; ++iX)
         UtilBitClear(cpD, iDestYPos + iX);
-    }
+    } // Update occupancy of changed area
+    PyramidUpdate(0, iXMin, iYMin, iXMax, iYMax);
   }
   /* -- Init --------------------------------------------------------------- */
   void InitBlank(const string &strName, const unsigned int uiWidth,
@@ -225,6 +473,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
     InitBlank(strName, uiWidth, uiHeight);
     // Now fill it with 1's
     back().MemFill<uint64_t>(0xFFFFFFFFFFFFFFFF);
+    // Build occupancy pyramid
+    PyramidBuild(size() - 1);
   }
   /* -- Init cleared mask -------------------------------------------------- */
   void InitZero(const string &strName, const unsigned int uiWidth,
@@ -233,6 +483,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
     InitBlank(strName, uiWidth, uiHeight);
     // Now fill it with zero's
     back().MemFill();
+    // Build occupancy pyramid
+    PyramidBuild(size() - 1);
   }
   /* -- Dump a tile to disk ------------------------------------------------ */
   void Dump(const size_t stId, const string &strFile) const
@@ -299,7 +551,11 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
     if(bData.DimGetWidth() == uiTileWidth &&
        bData.DimGetHeight() == uiTileHeight)
     { // We can just add the full size texture.
+      stAlloc = bData.MemSize();
       emplace_back(StdMove(bData));
+      // Set new size and build occupancy pyramid
+      DimSet(static_cast<int>(uiTileWidth), static_cast<int>(uiTileHeight));
+      PyramidBuild(0);
       return;
     } // We're dealing with memory now so we need everything as size_t
     const size_t
@@ -379,6 +635,8 @@ CTOR_BEGIN_DUO(Masks, Mask, CLHelperUnsafe, ICHelperUnsafe),
       imC.IsReversed() ? "reversed" : "non-reversed");
     // Set new size and tile size
     DimSet(static_cast<int>(stTWidth), static_cast<int>(stTHeight));
+    // Build occupancy pyramid for each tile
+    for(size_t stId = 0; stId < size(); ++stId) PyramidBuild(stId);
   }
   /* -- Get size of all masks ---------------------------------------------- */
   size_t GetAlloc(void) const { return stAlloc; }
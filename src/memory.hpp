@@ -140,6 +140,61 @@ class MemConst                         // Start of const MemBase Block Class
     { static_assert(is_integral_v<Type>, "Wrong type!");
       static_assert(sizeof(Type) > 1, "Wrong size!");
       return UtilToBigEndian(MemReadInt<Type>(stPos)); }
+  /* -- Check a range of elements of the specified size -------------------- */
+  void MemCheckRange(const size_t stPos, const size_t stCount,
+    const size_t stSize) const
+  { // Bail if the range does not fit. Written so it can't overflow.
+    if(stPos > MemSize() || (stSize && stCount > (MemSize() - stPos) / stSize))
+      MemErrorRead("Range error!", stPos, stCount * stSize);
+  }
+  /* -- Sum a range of elements -------------------------------------------- */
+  template<typename Type, bool bSwap=false,
+    typename SumType=conditional_t<is_floating_point_v<Type>,
+      double, uint64_t>>
+  SumType MemSumEx(const size_t stPos, const size_t stCount) const
+  { // Check the range
+    MemCheckRange(stPos, stCount, sizeof(Type));
+    // Add up all the elements. Integers use unsigned wraparound.
+    const char*const cpSrc = MemDoRead(stPos);
+    SumType tTotal = 0;
+    for(size_t stIndex = 0; stIndex < stCount; ++stIndex)
+      tTotal += static_cast<SumType>(
+        UtilReadElement<Type, bSwap>(cpSrc + stIndex * sizeof(Type)));
+    // Return total
+    return tTotal;
+  }
+  /* -- Return the lowest element in a range ------------------------------- */
+  template<typename Type, bool bSwap=false>
+    Type MemMinEx(const size_t stPos, const size_t stCount) const
+  { // Check the range and that there is something to compare
+    MemCheckRange(stPos, stCount, sizeof(Type));
+    if(!stCount) MemErrorRead("Empty range!", stPos, 0);
+    // Find the lowest element
+    const char*const cpSrc = MemDoRead(stPos);
+    Type tMin = UtilReadElement<Type, bSwap>(cpSrc);
+    for(size_t stIndex = 1; stIndex < stCount; ++stIndex)
+    { const Type tV =
+        UtilReadElement<Type, bSwap>(cpSrc + stIndex * sizeof(Type));
+      tMin = tV < tMin ? tV : tMin; }
+    // Return lowest element
+    return tMin;
+  }
+  /* -- Return the highest element in a range ------------------------------ */
+  template<typename Type, bool bSwap=false>
+    Type MemMaxEx(const size_t stPos, const size_t stCount) const
+  { // Check the range and that there is something to compare
+    MemCheckRange(stPos, stCount, sizeof(Type));
+    if(!stCount) MemErrorRead("Empty range!", stPos, 0);
+    // Find the highest element
+    const char*const cpSrc = MemDoRead(stPos);
+    Type tMax = UtilReadElement<Type, bSwap>(cpSrc);
+    for(size_t stIndex = 1; stIndex < stCount; ++stIndex)
+    { const Type tV =
+        UtilReadElement<Type, bSwap>(cpSrc + stIndex * sizeof(Type));
+      tMax = tV > tMax ? tV : tMax; }
+    // Return highest element
+    return tMax;
+  }
   /* -- Test a bit --------------------------------------------------------- */
   bool MemBitTest(const size_t stPos) const
   { // Throw error if invalid position
@@ -333,6 +388,43 @@ class MemBase :
     // Do the invert
     *reinterpret_cast<Type*const>(MemDoRead(stPos)) ^= tFlags;
   }
+  /* -- Add a value to every element in a range ---------------------------- */
+  template<typename Type, bool bSwap=false>void MemAddEx(const size_t stPos,
+    const size_t stCount, const Type tValue)
+  { // Check the range
+    MemCheckRange(stPos, stCount, sizeof(Type));
+    // Add to each element. Integers use unsigned wraparound.
+    char*const cpDst = MemDoRead(stPos);
+    for(size_t stIndex = 0; stIndex < stCount; ++stIndex)
+    { char*const cpElem = cpDst + stIndex * sizeof(Type);
+      const Type tV = UtilReadElement<Type, bSwap>(cpElem);
+      if constexpr(is_floating_point_v<Type>)
+        UtilWriteElement<Type, bSwap>(cpElem, tV + tValue);
+      else UtilWriteElement<Type, bSwap>(cpElem, static_cast<Type>(
+        static_cast<make_unsigned_t<Type>>(tV) +
+        static_cast<make_unsigned_t<Type>>(tValue))); }
+  }
+  /* -- Multiply every element in a range ---------------------------------- */
+  template<typename Type, bool bSwap=false>void MemScaleEx(const size_t stPos,
+    const size_t stCount, const double dScale)
+  { // Check the range
+    MemCheckRange(stPos, stCount, sizeof(Type));
+    // Scale each element. Integers are clamped to their range.
+    char*const cpDst = MemDoRead(stPos);
+    for(size_t stIndex = 0; stIndex < stCount; ++stIndex)
+    { char*const cpElem = cpDst + stIndex * sizeof(Type);
+      const Type tV = UtilReadElement<Type, bSwap>(cpElem);
+      if constexpr(is_floating_point_v<Type>)
+        UtilWriteElement<Type, bSwap>(cpElem,
+          static_cast<Type>(tV * static_cast<Type>(dScale)));
+      else
+      { const double dV = static_cast<double>(tV) * dScale;
+        UtilWriteElement<Type, bSwap>(cpElem,
+          !(dV > static_cast<double>(numeric_limits<Type>::lowest())) ?
+            numeric_limits<Type>::lowest() :
+          dV >= static_cast<double>(numeric_limits<Type>::max()) ?
+            numeric_limits<Type>::max() : static_cast<Type>(dV)); } }
+  }
   /* -- Assignment constructor (rvalue) ------------------------------------ */
   MemBase(MemBase &&mbOther) :
     /* -- Initialisers ----------------------------------------------------- */
@@ -30,6 +30,7 @@ namespace E {                          // Start of engine namespace
 #include "ident.hpp"                   // Identifier utility header
 #include "dir.hpp"                     // Directory handling utility header
 #include "util.hpp"                    // Miscellenious utilities header
+#include "lines.hpp"                   // Ring of text lines header
 #include "sysutil.hpp"                 // System utilities header
 #include "cvardef.hpp"                 // CVar definitions header
 #include "clock.hpp"                   // Clock utilities header
@@ -41,7 +42,9 @@ namespace E {                          // Start of engine namespace
 #include "log.hpp"                     // Logging helper class header
 #include "collect.hpp"                 // Class collector utility header
 #include "stat.hpp"                    // Statistic utility class header
+#include "profile.hpp"                 // Frame profiler class header
 #include "thread.hpp"                  // Thread helper class header
+#include "job.hpp"                     // Job pool class header
 #include "evtcore.hpp"                 // Thread-safe event system core header
 #include "evtmain.hpp"                 // Main engine events system header
 #include "glfwutil.hpp"                // GLFW utility class header
@@ -85,6 +88,7 @@ namespace E {                          // Start of engine namespace
 #include "imagedef.hpp"                // Image data definitions header
 #include "imagelib.hpp"                // Image codecs handling header
 #include "imagefmt.hpp"                // Image format support plugins header
+#include "imagedxt.hpp"                // Image DXT compressor header
 #include "bin.hpp"                     // Bin packing class header
 #include "image.hpp"                   // Image load and save handling header
 #include "shader.hpp"                  // OpenGL Shader handling header
@@ -112,6 +116,7 @@ namespace E {                          // Start of engine namespace
 #include "json.hpp"                    // Json handling class header
 #include "luavar.hpp"                  // Lua variable class
 #include "luacmd.hpp"                  // Lua console command class
+#include "bench.hpp"                   // Benchmark recording class header
 #include "core.hpp"                    // Core class header
 #include "lualib.hpp"                  // Lua lua function api library
 /* ------------------------------------------------------------------------- */
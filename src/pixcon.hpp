@@ -622,17 +622,17 @@ class SysCon :                         // All members initially private
   void RedrawTitleBar(const string &strTL, const string &strTR)
     { RedrawStatus(0, strTL, strTR); }
   /* -- Redraw console buffer ---------------------------------------------- */
-  void RedrawBuffer(const ConLines &cL, const ConLinesConstRevIt &lS)
+  void RedrawBuffer(const ConLines &cL, const uint64_t qwPos)
   { // Reset cursor position to top left of drawing area
     SetCursor(0, diSizeM1.DimGetHeight());
     // Set default text colour
     SetColour(15);
     // Draw until we go off the top of the screen
-    for(ConLinesConstRevIt lL{ lS };
-                           lL != cL.rend() && ValidY(CoordGetY());
-                         ++lL)
+    for(uint64_t qwIndex = qwPos;
+                 qwIndex > cL.LinesBegin() && ValidY(CoordGetY());
+               --qwIndex)
     { // Get structure
-      const ConLine &lD = *lL;
+      const ConLine lD{ cL.LinesGet(qwIndex - 1) };
       // Convert RGB colour to Win32 console id colour
       SetColour(lD.cColour);
       // Put text in a utf container and write the data. Note: Although
@@ -640,7 +640,7 @@ class SysCon :                         // All members initially private
       // value we can make sure we don't access any OOB memory by just checking
       // that the co-ordinates while drawing, we don't have to worry about the
       // integer wrapping at all we are not drawing.
-      CoordDecY(WriteLineWU(UtfDecoder{ lD.strLine }) - 1);
+      CoordDecY(WriteLineWU(UtfDecoder{ lD.strvLine }) - 1);
     } // Clear extra lines we didn't draw too
     while(CoordGetY() > 1) { CoordSetX(0); CoordDecY(); ClearLine(); }
   }
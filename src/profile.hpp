@@ -0,0 +1,275 @@
+/* == PROFILE.HPP ========================================================== **
+** ######################################################################### **
+** ## MS-ENGINE              Copyright (c) MS-Design, All Rights Reserved ## **
+** ######################################################################### **
+** ## This module times scoped zones of the main loop and worker threads  ## **
+** ## into a ring buffer per thread. The results can be queried as        ## **
+** ## rolling statistics or saved as a Chrome trace. When disabled a zone ## **
+** ## costs one atomic load.                                              ## **
+** ######################################################################### **
+** ========================================================================= */
+#pragma once                           // Only one incursion allowed
+/* ------------------------------------------------------------------------- */
+namespace IProfile {                   // Start of private namespace
+/* -- Dependencies --------------------------------------------------------- */
+using namespace IClock::P;             using namespace IError::P;
+using namespace IFStream::P;           using namespace ILog::P;
+using namespace IStd::P;               using namespace IString::P;
+using namespace IUtil::P;
+/* ------------------------------------------------------------------------- */
+namespace P {                          // Start of public namespace
+/* -- Zones ---------------------------------------------------------------- */
+enum ProfileZone : size_t              // Keep in order with aZoneNames
+{ /* ----------------------------------------------------------------------- */
+  PZ_EVENTS,                           // Window event manager
+  PZ_CONSOLE,                          // Console rendering
+  PZ_VIDEO,                            // Video rendering
+  PZ_INPUT,                            // Polling window events and joysticks
+  PZ_LUA,                              // Lua main tick
+  PZ_RENDER,                           // Fbo rendering and flushing
+  PZ_JOB,                              // Job pool worker running a job
+  /* ----------------------------------------------------------------------- */
+  PZ_MAX                               // Maximum number of zones
+};/* ----------------------------------------------------------------------- */
+struct ProfileEvent                    // A timed zone
+{ /* ----------------------------------------------------------------------- */
+  ProfileZone      pzZone;             // Zone that was timed
+  uint64_t         qwStart,            // Start time in nanoseconds
+                   qwDuration;         // Duration in nanoseconds
+};/* ----------------------------------------------------------------------- */
+struct ProfileStats                    // Statistics for a zone
+{ /* ----------------------------------------------------------------------- */
+  size_t           stCount;            // Number of times zone was entered
+  double           dTotal,             // Total time spent in zone
+                   dMinimum,           // Shortest time spent in zone
+                   dMaximum;           // Longest time spent in zone
+};/* ----------------------------------------------------------------------- */
+typedef array<ProfileStats, PZ_MAX> ProfileStatsArray; // Stats of each zone
+/* -- Add statistics to another -------------------------------------------- */
+static void ProfileStatsMerge(ProfileStats &psDst, const ProfileStats &psSrc)
+{ // Ignore if nothing to add or just copy it if nothing there yet
+  if(!psSrc.stCount) return;
+  if(!psDst.stCount) { psDst = psSrc; return; }
+  // Add to the totals and update the limits
+  psDst.stCount += psSrc.stCount;
+  psDst.dTotal += psSrc.dTotal;
+  psDst.dMinimum = UtilMinimum(psDst.dMinimum, psSrc.dMinimum);
+  psDst.dMaximum = UtilMaximum(psDst.dMaximum, psSrc.dMaximum);
+}
+/* ------------------------------------------------------------------------- */
+struct ProfileRing                     // Recent zones of one thread
+{ /* ----------------------------------------------------------------------- */
+  mutex            mEvents;            // Events being used
+  string           strName;            // Name of thread
+  array<ProfileEvent, 4096> aEvents;   // Events
+  size_t           stNext,             // Next event to write
+                   stCount;            // Number of events written
+  ProfileStatsArray psaTotals;         // Every event since last cleared
+  /* ----------------------------------------------------------------------- */
+  explicit ProfileRing(const string &strNName) :
+    /* -- Initialisers ----------------------------------------------------- */
+    strName{ strNName },               // Set name of thread
+    stNext(0),                         // Start at first event
+    stCount(0),                        // No events yet
+    psaTotals{}                        // No totals yet
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+};/* ----------------------------------------------------------------------- */
+typedef shared_ptr<ProfileRing> ProfileRingPtr; // Shared with its thread
+/* ------------------------------------------------------------------------- */
+static thread_local string strProfileThread{ "main" }; // Name of this thread
+static void ProfileSetThreadName(const string &strName)
+  { strProfileThread = strName; }
+/* == Profile class ======================================================== */
+static class Profile final             // Members initially private
+{ /* -- Private variables -------------------------------------------------- */
+  SafeBool         sbEnabled;          // Profiling enabled?
+  mutex            mRings;             // Ring list being used
+  list<ProfileRingPtr> lRings;         // A ring for every running thread
+  ProfileStatsArray psaRetired;        // Totals of rings that were reused
+  /* -- Get this threads ring ---------------------------------------------- */
+  ProfileRing &ProfileGetRing(void)
+  { // The thread shares the ring with the list and lets go of it when the
+    // thread exits so nothing here needs to touch this class at that time.
+    static thread_local ProfileRingPtr prpRing;
+    if(prpRing) return *prpRing;
+    const LockGuard lgRings{ mRings };
+    // Reuse the ring of a thread that exited so threads that come and go do
+    // not keep adding rings. Its events are kept until then for exporting.
+    for(const ProfileRingPtr &prpRef : lRings)
+    { if(prpRef.use_count() > 1) continue;
+      const LockGuard lgEvents{ prpRef->mEvents };
+      prpRef->strName = strProfileThread;
+      prpRef->stNext = prpRef->stCount = 0;
+      for(size_t stZone = 0; stZone < PZ_MAX; ++stZone)
+        ProfileStatsMerge(psaRetired[stZone], prpRef->psaTotals[stZone]);
+      prpRef->psaTotals = {};
+      prpRing = prpRef;
+      return *prpRing;
+    } // Else add a new ring
+    prpRing = lRings.emplace_back(ProfileRingPtr{
+      new ProfileRing{ strProfileThread } });
+    return *prpRing;
+  }
+  /* -- Write a string escaped for json ------------------------------------ */
+  static void ProfileJsonString(ostringstream &osDst, const string &strSrc)
+  { osDst << '\"';
+    for(const char cChar : strSrc) switch(cChar)
+    { case '\"': osDst << "\\\""; break;
+      case '\\': osDst << "\\\\"; break;
+      default:
+        if(static_cast<unsigned char>(cChar) >= 0x20) osDst << cChar;
+        else osDst << "\\u" << setw(4) << setfill('0') << hex
+          << static_cast<unsigned int>(cChar) << dec << setfill(' ');
+        break;
+    } osDst << '\"';
+  }
+  /* -- Zone names ------------------------------------------------- */ public:
+  static const char *ProfileGetZoneName(const size_t stZone)
+  { static const array<const char*const, PZ_MAX> aZoneNames{
+      "events", "console", "video", "input", "lua", "render", "job" };
+    return aZoneNames[stZone];
+  }
+  /* -- Is profiling enabled? ---------------------------------------------- */
+  bool ProfileIsEnabled(void) const { return sbEnabled; }
+  /* -- Enable or disable profiling ---------------------------------------- */
+  void ProfileSetEnabled(const bool bState)
+  { // Ignore if not changed
+    if(sbEnabled == bState) return;
+    // Start from nothing when enabling so the results are only recent
+    if(bState) ProfileClear();
+    sbEnabled = bState;
+    cLog->LogDebugExSafe("Profile $.", bState ? "enabled" : "disabled");
+  }
+  /* -- Forget all events -------------------------------------------------- */
+  void ProfileClear(void)
+  { // Free the rings of threads that exited and empty the rest
+    const LockGuard lgRings{ mRings };
+    lRings.remove_if([](const ProfileRingPtr &prpRef)
+      { return prpRef.use_count() <= 1; });
+    for(const ProfileRingPtr &prpRef : lRings)
+    { const LockGuard lgEvents{ prpRef->mEvents };
+      prpRef->stNext = prpRef->stCount = 0;
+      prpRef->psaTotals = {}; }
+    psaRetired = {};
+  }
+  /* -- Record a zone ------------------------------------------------------ */
+  void ProfileAdd(const ProfileZone pzZone, const uint64_t qwStart,
+    const uint64_t qwDuration)
+  { // Only this thread writes to the ring so the lock is never contended
+    ProfileRing &prRef = ProfileGetRing();
+    const LockGuard lgEvents{ prRef.mEvents };
+    prRef.aEvents[prRef.stNext] = { pzZone, qwStart, qwDuration };
+    prRef.stNext = (prRef.stNext + 1) % prRef.aEvents.size();
+    if(prRef.stCount < prRef.aEvents.size()) ++prRef.stCount;
+    // Add it to the totals which are not limited by the size of the ring
+    const double dTime = static_cast<double>(qwDuration) / 1e9;
+    ProfileStatsMerge(prRef.psaTotals[pzZone], { 1, dTime, dTime, dTime });
+  }
+  /* -- Get statistics of the events still in the rings -------------------- */
+  ProfileStatsArray ProfileGetStats(void)
+  { // Start with nothing
+    ProfileStatsArray apsStats{};
+    // For each ring and each event in it
+    const LockGuard lgRings{ mRings };
+    for(const ProfileRingPtr &prpRef : lRings)
+    { const ProfileRing &prRef = *prpRef;
+      const LockGuard lgEvents{ prpRef->mEvents };
+      for(size_t stIndex = 0; stIndex < prRef.stCount; ++stIndex)
+      { // Add it to the zone statistics
+        const ProfileEvent &peRef = prRef.aEvents[stIndex];
+        const double dTime = static_cast<double>(peRef.qwDuration) / 1e9;
+        ProfileStatsMerge(apsStats[peRef.pzZone], { 1, dTime, dTime, dTime });
+      }
+    } // Return statistics
+    return apsStats;
+  }
+  /* -- Get statistics of every event since last cleared ------------------- */
+  ProfileStatsArray ProfileGetTotals(void)
+  { // Start with the rings that were reused
+    const LockGuard lgRings{ mRings };
+    ProfileStatsArray psaTotals{ psaRetired };
+    // Add the totals of each ring
+    for(const ProfileRingPtr &prpRef : lRings)
+    { const LockGuard lgEvents{ prpRef->mEvents };
+      for(size_t stZone = 0; stZone < PZ_MAX; ++stZone)
+        ProfileStatsMerge(psaTotals[stZone], prpRef->psaTotals[stZone]);
+    } // Return totals
+    return psaTotals;
+  }
+  /* -- Save events as a Chrome trace -------------------------------------- */
+  size_t ProfileExport(const string &strFile)
+  { // Write the trace to memory first
+    ostringstream osTrace;
+    osTrace << fixed << setprecision(3) << "{\"traceEvents\":[";
+    size_t stEvents = 0, stThread = 0;
+    { const LockGuard lgRings{ mRings };
+      for(const ProfileRingPtr &prpRef : lRings)
+      { // Name the thread
+        const ProfileRing &prRef = *prpRef;
+        const LockGuard lgEvents{ prpRef->mEvents };
+        osTrace << (stThread ? "," : "")
+          << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+          << ++stThread << ",\"args\":{\"name\":";
+        ProfileJsonString(osTrace, prRef.strName);
+        osTrace << "}}";
+        // Write the events oldest first
+        const size_t stFirst = prRef.stCount < prRef.aEvents.size() ?
+          0 : prRef.stNext;
+        for(size_t stIndex = 0; stIndex < prRef.stCount; ++stIndex)
+        { const ProfileEvent &peRef =
+            prRef.aEvents[(stFirst + stIndex) % prRef.aEvents.size()];
+          osTrace << ",{\"name\":\"" << ProfileGetZoneName(peRef.pzZone)
+            << "\",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+            << stThread << ",\"ts\":"
+            << static_cast<double>(peRef.qwStart) / 1000
+            << ",\"dur\":"
+            << static_cast<double>(peRef.qwDuration) / 1000 << '}';
+        } // Add to total events written
+        stEvents += prRef.stCount;
+      }
+    } osTrace << "]}";
+    // Write it to disk
+    const string strTrace{ osTrace.str() };
+    if(FStream fsTrace{ strFile, FM_W_T })
+    { if(fsTrace.FStreamWriteString(strTrace) != strTrace.size())
+        XCL("Failed to write trace!", "File", strFile);
+    } else XCL("Failed to create trace!", "File", strFile);
+    // Log and return number of events written
+    cLog->LogInfoExSafe("Profile saved $ events to '$'.", stEvents, strFile);
+    return stEvents;
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  Profile(void) :                      // No parameters
+    /* -- Initialisers ----------------------------------------------------- */
+    sbEnabled(false),                  // Disabled by default
+    psaRetired{}                       // No reused rings yet
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(Profile)             // No copy constructor
+  /* ----------------------------------------------------------------------- */
+} *cProfile = nullptr;                 // Global access
+/* -- Time the scope it is declared in ------------------------------------- */
+class ProfileScope                     // Members initially private
+{ /* -- Private variables -------------------------------------------------- */
+  const ProfileZone pzZone;            // Zone being timed
+  const uint64_t   qwStart;            // Start time or zero if disabled
+  /* -- Constructor ------------------------------------------------ */ public:
+  explicit ProfileScope(const ProfileZone pzNZone) :
+    /* -- Initialisers ----------------------------------------------------- */
+    pzZone(pzNZone),                   // Set zone
+    qwStart(cProfile->ProfileIsEnabled() ? cmHiRes.GetTimeNS() : 0)
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+  /* -- Destructor --------------------------------------------------------- */
+  ~ProfileScope(void)
+    { if(qwStart) cProfile->ProfileAdd(pzZone, qwStart,
+        cmHiRes.GetTimeNS() - qwStart); }
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(ProfileScope)        // No copy constructor
+};/* ----------------------------------------------------------------------- */
+}                                      // End of public namespace
+/* ------------------------------------------------------------------------- */
+}                                      // End of private namespace
+/* == EoF =========================================================== EoF == */
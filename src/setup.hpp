@@ -187,6 +187,7 @@
 #include <array>                       // Static arrays
 #include <atomic>                      // Multithreaded integers
 #include <cctype>                      // Character type functions
+#include <charconv>                    // Fast number to string conversion
 #include <clocale>                     // Regional specific functions
 #include <cmath>                       // Perform mathematical functions
 #include <condition_variable>          // Synchronisation conditions
@@ -217,6 +218,28 @@
 #if CHAR_BIT != 8                      // Sanity check bits-per-byte
 # error Target architecture byte size must be eight bits!
 #endif                                 // Sanity checks
+/* -- Vector instructions available to the target -------------------------- */
+#if defined(CISC)                      // Using INTEL or AMD instruction set?
+# if defined(__SSE2__) || defined(_M_AMD64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP == 2)
+#  define SIMD_SSE2                    // SSE2 is available
+#  include <immintrin.h>               // SSE2, SSSE3 and AVX2 intrinsics
+#  if defined(_MSC_VER)                // Using MSVC?
+#   include <intrin.h>                 // For __cpuid() and _xgetbv()
+#  endif                               // MSVC check
+# endif                                // SSE2 check
+#elif defined(RISC)                    // Using ARM instruction set?
+# if defined(__ARM_NEON) || defined(_M_ARM64)
+#  define SIMD_NEON                    // NEON is available
+#  include <arm_neon.h>                // NEON intrinsics
+# endif                                // NEON check
+#endif                                 // Instruction set check
+/* -- Compile a function for extra instructions picked at run-time --------- */
+#if defined(__GNUC__) || defined(__clang__) // Using GCC or Clang?
+# define SIMD_TARGET(x) __attribute__((target(x)))
+#else                                  // Using MSVC?
+# define SIMD_TARGET(x)                // Intrinsics work without /arch
+#endif                                 // Compiler check
 /* -- Useful macros -------------------------------------------------------- */
 #define STR_HELPER(...)  #__VA_ARGS__            // Convert macro integer
 #define STR(...)         STR_HELPER(__VA_ARGS__) // to string
@@ -464,6 +487,7 @@ namespace Lib                          // LIBRARY OF EXTERNAL API FUNCTIONS
 #define RAPIDJSON_HAS_CXX11_NOEXCEPT 1 // Force to use noexcept
 #include <rapidjson/document.h>        // Main header
 #include <rapidjson/prettywriter.h>    // Pretty formatting
+#include <rapidjson/memorystream.h>   // Memory stream for SAX reading
 #include <rapidjson/error/en.h>        // Error handling
 #undef RAPIDJSON_HAS_CXX11_NOEXCEPT    // Done with this define
 #undef RAPIDJSON_ASSERT                // Done with this define
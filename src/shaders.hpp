@@ -22,12 +22,13 @@ static struct ShaderCore final
   Shader          &sh3DYCbCr;          // 3D YCbCr transformation shader
   Shader          &sh3DYCbCrK;         // 3D YCbCr ckey transformation shader
   /* -- 2D shader references ----------------------------------------------- */
-  array<Shader,5> sh2DBuiltIns;        // list of built-in 2D shaders
+  array<Shader,6> sh2DBuiltIns;        // list of built-in 2D shaders
   Shader          &sh2D;               // 2D-3D transformation shader
   Shader          &sh2DBGR;            // 2D BGR-3D transformation shader
   Shader          &sh2D8;              // 2D LUM-3D transformation shader
   Shader          &sh2D8Pal;           // 2D LUMPAL-3D transformation shader
   Shader          &sh2D16;             // 2D LUMAL-3D transformation shader
+  Shader          &sh2DSDF;            // 2D distance field font shader
   /* -------------------------------------------------------------- */ private:
   typedef array<const string,5> RoundList;
   const RoundList rList;               // Rounding method list
@@ -153,6 +154,23 @@ static struct ShaderCore final
     sh2D16.Link();
   }
   /* ----------------------------------------------------------------------- */
+  void Init2DSDFShader(void)
+  { // Add our 2D to 3D transformation shader for distance field fonts. The
+    // green channel holds the distance with 0.5 being the glyph edge. Outline
+    // glyphs share the same distance field and are told apart by having one
+    // added to their horizontal texture co-ordinate, which moves the edge
+    // out to 0.25. The edge is smoothed over about one screen pixel so the
+    // glyphs stay sharp at any scale. Use linear filtering with these fonts.
+    sh2DSDF.LockSet();
+    AddVertexShaderWith2DTemplate(sh2DSDF, "VERT-2D");
+    AddFragmentShaderWithTemplate(sh2DSDF, "FRAG-2D SDF>RGB",
+      "vec2 t = texcoordout.xy; float e = 0.5;"
+      "if(t.x >= 1.0) { t.x -= 1.0; e = 0.25; }"
+      "float d = texture(tex,t).g; float w = fwidth(d) * 0.75;"
+      "p = vec4(c.rgb, c.a * smoothstep(e - w, e + w, d));");
+    sh2DSDF.Link();
+  }
+  /* ----------------------------------------------------------------------- */
   void Init3DYCbCrTemplate(Shader &shDest, const char*const cpName,
     const char*const cpCode)
   { // Add YCbCr to RGB shaders
@@ -224,6 +242,7 @@ static struct ShaderCore final
     Init2D8Shader();
     Init2D8PalShader();
     Init2D16Shader();
+    Init2DSDFShader();
     // Log completion
     cLog->LogInfoExSafe("ShaderCore initialised $ built-in shader objects.",
       sh3DBuiltIns.size() + sh2DBuiltIns.size());
@@ -251,6 +270,7 @@ static struct ShaderCore final
     sh3DYCbCrK{ sh3DBuiltIns[2] },     sh2D{ sh2DBuiltIns[0] },
     sh2DBGR{ sh2DBuiltIns[1] },        sh2D8{ sh2DBuiltIns[2] },
     sh2D8Pal{ sh2DBuiltIns[3] },       sh2D16{ sh2DBuiltIns[4] },
+    sh2DSDF{ sh2DBuiltIns[5] },
     /* -- Rounding list ---------------------------------------------------- */
     rList{{                            // Initialise rounding strings list
       cCommon->Blank(),                // [0] No rounding
@@ -127,13 +127,19 @@ CTOR_MEM_BEGIN_CSLAVE(Sockets, Socket, ICHelperUnsafe),
   /* -- Do internal log ---------------------------------------------------- */
   template<typename ...VarArgs>void SocketLog(const LHLevel lhlSeverity,
     const char*const cpFormat, const VarArgs &...vaArgs)
-  { // If parameters are specified then cater to them
+  { // Return if we don't have this level
+    if(cLog->NotHasLevel(lhlSeverity)) return;
+    // Format the prefix and message into the reused thread local buffer
+    string &strLine = StrFormatBuffer();
+    StrFormatTo(strLine, "Socket $:$$$:$ ", CtrGet(), hex, FlagGet(), dec,
+      GetAddressAndPort());
+    // If parameters are specified then cater to them
     if constexpr(sizeof...(VarArgs) > 0)
-      cLog->LogExSafe(lhlSeverity, "Socket $:$$$:$ $", CtrGet(), hex,
-        FlagGet(), dec, GetAddressAndPort(), StrFormat(cpFormat, vaArgs...));
+      StrFormatVarTo(strLine, cpFormat, vaArgs...);
     // No parameters specified so don't need to format them
-    else cLog->LogExSafe(lhlSeverity, "Socket $:$$$:$ $", CtrGet(), hex,
-      FlagGet(), dec, GetAddressAndPort(), cpFormat);
+    else strLine.append(cpFormat);
+    // Log the line
+    cLog->LogNLCSafe(lhlSeverity, strLine);
   }
   /* -- Internal log ------------------------------------------------------- */
   template<typename ...VarArgs>void SocketLogSafe(const LHLevel lhlSeverity,
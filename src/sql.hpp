@@ -37,7 +37,21 @@ BUILD_FLAGS(Sql,                       // Sql flags classes
   SF_NONE                   {Flag[0]}, SF_ISTEMPDB               {Flag[1]},
   // Delete empty databases?           Debug sql executions?
   SF_DELETEEMPTYDB          {Flag[2]}
-);/* ----------------------------------------------------------------------- */
+);/* -- A cvar staged to be written to the database ------------------------ */
+struct SqlCVarWrite                    // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  string           strVar,             // Name of cvar
+                   strData;            // Value as text or encoded blob
+  int              iType;              // SQLITE_TEXT/BLOB or NULL to purge
+};/* ----------------------------------------------------------------------- */
+typedef vector<SqlCVarWrite> SqlCVarWrites; // List of staged cvars
+/* -- A connection and the cvar statements cached for it ------------------- */
+struct SqlCVarConn                     // Members initially public
+{ /* ----------------------------------------------------------------------- */
+  sqlite3         *sqlDB;              // Connection to write with
+  sqlite3_stmt    *stmtCommit,         // Cached insert or replace statement
+                  *stmtPurge;          // Cached delete statement
+};/* ----------------------------------------------------------------------- */
 class SqlData :                        // Query response data item class
   /* -- Base classes ------------------------------------------------------- */
   public Memory                        // Memory block and type
@@ -109,6 +123,7 @@ static struct Sql final :              // Members initially public
   sqlite3         *sqlDB;              // Pointer to SQL context
   int              iError;             // Last error code
   SqlResult        srKeys;             // Last Execute(Raw) result
+  SqlCVarConn      sccMain;            // Cvar statements of main connection
   unsigned int     uiQueryRetries;     // Times to retry query before failing
   ClkDuration      cdRetry,            // Sleep for this time when retrying
                    cdQuery;            // Last query execution time
@@ -974,35 +989,141 @@ static struct Sql final :              // Members initially public
   /* ----------------------------------------------------------------------- */
   CreateTableResult LuaCacheRebuildTable(void)
     { LuaCacheDropTable(); return LuaCacheCreateTable(); }
-  /* ----------------------------------------------------------------------- */
-  bool CVarCommitData(const string &strVar,
-    const SqlCVarDataFlagsConst &scvdfcFlags, const int iType,
-    const char*const cpData, const size_t stLength)
-  { // Try to write the specified cvar and if failed?
-    if(Execute(StrFormat(
-           "INSERT or REPLACE into `$`(`$`,`$`,`$`) VALUES(?,?,?)",
-           strvCVTable, strCVKeyColumn, strCVFlagsColumn, strCVValueColumn),
-         strVar, scvdfcFlags.FlagGet<int>(),
-         cpData, stLength, iType))
-    { // Log the warning and return failure
-      cLog->LogWarningExSafe("Sql failed to commit CVar '$' (T:$;ST:$;B:$) "
-                             "because $ ($)!",
-        strVar, scvdfcFlags.FlagGet(), iType, stLength, GetErrorStr(),
-        GetError());
+  /* -- Prepare a cvar statement once and keep it for the connection ------- */
+  static bool CVarPrepare(sqlite3*const sqlConn, sqlite3_stmt *&stmtData,
+    const string &strQuery)
+  { // Use the cached statement if it was already prepared
+    if(stmtData) return true;
+    // Prepare it telling sqlite that it will be reused many times
+    if(sqlite3_prepare_v3(sqlConn, strQuery.c_str(),
+      UtilIntOrMax<int>(strQuery.length()), SQLITE_PREPARE_PERSISTENT,
+      &stmtData, nullptr) == SQLITE_OK) return true;
+    // Failed so log it and make sure we try again next time
+    cLog->LogWarningExSafe("Sql failed to prepare '$' because $!",
+      strQuery, sqlite3_errmsg(sqlConn));
+    stmtData = nullptr;
+    return false;
+  }
+  /* -- Run a cached statement and make it ready to be used again ---------- */
+  static int CVarStep(sqlite3_stmt*const stmtData)
+  { // Run the statement then reset it and its bindings
+    const int iCode = sqlite3_step(stmtData);
+    sqlite3_reset(stmtData);
+    sqlite3_clear_bindings(stmtData);
+    return iCode;
+  }
+  /* -- Finalise the cached cvar statements of a connection ---------------- */
+  static void CVarFinalise(SqlCVarConn &sccConn)
+  { // Finalising a null statement is harmless
+    sqlite3_finalize(sccConn.stmtCommit);
+    sccConn.stmtCommit = nullptr;
+    sqlite3_finalize(sccConn.stmtPurge);
+    sccConn.stmtPurge = nullptr;
+  }
+  /* -- Open another connection to the database for writing cvars ---------- */
+  bool CVarConnOpen(SqlCVarConn &sccConn)
+  { // Need a database on disk which another connection can open
+    const char*const cpFile =
+      sqlDB ? sqlite3_db_filename(sqlDB, "main") : nullptr;
+    if(!cpFile || !*cpFile) return false;
+    // Open it without sharing the cache of the main connection
+    if(sqlite3_open_v2(cpFile, &sccConn.sqlDB, SQLITE_OPEN_READWRITE |
+      SQLITE_OPEN_FULLMUTEX | SQLITE_OPEN_PRIVATECACHE, nullptr) != SQLITE_OK)
+    { // Log the error and close the handle which is valid even on failure
+      cLog->LogWarningExSafe("Sql could not open writer for '$' because $!",
+        cpFile, sqlite3_errmsg(sccConn.sqlDB));
+      sqlite3_close(sccConn.sqlDB);
+      sccConn.sqlDB = nullptr;
       return false;
-    } // Report and return success
-    cLog->LogDebugExSafe("Sql commited CVar '$' (T:$;ST:$;B:$).",
-      strVar, scvdfcFlags.FlagGet(), iType, stLength);
+    } // Wait for the main connection to finish instead of failing
+    sqlite3_busy_timeout(sccConn.sqlDB, 5000);
+    // Success
+    cLog->LogDebugExSafe("Sql opened writer for '$'.", cpFile);
     return true;
   }
-  /* ----------------------------------------------------------------------- */
-  bool CVarCommitString(const string &strVar, const string &strVal)
-    { return CVarCommitData(strVar, SD_NONE,
-        SQLITE_TEXT, strVal.data(), strVal.length()); }
-  /* ----------------------------------------------------------------------- */
-  bool CVarCommitBlob(const string &strVar, const MemConst &mcSrc)
-    { return CVarCommitData(strVar, SD_ENCRYPTED,
-        SQLITE_BLOB, mcSrc.MemPtr<char>(), mcSrc.MemSize()); }
+  /* -- Close a connection opened with CVarConnOpen() ---------------------- */
+  static void CVarConnClose(SqlCVarConn &sccConn)
+  { // Ignore if not opened
+    if(!sccConn.sqlDB) return;
+    // Finalise statements and close the connection
+    CVarFinalise(sccConn);
+    sqlite3_close(sccConn.sqlDB);
+    sccConn.sqlDB = nullptr;
+  }
+  /* -- Write staged cvars in one transaction on a connection -------------- */
+  size_t CVarWrite(SqlCVarConn &sccConn, const SqlCVarWrites &scvwList,
+    StrVector &svFailed) const
+  { // Prepare the statements the first time they are needed
+    sqlite3*const sqlConn = sccConn.sqlDB;
+    if(!CVarPrepare(sqlConn, sccConn.stmtCommit, StrFormat(
+         "INSERT or REPLACE into `$`(`$`,`$`,`$`) VALUES(?,?,?)",
+         strvCVTable, strCVKeyColumn, strCVFlagsColumn, strCVValueColumn)) ||
+       !CVarPrepare(sqlConn, sccConn.stmtPurge, StrFormat(
+         "DELETE from `$` WHERE `$`=?", strvCVTable, strCVKeyColumn)))
+    { // Nothing was written so all of them failed
+      for(const SqlCVarWrite &scvwRef : scvwList)
+        svFailed.push_back(scvwRef.strVar);
+      return 0;
+    }
+    // Begin a transaction unless the caller already started one
+    const bool bBegin = sqlite3_get_autocommit(sqlConn) &&
+      sqlite3_exec(sqlConn, "BEGIN TRANSACTION",
+        nullptr, nullptr, nullptr) == SQLITE_OK;
+    // For each cvar staged
+    const size_t stFailed = svFailed.size();
+    size_t stWritten = 0;
+    for(const SqlCVarWrite &scvwRef : scvwList)
+    { // Purging the cvar?
+      const bool bPurge = scvwRef.iType == SQLITE_NULL;
+      sqlite3_stmt*const stmtData =
+        bPurge ? sccConn.stmtPurge : sccConn.stmtCommit;
+      // Bind the name which is always the first parameter
+      sqlite3_bind_text(stmtData, 1, scvwRef.strVar.data(),
+        UtilIntOrMax<int>(scvwRef.strVar.length()), SQLITE_STATIC);
+      // Committing the cvar? Bind flags and value
+      if(!bPurge)
+      { const SqlCVarDataFlagsConst
+          scdfFlags{ scvwRef.iType == SQLITE_BLOB ? SD_ENCRYPTED : SD_NONE };
+        sqlite3_bind_int64(stmtData, 2, scdfFlags.FlagGet<sqlite_int64>());
+        if(scvwRef.iType == SQLITE_BLOB)
+          sqlite3_bind_blob(stmtData, 3, scvwRef.strData.data(),
+            UtilIntOrMax<int>(scvwRef.strData.length()), SQLITE_STATIC);
+        else sqlite3_bind_text(stmtData, 3, scvwRef.strData.data(),
+            UtilIntOrMax<int>(scvwRef.strData.length()), SQLITE_STATIC);
+      } // Run the statement and log if it failed
+      const int iCode = CVarStep(stmtData);
+      if(iCode != SQLITE_DONE)
+      { cLog->LogWarningExSafe("Sql failed to $ CVar '$' because $ ($)!",
+          bPurge ? "purge" : "commit", scvwRef.strVar, sqlite3_errstr(iCode),
+          iCode);
+        svFailed.push_back(scvwRef.strVar);
+        continue;
+      } // Log and count the cvar written
+      cLog->LogDebugExSafe("Sql $ CVar '$' (T:$;B:$).",
+        bPurge ? "purged" : "commited", scvwRef.strVar, scvwRef.iType,
+        scvwRef.strData.length());
+      ++stWritten;
+    } // End the transaction if we started it
+    if(bBegin && sqlite3_exec(sqlConn, "END TRANSACTION",
+         nullptr, nullptr, nullptr) != SQLITE_OK)
+    { // Log the failure and rollback so the connection is usable again
+      cLog->LogWarningExSafe("Sql failed to end CVars transaction because $!",
+        sqlite3_errmsg(sqlConn));
+      sqlite3_exec(sqlConn, "ROLLBACK", nullptr, nullptr, nullptr);
+      // Nothing was written so all of them failed
+      svFailed.resize(stFailed);
+      for(const SqlCVarWrite &scvwRef : scvwList)
+        svFailed.push_back(scvwRef.strVar);
+      return 0;
+    } // Return number of cvars written
+    return stWritten;
+  }
+  /* -- Write staged cvars with the main connection ------------------------ */
+  size_t CVarWrite(const SqlCVarWrites &scvwList, StrVector &svFailed)
+  { // Statements are only cached while the database stays open
+    sccMain.sqlDB = sqlDB;
+    return CVarWrite(sccMain, scvwList, svFailed);
+  }
   /* ----------------------------------------------------------------------- */
   PurgeResult CVarPurgeData(const char*const cpKey, const size_t stKey)
   { // Try to purge the cvar from the database and if it failed?
@@ -1026,7 +1147,8 @@ static struct Sql final :              // Members initially public
     if(!sqlDB) return;
     // Log deinitialisation
     cLog->LogDebugExSafe("Sql database '$' is closing...", IdentGet());
-    // Finalise statements and if we found orphans
+    // Finalise cached statements then any orphans we find
+    CVarFinalise(sccMain);
     if(const size_t stOrphans = Finalise())
       cLog->LogWarningExSafe("Sql finalised $ orphan statements.", stOrphans);
     // Check if database should be deleted, if it should'nt?
@@ -1325,6 +1447,7 @@ static struct Sql final :              // Members initially public
     }},                                // Initialised 'can db be deleted' strs
     sqlDB(nullptr),                    // No sql database handle yet
     iError(sqlite3_initialize()),      // Initialise sqlite and store error
+    sccMain{},                         // No cached cvar statements yet
     uiQueryRetries(3),                 // Initially 3 retries
     cdRetry{milliseconds{1000}},       // Initially wait 1 second per retry
     strMemoryDBName{ ":memory:" },     // Create a memory database by default
@@ -38,12 +38,19 @@ using ::std::ostream_iterator;         using ::std::ostringstream;
 using ::std::put_time;                 using ::std::right;
 using ::std::setfill;                  using ::std::setprecision;
 using ::std::setw;                     using ::std::showpos;
-using ::std::uppercase;
+using ::std::streamsize;               using ::std::uppercase;
+/* -- Number conversion ---------------------------------------------------- */
+using ::std::chars_format;             using ::std::signbit;
+using ::std::to_chars;
 /* -- Constexpr functions -------------------------------------------------- */
 using ::std::is_floating_point_v;      using ::std::is_integral_v;
 using ::std::is_pointer_v;             using ::std::is_signed_v;
 using ::std::is_enum_v;                using ::std::is_same_v;
-using ::std::underlying_type_t;
+using ::std::underlying_type_t;        using ::std::underlying_type;
+using ::std::is_invocable_r_v;         using ::std::conditional_t;
+using ::std::decay_t;                  using ::std::remove_cv_t;
+using ::std::make_unsigned_t;          using ::std::type_identity;
+using ::std::type_identity_t;          using ::std::bool_constant;
 /* -- Namespaces ----------------------------------------------------------- */
 using ::std::placeholders::_1;
 /* -- Times ---------------------------------------------------------------- */
@@ -60,9 +67,9 @@ using ::std::execution::seq;
 /* -- Asynchronisation ----------------------------------------------------- */
 using ::std::atomic;                   using ::std::condition_variable;
 using ::std::lock_guard;               using ::std::mutex;
-using ::std::scoped_lock;              using ::std::thread;
-using ::std::try_to_lock;              using ::std::unique_lock;
-using ::std::unique_ptr;
+using ::std::scoped_lock;              using ::std::shared_ptr;
+using ::std::thread;                   using ::std::try_to_lock;
+using ::std::unique_lock;              using ::std::unique_ptr;
 typedef atomic<bool>       SafeBool;   // Thread safe boolean
 typedef atomic<double>     SafeDouble; // Thread safe double
 typedef atomic<int>        SafeInt;    // Thread safe integer
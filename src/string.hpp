@@ -178,6 +178,234 @@ template<typename ...VarArgs>
   // Return formated text
   return osS.str();
 }
+/* == Allocation free formatting =========================================== **
+** ######################################################################### **
+** ## The following functions produce exactly the same text as StrFormat  ## **
+** ## but append to a caller supplied or thread local string instead of   ## **
+** ## building a new ostringstream and string on every call. Numbers are  ## **
+** ## written with to_chars and manipulators (hex, fixed, setprecision,   ## **
+** ## setw, etc.) are applied to a thread local stream that is only ever  ## **
+** ## used to hold the formatting state.                                  ## **
+** ######################################################################### **
+** ------------------------------------------------------------------------- */
+template<typename ...VarArgs>struct StrFmt final // Compile time format string
+{ /* -- Variables ---------------------------------------------------------- */
+  const char      *cpFmt;              // Format string
+  size_t           stLen;              // Length of format string
+  array<size_t, sizeof...(VarArgs)> aPos; // Position of each '$'
+  /* -- Constructor (only from literals) ----------------------------------- */
+  template<size_t stSize>consteval StrFmt(const char (&caFmt)[stSize]) :
+    /* -- Initialisers ----------------------------------------------------- */
+    cpFmt(caFmt),                      // Set format string
+    stLen(stSize - 1),                 // Set length of format string
+    aPos{}                             // Positions are set below
+    /* -- Record where every placeholder is -------------------------------- */
+  { // Number of placeholders found
+    size_t stFound = 0;
+    // Walk the format string and record each placeholder
+    for(size_t stIndex = 0; stIndex < stLen; ++stIndex)
+      if(caFmt[stIndex] == '$')
+      { // Throwing here is a compile error when there are more placeholders
+        if(stFound >= aPos.size()) throw "Not enough arguments for format!";
+        aPos[stFound++] = stIndex;
+      } // Throwing here is a compile error when there are more arguments
+    if(stFound != aPos.size()) throw "Too many arguments for format!";
+  }
+};/* -- Get thread local formatting state with stream defaults ------------- */
+static ostringstream &StrFmtState(void)
+{ // Each thread gets its own stream to hold formatting state
+  static thread_local ostringstream osState;
+  // Reset state to the defaults of a newly constructed stream
+  osState.clear();
+  osState.flags(ios_base::dec|ios_base::skipws);
+  osState.precision(6);
+  osState.width(0);
+  osState.fill(' ');
+  // Return the state
+  return osState;
+}
+/* -- Append text padded to the current stream width ----------------------- */
+static void StrFmtPad(string &strDst, ostringstream &osState,
+  const char*const cpStr, const size_t stLen)
+{ // Get requested width and reset it as streams do after every output
+  const streamsize ssWidth = osState.width();
+  const size_t stWidth = ssWidth > 0 ? static_cast<size_t>(ssWidth) : 0;
+  osState.width(0);
+  // Padding not needed? Just append the text
+  if(stWidth <= stLen) { strDst.append(cpStr, stLen); return; }
+  // Left aligned? Put text first and padding after
+  if((osState.flags() & ios_base::adjustfield) == ios_base::left)
+    strDst.append(cpStr, stLen).append(stWidth - stLen, osState.fill());
+  // Right aligned so put padding first and text after
+  else strDst.append(stWidth - stLen, osState.fill()).append(cpStr, stLen);
+}
+/* -- Append a value by sending it through the stream ---------------------- */
+template<typename AnyType>static void StrFmtStream(string &strDst,
+  ostringstream &osState, const AnyType &atVal)
+{ // Send value to stream and return if it did not write anything
+  osState << atVal;
+  if(osState.tellp() <= 0) return;
+  // Move what it wrote into the string and empty the stream
+  strDst.append(osState.str());
+  osState.str(string{});
+}
+/* -- Append a value with the current stream state ------------------------- */
+template<typename AnyType>static void StrFmtPut(string &strDst,
+  ostringstream &osState, const AnyType &atVal)
+{ // Is a basic manipulator? (i.e. hex, dec, fixed, left, etc.)
+  if constexpr(is_invocable_r_v<ios_base&, const AnyType&, ios_base&>)
+    atVal(osState);
+  // Is a C++ string or string view?
+  else if constexpr(is_same_v<AnyType, string> ||
+                    is_same_v<AnyType, string_view>)
+    StrFmtPad(strDst, osState, atVal.data(), atVal.size());
+  // Is a C-String? A stream writes nothing for a null pointer.
+  else if constexpr(is_same_v<remove_cv_t<decay_t<AnyType>>, char*> ||
+                    is_same_v<decay_t<AnyType>, const char*>)
+  { if(atVal) StrFmtPad(strDst, osState, atVal, strlen(atVal)); }
+  // Is a character?
+  else if constexpr(is_same_v<AnyType, char> ||
+                    is_same_v<AnyType, signed char> ||
+                    is_same_v<AnyType, unsigned char>)
+    StrFmtPad(strDst, osState, reinterpret_cast<const char*>(&atVal), 1);
+  // Is a boolean?
+  else if constexpr(is_same_v<AnyType, bool>)
+  { // Stream prints words only when requested
+    if(osState.flags() & ios_base::boolalpha)
+    { if(atVal) StrFmtPad(strDst, osState, "true", 4);
+      else StrFmtPad(strDst, osState, "false", 5); }
+    // Else it is printed as a long integer
+    else StrFmtPut(strDst, osState, static_cast<long>(atVal));
+  } // Is an integer or an enum?
+  else if constexpr(is_integral_v<AnyType> || is_enum_v<AnyType>)
+  { // Get integral type of value
+    typedef typename conditional_t<is_enum_v<AnyType>,
+      underlying_type<AnyType>, type_identity<AnyType>>::type IntType;
+    const IntType itVal = static_cast<IntType>(atVal);
+    // Let the stream handle prefixes and internal padding
+    const ios_base::fmtflags ffFlags = osState.flags();
+    if(ffFlags & (ios_base::showbase|ios_base::internal))
+    { // Byte sized values are promoted so they do not print as characters
+      if constexpr(sizeof(IntType) > 1)
+        return StrFmtStream(strDst, osState, itVal);
+      else return StrFmtStream(strDst, osState, +itVal);
+    }
+    // Get requested base. Streams print non-decimal as unsigned.
+    const int iBase = ffFlags & ios_base::hex ? 16 :
+                     (ffFlags & ios_base::oct ? 8 : 10);
+    // Buffer for number and the position of the sign
+    char caBuf[72], *cpPtr = caBuf + 1;
+    // Decimal?
+    if(iBase == 10)
+    { // Write the number and add a sign to signed types if requested
+      cpPtr = to_chars(cpPtr, caBuf + sizeof(caBuf), itVal).ptr;
+      if(is_signed_v<IntType> && ffFlags & ios_base::showpos && itVal >= 0)
+        return StrFmtPad(strDst, osState, (*caBuf = '+', caBuf),
+          static_cast<size_t>(cpPtr - caBuf));
+    } // Hexadecimal or octal so write as unsigned
+    else
+    { // Write the number
+      cpPtr = to_chars(cpPtr, caBuf + sizeof(caBuf),
+        static_cast<make_unsigned_t<IntType>>(itVal), iBase).ptr;
+      // Uppercase requested? Convert letters
+      if(iBase == 16 && ffFlags & ios_base::uppercase)
+        for(char *cpChar = caBuf + 1; cpChar < cpPtr; ++cpChar)
+          *cpChar = static_cast<char>(toupper(static_cast<int>(*cpChar)));
+    } // Append the number
+    StrFmtPad(strDst, osState, caBuf + 1,
+      static_cast<size_t>(cpPtr - caBuf - 1));
+  } // Is a floating point number?
+  else if constexpr(is_floating_point_v<AnyType>)
+  { // Get requested notation and precision
+    const ios_base::fmtflags ffFlags = osState.flags(),
+      ffFloat = ffFlags & ios_base::floatfield;
+    // Let the stream handle hexfloat, forced points, uppercase and padding
+    if(ffFloat == ios_base::floatfield || ffFlags &
+      (ios_base::showpoint|ios_base::uppercase|ios_base::internal))
+        return StrFmtStream(strDst, osState, atVal);
+    const int iPrec = static_cast<int>(osState.precision());
+    // Buffer for number and the position of the sign
+    char caBuf[384], *cpPtr = caBuf + 1;
+#if defined(MACOS)                     // Floating to_chars not on older MacOS
+    const int iLen = snprintf(cpPtr, sizeof(caBuf) - 1,
+      ffFloat == ios_base::fixed ? "%.*f" :
+        (ffFloat == ios_base::scientific ? "%.*e" : "%.*g"),
+      iPrec, static_cast<double>(atVal));
+    if(iLen > 0) cpPtr += static_cast<size_t>(iLen) < sizeof(caBuf) - 2 ?
+      static_cast<size_t>(iLen) : sizeof(caBuf) - 2;
+#else                                  // Other targets?
+    cpPtr = to_chars(cpPtr, caBuf + sizeof(caBuf), atVal,
+      ffFloat == ios_base::fixed ? chars_format::fixed :
+        (ffFloat == ios_base::scientific ? chars_format::scientific :
+          chars_format::general), iPrec).ptr;
+#endif                                 // Target check
+    // Add a sign if requested
+    if(ffFlags & ios_base::showpos && !signbit(atVal))
+      return StrFmtPad(strDst, osState, (*caBuf = '+', caBuf),
+        static_cast<size_t>(cpPtr - caBuf));
+    // Append the number
+    StrFmtPad(strDst, osState, caBuf + 1,
+      static_cast<size_t>(cpPtr - caBuf - 1));
+  } // Anything else (setw, setprecision, pointers, etc.) goes to the stream
+  else StrFmtStream(strDst, osState, atVal);
+}
+/* -- Append final part of a runtime format -------------------------------- */
+static void StrFormatVarHelper(string &strDst, ostringstream&,
+  const char*const cpPos) { strDst.append(cpPos); }
+/* -- Append a parameter of a runtime format ------------------------------- */
+template<typename AnyType, typename ...VarArgs>
+  static void StrFormatVarHelper(string &strDst, ostringstream &osState,
+    const char*const cpPos, const AnyType &atVal, const VarArgs &...vaVars)
+{ // Find the mark that will be replaced by this parameter and if we
+  // find the character?
+  if(const char*const cpNewPos = strchr(cpPos, '$'))
+  { // Copy text up to the mark and then the value
+    strDst.append(cpPos, cpNewPos);
+    StrFmtPut(strDst, osState, atVal);
+    // Process more parameters from after the mark
+    StrFormatVarHelper(strDst, osState, cpNewPos + 1, vaVars...);
+  } // Return the rest of the string.
+  else strDst.append(cpPos);
+}
+/* -- Append formatted text from a runtime format string ------------------- */
+template<typename ...VarArgs>
+  static string &StrFormatVarTo(string &strDst, const char*const cpFmt,
+    const VarArgs &...vaVars)
+{ // Append the formatted text if the format is valid
+  if(UtfIsCStringValid(cpFmt))
+    StrFormatVarHelper(strDst, StrFmtState(), cpFmt, vaVars...);
+  // Return the string
+  return strDst;
+}
+/* -- Append formatted text from a compile time format string -------------- */
+template<typename ...VarArgs>
+  static string &StrFormatTo(string &strDst,
+    const StrFmt<type_identity_t<VarArgs>...> sfFmt,
+    const VarArgs &...vaVars)
+{ // Get formatting state and position after the last placeholder written
+  ostringstream &osState = StrFmtState();
+  size_t stIndex = 0, stStart = 0;
+  // Copy text up to each placeholder and then its value
+  ((strDst.append(sfFmt.cpFmt + stStart, sfFmt.aPos[stIndex] - stStart),
+    StrFmtPut(strDst, osState, vaVars),
+    stStart = sfFmt.aPos[stIndex++] + 1), ...);
+  // Copy the rest of the format and return the string
+  return strDst.append(sfFmt.cpFmt + stStart, sfFmt.stLen - stStart);
+}
+/* -- Get thread local format buffer --------------------------------------- */
+static string &StrFormatBuffer(void)
+  { static thread_local string strBuffer; strBuffer.clear();
+    return strBuffer; }
+/* -- Format into thread local buffer (valid until next call on thread) ---- */
+template<typename ...VarArgs>
+  static const string &StrFormatTL(
+    const StrFmt<type_identity_t<VarArgs>...> sfFmt, const VarArgs &...vaVars)
+      { return StrFormatTo(StrFormatBuffer(), sfFmt, vaVars...); }
+/* -- Format runtime string into thread local buffer ----------------------- */
+template<typename ...VarArgs>
+  static const string &StrFormatVarTL(const char*const cpFmt,
+    const VarArgs &...vaVars)
+      { return StrFormatVarTo(StrFormatBuffer(), cpFmt, vaVars...); }
 /* == Format a number ====================================================== */
 template<typename IntType>
   static const string StrReadableFromNum(const IntType itVal,
@@ -300,9 +528,11 @@ struct ErrorPluginStandard final
 { /* -- Exception class helper macro for C runtime errors ------------------ */
 #define XCL(r,...) throw Error<ErrorPluginStandard>(r, ## __VA_ARGS__)
   /* -- Constructor to add C runtime error code ---------------------------- */
-  explicit ErrorPluginStandard(ostringstream &osS)
-    { osS << "\n+ Reason<" << StdGetError() << "> = \""
-          << StrFromErrNo() << "\"."; }
+  explicit ErrorPluginStandard(string &strErr)
+  { // Get C runtime error code and add formatted parameter
+    const int iCode = StdGetError();
+    StrFormatTo(strErr, "\n+ Reason<$> = \"$\".", iCode, StrFromErrNo(iCode));
+  }
 };/* ----------------------------------------------------------------------- */
 /* -- Convert special formatted string to unix timestamp ------------------- */
 static StdTimeT StrParseTime2(const string &strS)
@@ -245,10 +245,10 @@ struct SysErrorPlugin final
 { /* -- Exception class helper macro for system errors --------------------- */
 #define XCS(r,...) throw Error<SysErrorPlugin>(r, ## __VA_ARGS__)
   /* -- Constructor to add system error code ------------------------------- */
-  explicit SysErrorPlugin(ostringstream &osS)
+  explicit SysErrorPlugin(string &strErr)
   { // Get system error code and add system formatted parameter
     const int iCode = SysErrorCode();
-    osS << "\n+ Reason<" << iCode << "> = \"" << SysError(iCode) << "\".";
+    StrFormatTo(strErr, "\n+ Reason<$> = \"$\".", iCode, SysError(iCode));
   }
 };/* ----------------------------------------------------------------------- */
 static bool SysIsErrorCode(const int iCode=0)
@@ -11,15 +11,15 @@
 /* ------------------------------------------------------------------------- */
 namespace ITexture {                   // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
-using namespace ICollector::P;         using namespace IError::P;
-using namespace IFboDef::P;            using namespace IFbo::P;
-using namespace IFboItem::P;           using namespace IImage::P;
-using namespace IImageDef::P;          using namespace ILog::P;
-using namespace IMemory::P;            using namespace IOgl::P;
-using namespace IShader::P;            using namespace IShaders::P;
-using namespace IStd::P;               using namespace ISysUtil::P;
-using namespace ITexDef::P;            using namespace IUtil::P;
-using namespace Lib::OS::GlFW;
+using namespace IAsset::P;             using namespace ICollector::P;
+using namespace IError::P;             using namespace IFboDef::P;
+using namespace IFbo::P;               using namespace IFboItem::P;
+using namespace IImage::P;             using namespace IImageDef::P;
+using namespace ILog::P;               using namespace IMemory::P;
+using namespace IOgl::P;               using namespace IShader::P;
+using namespace IShaders::P;           using namespace IStd::P;
+using namespace ISysUtil::P;           using namespace ITexDef::P;
+using namespace IUtil::P;              using namespace Lib::OS::GlFW;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* -- Texture collector class for collector data and custom variables ------ */
@@ -157,7 +157,9 @@ CTOR_MEM_BEGIN(Textures, Texture, ICHelperUnsafe, /* No IdentCSlave<> */),
   template<class TexCompFtor>
     void UploadTexture(const size_t stSlots, const ImageSlot &isSlot,
       const TextureType ttNICFormat, const TextureType ttNXCFormat)
-  { // Reset previous marked for deletion flag
+  { // Time the upload
+    const AssetStageScope assUpload{ AS_UPLOAD };
+    // Reset previous marked for deletion flag
     FlagClear(TF_DELETE);
     // If no mipmaps in this bitmap?
     if(IsNotMipmaps())
@@ -393,8 +395,10 @@ CTOR_MEM_BEGIN(Textures, Texture, ICHelperUnsafe, /* No IdentCSlave<> */),
         break;
       // Texture is 16-bpp?
       case TT_GRAYALPHA:
-        // Set GL_LUMINANCE_ALPHA decoding shader
-        shProgram = &cShaderCore->sh2D16;
+        // Set GL_LUMINANCE_ALPHA decoding shader or the distance field
+        // shader if this is a font storing glyphs as distance fields.
+        shProgram = FlagIsSet(FF_SDF) ?
+          &cShaderCore->sh2DSDF : &cShaderCore->sh2D16;
         ttNXCFormat = GetPixelType();
         // Break to upload raw pixels
         break;
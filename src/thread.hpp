@@ -11,8 +11,9 @@
 namespace IThread {                    // Start of private namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IClock::P;             using namespace ICollector::P;
-using namespace IError::P;             using namespace IIdent::P;
-using namespace ILog::P;               using namespace IStd::P;
+using namespace ICVarDef::P;           using namespace IError::P;
+using namespace IIdent::P;             using namespace ILog::P;
+using namespace IProfile::P;           using namespace IStd::P;
 using namespace IString::P;            using namespace ISysUtil::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public namespace
@@ -65,8 +66,9 @@ CTOR_MEM_BEGIN_CSLAVE(Threads, Thread, ICHelperUnsafe),
     ++cParent->stRunning;
     // Thread longer running
     sbRunning = true;
-    // Thread starting up in log
+    // Thread starting up in log and name it in profiles
     cLog->LogDebugExSafe("Thread $<$> started.", CtrGet(), IdentGet());
+    ProfileSetThreadName(IdentGet());
     // Set the start time and initialise the end time
     scdStart = cmHiRes.GetEpochTime();
     scdEnd = seconds(0);
@@ -373,6 +375,75 @@ template<class Callbacks>class ThreadSyncHelper : private Callbacks
   DELETECOPYCTORS(ThreadSyncHelper)    // Omit copy constructor for safety
 };/* ----------------------------------------------------------------------- */
 static size_t ThreadGetRunning(void) { return cThreads->stRunning; }
+/* == Log writer thread class ============================================== **
+** ######################################################################### **
+** ## The log is created before threads can be, so the thread that writes ## **
+** ## lines queued by the log to the log file lives here.                 ## **
+** ######################################################################### **
+** ------------------------------------------------------------------------- */
+static class LogWriter final :         // Members initially private
+  /* -- Base classes ------------------------------------------------------- */
+  private Thread                       // The writer thread
+{ /* -- Private variables -------------------------------------------------- */
+  SafeBool         bWanted;            // Asynchronous writing requested
+  /* -- Writer thread ------------------------------------------------------ */
+  int WriterMain(Thread&)
+  { // Write batches of queued lines until we're told to exit
+    while(ThreadShouldNotExit()) cLog->WriterTick();
+    // Terminate thread
+    return 1;
+  }
+  /* -- Start the writer thread -------------------------------------------- */
+  void WriterStart(void)
+  { // Ignore if running, not requested or the log has no file to write to
+    if(ThreadIsJoinable() || !bWanted || !cLog->WriterBegin()) return;
+    // Start the thread
+    ThreadStart();
+  }
+  /* -- Stop the writer thread --------------------------------------------- */
+  void WriterStop(void)
+  { // Ignore if not running
+    if(ThreadIsNotJoinable()) return;
+    // Tell the writer thread to exit and wait for it
+    ThreadSetExit();
+    cLog->WriterEnd();
+    ThreadStop();
+    // Write anything that was queued before it was told to exit
+    cLog->WriterFinish();
+  }
+  /* -- Conlib callback function for APP_LOG variable ------------- */ public:
+  CVarReturn LogFileModified(const string &strFN, string &strCV)
+  { // The file is about to change so stop the writer thread
+    WriterStop();
+    // Open the new log file and restart the writer thread if needed
+    const CVarReturn cvrResult = cLog->LogFileModified(strFN, strCV);
+    WriterStart();
+    // Return result
+    return cvrResult;
+  }
+  /* -- Conlib callback function for LOG_ASYNC variable -------------------- */
+  CVarReturn LogAsyncModified(const bool bState)
+  { // Set new state and start or stop the writer thread
+    bWanted = bState;
+    if(bState) WriterStart(); else WriterStop();
+    // Success
+    return ACCEPT;
+  }
+  /* -- Constructor -------------------------------------------------------- */
+  LogWriter(void) :                    // No parameters
+    /* -- Initialisers ----------------------------------------------------- */
+    Thread{ "log", STP_LOW,            // Initialise low perf writer thread
+      bind(&LogWriter::WriterMain,     // " with reference to callback
+        this, _1) },                   // " function
+    bWanted{ false }                   // Writer thread not requested yet
+    /* --------------------------------------------------------------------- */
+    { }                                // Do nothing else
+  /* -- Destructor --------------------------------------------------------- */
+  DTORHELPER(~LogWriter, WriterStop())
+  /* ----------------------------------------------------------------------- */
+  DELETECOPYCTORS(LogWriter)           // Omit copy constructor for safety
+  /* -- End ---------------------------------------------------------------- */
+} *cLogWriter = nullptr;               // Pointer to static class
 /* ------------------------------------------------------------------------- */
 };                                     // End of public namespace
 /* ------------------------------------------------------------------------- */
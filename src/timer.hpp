@@ -2,7 +2,10 @@
 ** ######################################################################### **
 ** ## MS-ENGINE              Copyright (c) MS-Design, All Rights Reserved ## **
 ** ######################################################################### **
-** ## This class is the engine timer manager.                             ## **
+** ## This class is the engine timer manager. It can optionally pace      ## **
+** ## frames by sleeping for most of the time until the next tick is due  ## **
+** ## and then yielding for the remainder, where the amount of time left  ## **
+** ## to yield is calibrated from how long previous sleeps overslept.     ## **
 ** ######################################################################### **
 ** ========================================================================= */
 #pragma once                           // Only one incursion allowed
@@ -10,27 +13,83 @@
 namespace ITimer {                     // Start of private module namespace
 /* -- Dependencies --------------------------------------------------------- */
 using namespace IClock::P;             using namespace ICVarDef::P;
+using namespace IStd::P;               using namespace IUtil::P;
 /* ------------------------------------------------------------------------- */
 namespace P {                          // Start of public module namespace
 /* ------------------------------------------------------------------------- */
+struct TimerFrameStats                 // Frame time statistics
+{ /* ----------------------------------------------------------------------- */
+  uint64_t         uqFrames;           // Number of frames measured
+  double           dMean,              // Average frame time
+                   dStdDev,            // Standard deviation of frame time
+                   dMinimum,           // Shortest frame time
+                   dMaximum,           // Longest frame time
+                   dOversleep;         // Current oversleep estimate
+};/* ----------------------------------------------------------------------- */
 static class Timer final               // Members initially private
 { /* -- Limits ------------------------------------------------------------- */
   static const uint64_t uqIntvMin =    2000000, // Minimum interval
-                        uqIntvMax = 1000000000; // Maximum interval
+                        uqIntvMax = 1000000000, // Maximum interval
+                        uqBucket  =     250000; // Histogram bucket width
+  /* -- Typedefs ----------------------------------------------------------- */
+  typedef array<uint64_t, 128> Histogram; // Frame times in 250us buckets
   /* -- Variables ---------------------------------------------------------- */
   ClkTimePoint     ctpStart,           // Start of frame time
                    ctpTimeOut,         // Time script times out
-                   ctpEnd;             // End of frame time
+                   ctpEnd,             // End of frame time
+                   ctpFrame;           // Time last frame was rendered
   ClkDuration      cdLoop,             // Loop duration
                    cdFrame,            // Frame duration
                    cdAcc,              // Accumulator duration
                    cdLimit,            // Frame limit
                    cdDelay,            // Delay duration
                    cdDelayPst,         // Persistent delay duration
-                   cdTimeOut;          // Frame timeout duration
+                   cdTimeOut,          // Frame timeout duration
+                   cdOversleep;        // Estimated oversleep of a suspend
   uint64_t         uqTriggers,         // Number of frame timeout checks
-                   uqTicks;            // Number of ticks processed this sec
-  bool             bWait;              // Force wait?
+                   uqTicks,            // Number of ticks processed this sec
+                   uqBench,            // Benchmark ticks to run (0 = off)
+                   uqFrames;           // Number of frame times measured
+  double           dFrameMean,         // Running average frame time
+                   dFrameM2,           // Running sum of squared differences
+                   dFrameMin,          // Shortest frame time
+                   dFrameMax;          // Longest frame time
+  Histogram        hFrames;            // Frame time histogram
+  bool             bWait,              // Force wait?
+                   bPacing;            // Pace frames precisely?
+  /* -- Record the time taken by a frame ----------------------------------- */
+  void TimerAddFrame(const ClkDuration cdTime)
+  { // Update running mean and variance (Welford's method)
+    const double dTime = ClockDurationToDouble(cdTime),
+                 dDelta = dTime - dFrameMean;
+    dFrameMean += dDelta / static_cast<double>(++uqFrames);
+    dFrameM2 += dDelta * (dTime - dFrameMean);
+    // Update shortest and longest frame time
+    if(uqFrames == 1) dFrameMin = dFrameMax = dTime;
+    else
+    { dFrameMin = UtilMinimum(dFrameMin, dTime);
+      dFrameMax = UtilMaximum(dFrameMax, dTime); }
+    // Add to histogram with the last bucket holding anything longer
+    ++hFrames[UtilMinimum(static_cast<size_t>(
+      ClockGetCount<nanoseconds>(cdTime) / uqBucket), hFrames.size() - 1)];
+  }
+  /* -- Wait precisely until the next tick is due -------------------------- */
+  void TimerPace(void)
+  { // Time the next tick is due
+    const ClkTimePoint ctpDue = ctpEnd + (cdLimit - cdAcc);
+    // Let the oversleep estimate fall back slowly so it is recalibrated
+    cdOversleep -= cdOversleep / 16;
+    // Sleep for the bulk of the time leaving enough left for an oversleep
+    const ClkTimePoint ctpSleep = cmHiRes.GetTime();
+    const ClkDuration cdSleep = ctpDue - ctpSleep - cdOversleep;
+    if(cdSleep >= milliseconds{ 1 })
+    { TimerSuspend(cdSleep);
+      // Rise straight to any worse oversleep just measured
+      cdOversleep = UtilMaximum(cdOversleep,
+        cmHiRes.GetTime() - ctpSleep - cdSleep);
+    } // Yield for the remainder which should be a fraction of a millisecond
+    while(cmHiRes.GetTime() < ctpDue) ::std::this_thread::yield();
+  }
   /* -- Set engine tick rate --------------------------------------- */ public:
   void TimerSetInterval(const uint64_t uqInterval)
     { cdLimit = nanoseconds{ uqInterval }; }
@@ -58,6 +117,15 @@ static class Timer final               // Members initially private
     // Set new timeout time
     ctpTimeOut = ctpEnd + cdTimeOut;
   }
+  /* -- Do time calculations without looking at the clock ------------------ */
+  void TimerCalculateFixedTime(void)
+  { // Every tick takes exactly the tick rate so results are reproducible
+    cdLoop = cdLimit;
+    ctpEnd = ctpStart + cdLoop;
+    ctpStart = ctpEnd;
+    // The script timeout still has to be measured in real time
+    ctpTimeOut = cmHiRes.GetTime() + cdTimeOut;
+  }
   /* -- Thread suspense by duration ---------------------------------------- */
   void TimerSuspend(const ClkDuration cdAmount) const
     { ::std::this_thread::sleep_for(cdAmount); }
@@ -73,10 +141,13 @@ static class Timer final               // Members initially private
     { if(cdDelay == seconds(0)) bWait = true; }
   /* -- Calculate time elapsed since c++ ----------------------------------- */
   void TimerUpdateBot(void)
-  { // Sleep if theres a delay
-    TimerSuspendRequested();
-    // Calculate current time using stl
-    TimerCalculateTime();
+  { // Benchmarking? Run as fast as possible on a fixed clock
+    if(TimerIsBenchmark()) TimerCalculateFixedTime();
+    // Sleep if theres a delay and calculate current time using stl
+    else
+    { TimerSuspendRequested();
+      TimerCalculateTime();
+    }
     // Frame time is loop time since theres no accumulator
     cdFrame = cdLoop;
     // Increment ticks
@@ -95,13 +166,27 @@ static class Timer final               // Members initially private
     TimerUpdateInteractiveInterim();
     // Store grand frame time
     cdFrame = cdLoop;
+    // Record time since the last frame was rendered
+    TimerAddFrame(ctpEnd - ctpFrame);
+    ctpFrame = ctpEnd;
+  }
+  /* -- Initialise accumulator for first time without recording a frame ---- */
+  void TimerStartInteractive(void)
+  { // Calculate frame time and store it
+    TimerUpdateInteractiveInterim();
+    cdFrame = cdLoop;
+    // Frames are timed from here so the startup script is not one of them
+    ctpFrame = ctpEnd;
+    TimerResetFrameStats();
   }
   /* -- Should execute a game tick? ---------------------------------------- */
   bool TimerShouldTick(void)
   { // Frame limit not reached?
     if(cdAcc < cdLimit)
-    { // Force if we're forced to wait
-      if(bWait) TimerSuspend();
+    { // Wait precisely until the next tick if pacing
+      if(bPacing) TimerPace();
+      // Force if we're forced to wait
+      else if(bWait) TimerSuspend();
       // Or wait a little bit if we can
       else TimerSuspendRequested();
       // Suspend engine thread for the requested delay
@@ -121,9 +206,26 @@ static class Timer final               // Members initially private
   void TimerCatchup(void)
   { // Reset accumulator and duration
     cdAcc = cdLoop = cdFrame = seconds{ 0 };
-    // Update new start and end time
-    ctpStart = ctpEnd = cmHiRes.GetTime();
+    // Update new start, end and frame time
+    ctpStart = ctpEnd = ctpFrame = cmHiRes.GetTime();
+  }
+  /* -- Forget frame time statistics --------------------------------------- */
+  void TimerResetFrameStats(void)
+  { // Clear running statistics and histogram
+    uqFrames = 0;
+    dFrameMean = dFrameM2 = dFrameMin = dFrameMax = 0;
+    hFrames.fill(0);
   }
+  /* -- Return frame time statistics --------------------------------------- */
+  const TimerFrameStats TimerGetFrameStats(void) const
+  { return { uqFrames, dFrameMean, uqFrames > 1 ?
+      sqrt(dFrameM2 / static_cast<double>(uqFrames - 1)) : 0, dFrameMin,
+      dFrameMax, ClockDurationToDouble(cdOversleep) }; }
+  /* -- Return frame time histogram ---------------------------------------- */
+  const Histogram &TimerGetHistogram(void) const { return hFrames; }
+  /* -- Return width of a histogram bucket in seconds ---------------------- */
+  double TimerGetHistogramBucket(void) const
+    { return ClockDurationToDouble(nanoseconds{ uqBucket }); }
   /* -- Return if script timer timed out ----------------------------------- */
   bool TimerIsTimedOut(void)
     { ++uqTriggers; return cmHiRes.GetTime() >= ctpTimeOut; }
@@ -146,6 +248,10 @@ static class Timer final               // Members initially private
   double TimerGetFPSLimit(void) const { return 1.0 / TimerGetLimit(); }
   /* -- Get the number of engine ticks processed --------------------------- */
   uint64_t TimerGetTicks(void) const { return uqTicks; }
+  /* -- Is a benchmark being run? ------------------------------------------ */
+  bool TimerIsBenchmark(void) const { return !!uqBench; }
+  /* -- Get the number of ticks the benchmark runs for --------------------- */
+  uint64_t TimerGetBenchmark(void) const { return uqBench; }
   /* -- Get the current suspend time --------------------------------------- */
   double TimerGetDelay(void) const
     { return ClockDurationToDouble(cdDelay); }
@@ -158,8 +264,9 @@ static class Timer final               // Members initially private
     TimerRestoreDelay();
     // Force a suspend when leaving sandbox if suspend is disabled
     if(bIdle) TimerSetDelayIfZero();
-    // Reset timer
+    // Reset timer and frame time statistics
     TimerCatchup();
+    TimerResetFrameStats();
   }
   /* -- Default constructors ----------------------------------------------- */
   Timer(void) :                        // No parameters
@@ -167,6 +274,7 @@ static class Timer final               // Members initially private
     ctpStart{ milliseconds{0} },       // Init start of frame time
     ctpTimeOut{ ctpStart },            // Init time script times out
     ctpEnd{ ctpStart },                // Init end of frame time
+    ctpFrame{ ctpStart },              // Init time last frame was rendered
     cdLoop{ milliseconds{0} },         // Init loop duration
     cdFrame{ cdLoop },                 // Init frame duration
     cdAcc{ cdLoop },                   // Init accumulator duration
@@ -174,11 +282,14 @@ static class Timer final               // Members initially private
     cdDelay{ cdLoop },                 // Init delay duration
     cdDelayPst{ cdLoop },              // Init persistent delay duration
     cdTimeOut{ cdLoop },               // Init frame timeout duration
+    cdOversleep{ milliseconds{1} },    // Init oversleep estimate
     uqTriggers(0),                     // Init number of frame timeout checks
     uqTicks(0),                        // Init no. of ticks processed this sec
-    bWait(false)                       // Init force wait?
-    /* -- No code ---------------------------------------------------------- */
-    { }
+    uqBench(0),                        // Init benchmark disabled
+    bWait(false),                      // Init force wait?
+    bPacing(false)                     // Init pacing disabled
+    /* -- Reset frame time statistics -------------------------------------- */
+    { TimerResetFrameStats(); }
   /* ----------------------------------------------------------------------- */
   DELETECOPYCTORS(Timer)               // Disable copy constructor and operator
   /* -- TimerSetDelay ------------------------------------------------------ */
@@ -190,6 +301,12 @@ static class Timer final               // Members initially private
     { return CVarSimpleSetIntNLGE(cdLimit, nanoseconds{ uqInterval},
         nanoseconds{ TimerGetMinInterval() },
         nanoseconds{ TimerGetMaxInterval() }); }
+  /* -- Set frame pacing --------------------------------------------------- */
+  CVarReturn TimerSetPacing(const bool bState)
+    { return CVarSimpleSetInt(bPacing, bState); }
+  /* -- Set number of ticks to benchmark ----------------------------------- */
+  CVarReturn TimerSetBenchmark(const uint64_t uqTicksMax)
+    { return CVarSimpleSetInt(uqBench, uqTicksMax); }
   /* -- TimerSetDelay ------------------------------------------------------ */
   CVarReturn TimerSetDelay(const unsigned int uiNewDelay)
   { // Ignore if set over one second, any sort of app would not be usable with
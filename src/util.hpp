@@ -213,6 +213,35 @@ static double UtilToF64LE(const double dV)
   { return UtilCastInt64ToDouble(UtilToI64LE(UtilCastDoubleToInt64(dV))); }
 static double UtilToF64BE(const double dV)
   { return UtilCastInt64ToDouble(UtilToI64BE(UtilCastDoubleToInt64(dV))); }
+/* -- Reverse the byte order of any 1, 2, 4 or 8 byte value ---------------- */
+template<typename Type>static Type UtilByteSwap(const Type tV)
+{ // Swap using the integer of the same size
+  if constexpr(sizeof(Type) == 8)
+    return UtilBruteCast<Type>(SWAP_U64(UtilBruteCast<uint64_t>(tV)));
+  else if constexpr(sizeof(Type) == 4)
+    return UtilBruteCast<Type>(SWAP_U32(UtilBruteCast<uint32_t>(tV)));
+  else if constexpr(sizeof(Type) == 2)
+    return UtilBruteCast<Type>(SWAP_U16(UtilBruteCast<uint16_t>(tV)));
+  else return tV;
+}
+/* -- Read an unaligned element with optional byte swap -------------------- */
+template<typename Type, bool bSwap=false>
+  static Type UtilReadElement(const char*const cpSrc)
+{ // Copy so unaligned reads are safe then swap if requested
+  Type tV;
+  memcpy(&tV, cpSrc, sizeof(Type));
+  if constexpr(bSwap) return UtilByteSwap(tV);
+  else return tV;
+}
+/* -- Write an unaligned element with optional byte swap ------------------- */
+template<typename Type, bool bSwap=false>
+  static void UtilWriteElement(char*const cpDst, const Type tV)
+{ // Swap if requested and copy so unaligned writes are safe
+  if constexpr(bSwap)
+  { const Type tSwapped = UtilByteSwap(tV);
+    memcpy(cpDst, &tSwapped, sizeof(Type)); }
+  else memcpy(cpDst, &tV, sizeof(Type));
+}
 /* -- More helper functions for byte ordering ------------------------------ */
 static int16_t UtilToLittleEndian(const int16_t wV)
   { return UtilToI16LE(wV); }
@@ -440,6 +469,22 @@ template<typename PtrType,typename IntType>
     const PtrType*const ptSrc, const IntType itSrcPos)
       { ptDst[UtilBitToByte(itDstPos)] |=
           UtilReverseByte(ptSrc[UtilBitToByte(itSrcPos)]); }
+/* -- Read up to 64 bits from any bit position into one word --------------- */
+static uint64_t UtilBitGetWord(const unsigned char*const ucpSrc,
+  const size_t stBytes, const size_t stPos, const size_t stBits)
+{ // Get byte to start reading from and bits to shift out of the first byte
+  const size_t stByte = stPos / CHAR_BIT, stShift = stPos % CHAR_BIT,
+               stAvail = stBytes - stByte;
+  // Load as many bytes as we can into the word without overrunning buffer
+  uint64_t uqWord = 0;
+  memcpy(&uqWord, ucpSrc + stByte, stAvail < 8 ? stAvail : 8);
+  uqWord = STRICT_U64LE(uqWord) >> stShift;
+  // Need bits from the ninth byte? Pull them in if they exist
+  if(stShift && stBits > 64 - stShift && stAvail > 8)
+    uqWord |= static_cast<uint64_t>(ucpSrc[stByte + 8]) << (64 - stShift);
+  // Mask off the bits we don't want
+  return stBits < 64 ? uqWord & ((UINT64_C(1) << stBits) - 1) : uqWord;
+}
 // template<typename PtrType,typename IntType>
 //   static bool UtilBitTest2(PtrType*const ptDst, const IntType itDstPos,
 //     const PtrType*const ptSrc, const IntType itSrcPos)
@@ -639,16 +639,17 @@ class SysCon :                         // Members initially private
   void RedrawTitleBar(const string &strTL, const string &strTR)
     { RedrawStatus(0, strTL, strTR); }
   /* -- Redraw console buffer ---------------------------------------------- */
-  void RedrawBuffer(const ConLines &cL, const ConLinesConstRevIt &lS)
+  void RedrawBuffer(const ConLines &cL, const uint64_t qwPos)
   { // Reset cursor position to top left of drawing area
     stX = 0;
     stY = stHm1;
     // Set default text colour
     SetColour(FOREGROUND_RED|FOREGROUND_GREEN|FOREGROUND_BLUE);
     // Draw until we go off the top of the screen
-    for(ConLinesConstRevIt lL(lS); lL != cL.rend() && ValidY(stY); ++lL)
+    for(uint64_t qwIndex = qwPos;
+        qwIndex > cL.LinesBegin() && ValidY(stY); --qwIndex)
     { // Get structure
-      const ConLine &lD = *lL;
+      const ConLine lD{ cL.LinesGet(qwIndex - 1) };
       // Convert RGB colour to Win32 console id colour
       SetColour(wNDXtoW32C[lD.cColour]);
       // Put text in a utf container and write the data. Note: Although
@@ -656,7 +657,7 @@ class SysCon :                         // Members initially private
       // we can make sure we don't access any OOB memory by just checking that
       // the co-ordinates while drawing, we don't have to worry about the
       // integer wrapping at all we are not drawing.
-      stY -= WriteLineWU(UtfDecoder(lD.strLine)) - 1;
+      stY -= WriteLineWU(UtfDecoder(lD.strvLine)) - 1;
     } // Done if there is no lines to clear up to the top
     if(!ValidY(stY)) return;
     // Goto beginning so we can clear lines